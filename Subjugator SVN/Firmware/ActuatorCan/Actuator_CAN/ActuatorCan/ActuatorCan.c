@@ -12,6 +12,7 @@
 #include "inc/hw_gpio.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "MIL_CLK.h"
 #include "MIL_CAN.h"
 
@@ -19,6 +20,7 @@
 //Introduce Parameters
 
 #define MOBO_ID 0x51
+#define ACT_BYTE 0x41 // ASCII 'A' chosen for Actuator Board verification
 
 #define PIN0  GPIO_PIN_0 // Port D
 #define PIN1  GPIO_PIN_1
@@ -37,7 +39,7 @@
 #define PORTD_CLK_ENABLE() SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD)
 #define PORTE_CLK_ENABLE() SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE)
 
-uint8_t VerifyMsg(uint8_t *msg);
+void    ActuatorMsgHandler(MIL_CAN_Frame_t *pframe, void *pctx);
 void    InitProcess(void);
 void    GPIOPinOn(uint8_t *msg);
 void    GPIOPinOff(uint8_t *msg);
@@ -52,14 +54,20 @@ int main(void) {
     uint8_t msg[4]; //use blank message for actual use
     //uint8_t msg[4] = {0x41, 0x08, 0x00, 0x00}; //use dummy message for debugging
     uint8_t arr[12] = {0,0,0,0,0,0,0,0,0,0,0,0};
-    MIL_CAN_MailBox_t MailBox;
+    MIL_CAN_MailBox_t MailBox = {0};
+    static MIL_CAN_Ring_t RxRing;
+    static MIL_CAN_Dispatch_t Dispatch;
     MIL_ClkSetInt_16MHz();
     PORTA_CLK_ENABLE();
     PORTD_CLK_ENABLE();
     PORTE_CLK_ENABLE();
-    MIL_InitCAN(MIL_CAN_PORT_A, CAN1_BASE);
+    MIL_InitCANRate(MIL_CAN_PORT_A, CAN1_BASE, 200000);
     InitProcess();
 
+    //frames are queued by the CAN ISR, 'A' frames go to ActuatorMsgHandler
+    MIL_CAN_RxRingEnable(CAN1_BASE, &RxRing);
+    MIL_CAN_DispatchEnable(CAN1_BASE, &Dispatch, false);
+
     //Mailbox defines, refer to MIL_CAN.c for more information
 
     MailBox.canid = MOBO_ID;
@@ -69,38 +77,36 @@ int main(void) {
     MailBox.obj_num = 0x02;
     MailBox.buffer = msg;
     MIL_InitMailBox(&MailBox);
+    MIL_CAN_Register(&MailBox, ACT_BYTE, &ActuatorMsgHandler, arr);
+
+    IntMasterEnable();
 
     while(1) {
-        // Checks Mailbox, if there is a new message, edit the existing message to copy it
-        if (MIL_CAN_CheckMail(&MailBox) == MIL_CAN_OK) {
-            MIL_CAN_GetMail(&MailBox);
-            if (VerifyMsg(msg)) {
-                if (msg[2] == 0x01) {                         // Pin Write
-                    if (msg[3] == 0x01) {                     // Turns the valve on
-                        GPIOPinOn(msg);
-                        arr[msg[1]] = 0x01;
-                    } else if (msg[3] == 0x00) {              // Turns the valve off
-                        GPIOPinOff(msg);
-                        arr[msg[1]] = 0x00;
-                    }
-                } else if (msg[2] == 0x00) {                  // Pin Read
-                    uint8_t msg_out[4] = {0x41,msg[1],arr[msg[1]],0x00
-                }; // New array created to display the state of a certain pin
-                    MIL_CANSimpleTX(0x53, msg_out, MailBox.msg_len, MailBox.base);
-                }
-            }
-        }
+        // Hands every new message to its handler
+        MIL_CAN_DispatchPoll(CAN1_BASE);
     }
 }
 
 /*************************************************************************/
 //Helper methods
 
-uint8_t VerifyMsg(uint8_t *msg) {
-    if (msg[0] == 0x41) { // ASCII 'A' chosen for Actuator Board verification
-        return 1;
-    } else {
-        return 0;
+// Handles an 'A' message, pctx is the array of pin states
+void ActuatorMsgHandler(MIL_CAN_Frame_t *pframe, void *pctx) {
+    uint8_t *msg = pframe->data;
+    uint8_t *arr = (uint8_t *)pctx;
+
+    if (msg[2] == 0x01) {                         // Pin Write
+        if (msg[3] == 0x01) {                     // Turns the valve on
+            GPIOPinOn(msg);
+            arr[msg[1]] = 0x01;
+        } else if (msg[3] == 0x00) {              // Turns the valve off
+            GPIOPinOff(msg);
+            arr[msg[1]] = 0x00;
+        }
+    } else if (msg[2] == 0x00) {                  // Pin Read
+        uint8_t msg_out[4] = {ACT_BYTE,msg[1],arr[msg[1]],0x00
+    }; // New array created to display the state of a certain pin
+        MIL_CANSimpleTX(0x53, msg_out, 4, CAN1_BASE);
     }
 }
 
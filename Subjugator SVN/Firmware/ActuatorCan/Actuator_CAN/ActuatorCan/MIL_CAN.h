@@ -12,11 +12,27 @@
  *        board termination resistors
  */
 
+#ifdef MIL_CAN_SOCKETCAN
+#include "MIL_CAN_SocketCAN.h"
+#else
 #include "driverlib/can.h"
+#endif
+#include "MIL_CAN_Ring.h"
+#include "MIL_CAN_TxQ.h"
+#include "MIL_CAN_Dispatch.h"
+#include "MIL_CAN_Timing.h"
+#include "MIL_CAN_Diag.h"
+#include "MIL_CAN_TP.h"
+#include "MIL_CAN_Gw.h"
 
 #ifndef MIL_CAN_H_
 #define MIL_CAN_H_
 
+//bit rate MIL_InitCAN uses(see Notes at the top of this file)
+#ifndef MIL_CAN_DEFAULT_RATE
+#define MIL_CAN_DEFAULT_RATE 100000
+#endif
+
 /*
  *Desc: Port selection will come from this enum
  */
@@ -78,9 +94,30 @@ typedef enum {
  * rx_flag - only set this variable if you intend on setting up
  *               CAN interrupts otherwise make it 0
  * buffer  - a pointer to your out data (MUST BE SET)
+ * fifo_depth - message objects chained into a hardware FIFO
+ *              starting at obj_num(0 or 1 means a single object).
+ *              This is its size, fifo_used is how full it is
+ * overruns - frames lost because every object was full, counted
+ *            by MIL_CAN_GetMail(dispatched frames carry
+ *            MIL_CAN_FRAME_LOST_bm instead)
+ * fifo_used - frames still waiting for this mailbox, updated by
+ *             MIL_CAN_GetMail and MIL_CAN_CheckMail
  *
  * OBJ_NUM NOTE: CAN OBJECTS ARE ENUMERATED 1 TO 32 NOT 0 TO 31
  *
+ * FIFO NOTE: A mailbox with fifo_depth N uses objects obj_num to
+ *            obj_num + N - 1, the next mailbox has to start after
+ *            that. The hardware keeps filling the FIFO while you
+ *            are busy so a burst of up to N frames on the same ID
+ *            survives between polls. Call MIL_CAN_GetMail until it
+ *            returns MIL_CAN_NOK to empty it in arrival order.
+ *
+ * ORDER NOTE: The hardware puts a frame in the lowest FREE object of
+ *             the FIFO, so once part of it has been read a newer frame
+ *             can sit below older ones. MIL_CAN_GetMail queues objects
+ *             in the order it first sees them hold data and reads them
+ *             in that order, not lowest first
+ *
  */
 typedef struct{
 
@@ -91,6 +128,12 @@ typedef struct{
   uint8_t  obj_num;         //values 1 to 32
   uint8_t  rx_flag_int;         //value 0 or 1
   uint8_t *buffer;           //pointer to your out array
+  uint8_t  fifo_depth;      //values 0 to 32
+  uint32_t overruns;        //filled in by MIL_CAN
+  uint8_t  fifo_used;       //filled in by MIL_CAN
+  uint32_t fifo_seen;       //objects already in fifo_order(used by MIL_CAN)
+  uint8_t  fifo_head;       //used by MIL_CAN
+  uint8_t  fifo_order[32];  //objects in the order they filled(used by MIL_CAN)
   tCANMsgObject msg_obj;    //used to interface with other TI functions(you do not configure this)
 
 } MIL_CAN_MailBox_t;
@@ -114,9 +157,54 @@ typedef struct{
  *
  * Inputs: port from mil_port enum
  * Assumes: Port clocks are enabled
+ *
+ * Notes: Runs at MIL_CAN_DEFAULT_RATE(100k), use MIL_InitCANRate
+ *        for anything else
  */
 void MIL_InitCAN(mil_can_port_t port,uint32_t base);
 
+/*
+ * Desc: Same as MIL_InitCAN but at a bit rate you pick
+ *
+ * Notes: The bit timing is worked out from the current system
+ *        clock, so set the clock(MIL_CLK) BEFORE calling this
+ *
+ * Inputs:
+ * port - from mil_port enum
+ * base - CAN0_BASE or CAN1_BASE
+ * rate - bit rate(125000 to 1000000 are the usual ones)
+ *
+ * Returns:
+ * MIL_CAN_OK if the rate could be set
+ * MIL_CAN_NOK if the system clock cannot make that rate,
+ *             the controller is left disabled
+ */
+mil_can_status_t MIL_InitCANRate(mil_can_port_t port, uint32_t base, uint32_t rate);
+
+/*
+ * Desc: Changes the bit rate of a running controller
+ *
+ * Notes: The controller drops off the bus for a moment while
+ *        the timing is written. Every node has to agree on the
+ *        rate so change it on the whole bus at once
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * rate - bit rate
+ * sample_point - in 1/10 %, MIL_CAN_SP_DEFAULT(87.5%) if unsure
+ *
+ * Returns:
+ * MIL_CAN_OK if the rate was set
+ * MIL_CAN_NOK if the system clock cannot make that rate(nothing changed)
+ */
+mil_can_status_t MIL_CAN_SetBitRate(uint32_t base, uint32_t rate, uint16_t sample_point);
+
+/*
+ * Desc: Returns the bit rate the controller actually runs at
+ *       (0 before the controller is initialized)
+ */
+uint32_t MIL_CAN_GetBitRate(uint32_t base);
+
 /*
  * Desc: Enables interrupts on CAN0
  *
@@ -154,6 +242,10 @@ void MIL_CANPortClkEnable(mil_can_port_t port);
  * Desc: Easy to use function to transmit a message to the CAN bus
  * 	     This function declares a temporary Can message object and uses
  *	     object 0 to transmit the message
+ *
+ *       If MIL_CAN_TxQueueInit was called for this base the message
+ *       goes through the TX queue instead(see MIL_CANQueueTX) so
+ *       back to back calls no longer overwrite each other
  * 
  * Inputs: 
  * canid - ID of your CAN node
@@ -163,6 +255,60 @@ void MIL_CANPortClkEnable(mil_can_port_t port);
  */
 void MIL_CANSimpleTX(uint32_t canid,uint8_t *pMsg,uint8_t MsgLen, uint32_t base);
 
+/*
+ * Desc: Reserves a bank of message objects as a transmit queue
+ *
+ *       Up to num_obj frames wait in hardware at once, anything
+ *       past that waits in a software overflow ring(see
+ *       MIL_CAN_TxQ.h for how frames are ordered)
+ *
+ * Notes: Objects first_obj to first_obj + num_obj - 1 belong to the
+ *        queue from now on, DO NOT USE THEM FOR MAILBOXES
+ *
+ *        Call this once before anything is sent, frames already
+ *        queued are forgotten
+ *
+ *        This installs the MIL CAN ISR, do not register your
+ *        own ISR on the same base
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pq - queue storage you declare(one per controller)
+ * first_obj - first message object of the bank(1 to 32)
+ * num_obj - objects in the bank(up to MIL_CAN_TXQ_MAX_BANK)
+ */
+void MIL_CAN_TxQueueInit(uint32_t base, MIL_CAN_TxQ_t *pq, uint8_t first_obj, uint8_t num_obj);
+
+/*
+ * Desc: Puts a message on the TX queue
+ *
+ * Notes: Safe to call from the main loop and from ISRs
+ *
+ * Parameters:
+ * canid - ID to transmit with
+ * pMsg - pointer to your message(copied, reuse it right away)
+ * MsgLen - the number of bytes in your message(up to 8 bytes)
+ * base - CAN0_BASE or CAN1_BASE
+ * pdone - called from the CAN ISR once the frame has been sent(can be 0)
+ * pctx - handed back to pdone
+ *
+ * Returns:
+ * MIL_CAN_OK if the message was queued
+ * MIL_CAN_NOK if the queue is full or was never set up
+ */
+mil_can_status_t MIL_CANQueueTX(uint32_t canid, uint8_t *pMsg, uint8_t MsgLen, uint32_t base,
+                                void (*pdone)(uint32_t canid, void *pctx), void *pctx);
+
+/*
+ * Desc: Copies out the TX queue statistics
+ *       (sent/parked/dropped counts and high water marks)
+ *
+ * Returns:
+ * MIL_CAN_OK if the stats were copied
+ * MIL_CAN_NOK if the queue was never set up
+ */
+mil_can_status_t MIL_CAN_TxStatsGet(uint32_t base, MIL_CAN_TxStats_t *pstats);
+
 
 /*
  * Desc: after configureing your mailbox struct
@@ -208,4 +354,247 @@ mil_can_status_t MIL_CAN_GetMail(MIL_CAN_MailBox_t *pmailbox);
  */
 mil_can_status_t MIL_CAN_CheckMail(MIL_CAN_MailBox_t *pmailbox);
 
+/*
+ * Desc: Switches a CAN controller from polled reception
+ *       to interrupt driven reception. From then on the
+ *       MIL CAN ISR copies every message object with new
+ *       data into pring the moment it arrives so a long
+ *       handler in your main loop can no longer cause a
+ *       frame to be overwritten in hardware
+ *
+ * Notes: CALL THIS BEFORE MIL_InitMailBox. Every mailbox
+ *        initialized on this base afterwards gets its RX
+ *        interrupt turned on regardless of rx_flag_int
+ *
+ *        MIL_CAN_CheckMail/MIL_CAN_GetMail keep working but
+ *        hand out frames strictly in arrival order. A mailbox
+ *        only gets mail when its frame is the oldest one in the
+ *        ring, so poll every mailbox you initialize or read
+ *        frames directly with MIL_CAN_ReadFrame
+ *
+ *        This installs the MIL CAN ISR, do not register your
+ *        own ISR on the same base
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pring - ring storage you declare(one per controller)
+ */
+void MIL_CAN_RxRingEnable(uint32_t base, MIL_CAN_Ring_t *pring);
+
+/*
+ * Desc: Sets the function the ISR calls to timestamp frames
+ *       (for example a free running timer read). Frames are
+ *       stamped 0 until one is set
+ *
+ * Parameters:
+ * ptime_fn - returns the current time in whatever unit you like
+ */
+void MIL_CAN_SetTimeSource(uint32_t (*ptime_fn)(void));
+
+/*
+ * Desc: Pulls the oldest received frame off the ring
+ *       of a controller set up with MIL_CAN_RxRingEnable
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pframe - where the frame is copied
+ *
+ * Returns:
+ * MIL_CAN_OK if a frame was copied
+ * MIL_CAN_NOK if the ring is empty or not enabled
+ */
+mil_can_status_t MIL_CAN_ReadFrame(uint32_t base, MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: Turns on handler dispatch for a controller. Instead of
+ *       checking every mailbox and decoding the first byte with
+ *       if/else chains, register a handler per message type with
+ *       MIL_CAN_Register and each frame is handed to its handler
+ *       through a jump table(see MIL_CAN_Dispatch.h)
+ *
+ * Notes: CALL THIS BEFORE MIL_InitMailBox
+ *
+ *        in_isr = false: handlers run from MIL_CAN_DispatchPoll
+ *        in your main loop. With MIL_CAN_RxRingEnable frames are
+ *        taken off the ring, without it the mailboxes are polled
+ *
+ *        in_isr = true: handlers run inside the CAN ISR the
+ *        moment a frame arrives. Frames without a handler still
+ *        go to the ring if one is enabled. KEEP HANDLERS SHORT,
+ *        NO DELAYS
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pd - table storage you declare(one per controller)
+ * in_isr - where handlers run, see notes
+ */
+void MIL_CAN_DispatchEnable(uint32_t base, MIL_CAN_Dispatch_t *pd, bool in_isr);
+
+/*
+ * Desc: Registers a handler for one message type on a mailbox
+ *
+ * Notes: The mailbox's canid/filt_mask picks which IDs reach
+ *        it, msg_type picks frames by their first data byte
+ *
+ * Parameters:
+ * pmailbox - mailbox the frames arrive in
+ * msg_type - first data byte(for example 'K') or MIL_CAN_ANY_TYPE
+ *            for every type without its own handler
+ * phandler - function to call with the frame
+ * pctx - handed back to phandler
+ *
+ * Returns:
+ * MIL_CAN_OK if the handler was added
+ * MIL_CAN_NOK if dispatch is off or the table is full
+ */
+mil_can_status_t MIL_CAN_Register(MIL_CAN_MailBox_t *pmailbox, int16_t msg_type,
+                                  mil_can_handler_t phandler, void *pctx);
+
+/*
+ * Desc: Runs the handler of every frame waiting in the ring,
+ *       call this from your main loop
+ *
+ *       Without a ring it polls every mailbox at once instead:
+ *       NEWDAT is read one time and only the objects holding a
+ *       frame are read(lowest object number first), so one call
+ *       replaces a MIL_CAN_GetMail per mailbox
+ *
+ * Notes: Frames are removed whether or not they had a handler,
+ *        do not mix this with MIL_CAN_GetMail on the same base
+ *
+ *        Also sends whatever segmented transport frames are due
+ *        (see MIL_CAN_TPEnable)
+ *
+ * Returns: number of frames taken off the ring
+ */
+uint32_t MIL_CAN_DispatchPoll(uint32_t base);
+
+/*
+ * Desc: Turns on the segmented transport(see MIL_CAN_TP.h) on a
+ *       mailbox so messages longer than 8 bytes can be sent and
+ *       received. Transport frames(first byte 0x00 to 0x3F) go to
+ *       the transport, every other type still goes to your handlers
+ *
+ * Notes: Needs MIL_CAN_TxQueueInit and MIL_CAN_DispatchEnable with
+ *        in_isr = false on the same base, the transport runs from
+ *        MIL_CAN_DispatchPoll
+ *
+ *        Transport frames only go out while nothing is parked in
+ *        the TX overflow ring and each session has one consecutive
+ *        frame in the queue at a time, so a long transfer never
+ *        pushes your other frames out of the queue
+ *
+ *        Add peers with MIL_CAN_TPOpen afterwards
+ *
+ * Parameters:
+ * pmailbox - mailbox the peers' frames arrive in
+ * ptp - transport storage you declare(one per controller)
+ * tick_hz - ticks per second of the time source(0 if none)
+ *
+ * Returns:
+ * MIL_CAN_OK if the transport is on
+ * MIL_CAN_NOK if the TX queue or main loop dispatch is missing
+ *             or the dispatch table is full
+ */
+mil_can_status_t MIL_CAN_TPEnable(MIL_CAN_MailBox_t *pmailbox, MIL_CAN_TP_t *ptp, uint32_t tick_hz);
+
+/*
+ * Desc: Starts sending a message to a transport peer
+ *
+ * Notes: data is NOT copied, leave it alone until the
+ *        session's pdone runs
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * session - from MIL_CAN_TPOpen
+ * data/len - message(1 to MIL_CAN_TP_MAX_LEN bytes)
+ *
+ * Returns:
+ * MIL_CAN_OK if sending started
+ * MIL_CAN_NOK if the session is still busy, the transport is
+ *             off or the first frame did not fit in the queue
+ */
+mil_can_status_t MIL_CAN_TPWrite(uint32_t base, uint8_t session, uint8_t *data, uint16_t len);
+
+/*
+ * Desc: Turns the board into a gateway between CAN0 and CAN1
+ *       (see MIL_CAN_Gw.h). Frames arriving in the two mailboxes
+ *       are checked against the rule table and queued for the
+ *       other bus, MIL_CAN_GwService sends them
+ *
+ * Notes: Needs MIL_InitCAN, MIL_CAN_TxQueueInit and
+ *        MIL_CAN_DispatchEnable on BOTH bases. The mailboxes are
+ *        usually catch alls(filt_mask = 0) so every frame reaches
+ *        the rules, the gateway takes every message type without
+ *        a handler of its own
+ *
+ *        Add rules with MIL_CAN_GwAddRule and limits with
+ *        MIL_CAN_GwSetRate right after this, before frames arrive.
+ *        Handlers may run in the ISR(in_isr = true), the queues
+ *        are safe for that
+ *
+ *        Forwarded frames only go out while nothing is parked in
+ *        the TX overflow ring, so the node's own frames keep their
+ *        place and a busy bus fills the gateway queue instead
+ *
+ * Parameters:
+ * pgw - gateway storage you declare
+ * pmailbox0 - mailbox on CAN0 the frames to forward arrive in
+ * pmailbox1 - mailbox on CAN1 the frames to forward arrive in
+ * tick_hz - ticks per second of the time source(rate limits need it)
+ *
+ * Returns:
+ * MIL_CAN_OK if the gateway is on
+ * MIL_CAN_NOK if a TX queue or dispatch is missing or a
+ *             dispatch table is full
+ */
+mil_can_status_t MIL_CAN_GwEnable(MIL_CAN_Gw_t *pgw, MIL_CAN_MailBox_t *pmailbox0,
+                                  MIL_CAN_MailBox_t *pmailbox1, uint32_t tick_hz);
+
+/*
+ * Desc: Sends the queued gateway frames the rate limits allow,
+ *       call this from your main loop after MIL_CAN_DispatchPoll
+ *
+ * Notes: Frames of one ID leave the other bus in the order they
+ *        arrived, the TX queue never has two of them loaded at once
+ *
+ * Returns: number of frames forwarded
+ */
+uint32_t MIL_CAN_GwService(void);
+
+/*
+ * Desc: Turns on bus load and error telemetry for a controller
+ *       (see MIL_CAN_Diag.h for what is tracked)
+ *
+ * Notes: Set a time source with MIL_CAN_SetTimeSource first,
+ *        latency/recovery times and the report period use it
+ *
+ *        TX counts and latency need the TX queue
+ *        (MIL_CAN_TxQueueInit), frames sent the legacy way
+ *        are not seen
+ *
+ *        This installs the MIL CAN ISR, do not register your
+ *        own ISR on the same base
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pd - diag storage you declare(one per controller)
+ * tick_hz - ticks per second of the time source
+ * report_id - CAN ID the 'D' frame is sent with
+ * report_ms - how often MIL_CAN_DiagService sends it
+ */
+void MIL_CAN_DiagEnable(uint32_t base, MIL_CAN_Diag_t *pd, uint32_t tick_hz,
+                        uint32_t report_id, uint32_t report_ms);
+
+/*
+ * Desc: Call this from your main loop. Once every report_ms it reads
+ *       the error counters, works out utilisation for the period and
+ *       sends the 'D' frame(layout in MIL_CAN_DiagEncode)
+ *
+ * Returns:
+ * MIL_CAN_OK if a report was sent this call
+ * MIL_CAN_NOK otherwise
+ */
+mil_can_status_t MIL_CAN_DiagService(uint32_t base);
+
 #endif /* MIL_CAN_H_ */
@@ -0,0 +1,175 @@
+/*
+ * Name: MIL_CAN_Dispatch.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Jump table that hands received CAN frames
+ *       straight to the function that handles them
+ *
+ * Note: This file only depends on stdint/stdbool and MIL_CAN_Ring.h
+ *       so it can be built on a PC as well as the TIVA
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_CAN_Dispatch.h"
+
+/*
+ * Desc: empties the table
+ */
+void MIL_CAN_DispatchInit(MIL_CAN_Dispatch_t *pd){
+
+    for(uint8_t i = 0;i < 32;i++){
+        pd->route_of[i] = 0;
+    }
+
+    for(uint8_t r = 0;r < MIL_CAN_DISPATCH_ROUTES;r++){
+        for(uint16_t t = 0;t < 256;t++){
+            pd->jump[r][t] = 0;
+        }
+        pd->any[r] = 0;
+    }
+
+    pd->num_routes = 0;
+    pd->num_handlers = 0;
+    pd->unhandled = 0;
+
+}
+
+/*
+ * Desc: claims a route for the mailbox(if it has none yet)
+ *       and a handler slot
+ *
+ * Returns: handler + 1, 0 if the table is full
+ */
+static uint8_t MIL_CAN_DispatchNew(MIL_CAN_Dispatch_t *pd, uint8_t obj_num,
+                                   mil_can_handler_t phandler, void *pctx){
+
+    //first handler on this mailbox claims a route
+    if(!pd->route_of[obj_num - 1]){
+        if(pd->num_routes >= MIL_CAN_DISPATCH_ROUTES){
+            return 0;
+        }
+        pd->num_routes++;
+        pd->route_of[obj_num - 1] = pd->num_routes;
+    }
+
+    if(pd->num_handlers >= MIL_CAN_DISPATCH_HANDLERS){
+        return 0;
+    }
+    pd->handler[pd->num_handlers] = phandler;
+    pd->ctx[pd->num_handlers] = pctx;
+    pd->num_handlers++;
+
+    return pd->num_handlers;
+
+}
+
+/*
+ * Desc: registers a handler for one message type on one mailbox
+ */
+bool MIL_CAN_DispatchAdd(MIL_CAN_Dispatch_t *pd, uint8_t obj_num, int16_t msg_type,
+                         mil_can_handler_t phandler, void *pctx){
+
+    uint8_t route;
+    uint8_t entry;
+
+    if((obj_num < 1) || (obj_num > 32) || (msg_type < MIL_CAN_ANY_TYPE) || (msg_type > 255)){
+        return false;
+    }
+
+    if(msg_type != MIL_CAN_ANY_TYPE){
+        return MIL_CAN_DispatchAddRange(pd, obj_num, (uint8_t)msg_type, (uint8_t)msg_type,
+                                        phandler, pctx);
+    }
+
+    entry = MIL_CAN_DispatchNew(pd, obj_num, phandler, pctx);
+    if(!entry){
+        return false;
+    }
+    route = pd->route_of[obj_num - 1] - 1;
+
+    /*
+     * Catch all: fill every type that does not have its own handler,
+     * including ones a previous catch all filled in
+     */
+    for(uint16_t t = 0;t < 256;t++){
+        if(!pd->jump[route][t] || (pd->jump[route][t] == pd->any[route])){
+            pd->jump[route][t] = entry;
+        }
+    }
+    pd->any[route] = entry;
+
+    return true;
+
+}
+
+/*
+ * Desc: registers one handler for a range of message types
+ */
+bool MIL_CAN_DispatchAddRange(MIL_CAN_Dispatch_t *pd, uint8_t obj_num, uint8_t first_type,
+                              uint8_t last_type, mil_can_handler_t phandler, void *pctx){
+
+    uint8_t route;
+    uint8_t entry;
+
+    if((obj_num < 1) || (obj_num > 32) || (first_type > last_type)){
+        return false;
+    }
+
+    entry = MIL_CAN_DispatchNew(pd, obj_num, phandler, pctx);
+    if(!entry){
+        return false;
+    }
+    route = pd->route_of[obj_num - 1] - 1;
+
+    for(uint16_t t = first_type;t <= last_type;t++){
+        pd->jump[route][t] = entry;
+    }
+
+    return true;
+
+}
+
+/*
+ * Desc: makes the message objects after obj_num share its handlers
+ */
+bool MIL_CAN_DispatchLink(MIL_CAN_Dispatch_t *pd, uint8_t obj_num, uint8_t count){
+
+    if((obj_num < 1) || (obj_num > 32) || !pd->route_of[obj_num - 1]){
+        return false;
+    }
+
+    for(uint8_t i = 1;(i < count) && ((obj_num + i) <= 32);i++){
+        pd->route_of[obj_num - 1 + i] = pd->route_of[obj_num - 1];
+    }
+
+    return true;
+
+}
+
+/*
+ * Desc: calls the handler registered for a frame
+ */
+bool MIL_CAN_DispatchFrame(MIL_CAN_Dispatch_t *pd, MIL_CAN_Frame_t *pframe){
+
+    uint8_t route = pd->route_of[(pframe->obj_num - 1) & 0x1F];
+    uint8_t entry;
+
+    if(!route){
+        pd->unhandled++;
+        return false;
+    }
+
+    //an empty frame has no type byte, only a catch all can take it
+    entry = pframe->len ? pd->jump[route - 1][pframe->data[0]] : pd->any[route - 1];
+
+    if(!entry){
+        pd->unhandled++;
+        return false;
+    }
+
+    pd->handler[entry - 1](pframe, pd->ctx[entry - 1]);
+
+    return true;
+
+}
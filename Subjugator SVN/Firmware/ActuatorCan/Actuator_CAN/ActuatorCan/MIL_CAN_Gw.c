@@ -0,0 +1,166 @@
+/*
+ * Name: MIL_CAN_Gw.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Rule table, queues and rate limits for forwarding
+ *       frames between CAN0 and CAN1
+ *
+ * Note: This file only depends on stdint/stdbool and MIL_CAN_Ring
+ *       so it can be built on a PC as well as the TIVA
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_CAN_Gw.h"
+
+/*
+ * Desc: sets up an empty gateway
+ */
+void MIL_CAN_GwInit(MIL_CAN_Gw_t *pgw, uint32_t tick_hz, uint32_t now){
+
+    pgw->num_rules = 0;
+    pgw->tick_hz = tick_hz;
+
+    for(uint8_t d = 0;d < 2;d++){
+
+        MIL_CAN_GwDir_t *pdir = &pgw->dir[d];
+
+        MIL_CAN_RingInit(&pdir->queue);
+        pdir->rate = 0;
+        pdir->burst = 1;
+        pdir->credit = 0;
+        pdir->last = now;
+        pdir->stats.forwarded = 0;
+        pdir->stats.filtered = 0;
+        pdir->stats.dropped = 0;
+    }
+
+}
+
+/*
+ * Desc: appends a rule to the table
+ */
+bool MIL_CAN_GwAddRule(MIL_CAN_Gw_t *pgw, uint8_t dir_bm, uint32_t id, uint32_t mask,
+                       uint32_t rw_id, uint32_t rw_mask){
+
+    MIL_CAN_GwRule_t *prule;
+
+    if(pgw->num_rules >= MIL_CAN_GW_RULES)
+        return false;
+
+    prule = &pgw->rule[pgw->num_rules];
+    prule->id = id & mask;
+    prule->mask = mask;
+    prule->rw_id = rw_id & rw_mask;
+    prule->rw_mask = rw_mask;
+    prule->dir_bm = dir_bm;
+
+    pgw->num_rules++;
+
+    return true;
+
+}
+
+/*
+ * Desc: sets a direction's token bucket, it starts full
+ */
+void MIL_CAN_GwSetRate(MIL_CAN_Gw_t *pgw, uint8_t dir, uint32_t rate, uint32_t burst){
+
+    MIL_CAN_GwDir_t *pdir = &pgw->dir[dir & 1];
+
+    if(burst == 0)
+        burst = 1;
+
+    pdir->rate = rate;
+    pdir->burst = burst;
+    pdir->credit = (uint64_t)burst * pgw->tick_hz;
+
+}
+
+/*
+ * Desc: first matching rule decides, the frame is rewritten
+ *       straight into the queue slot so it is only copied once
+ */
+bool MIL_CAN_GwInput(MIL_CAN_Gw_t *pgw, uint8_t dir, const MIL_CAN_Frame_t *pframe){
+
+    MIL_CAN_GwDir_t *pdir = &pgw->dir[dir & 1];
+    uint8_t dir_bm = (dir & 1) ? MIL_CAN_GW_1TO0_bm : MIL_CAN_GW_0TO1_bm;
+    MIL_CAN_GwRule_t *prule = 0;
+    MIL_CAN_Frame_t *pslot;
+
+    for(uint8_t i = 0;i < pgw->num_rules;i++){
+        if((pframe->canid & pgw->rule[i].mask) == pgw->rule[i].id){
+            prule = &pgw->rule[i];
+            break;
+        }
+    }
+
+    if(!prule || !(prule->dir_bm & dir_bm)){
+        pdir->stats.filtered++;
+        return false;
+    }
+
+    pslot = MIL_CAN_RingClaim(&pdir->queue);
+    if(!pslot){
+        pdir->stats.dropped++;
+        return false;
+    }
+
+    *pslot = *pframe;
+    pslot->canid = (pframe->canid & ~prule->rw_mask) | prule->rw_id;
+
+    MIL_CAN_RingCommit(&pdir->queue);
+
+    return true;
+
+}
+
+/*
+ * Desc: tops up the bucket and hands out the oldest frame if
+ *       there is a whole token for it
+ */
+MIL_CAN_Frame_t *MIL_CAN_GwPeek(MIL_CAN_Gw_t *pgw, uint8_t dir, uint32_t now){
+
+    MIL_CAN_GwDir_t *pdir = &pgw->dir[dir & 1];
+    MIL_CAN_Frame_t *pframe = MIL_CAN_RingPeek(&pdir->queue);
+
+    if(!pframe || pdir->rate == 0 || pgw->tick_hz == 0)
+        return pframe;
+
+    uint64_t full = (uint64_t)pdir->burst * pgw->tick_hz;
+
+    pdir->credit += (uint64_t)(now - pdir->last) * pdir->rate;
+    pdir->last = now;
+    if(pdir->credit > full)
+        pdir->credit = full;
+
+    if(pdir->credit < pgw->tick_hz)
+        return 0;
+
+    return pframe;
+
+}
+
+/*
+ * Desc: removes the sent frame and pays for it
+ */
+void MIL_CAN_GwDrop(MIL_CAN_Gw_t *pgw, uint8_t dir){
+
+    MIL_CAN_GwDir_t *pdir = &pgw->dir[dir & 1];
+
+    MIL_CAN_RingDrop(&pdir->queue);
+    pdir->stats.forwarded++;
+
+    if(pdir->rate != 0 && pgw->tick_hz != 0 && pdir->credit >= pgw->tick_hz)
+        pdir->credit -= pgw->tick_hz;
+
+}
+
+/*
+ * Desc: copies out a direction's counters
+ */
+void MIL_CAN_GwStatsGet(MIL_CAN_Gw_t *pgw, uint8_t dir, MIL_CAN_GwStats_t *pstats){
+
+    *pstats = pgw->dir[dir & 1].stats;
+
+}
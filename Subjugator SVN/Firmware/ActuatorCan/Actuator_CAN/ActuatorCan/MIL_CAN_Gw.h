@@ -0,0 +1,185 @@
+/*
+ * Name: MIL_CAN_Gw.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Rule table, queues and rate limits for forwarding
+ *       frames between CAN0 and CAN1
+ *
+ * What to understand: The TM4C123 has two CAN controllers, so one
+ *                     board can join two separate buses(for example
+ *                     the thrusters on one and sensors/batteries on
+ *                     the other) and pass only the frames each side
+ *                     needs across.
+ *
+ *                     Every frame received on one side is checked
+ *                     against the rule table, top to bottom, and the
+ *                     first rule whose id/mask matches decides:
+ *                     - the rule allows this direction: the ID is
+ *                       rewritten(if asked) and the frame is queued
+ *                       for the other side
+ *                     - the rule does not allow this direction: the
+ *                       frame stays where it is
+ *                     Frames no rule matches are not forwarded.
+ *
+ *                     Each direction has its own queue(a MIL_CAN_Ring_t)
+ *                     and its own rate limit, a token bucket that lets
+ *                     through rate frames per second on average and up
+ *                     to burst frames back to back. A busy side can
+ *                     therefore never flood the other one.
+ *
+ * REWRITE NOTE: The forwarded ID is (id & ~rw_mask) | (rw_id & rw_mask),
+ *               rw_mask = 0 keeps the ID as it is
+ *
+ * Note: This file only depends on stdint/stdbool and MIL_CAN_Ring.h
+ *       so it can be built on a PC as well as the TIVA.
+ *       MIL_CAN_GwInput is the only producer of a direction's queue
+ *       and MIL_CAN_GwPeek/MIL_CAN_GwDrop the only consumer, so input
+ *       can run in the CAN ISR while the queues drain in the main loop.
+ *       Add rules before frames start arriving.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "MIL_CAN_Ring.h"
+
+#ifndef MIL_CAN_GW_H_
+#define MIL_CAN_GW_H_
+
+//rules the table can hold
+#ifndef MIL_CAN_GW_RULES
+#define MIL_CAN_GW_RULES 16
+#endif
+
+//directions, also the index of MIL_CAN_Gw_t dir
+#define MIL_CAN_GW_0TO1 0 //received on CAN0, sent on CAN1
+#define MIL_CAN_GW_1TO0 1 //received on CAN1, sent on CAN0
+
+//direction bits of a rule
+#define MIL_CAN_GW_0TO1_bm 0x01
+#define MIL_CAN_GW_1TO0_bm 0x02
+#define MIL_CAN_GW_BOTH_bm (MIL_CAN_GW_0TO1_bm | MIL_CAN_GW_1TO0_bm)
+
+/*
+ * Desc: one rule
+ *
+ * id/mask - frames with (canid & mask) == (id & mask) match
+ * dir_bm - directions the frame is forwarded in(0 blocks it)
+ * rw_id/rw_mask - see REWRITE NOTE
+ */
+typedef struct{
+
+  uint32_t id;
+  uint32_t mask;
+  uint32_t rw_id;
+  uint32_t rw_mask;
+  uint8_t  dir_bm;
+
+}MIL_CAN_GwRule_t;
+
+/*
+ * Desc: direction counters, all counters only go up
+ *
+ * forwarded - frames handed to the other side
+ * filtered - frames no rule let through
+ * dropped - frames lost because the queue was full
+ */
+typedef struct{
+
+  uint32_t forwarded;
+  uint32_t filtered;
+  uint32_t dropped;
+
+}MIL_CAN_GwStats_t;
+
+/*
+ * Desc: one direction(do not touch fields directly)
+ */
+typedef struct{
+
+  MIL_CAN_Ring_t queue;
+  uint32_t rate;            //frames per second, 0 = no limit
+  uint32_t burst;           //most frames sent back to back
+  uint64_t credit;          //tokens x tick_hz
+  uint32_t last;            //tick credit was last topped up
+  MIL_CAN_GwStats_t stats;
+
+}MIL_CAN_GwDir_t;
+
+/*
+ * Desc: the gateway(do not touch fields directly)
+ */
+typedef struct{
+
+  MIL_CAN_GwRule_t rule[MIL_CAN_GW_RULES];
+  uint8_t  num_rules;
+  uint32_t tick_hz;
+  MIL_CAN_GwDir_t dir[2];
+
+}MIL_CAN_Gw_t;
+
+/*
+ * Desc: empty rule table, empty queues, no rate limits
+ *
+ * Parameters:
+ * pgw - your gateway
+ * tick_hz - ticks per second of the now values you pass in
+ * now - current tick
+ */
+void MIL_CAN_GwInit(MIL_CAN_Gw_t *pgw, uint32_t tick_hz, uint32_t now);
+
+/*
+ * Desc: adds a rule below the ones already in the table
+ *
+ * Parameters:
+ * dir_bm - MIL_CAN_GW bits, directions the frames are forwarded in
+ * id/mask - frames the rule matches
+ * rw_id/rw_mask - ID rewrite(rw_mask 0 for none)
+ *
+ * Returns: false if the table is full
+ */
+bool MIL_CAN_GwAddRule(MIL_CAN_Gw_t *pgw, uint8_t dir_bm, uint32_t id, uint32_t mask,
+                       uint32_t rw_id, uint32_t rw_mask);
+
+/*
+ * Desc: limits one direction
+ *
+ * Notes: Frames over the limit wait in the queue, they are only
+ *        dropped if the queue fills up
+ *
+ * Parameters:
+ * dir - MIL_CAN_GW_0TO1 or MIL_CAN_GW_1TO0
+ * rate - frames per second on average(0 = no limit, needs tick_hz)
+ * burst - frames allowed back to back(at least 1)
+ */
+void MIL_CAN_GwSetRate(MIL_CAN_Gw_t *pgw, uint8_t dir, uint32_t rate, uint32_t burst);
+
+/*
+ * Desc: checks a received frame against the rules and
+ *       queues it for the other side
+ *
+ * Returns: true if the frame was queued
+ */
+bool MIL_CAN_GwInput(MIL_CAN_Gw_t *pgw, uint8_t dir, const MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: next frame to send in a direction, if the rate limit allows
+ *
+ * Parameters:
+ * now - current tick
+ *
+ * Returns: the frame(ID already rewritten), 0 if there is nothing to send yet
+ */
+MIL_CAN_Frame_t *MIL_CAN_GwPeek(MIL_CAN_Gw_t *pgw, uint8_t dir, uint32_t now);
+
+/*
+ * Desc: the frame from MIL_CAN_GwPeek was sent, removes
+ *       it and uses up one token
+ */
+void MIL_CAN_GwDrop(MIL_CAN_Gw_t *pgw, uint8_t dir);
+
+/*
+ * Desc: copies out a direction's counters
+ */
+void MIL_CAN_GwStatsGet(MIL_CAN_Gw_t *pgw, uint8_t dir, MIL_CAN_GwStats_t *pstats);
+
+#endif /* MIL_CAN_GW_H_ */
@@ -0,0 +1,80 @@
+/*
+ * Name: MIL_CAN_Timing.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Works out CAN bit timing registers for any
+ *       system clock and bit rate
+ *
+ * What to understand: A CAN bit is split into time quanta(TQ). The
+ *                     prescaler divides the system clock down to one
+ *                     TQ and a bit is sync + prop + phase1 + phase2 TQ
+ *                     long. The bus samples the bit between phase1
+ *                     and phase2, this is the sample point.
+ *
+ *                           |sync|  prop + phase1  | phase2 |
+ *                                                  ^ sample point
+ *
+ *                     The solver tries every bit length the TIVA
+ *                     supports(4 to 24 TQ) and keeps the setting with
+ *                     the smallest bit rate error, then the sample point
+ *                     closest to the one asked for, then the most TQ
+ *                     per bit(finer resynchronization)
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_CAN_TIMING_H_
+#define MIL_CAN_TIMING_H_
+
+//CiA recommended sample point for the whole 125k to 1M range
+#define MIL_CAN_SP_DEFAULT 875 //87.5%
+
+//worst bit rate error the solver will accept(in parts per million)
+#ifndef MIL_CAN_RATE_TOL_PPM
+#define MIL_CAN_RATE_TOL_PPM 5000 //0.5%
+#endif
+
+/*
+ * Desc: a solved bit timing
+ *
+ * PARAMETERS:
+ * sync_prop_phase1 - sync + prop + phase1 in TQ(2 to 16),
+ *                    same meaning as TivaWare ui32SyncPropPhase1Seg
+ * phase2 - phase2 in TQ(1 to 8)
+ * sjw - resync jump width in TQ(1 to 4)
+ * prescaler - system clocks per TQ(1 to 1024)
+ * actual_rate - bit rate these settings really give
+ * sample_point - where the bit is sampled in 1/10 % (875 = 87.5%)
+ */
+typedef struct{
+
+  uint8_t  sync_prop_phase1;
+  uint8_t  phase2;
+  uint8_t  sjw;
+  uint16_t prescaler;
+  uint32_t actual_rate;
+  uint16_t sample_point;
+
+}MIL_CAN_BitTiming_t;
+
+/*
+ * Desc: finds the best bit timing for a bit rate
+ *
+ * Parameters:
+ * clk_hz - CAN module clock(the system clock)
+ * rate - bit rate you want(for example 500000)
+ * sample_point - sample point you want in 1/10 %
+ *                (use MIL_CAN_SP_DEFAULT if unsure)
+ * ptiming - filled in with the result
+ *
+ * Returns: false if no setting gets within MIL_CAN_RATE_TOL_PPM
+ *          of rate, ptiming is left alone
+ */
+bool MIL_CAN_SolveBitTiming(uint32_t clk_hz, uint32_t rate, uint16_t sample_point,
+                            MIL_CAN_BitTiming_t *ptiming);
+
+#endif /* MIL_CAN_TIMING_H_ */
@@ -19,15 +19,53 @@
  *                     If a design for some reason absolutely needs an
  *                     external oscillator,it will be discussed
  *
+ *                     Boards that need the speed can run the crystal
+ *                     through the PLL at up to 80MHz(MIL_ClkSetProfile).
+ *                     MIL_ClkGetHz always tells you what you are running at
+ *
  * Clock system diagram for TIVA:
  * see page 222 ,figure 5-5 of Tiva MCU manual to see how
  * clock system in connected
  */
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #ifndef MIL_CLK_H_
 #define MIL_CLK_H_
 
 #define MIL_16MHz 16000000
+#define MIL_80MHz 80000000
+
+/*
+ * Crystal fitted to the board, a SYSCTL_XTAL_ define
+ * and its frequency. The PLL profiles need it
+ */
+#ifndef MIL_CLK_XTAL
+#define MIL_CLK_XTAL    SYSCTL_XTAL_16MHZ
+#define MIL_CLK_XTAL_HZ 16000000
+#endif
+
+/*
+ * Desc: clock profiles for MIL_ClkSetProfile
+ *
+ * MIL_CLK_INT_16MHz - internal oscillator, PLL off(what the TIVA resets to)
+ * MIL_CLK_XTAL_16MHz - crystal, PLL off
+ * MIL_CLK_PLL_xxMHz - crystal through the PLL(400MHz / 2 / divider)
+ *
+ * Note: The PLL profiles need a crystal on the board. 80MHz is
+ *       the fastest the TM4C123 runs, 5 times the 16MHz default
+ */
+typedef enum{
+
+    MIL_CLK_INT_16MHz,
+    MIL_CLK_XTAL_16MHz,
+    MIL_CLK_PLL_40MHz,
+    MIL_CLK_PLL_50MHz,
+    MIL_CLK_PLL_66MHz,
+    MIL_CLK_PLL_80MHz
+
+}mil_clk_profile_t;
 
 /*
  * Name: MIL_ClkSetInt_16MHz
@@ -36,5 +74,38 @@
  */
 void MIL_ClkSetInt_16MHz(void);
 
+/*
+ * Name: MIL_ClkSetPLL_80MHz
+ * Desc: configures the systems clock to
+ *       run the crystal through the PLL at 80 MHz
+ */
+void MIL_ClkSetPLL_80MHz(void);
+
+/*
+ * Name: MIL_ClkSetProfile
+ * Desc: configures the systems clock to one of
+ *       the profiles in mil_clk_profile_t
+ *
+ * Note: Call this first thing in main, before any
+ *       peripheral is set up. Baud rates, CAN bit timing
+ *       and timer periods are worked out from the clock
+ *       when you set them up, they do not follow a change
+ *       made afterwards
+ */
+void MIL_ClkSetProfile(mil_clk_profile_t profile);
+
+/*
+ * Name: MIL_ClkGetHz
+ * Desc: system clock in Hz
+ *
+ * Note: Every MIL library works its timing out from this,
+ *       do the same in your project instead of writing the
+ *       frequency in(16000000, SysCtlDelay counts...).
+ *
+ *       Change the clock through MIL_CLK only, anything
+ *       else is not seen here
+ */
+uint32_t MIL_ClkGetHz(void);
+
 
 #endif /* MIL_CLK_H_ */
@@ -0,0 +1,264 @@
+/*
+ * Name: dsp_golden.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Expected MIL_DSP outputs, written by dsp_golden.py(do not edit)
+ */
+#include <stdint.h>
+
+#ifndef DSP_GOLDEN_H_
+#define DSP_GOLDEN_H_
+
+#define GOLD_COUNT 67
+#define GOLD_SPLIT 30
+#define GOLD_CIC_LAPS 4
+
+//inputs
+static const int16_t GoldQ15In[67] = {
+    32767, 32767, -32768, -32768, 32767, -32768, 20506, 6769,
+    16236, 29073, -5539, -12495, 19992, -15810, 22204, -3374,
+    8175, -22703, -7134, -2915, -18062, 18767, -15141, 985,
+    -24977, 569, 26222, -24914, 2859, 8904, -12254, 7983,
+    29708, 19939, 14573, -27764, -28312, -18309, 31650, 9609,
+    -9575, -1066, -6855, 10151, -12385, -22030, 18517, -11010,
+    -9839, 20501, 14776, 9504, -28246, -24710, 16276, -17782,
+    672, 13901, 32192, 32669, -2562, 3657, 17228, -26404,
+    10894, -21024, -7495
+};
+static const int16_t GoldQ15InB[67] = {
+    32767, 1, -32768, -1, -32768, 32767, 5148, 29407,
+    -22724, 14775, -30878, 8911, -14014, 17157, 8729, 4108,
+    -19125, -24397, 12767, 28129, -23684, 18245, -17413, 32336,
+    19793, 24679, -20624, 10616, 32457, 8452, 15096, 17987,
+    16396, -17228, 29512, -4237, 459, 454, -1019, -21032,
+    22943, -14248, 30960, -29331, -26409, 12773, -31176, 24748,
+    13038, 6127, 6125, -19204, 28911, 663, 19198, 7702,
+    3639, 31676, 21251, 23015, 2986, -3152, -9883, 24376,
+    21571, -24503, 4311
+};
+static const int32_t GoldQ31In[67] = {
+    2147483647, 2147483647, (-2147483647 - 1), (-2147483647 - 1),
+    368415359, 1358829026, -637434717, -1205359415,
+    -93591338, 1767638702, -658505942, -871416729,
+    1543175526, -1903044883, 1036629419, 1692848821,
+    1756729421, -1925709965, 703423999, 789196182,
+    1034142090, -137966813, -84594126, -891760373,
+    -809306217, -1220821265, -601756388, -775838083,
+    1153493946, 1866951489, -942784362, -196319112,
+    1361694713, 1913498066, 566674281, -858232772,
+    -97611085, 660879215, -1866894645, 1659501275,
+    -337365950, -1058792332, 775751137, 1588409985,
+    -137347745, -15791838, -616333097, -1065379301,
+    1419809573, -1639573337, -150464562, 1271139318,
+    -1645249589, 542274176, -1370819167, -282388962,
+    821726634, 1219517613, 664697567, -260556515,
+    472364208, -1131807512, -511504094, -146469167,
+    -2055227810, 87932676, -378426582
+};
+static const uint16_t GoldADCRaw[268] = {
+    8480, 49776, 47459, 22559, 49544, 6330, 4269, 8835,
+    37482, 61842, 51035, 10459, 51675, 27591, 26095, 27015,
+    3579, 24341, 2796, 19877, 62648, 11414, 36511, 40981,
+    51785, 15971, 24704, 34716, 30153, 19334, 33331, 52941,
+    3077, 21036, 59965, 2370, 56427, 22195, 56316, 32841,
+    24874, 41925, 34306, 41761, 20972, 41538, 31894, 10192,
+    51826, 61203, 49471, 3673, 62248, 58184, 55494, 56569,
+    13483, 20971, 44257, 20102, 12289, 54509, 57448, 16047,
+    8047, 48645, 5969, 62899, 46458, 47595, 59006, 25809,
+    41456, 19355, 21444, 26452, 15036, 25254, 51852, 12868,
+    52718, 46790, 25077, 59689, 47337, 13935, 24787, 44201,
+    53112, 6962, 27600, 12442, 19309, 30941, 43113, 50563,
+    64222, 4147, 264, 56867, 8859, 13843, 17321, 22856,
+    25096, 47976, 52617, 48413, 51638, 5796, 7481, 3258,
+    117, 50920, 42160, 50220, 33117, 23596, 2569, 15186,
+    31021, 22086, 58817, 47671, 52568, 57938, 42515, 48473,
+    26777, 16345, 12422, 23458, 56118, 10423, 4123, 42105,
+    44600, 34802, 43212, 5622, 49284, 54114, 2305, 35496,
+    57356, 17669, 11435, 47542, 22773, 62968, 47360, 56641,
+    32171, 30213, 31369, 421, 40337, 30354, 28678, 35156,
+    460, 55512, 24251, 49565, 44946, 49253, 23289, 14076,
+    24663, 24882, 59692, 5911, 13359, 12573, 43216, 60879,
+    65106, 49277, 19422, 47076, 26317, 28184, 2960, 64498,
+    9035, 42136, 60551, 16526, 46937, 65056, 50048, 5235,
+    19338, 60394, 22663, 50399, 37424, 13757, 23524, 184,
+    47472, 14698, 63821, 11448, 13395, 21930, 21725, 13108,
+    22166, 59584, 45173, 21225, 1737, 39410, 23136, 16829,
+    56603, 45429, 51552, 43509, 33667, 4154, 24335, 50122,
+    56202, 20602, 42262, 51374, 12810, 42795, 36606, 20334,
+    23785, 35502, 14293, 28242, 31310, 50550, 42386, 60586,
+    35237, 3642, 54132, 40235, 727, 46510, 20390, 22102,
+    32751, 34563, 37969, 2395, 54248, 24485, 47161, 37883,
+    25086, 64334, 9104, 13414, 55876, 34394, 40147, 20411,
+    30965, 13751, 30051, 47004
+};
+
+//MIL_DSP_FromADC(GoldADCRaw + 2, 4, out, GOLD_COUNT - 1)
+static const int16_t GoldFromADC[66] = {
+    19224, 1384, 15064, 12152, 22368, 29944, 1024, 4504,
+    20968, 24544, 12304, 25776, 2552, 17968, 26376, 832,
+    14984, 13296, 7712, 21600, 4008, 1688, 24192, 17224,
+    2112, 7496, 27720, 27080, 9600, 20552, 11784, 12440,
+    1072, 216, 18016, 18440, 25944, 18432, 21576, 48,
+    30168, 22472, 18784, 18048, 24304, 23680, 25656, 7168,
+    17464, 24352, 19048, 9960, 936, 21248, 19200, 30840,
+    10416, 30704, 16040, 11408, 7072, 32048, 8840, 16840,
+    7296, 26264
+};
+
+//MIL_DSP_MeanQ15(GoldQ15In, n) for n = 1 to GOLD_COUNT
+static const int16_t GoldMean[67] = {
+    32767, 32767, 10922, 0, 6553, 0, 2929, 3409,
+    4834, 7258, 6094, 4545, 5733, 4194, 5395, 4847,
+    5043, 3501, 2941, 2649, 1662, 2440, 1675, 1647,
+    582, 581, 1531, 586, 665, 939, 514, 747,
+    1625, 2163, 2518, 1677, 866, 362, 1164, 1375,
+    1108, 1056, 872, 1083, 784, 288, 676, 432,
+    222, 628, 905, 1071, 518, 50, 345, 22,
+    33, 272, 813, 1344, 1280, 1318, 1571, 1134,
+    1284, 946, 820
+};
+
+//MIL_DSP_AddQ15(GoldQ15In, GoldQ15InB)
+static const int16_t GoldAdd[67] = {
+    32767, 32767, -32768, -32768, -1, -1, 25654, 32767,
+    -6488, 32767, -32768, -3584, 5978, 1347, 30933, 734,
+    -10950, -32768, 5633, 25214, -32768, 32767, -32554, 32767,
+    -5184, 25248, 5598, -14298, 32767, 17356, 2842, 25970,
+    32767, 2711, 32767, -32001, -27853, -17855, 30631, -11423,
+    13368, -15314, 24105, -19180, -32768, -9257, -12659, 13738,
+    3199, 26628, 20901, -9700, 665, -24047, 32767, -10080,
+    4311, 32767, 32767, 32767, 424, 505, 7345, -2028,
+    32465, -32768, -3184
+};
+
+//MIL_DSP_MAvgQ15, len 8, start 1000
+static const int16_t GoldMAvgQ15[67] = {
+    4970, 8941, 4720, 499, 4470, 249, 2687, 3409,
+    1342, 880, 4284, 6818, 5221, 7341, 7553, 6285,
+    5278, -1194, -1394, -196, -4953, -631, -5299, -4754,
+    -8898, -5989, -1819, -4569, -1954, -3187, -2826, -1951,
+    4884, 7305, 5849, 5493, 1597, -1805, 3683, 3886,
+    -1024, -3650, -6328, -1589, 402, -63, -1705, -4282,
+    -4315, -1619, 1085, 1004, -979, -1314, -1594, -2440,
+    -1127, -1952, 225, 3121, 6332, 9877, 9996, 8919,
+    10196, 5831, 870
+};
+
+//MIL_DSP_MAvgQ31, len 16, start -500000000
+static const int32_t GoldMAvgQ31[67] = {
+    -334532273, -169064545, -272032273, -375000001,
+    -320724041, -204547227, -213136896, -257221860,
+    -231821318, -90093900, -100000521, -123214066,
+    4484404, -83205901, 12833437, 149886489,
+    125464350, -129110251, 49071477, 232613966,
+    274221887, 180672147, 215224684, 234824624,
+    190092444, 3313696, 6860543, 12834209,
+    -11520890, 224103883, 100390522, -17682474,
+    -42372143, 197578359, 189031501, 86067192,
+    15332618, 65260495, -46133287, 113320566,
+    142816832, 152943641, 239037861, 386803365,
+    306125759, 188454301, 208857506, 154541244,
+    158173422, -63893540, -108714718, 24371038,
+    -72356369, -79769184, -48764466, -170132606,
+    -97689320, 44705052, 37764204, -77796202,
+    -39689205, -109440185, -102888372, -45456489,
+    -262646325, -154677200, -168924826
+};
+
+//MIL_DSP_EmaQ15, k 3, start -2000
+static const int16_t GoldEmaQ15[67] = {
+    2346, 6149, 1284, -2973, 1495, -2788, 124, 954,
+    2865, 6141, 4681, 2534, 4716, 2150, 4657, 3653,
+    4218, 853, -145, -491, -2688, -6, -1898, -1537,
+    -4467, -3838, -80, -3185, -2429, -1012, -2418, -1118,
+    2736, 4886, 6097, 1864, -1908, -3958, 493, 1633,
+    232, 69, -796, 572, -1047, -3670, -897, -2161,
+    -3121, -168, 1700, 2675, -1190, -4130, -1579, -3604,
+    -3070, -948, 3194, 6878, 5698, 5443, 6916, 2751,
+    3769, 670, -351
+};
+
+//MIL_DSP_EmaQ31, k 5, start 0
+static const int32_t GoldEmaQ31[67] = {
+    67108863, 132120575, 60882943, -8128513,
+    3638483, 45988187, 24631221, -13805987,
+    -16299280, 39448781, 17637695, -10145256,
+    38396018, -22274011, 10816721, 63380224,
+    116297386, 52484656, 72826510, 95213062,
+    124554594, 116350800, 110071271, 78764032,
+    51011836, 11267051, -7889932, -31888312,
+    5154883, 63336026, 31894763, 24763079,
+    66542192, 124259563, 138085022, 106950090,
+    100557553, 118067604, 56037533, 106145774,
+    92286032, 56314833, 78797217, 125972616,
+    117743854, 113570863, 90761364, 54631968,
+    97293768, 43016670, 36970381, 75538160,
+    21763542, 38029499, -5997022, -14634271,
+    11502007, 49252494, 68485152, 58202599,
+    71145149, 33552878, 16519847, 11426440,
+    -53156506, -48747470, -59049943
+};
+
+//MIL_DSP_BiquadQ15, 1106, 2210, 1106, 18727, -6763
+static const int16_t GoldBiquadQ15[67] = {
+    2212, 9160, 13977, 7775, -1303, -4703, -5662, -3519,
+    1708, 8014, 13099, 12036, 7640, 4550, 2763, 2980,
+    3861, 2525, -1700, -5677, -7881, -8031, -5636, -3836,
+    -4633, -6976, -5900, -1971, -1215, -1270, -383, -426,
+    1926, 8269, 14335, 14409, 5880, -6156, -11708, -7159,
+    -564, 1596, 804, -51, -320, -2817, -5645, -5022,
+    -4309, -3539, 832, 6430, 7379, 944, -6108, -8044,
+    -7928, -5913, 607, 10621, 18296, 18635, 15231, 10505,
+    4057, -1431, -5917
+};
+
+//MIL_DSP_BiquadQ15, 31130, 31130, 31130, 0, 0
+static const int16_t GoldBiquadQ15Hot[67] = {
+    32767, 32767, 32767, -32768, -32768, -32768, 32767, -10437,
+    32767, 32767, 32767, 20974, 3720, -15795, 32767, 5738,
+    32767, -32768, -32768, -32768, -32768, -4199, -27429, 8761,
+    -32768, -32768, 3447, 3566, 7917, -24987, -933, 8803,
+    32767, 32767, 32767, 12821, -32768, 32767, -28445, 32767,
+    32767, -1961, -32768, 4237, -17269, -32768, -30207, -27594,
+    -4431, -661, 32767, 32767, -7535, -32768, -32768, -32768,
+    -1585, -6097, 32767, -32768, 32767, 32767, 32767, -10486,
+    3264, -32768, -32768
+};
+
+//MIL_DSP_BiquadQ31, 72416791, 144833582, 72416791, 1227261013, -443185484
+static const int32_t GoldBiquadQ31[67] = {
+    144833582, 600042038, 915720879, 509313181,
+    -205483433, -448576115, -262754174, -190803509,
+    -321522313, -263440573, 19308786, 102424718,
+    51221825, 37304529, -61208370, 40294189,
+    488055488, 762458919, 576196184, 362106714,
+    399694534, 490795377, 441424739, 221103781,
+    -110055534, -468695493, -750121878, -879748252,
+    -763358500, -280205980, 260844561, 399297646,
+    350496223, 535286163, 855313683, 904271819,
+    596402273, 281959809, 32759974, -174259753,
+    -137514352, -90242471, -159637015, -4856013,
+    317651262, 452608352, 333249401, 38029506,
+    -183597840, -216462165, -307179117, -306897979,
+    -173638384, -171412430, -254519554, -387537314,
+    -413016406, -138069093, 277408618, 528393699,
+    530982898, 358616801, 35422281, -262738244,
+    -507789837, -753117655, -803478703
+};
+
+//MIL_DSP_CicQ15, order 3, rate 8, GoldQ15In GOLD_CIC_LAPS times
+static const int16_t GoldCic3[33] = {
+    2181, 3328, 2567, -4132, 1364, -59, -1684, 697,
+    5489, 947, 4317, -2614, -1389, 1620, -1664, -962,
+    5203, 1714, 3653, 306, -3540, 2310, -1310, -1267,
+    2501, 4044, 1870, 3393, -3850, 394, 709, -1810,
+    -15
+};
+
+//MIL_DSP_CicQ15, order 4, rate 16, GoldQ15In GOLD_CIC_LAPS times
+static const int16_t GoldCic4[16] = {
+    425, 2143, 137, -374, 652, 2762, 538, -449,
+    202, 2680, 1129, -527, -99, 2406, 1710, -541
+};
+
+#endif /* DSP_GOLDEN_H_ */
@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+"""
+Name: dsp_golden.py
+Author: MIL
+Date Created: 10/15/2026
+Desc: Writes dsp_golden.h, the expected output of every MIL_DSP filter
+      for fixed inputs, for test_dsp.c
+
+  python3 dsp_golden.py > dsp_golden.h
+
+The filters are worked out here from the ARM Architecture Reference
+Manual pseudocode of SMLAD and QADD16, not from MIL_DSP.c, so the table
+checks the C fallback and the __smlad/__qadd16 build against the same
+independent answer:
+
+  SMLAD  - SInt(x.lo)*SInt(y.lo) + SInt(x.hi)*SInt(y.hi) + SInt(acc),
+           low 32 bits kept(the Q flag is never read)
+  QADD16 - SignedSat(x.lo + y.lo, 16), SignedSat(x.hi + y.hi, 16)
+
+Everything else follows the C the filters are written in: arithmetic
+right shifts, division truncating towards 0 and wrapping casts.
+"""
+
+import sys
+
+COUNT = 67          # odd, so the pairwise loops run their tail too
+SPLIT = 30          # block filters get COUNT samples in two calls
+CIC_LAPS = 4        # the CIC inputs go round GoldQ15In this many times
+
+
+def s16(v):
+    v &= 0xFFFF
+    return v - 0x10000 if v & 0x8000 else v
+
+
+def s32(v):
+    v &= 0xFFFFFFFF
+    return v - 0x100000000 if v & 0x80000000 else v
+
+
+def sat(v, bits):
+    hi = (1 << (bits - 1)) - 1
+    return max(-hi - 1, min(hi, v))
+
+
+def smlad(x, y, acc):
+    """SMLAD, x/y packed as (lo, hi) pairs"""
+    return s32(x[0] * y[0] + x[1] * y[1] + acc)
+
+
+def qadd16(x, y):
+    """QADD16, x/y packed as (lo, hi) pairs"""
+    return (sat(x[0] + y[0], 16), sat(x[1] + y[1], 16))
+
+
+def c_div(a, b):
+    """C integer division, truncates towards 0"""
+    q = abs(a) // abs(b)
+    return q if (a < 0) == (b < 0) else -q
+
+
+class Rand:
+    """xorshift32, the same inputs on every run"""
+
+    def __init__(self, seed):
+        self.s = seed
+
+    def next(self):
+        s = self.s
+        s ^= (s << 13) & 0xFFFFFFFF
+        s ^= s >> 17
+        s ^= (s << 5) & 0xFFFFFFFF
+        self.s = s
+        return s
+
+
+def inputs():
+    r = Rand(0x2545F491)
+    q15 = [s16(r.next()) for _ in range(COUNT)]
+    q15b = [s16(r.next()) for _ in range(COUNT)]
+    q31 = [s32(r.next()) for _ in range(COUNT)]
+
+    # the corners, saturation and wrapping have to be hit
+    q15[:6] = [32767, 32767, -32768, -32768, 32767, -32768]
+    q15b[:6] = [32767, 1, -32768, -1, -32768, 32767]
+    q31[:4] = [2147483647, 2147483647, -2147483648, -2147483648]
+
+    adc = [r.next() & 0xFFFF for _ in range(4 * COUNT)]
+    return q15, q15b, q31, adc
+
+
+def from_adc(raw, stride, count):
+    return [s16((raw[i * stride] & 0xFFF) << 3) for i in range(count)]
+
+
+def mean_q15(x):
+    acc = 0
+    i = 0
+    while i + 1 < len(x):
+        acc = smlad((x[i], x[i + 1]), (1, 1), acc)
+        i += 2
+    if i < len(x):
+        acc = s32(acc + x[i])
+    return s16(c_div(acc, len(x)))
+
+
+def add_q15(a, b):
+    out = []
+    i = 0
+    while i + 1 < len(a):
+        out += qadd16((a[i], a[i + 1]), (b[i], b[i + 1]))
+        i += 2
+    if i < len(a):
+        out.append(sat(a[i] + b[i], 16))
+    return out
+
+
+def mavg(x, length, start, bits):
+    hist = [start] * length
+    shift = length.bit_length() - 1
+    total = start * length
+    pos = 0
+    out = []
+    for v in x:
+        total += v - hist[pos]
+        if bits == 16:
+            total = s32(total)
+        hist[pos] = v
+        pos = (pos + 1) & (length - 1)
+        out.append(s16(total >> shift) if bits == 16 else s32(total >> shift))
+    return out
+
+
+def ema_q15(x, k, start):
+    y = start * 65536
+    out = []
+    for v in x:
+        y = s32(y + s32((v * 65536 - y) >> k))
+        out.append(s16(s32(y + 0x8000) >> 16))
+    return out
+
+
+def ema_q31(x, k, start):
+    y = start
+    out = []
+    for v in x:
+        y = s32(y + s32((v - y) >> k))
+        out.append(y)
+    return out
+
+
+def biquad_q15(x, b0, b1, b2, a1, a2):
+    x1 = x2 = y1 = y2 = 0
+    out = []
+    for x0 in x:
+        acc = smlad((x0, x1), (b0, b1), 0x2000)
+        acc = smlad((x2, y1), (b2, a1), acc)
+        acc = s32(acc + a2 * y2)
+        x2, x1 = x1, x0
+        y2, y1 = y1, sat(acc >> 14, 16)
+        out.append(y1)
+    return out
+
+
+def biquad_q31(x, b0, b1, b2, a1, a2):
+    x1 = x2 = y1 = y2 = 0
+    out = []
+    for x0 in x:
+        acc = (1 << 29) + b0 * x0 + b1 * x1 + b2 * x2 + a1 * y1 + a2 * y2
+        x2, x1 = x1, x0
+        y2, y1 = y1, sat(acc >> 30, 32)
+        out.append(y1)
+    return out
+
+
+def cic_q15(x, order, rate):
+    shift = order * (rate.bit_length() - 1)
+    integ = [0] * order
+    comb = [0] * order
+    phase = 0
+    out = []
+    for v in x:
+        v &= 0xFFFFFFFF
+        for s in range(order):
+            integ[s] = (integ[s] + v) & 0xFFFFFFFF
+            v = integ[s]
+        phase += 1
+        if phase < rate:
+            continue
+        phase = 0
+        for s in range(order):
+            prev = comb[s]
+            comb[s] = v
+            v = (v - prev) & 0xFFFFFFFF
+        out.append(sat(s32(v) >> shift, 16))
+    return out
+
+
+def table(ctype, name, values, per_line=8):
+    lines = ["static const %s %s[%d] = {" % (ctype, name, len(values))]
+    for i in range(0, len(values), per_line):
+        chunk = values[i:i + per_line]
+        lines.append("    " + ", ".join(str(v) for v in chunk) + ("," if i + per_line < len(values) else ""))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def q31(v):
+    # -2^31 cannot be written as one literal
+    return "(-2147483647 - 1)" if v == -2147483648 else str(v)
+
+
+# filter settings, test_dsp.c sets up the same ones
+BIQ15_LP = (1106, 2210, 1106, 18727, -6763)         # Butterworth, fc = 0.1 fs
+BIQ15_HOT = (31130, 31130, 31130, 0, 0)             # sum wraps on full scale input
+BIQ31_LP = (72416791, 144833582, 72416791, 1227261013, -443185484)
+
+
+def main():
+    q15, q15b, q31_in, adc = inputs()
+
+    out = []
+    out.append("/*")
+    out.append(" * Name: dsp_golden.h")
+    out.append(" * Author: MIL")
+    out.append(" * Date Created: 10/15/2026")
+    out.append(" * Desc: Expected MIL_DSP outputs, written by dsp_golden.py(do not edit)")
+    out.append(" */")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("#ifndef DSP_GOLDEN_H_")
+    out.append("#define DSP_GOLDEN_H_")
+    out.append("")
+    out.append("#define GOLD_COUNT %d" % COUNT)
+    out.append("#define GOLD_SPLIT %d" % SPLIT)
+    out.append("#define GOLD_CIC_LAPS %d" % CIC_LAPS)
+    out.append("")
+    out.append("//inputs")
+    out.append(table("int16_t", "GoldQ15In", q15))
+    out.append(table("int16_t", "GoldQ15InB", q15b))
+    out.append(table("int32_t", "GoldQ31In", [q31(v) for v in q31_in], 4))
+    out.append(table("uint16_t", "GoldADCRaw", adc))
+    out.append("")
+    out.append("//MIL_DSP_FromADC(GoldADCRaw + 2, 4, out, GOLD_COUNT - 1)")
+    out.append(table("int16_t", "GoldFromADC", from_adc(adc[2:], 4, COUNT - 1)))
+    out.append("")
+    out.append("//MIL_DSP_MeanQ15(GoldQ15In, n) for n = 1 to GOLD_COUNT")
+    out.append(table("int16_t", "GoldMean", [mean_q15(q15[:n]) for n in range(1, COUNT + 1)]))
+    out.append("")
+    out.append("//MIL_DSP_AddQ15(GoldQ15In, GoldQ15InB)")
+    out.append(table("int16_t", "GoldAdd", add_q15(q15, q15b)))
+    out.append("")
+    out.append("//MIL_DSP_MAvgQ15, len 8, start 1000")
+    out.append(table("int16_t", "GoldMAvgQ15", mavg(q15, 8, 1000, 16)))
+    out.append("")
+    out.append("//MIL_DSP_MAvgQ31, len 16, start -500000000")
+    out.append(table("int32_t", "GoldMAvgQ31", [q31(v) for v in mavg(q31_in, 16, -500000000, 32)], 4))
+    out.append("")
+    out.append("//MIL_DSP_EmaQ15, k 3, start -2000")
+    out.append(table("int16_t", "GoldEmaQ15", ema_q15(q15, 3, -2000)))
+    out.append("")
+    out.append("//MIL_DSP_EmaQ31, k 5, start 0")
+    out.append(table("int32_t", "GoldEmaQ31", [q31(v) for v in ema_q31(q31_in, 5, 0)], 4))
+    out.append("")
+    out.append("//MIL_DSP_BiquadQ15, %d, %d, %d, %d, %d" % BIQ15_LP)
+    out.append(table("int16_t", "GoldBiquadQ15", biquad_q15(q15, *BIQ15_LP)))
+    out.append("")
+    out.append("//MIL_DSP_BiquadQ15, %d, %d, %d, %d, %d" % BIQ15_HOT)
+    out.append(table("int16_t", "GoldBiquadQ15Hot", biquad_q15(q15, *BIQ15_HOT)))
+    out.append("")
+    out.append("//MIL_DSP_BiquadQ31, %d, %d, %d, %d, %d" % BIQ31_LP)
+    out.append(table("int32_t", "GoldBiquadQ31", [q31(v) for v in biquad_q31(q31_in, *BIQ31_LP)], 4))
+    out.append("")
+    out.append("//MIL_DSP_CicQ15, order 3, rate 8, GoldQ15In GOLD_CIC_LAPS times")
+    out.append(table("int16_t", "GoldCic3", cic_q15(q15 * CIC_LAPS, 3, 8)))
+    out.append("")
+    out.append("//MIL_DSP_CicQ15, order 4, rate 16, GoldQ15In GOLD_CIC_LAPS times")
+    out.append(table("int16_t", "GoldCic4", cic_q15(q15 * CIC_LAPS, 4, 16)))
+    out.append("")
+    out.append("#endif /* DSP_GOLDEN_H_ */")
+
+    sys.stdout.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,60 @@
+/*
+ * Name: mil_test.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Bare minimum check macros for the MIL_TIVA_LIB host tests
+ *
+ * HOW TO USE:
+ *   static void TestSomething(void){
+ *     MIL_CHECK(MIL_CAN_RingCount(&ring) == 0);
+ *     MIL_CHECK_EQ(frame.canid, 0x12);
+ *   }
+ *
+ *   int main(void){
+ *     MIL_RUN(TestSomething);
+ *     return MIL_TEST_DONE();
+ *   }
+ *
+ * Note: Include this from the test file only(one per executable)
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef MIL_TEST_H_
+#define MIL_TEST_H_
+
+static unsigned MilTestChecks;
+static unsigned MilTestFails;
+
+//a failed check prints itself and the test keeps going
+#define MIL_CHECK(cond) do{ \
+    MilTestChecks++; \
+    if(!(cond)){ \
+        MilTestFails++; \
+        printf("%s:%d: FAIL %s\n", __FILE__, __LINE__, #cond); \
+    } \
+}while(0)
+
+//same but prints both values
+#define MIL_CHECK_EQ(a, b) do{ \
+    long long mil_a_ = (long long)(a); \
+    long long mil_b_ = (long long)(b); \
+    MilTestChecks++; \
+    if(mil_a_ != mil_b_){ \
+        MilTestFails++; \
+        printf("%s:%d: FAIL %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, mil_a_, mil_b_); \
+    } \
+}while(0)
+
+#define MIL_RUN(test) do{ \
+    unsigned mil_before_ = MilTestFails; \
+    test(); \
+    printf("%-40s %s\n", #test, (MilTestFails == mil_before_) ? "ok" : "FAILED"); \
+}while(0)
+
+//exit code for main, 0 when every check passed
+#define MIL_TEST_DONE() \
+    (printf("%u checks, %u failed\n", MilTestChecks, MilTestFails), MilTestFails ? 1 : 0)
+
+#endif /* MIL_TEST_H_ */
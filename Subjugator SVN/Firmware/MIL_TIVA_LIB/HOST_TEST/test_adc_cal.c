@@ -0,0 +1,278 @@
+/*
+ * Name: test_adc_cal.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host tests and a conversion benchmark for MIL_ADC_Cal
+ *
+ * Note: Results are checked against the exact Q16 value worked out
+ *       with floor division, halves go up(-1.5 mV reads -1 mV)
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "MIL_ADC_Cal.h"
+#include "mil_test.h"
+
+/*
+ * Desc: floor(q / 65536 + 1/2) without relying on >> of a negative number
+ */
+static int64_t RoundQ16(int64_t q){
+
+    int64_t n = q + 0x8000;
+    int64_t f = n / 65536;
+
+    if((n % 65536) < 0){
+        f--;
+    }
+
+    return f;
+
+}
+
+/*
+ * Desc: every raw value against the exact result
+ */
+static void CheckAllRaw(const MIL_ADC_Cal_t *pcal){
+
+    uint32_t bad = 0;
+
+    for(uint32_t raw = 0;raw <= MIL_ADC_FULL_SCALE;raw++){
+        int64_t q = (int64_t)raw * pcal->gain + pcal->offset;
+
+        bad += MIL_ADC_CalToMilliVolts(pcal, (uint16_t)raw) != RoundQ16(q);
+    }
+
+    MIL_CHECK_EQ(bad, 0);
+
+}
+
+static void TestIdeal(void){
+
+    MIL_ADC_Cal_t cal;
+
+    //no divider, full scale is the reference
+    MIL_ADC_CalIdeal(&cal, 0, 0);
+    MIL_CHECK_EQ(cal.offset, 0);
+    MIL_CHECK_EQ(cal.gain, 52813);          //3300 * 65536 / 4095 rounded
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, 0), 0);
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, MIL_ADC_FULL_SCALE), MIL_ADC_VREF_MV);
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, 2048), 1650);
+    CheckAllRaw(&cal);
+
+    //a 1:1 divider doubles it, only the ratio matters
+    MIL_ADC_CalIdeal(&cal, 10, 10);
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, MIL_ADC_FULL_SCALE), 2 * MIL_ADC_VREF_MV);
+    MIL_ADC_CalIdeal(&cal, 10000, 10000);
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, MIL_ADC_FULL_SCALE), 2 * MIL_ADC_VREF_MV);
+
+    //a battery divider(100k over 10k), 36.3V full scale
+    MIL_ADC_CalIdeal(&cal, 100000, 10000);
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, MIL_ADC_FULL_SCALE), 11 * MIL_ADC_VREF_MV);
+    CheckAllRaw(&cal);
+
+    //a bottom resistor of 0 is no divider
+    MIL_ADC_CalIdeal(&cal, 100, 0);
+    MIL_CHECK_EQ(cal.gain, 52813);
+
+}
+
+static void TestTwoPoint(void){
+
+    MIL_ADC_Cal_t cal = {1, 2};
+    uint32_t refused = 0;
+
+    //refused, and the calibration is left alone
+    MIL_CHECK(!MIL_ADC_CalTwoPoint(&cal, 100, 0, 100, 1000));
+    MIL_CHECK(!MIL_ADC_CalTwoPoint(&cal, 200, 0, 100, 1000));
+    MIL_CHECK_EQ(cal.gain, 1);
+    MIL_CHECK_EQ(cal.offset, 2);
+
+    //the low point comes back exactly, the high one within a millivolt,
+    //unless the line is out of Q16 range at raw 0 and has to be refused
+    for(uint32_t n = 0;n < 200;n++){
+
+        uint16_t raw_lo = (uint16_t)(n * 7);
+        uint16_t raw_hi = (uint16_t)(MIL_ADC_FULL_SCALE - n * 11);
+        int32_t mv_lo = (int32_t)n * 13 - 1200;
+        int32_t mv_hi = 30000 - (int32_t)n * 17;
+        int64_t gain = ((int64_t)(mv_hi - mv_lo) * 65536) / (raw_hi - raw_lo);
+        int64_t offset = (int64_t)mv_lo * 65536 - gain * raw_lo;
+        int32_t err;
+
+        if(offset < INT32_MIN){
+            cal.offset = 2;
+            MIL_CHECK(!MIL_ADC_CalTwoPoint(&cal, raw_lo, mv_lo, raw_hi, mv_hi));
+            MIL_CHECK_EQ(cal.offset, 2);
+            refused++;
+            continue;
+        }
+
+        MIL_CHECK(MIL_ADC_CalTwoPoint(&cal, raw_lo, mv_lo, raw_hi, mv_hi));
+        MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, raw_lo), mv_lo);
+
+        err = MIL_ADC_CalToMilliVolts(&cal, raw_hi) - mv_hi;
+        MIL_CHECK(err >= -1 && err <= 1);
+    }
+    MIL_CHECK(refused > 0 && refused < 200);
+
+    //a line through -40V at raw 0 is out of range, one through -32V is not
+    MIL_CHECK(!MIL_ADC_CalTwoPoint(&cal, 0, -40000, 4000, 0));
+    MIL_CHECK(MIL_ADC_CalTwoPoint(&cal, 0, -32000, 4000, 0));
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, 0), -32000);
+    CheckAllRaw(&cal);
+
+    //a current sensor centred on mid scale reads negative below it
+    MIL_CHECK(MIL_ADC_CalTwoPoint(&cal, 2048, 0, 4000, 25000));
+    MIL_CHECK(cal.offset < 0);
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, 2048), 0);
+    MIL_CHECK(MIL_ADC_CalToMilliVolts(&cal, 100) < -24000);
+    CheckAllRaw(&cal);
+
+    //falling slope
+    MIL_CHECK(MIL_ADC_CalTwoPoint(&cal, 500, 4000, 3500, -2000));
+    MIL_CHECK(cal.gain < 0);
+    MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, 500), 4000);
+    CheckAllRaw(&cal);
+
+}
+
+static void TestNegativeRounding(void){
+
+    //offset in Q16 with no gain, so the result is the offset rounded
+    static const struct{ int32_t offset; int32_t mv; } cases[] = {
+        { -32767,  0 },     //-0.49998
+        { -32768,  0 },     //-0.5 goes up
+        { -32769, -1 },     //-0.50002
+        { -65536, -1 },
+        { -98304, -1 },     //-1.5 goes up
+        { -98305, -2 },
+        {-163840, -2 },     //-2.5 goes up
+        {-163841, -3 },
+        {  32767,  0 },
+        {  32768,  1 },     //0.5 goes up
+        {  98304,  2 },     //1.5 goes up
+        { -65536 * 1000 - 32768, -1000 },
+        { -65536 * 1000 - 32769, -1001 }
+    };
+    MIL_ADC_Cal_t cal;
+
+    cal.gain = 0;
+    for(uint8_t i = 0;i < sizeof(cases) / sizeof(cases[0]);i++){
+        cal.offset = cases[i].offset;
+        MIL_CHECK_EQ(MIL_ADC_CalToMilliVolts(&cal, 1234), cases[i].mv);
+    }
+
+    //a negative offset big enough that every reading is below zero
+    cal.gain = 52813;
+    cal.offset = -(int32_t)4000 * 65536 - 12345;
+    CheckAllRaw(&cal);
+    MIL_CHECK(MIL_ADC_CalToMilliVolts(&cal, MIL_ADC_FULL_SCALE) < 0);
+
+    //the largest gain and offset still fit the 64 bit product
+    cal.gain = INT32_MAX;
+    cal.offset = INT32_MIN;
+    CheckAllRaw(&cal);
+
+}
+
+static void TestBlock(void){
+
+    MIL_ADC_Cal_t cal[3];
+    uint16_t raw[301];
+    int32_t mv[301];
+    uint32_t bad = 0;
+
+    MIL_ADC_CalIdeal(&cal[0], 0, 0);
+    MIL_ADC_CalIdeal(&cal[1], 100000, 10000);
+    MIL_ADC_CalTwoPoint(&cal[2], 2048, 0, 4000, -25000);
+
+    for(uint16_t i = 0;i < 301;i++){
+        raw[i] = (uint16_t)((i * 1031u) & MIL_ADC_FULL_SCALE);
+        mv[i] = 0x7FFFFFFF;
+    }
+
+    //the count does not have to be whole scans
+    MIL_ADC_CalBlock(cal, 3, raw, mv, 301);
+    for(uint16_t i = 0;i < 301;i++){
+        bad += mv[i] != MIL_ADC_CalToMilliVolts(&cal[i % 3], raw[i]);
+    }
+    MIL_CHECK_EQ(bad, 0);
+
+    //one step uses the same calibration for everything
+    MIL_ADC_CalBlock(&cal[2], 1, raw, mv, 300);
+    bad = 0;
+    for(uint16_t i = 0;i < 300;i++){
+        bad += mv[i] != MIL_ADC_CalToMilliVolts(&cal[2], raw[i]);
+    }
+    MIL_CHECK_EQ(bad, 0);
+
+    //a count of 0 writes nothing
+    mv[0] = 12345;
+    MIL_ADC_CalBlock(cal, 3, raw, mv, 0);
+    MIL_CHECK_EQ(mv[0], 12345);
+
+}
+
+/*
+ * Desc: samples per second through MIL_ADC_CalBlock and
+ *       MIL_ADC_CalToMilliVolts
+ */
+static void BenchConvert(void){
+
+    static uint16_t raw[1024];
+    static int32_t mv[1024];
+    MIL_ADC_Cal_t cal[8];
+    const uint32_t rounds = 20000;
+    volatile int32_t sink = 0;
+    int64_t sum = 0;
+    clock_t start;
+    double block_secs;
+    double one_secs;
+
+    for(uint8_t s = 0;s < 8;s++){
+        MIL_ADC_CalTwoPoint(&cal[s], 100 + s, -500 * s, 4000 - s, 3300 + 100 * s);
+    }
+    for(uint16_t i = 0;i < 1024;i++){
+        raw[i] = (uint16_t)((i * 2654435761u) >> 20);
+    }
+
+    start = clock();
+    for(uint32_t r = 0;r < rounds;r++){
+        raw[r & 1023] ^= 1;
+        MIL_ADC_CalBlock(cal, 8, raw, mv, 1024);
+        sum += mv[r & 1023];
+    }
+    block_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for(uint32_t r = 0;r < rounds;r++){
+        for(uint16_t i = 0;i < 1024;i++){
+            sum += MIL_ADC_CalToMilliVolts(&cal[i & 7], raw[i]);
+        }
+    }
+    one_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    sink = (int32_t)sum;
+    (void)sink;
+
+    MIL_CHECK_EQ(mv[5], MIL_ADC_CalToMilliVolts(&cal[5], raw[5]));
+
+    if(block_secs > 0 && one_secs > 0){
+        printf("  block: %.1f Msamples/s, one at a time: %.1f Msamples/s\n",
+               (double)rounds * 1024 / block_secs / 1e6, (double)rounds * 1024 / one_secs / 1e6);
+    }
+
+}
+
+int main(void){
+
+    MIL_RUN(TestIdeal);
+    MIL_RUN(TestTwoPoint);
+    MIL_RUN(TestNegativeRounding);
+    MIL_RUN(TestBlock);
+    MIL_RUN(BenchConvert);
+
+    return MIL_TEST_DONE();
+
+}
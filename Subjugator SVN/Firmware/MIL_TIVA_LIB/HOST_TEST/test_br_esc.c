@@ -0,0 +1,275 @@
+/*
+ * Name: test_br_esc.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host tests for the integer(Q15) path of the kill board's MIL_BR_ESC
+ *
+ * Note: MIL_BR_q15_per is checked against the exact pulse width worked
+ *       out with integer fractions, for every Q15 thrust at six periods
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/pwm.h"
+
+#include "MIL_BR_ESC.h"
+#include "mil_test.h"
+#include "tiva_host.h"
+
+//one generator per period under test
+static const uint32_t Periods[] = {16000, 25000, 40000, 50000, 0xFFFF, 2 * 0xFFFF};
+#define NUM_PERIODS (sizeof(Periods) / sizeof(Periods[0]))
+
+/*
+ * Desc: floor(n / d) for d > 0, without relying on / or >> of a negative
+ */
+static int64_t FloorDiv(int64_t n, int64_t d){
+
+    int64_t q = n / d;
+
+    if((n % d) < 0){
+        q--;
+    }
+
+    return q;
+
+}
+
+/*
+ * Desc: the nearest whole number to n / d, halves go up
+ */
+static int64_t RoundDiv(int64_t n, int64_t d){
+
+    return FloorDiv(2 * n + d, 2 * d);
+
+}
+
+static void Setup(mil_br_gen_t *pgen, uint32_t period){
+
+    HostReset();
+    HostPWM_SetPeriod(PWM0_BASE, PWM_GEN_0, period);
+    MIL_BR_gen_init(pgen, PWM0_BASE, PWM_GEN_0);
+
+}
+
+/*
+ * Desc: the straight line curve, every thrust at every period
+ *
+ * Notes: exact is stop + thrust * span / 32768 rounded, with stop and
+ *        span the 1500us and 400us pulses rounded to PWM clocks
+ */
+static void TestStraightLineExact(void){
+
+    mil_br_gen_t gen;
+
+    MIL_BR_curve_set(0);
+
+    for(uint8_t p = 0;p < NUM_PERIODS;p++){
+
+        int64_t period = Periods[p];
+        int64_t stop = RoundDiv(period * BR_STOP_US, BR_ESC_PERIOD_US);
+        int64_t span = RoundDiv(period * BR_SPAN_US, BR_ESC_PERIOD_US);
+        uint32_t bad = 0;
+        uint32_t far = 0;
+
+        Setup(&gen, Periods[p]);
+
+        for(int32_t t = -32768;t <= 32767;t++){
+
+            int64_t got = MIL_BR_q15_per(&gen, (int16_t)t);
+            //the pulse the ESC asks for, as a fraction of PWM clocks over 2000 * 32768
+            int64_t ideal = period * (BR_STOP_US * 32768 + BR_SPAN_US * (int64_t)t);
+            int64_t err = got * BR_ESC_PERIOD_US * 32768 - ideal;
+
+            bad += got != stop + RoundDiv(t * span, 32768);
+            far += (err < 0 ? -err : err) > BR_ESC_PERIOD_US * 32768;
+        }
+
+        MIL_CHECK_EQ(bad, 0);
+        //and never more than one PWM clock off the ideal pulse
+        MIL_CHECK_EQ(far, 0);
+
+        //the ends and the middle
+        MIL_CHECK_EQ(MIL_BR_q15_per(&gen, 0), stop);
+        MIL_CHECK_EQ(MIL_BR_q15_per(&gen, -32768), stop - span);
+        MIL_CHECK_EQ(MIL_BR_q15_per(&gen, 32767), stop + RoundDiv(32767 * span, 32768));
+    }
+
+}
+
+/*
+ * Desc: the float path against the Q15 path, within one PWM clock
+ */
+static void TestMatchesFloat(void){
+
+    mil_br_gen_t gen;
+
+    MIL_BR_curve_set(0);
+
+    for(uint8_t p = 0;p < NUM_PERIODS;p++){
+
+        uint32_t bad = 0;
+
+        Setup(&gen, Periods[p]);
+
+        for(int32_t t = -32768;t <= 32767;t += 7){
+            int32_t q15 = (int32_t)MIL_BR_q15_per(&gen, (int16_t)t);
+            int32_t flt = (int32_t)MIL_BR_linear_per(t / 32768.0f, PWM0_BASE, PWM_GEN_0);
+
+            bad += (q15 - flt) > 1 || (flt - q15) > 1;
+        }
+        MIL_CHECK_EQ(bad, 0);
+    }
+
+    //float to Q15 clamps
+    MIL_CHECK_EQ(MIL_BR_float_to_q15(1.5f), 32767);
+    MIL_CHECK_EQ(MIL_BR_float_to_q15(1.0f), 32767);
+    MIL_CHECK_EQ(MIL_BR_float_to_q15(-1.0f), -32768);
+    MIL_CHECK_EQ(MIL_BR_float_to_q15(-7.0f), -32768);
+    MIL_CHECK_EQ(MIL_BR_float_to_q15(0.5f), 16384);
+
+}
+
+/*
+ * Desc: a measured curve, exact on its points and never going
+ *       backwards between them
+ */
+static void TestCurve(void){
+
+    static int32_t curve[BR_CURVE_LEN];
+    mil_br_gen_t gen;
+
+    //a dead band around stop and a steeper top end
+    for(int32_t i = 0;i < BR_CURVE_LEN;i++){
+        int32_t x = (i << (16 - BR_CURVE_BITS)) - 32768;
+
+        curve[i] = (x / 2) + (x / 4096) * (x < 0 ? -x : x) / 16;
+    }
+
+    Setup(&gen, 50000);
+    MIL_BR_curve_set(curve);
+
+    for(uint8_t p = 0;p < 2;p++){
+
+        int64_t span = RoundDiv((int64_t)gen.period * BR_SPAN_US, BR_ESC_PERIOD_US);
+        uint32_t bad = 0;
+        uint32_t backwards = 0;
+        uint32_t last = 0;
+
+        for(int32_t i = 0;i < BR_CURVE_LEN - 1;i++){
+            int32_t t = (i << (16 - BR_CURVE_BITS)) - 32768;
+
+            bad += MIL_BR_q15_per(&gen, (int16_t)t) != gen.stop + RoundDiv(curve[i] * span, 32768);
+        }
+        for(int32_t t = -32768;t <= 32767;t++){
+            uint32_t got = MIL_BR_q15_per(&gen, (int16_t)t);
+
+            backwards += t > -32768 && got < last;
+            last = got;
+        }
+        MIL_CHECK_EQ(bad, 0);
+        MIL_CHECK_EQ(backwards, 0);
+
+        //a new period keeps the loaded curve
+        Setup(&gen, 2 * 0xFFFF);
+    }
+
+    MIL_BR_curve_set(0);
+
+}
+
+/*
+ * Desc: staged widths only show once committed, all at once and
+ *       with interrupts held off
+ */
+static void TestStageCommit(void){
+
+    static const uint32_t outs[8] = {PWM_OUT_0, PWM_OUT_1, PWM_OUT_2, PWM_OUT_3,
+                                     PWM_OUT_4, PWM_OUT_5, PWM_OUT_6, PWM_OUT_7};
+    mil_br_stage_t stage;
+
+    HostReset();
+    MIL_BR_stage_init(&stage, PWM0_BASE);
+
+    MIL_CHECK(MIL_BR_stage(&stage, PWM_OUT_0, 100));
+    MIL_CHECK(MIL_BR_stage(&stage, PWM_OUT_5, 200));
+    MIL_CHECK(MIL_BR_stage(&stage, PWM_OUT_0, 150));       //replaces the first
+    MIL_CHECK_EQ(HostPWM_Width(PWM0_BASE, PWM_OUT_0), 0);
+
+    MIL_BR_commit(&stage);
+    MIL_CHECK_EQ(HostPWM_Width(PWM0_BASE, PWM_OUT_0), 150);
+    MIL_CHECK_EQ(HostPWM_Width(PWM0_BASE, PWM_OUT_5), 200);
+    MIL_CHECK_EQ(HostPWM_SyncCount(PWM0_BASE, true), 1);
+    MIL_CHECK_EQ(HostPWM_SyncCount(PWM0_BASE, false), 0);
+    MIL_CHECK(!HostIntMasked());
+
+    //a stage holds every output once, a ninth is refused
+    for(uint8_t i = 0;i < 8;i++){
+        MIL_CHECK(MIL_BR_stage(&stage, outs[i], 1000 + i));
+    }
+    MIL_CHECK(!MIL_BR_stage(&stage, PWM_OUT_7 + 0x40, 1));      //not one of the eight
+    MIL_BR_commit(&stage);
+    MIL_CHECK_EQ(HostPWM_Width(PWM0_BASE, PWM_OUT_7), 1007);
+
+}
+
+/*
+ * Desc: conversions per second on the PC, float path and Q15 path
+ *
+ * Notes: Only the ratio means anything, the PC has a hardware double
+ *        unit the M4F does not. Cycle counts on the target come from
+ *        a TKB_BENCH build of the kill board
+ */
+static void BenchConvert(void){
+
+    const uint32_t rounds = 2000;
+    mil_br_gen_t gen;
+    volatile uint32_t sink = 0;
+    uint32_t sum = 0;
+    clock_t start;
+    double flt_secs;
+    double q15_secs;
+
+    Setup(&gen, 40000);
+    MIL_BR_curve_set(0);
+
+    start = clock();
+    for(uint32_t r = 0;r < rounds;r++){
+        for(int32_t t = -32768;t < 32768;t += 64){
+            sum += MIL_BR_linear_per((t + (int32_t)(r & 63)) / 32768.0f, PWM0_BASE, PWM_GEN_0);
+        }
+    }
+    flt_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for(uint32_t r = 0;r < rounds;r++){
+        for(int32_t t = -32768;t < 32768;t += 64){
+            sum += MIL_BR_q15_per(&gen, (int16_t)(t + (int32_t)(r & 63)));
+        }
+    }
+    q15_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    sink = sum;
+    (void)sink;
+
+    MIL_CHECK(sum != 0);
+
+    if(flt_secs > 0 && q15_secs > 0){
+        printf("  float: %.1f M/s, Q15: %.1f M/s(PC, not target cycles)\n",
+               rounds * 1024.0 / flt_secs / 1e6, rounds * 1024.0 / q15_secs / 1e6);
+    }
+
+}
+
+int main(void){
+
+    MIL_RUN(TestStraightLineExact);
+    MIL_RUN(TestMatchesFloat);
+    MIL_RUN(TestCurve);
+    MIL_RUN(TestStageCommit);
+    MIL_RUN(BenchConvert);
+
+    return MIL_TEST_DONE();
+
+}
@@ -0,0 +1,164 @@
+/*
+ * Name: test_can_fifo.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host tests for a polled FIFO mailbox(no ring), frames have to
+ *       come out of MIL_CAN_GetMail in the order they arrived
+ *
+ * Note: The simulated controller fills the lowest free object of a
+ *       FIFO like the real one, so after a partial drain newer frames
+ *       land below older ones
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+
+#include "MIL_CAN.h"
+#include "mil_test.h"
+#include "tiva_host.h"
+
+#define ID_A  0x10
+#define DEPTH 4
+
+static MIL_CAN_MailBox_t Box;
+static uint8_t Buf[8];
+static uint32_t Sent;
+
+/*
+ * Desc: CAN0 polled, a DEPTH deep FIFO mailbox for ID_A on objects 1-4
+ */
+static void SetupCAN(void){
+
+    HostReset();
+    Sent = 0;
+
+    MIL_InitCAN(MIL_CAN_PORT_B, CAN0_BASE);
+
+    Box.canid = ID_A;
+    Box.filt_mask = 0x7FF;
+    Box.base = CAN0_BASE;
+    Box.msg_len = 8;
+    Box.obj_num = 1;
+    Box.buffer = Buf;
+    Box.fifo_depth = DEPTH;
+    MIL_InitMailBox(&Box);
+
+}
+
+/*
+ * Desc: the next frame, its number is the first two data bytes
+ */
+static void SendNext(void){
+
+    uint8_t data[2] = {(uint8_t)Sent, (uint8_t)(Sent >> 8)};
+
+    HostCAN_Rx(CAN0_BASE, ID_A, data, 2);
+    Sent++;
+
+}
+
+/*
+ * Desc: number of the frame MIL_CAN_GetMail gave back
+ */
+static uint32_t GotNum(void){
+
+    return Buf[0] | ((uint32_t)Buf[1] << 8);
+
+}
+
+/*
+ * Desc: three in, one out, two more in, the rest has to come out in order
+ */
+static void TestPartialDrain(void){
+
+    SetupCAN();
+
+    SendNext();
+    SendNext();
+    SendNext();
+    MIL_CHECK_EQ(MIL_CAN_CheckMail(&Box), MIL_CAN_OK);
+    MIL_CHECK_EQ(Box.fifo_used, 3);
+
+    MIL_CHECK_EQ(MIL_CAN_GetMail(&Box), MIL_CAN_OK);
+    MIL_CHECK_EQ(GotNum(), 0);
+    MIL_CHECK_EQ(Box.fifo_used, 2);
+
+    //frame 3 takes object 1, frame 4 object 4
+    SendNext();
+    SendNext();
+
+    for(uint32_t n = 1;n < 5;n++){
+        MIL_CHECK_EQ(MIL_CAN_GetMail(&Box), MIL_CAN_OK);
+        MIL_CHECK_EQ(GotNum(), n);
+        MIL_CHECK_EQ(Box.fifo_used, 4 - n);
+    }
+    MIL_CHECK_EQ(MIL_CAN_GetMail(&Box), MIL_CAN_NOK);
+    MIL_CHECK_EQ(MIL_CAN_CheckMail(&Box), MIL_CAN_NOK);
+    MIL_CHECK_EQ(Box.overruns, 0);
+    MIL_CHECK(!HostIntMasked());
+
+}
+
+/*
+ * Desc: random sends and reads that never overfill the FIFO
+ */
+static void TestInterleaved(void){
+
+    uint32_t seed = 0x2545F491;
+    uint32_t expect = 0;
+    uint32_t waiting = 0;
+    uint32_t bad_order = 0;
+    uint32_t bad_used = 0;
+
+    SetupCAN();
+
+    for(uint32_t i = 0;i < 20000;i++){
+
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        if((seed & 1) && waiting < DEPTH){
+            SendNext();
+            waiting++;
+        }
+        else if(waiting){
+            MIL_CHECK_EQ(MIL_CAN_GetMail(&Box), MIL_CAN_OK);
+            bad_order += GotNum() != (expect & 0xFFFF);
+            expect++;
+            waiting--;
+            bad_used += Box.fifo_used != waiting;
+        }
+    }
+
+    MIL_CHECK_EQ(bad_order, 0);
+    MIL_CHECK_EQ(bad_used, 0);
+    MIL_CHECK_EQ(Box.overruns, 0);
+
+}
+
+/*
+ * Desc: a new init forgets frames the FIFO was holding
+ */
+static void TestReinit(void){
+
+    SetupCAN();
+
+    SendNext();
+    SendNext();
+    MIL_CHECK_EQ(MIL_CAN_CheckMail(&Box), MIL_CAN_OK);
+    MIL_InitMailBox(&Box);
+    MIL_CHECK_EQ(Box.fifo_used, 0);
+    MIL_CHECK_EQ(MIL_CAN_GetMail(&Box), MIL_CAN_NOK);
+
+}
+
+int main(void){
+
+    MIL_RUN(TestPartialDrain);
+    MIL_RUN(TestInterleaved);
+    MIL_RUN(TestReinit);
+
+    return MIL_TEST_DONE();
+
+}
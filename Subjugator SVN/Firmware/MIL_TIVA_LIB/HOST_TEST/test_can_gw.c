@@ -0,0 +1,150 @@
+/*
+ * Name: test_can_gw.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host tests for the CAN0/CAN1 gateway in MIL_CAN
+ *
+ * Note: Both controllers are simulated, frames are fed into CAN0
+ *       and read back off CAN1 the way the wire would see them
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+
+#include "MIL_CAN.h"
+#include "mil_test.h"
+#include "tiva_host.h"
+
+#define ID_THRUST 0x12
+#define ID_OTHER  0x30
+
+static uint32_t Ticks;
+static uint32_t TestClock(void){
+
+    return Ticks;
+
+}
+
+static void SetupGateway(void){
+
+    static MIL_CAN_TxQ_t q0;
+    static MIL_CAN_TxQ_t q1;
+    static MIL_CAN_Dispatch_t disp0;
+    static MIL_CAN_Dispatch_t disp1;
+    static MIL_CAN_MailBox_t box0;
+    static MIL_CAN_MailBox_t box1;
+    static uint8_t buf0[8];
+    static uint8_t buf1[8];
+    static MIL_CAN_Gw_t gw;
+
+    HostReset();
+    MIL_InitCAN(MIL_CAN_PORT_B, CAN0_BASE);
+    MIL_InitCAN(MIL_CAN_PORT_A, CAN1_BASE);
+    MIL_CAN_SetTimeSource(&TestClock);
+    MIL_CAN_TxQueueInit(CAN0_BASE, &q0, 20, 4);
+    MIL_CAN_TxQueueInit(CAN1_BASE, &q1, 20, 4);
+    MIL_CAN_DispatchEnable(CAN0_BASE, &disp0, true);
+    MIL_CAN_DispatchEnable(CAN1_BASE, &disp1, true);
+
+    //catch alls on both sides
+    box0.canid = 0;
+    box0.filt_mask = 0;
+    box0.base = CAN0_BASE;
+    box0.msg_len = 8;
+    box0.obj_num = 1;
+    box0.buffer = buf0;
+    box0.fifo_depth = 4;
+    MIL_InitMailBox(&box0);
+
+    box1 = box0;
+    box1.base = CAN1_BASE;
+    box1.buffer = buf1;
+    MIL_InitMailBox(&box1);
+
+    MIL_CHECK_EQ(MIL_CAN_GwEnable(&gw, &box0, &box1, 1000), MIL_CAN_OK);
+    MIL_CHECK(MIL_CAN_GwAddRule(&gw, MIL_CAN_GW_0TO1_bm, ID_THRUST, 0x7FF, 0, 0));
+    MIL_CHECK(MIL_CAN_GwAddRule(&gw, MIL_CAN_GW_0TO1_bm, ID_OTHER, 0x7FF, 0, 0));
+
+}
+
+/*
+ * Desc: takes one frame off CAN1 and checks it against what came before
+ *
+ * Returns: false if CAN1 had nothing to send
+ */
+static bool WireOne(uint32_t *pnext_thrust, uint32_t *pnext_other){
+
+    host_can_frame_t wire;
+    uint32_t seq;
+
+    if(!HostCAN_TxOne(CAN1_BASE, &wire)){
+        return false;
+    }
+
+    seq = wire.data[1] | ((uint32_t)wire.data[2] << 8);
+
+    if(wire.canid == ID_THRUST){
+        MIL_CHECK_EQ(seq, *pnext_thrust);
+        *pnext_thrust = seq + 1;
+    }
+    else{
+        MIL_CHECK_EQ(wire.canid, ID_OTHER);
+        MIL_CHECK(seq >= *pnext_other);
+        *pnext_other = seq + 1;
+    }
+
+    HostCAN_Interrupt(CAN1_BASE);
+
+    return true;
+
+}
+
+static void TestThrustBurstKeepsOrder(void){
+
+    uint8_t data[8] = {'T'};
+    uint32_t thrust = 0;
+    uint32_t other = 0;
+    uint32_t next_thrust = 0;
+    uint32_t next_other = 0;
+
+    SetupGateway();
+
+    //a burst of thrust frames with a little other traffic mixed in
+    for(uint32_t n = 0;n < 60;n++){
+
+        bool is_thrust = (n % 5) != 4;
+        uint32_t seq = is_thrust ? thrust++ : other++;
+
+        data[1] = (uint8_t)seq;
+        data[2] = (uint8_t)(seq >> 8);
+        MIL_CHECK(HostCAN_Rx(CAN0_BASE, is_thrust ? ID_THRUST : ID_OTHER, data, 8) != 0);
+        HostCAN_Interrupt(CAN0_BASE);
+
+        //the main loop forwards faster than CAN1 drains
+        MIL_CAN_GwService();
+        if(n & 1){
+            WireOne(&next_thrust, &next_other);
+        }
+        Ticks++;
+    }
+
+    for(uint32_t guard = 0;guard < 200;guard++){
+        MIL_CAN_GwService();
+        if(!WireOne(&next_thrust, &next_other)){
+            break;
+        }
+    }
+
+    MIL_CHECK_EQ(next_thrust, thrust);
+    MIL_CHECK_EQ(next_other, other);
+    MIL_CHECK_EQ(HostCAN_Obj0Count(CAN1_BASE), 0);
+
+}
+
+int main(void){
+
+    MIL_RUN(TestThrustBurstKeepsOrder);
+
+    return MIL_TEST_DONE();
+
+}
@@ -0,0 +1,241 @@
+/*
+ * Name: test_can_ring.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host tests for MIL_CAN_Ring and the MIL_CAN receive ISR
+ *
+ * Note: Bursts are pushed through the real ISR against the simulated
+ *       controller in tiva_host.c, nothing in MIL_CAN is stubbed out
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/interrupt.h"
+
+#include "MIL_CAN.h"
+#include "mil_test.h"
+#include "tiva_host.h"
+
+#define ID_A 0x10
+#define ID_B 0x20
+
+static MIL_CAN_Ring_t Ring;
+static uint8_t BufA[8];
+static uint8_t BufB[8];
+static uint32_t Ticks;
+
+static uint32_t TestClock(void){
+
+    return Ticks++;
+
+}
+
+/*
+ * Desc: frame number n, the number is also the first data byte
+ */
+static void MakeFrame(MIL_CAN_Frame_t *pframe, uint32_t n){
+
+    pframe->canid = ID_A;
+    pframe->len = 2;
+    pframe->data[0] = (uint8_t)n;
+    pframe->data[1] = (uint8_t)(n >> 8);
+    pframe->obj_num = 1;
+    pframe->flags = 0;
+    pframe->timestamp = n;
+
+}
+
+/*
+ * Desc: CAN0 with the ring on, a 4 deep FIFO mailbox for ID_A on
+ *       objects 1-4 and a single object mailbox for ID_B on 5
+ */
+static void SetupCAN(void){
+
+    static MIL_CAN_MailBox_t box_a;
+    static MIL_CAN_MailBox_t box_b;
+
+    HostReset();
+    Ticks = 0;
+
+    MIL_InitCAN(MIL_CAN_PORT_B, CAN0_BASE);
+    MIL_CAN_SetTimeSource(&TestClock);
+    MIL_CAN_RxRingEnable(CAN0_BASE, &Ring);
+
+    box_a.canid = ID_A;
+    box_a.filt_mask = 0x7FF;
+    box_a.base = CAN0_BASE;
+    box_a.msg_len = 8;
+    box_a.obj_num = 1;
+    box_a.buffer = BufA;
+    box_a.fifo_depth = 4;
+    MIL_InitMailBox(&box_a);
+
+    box_b = box_a;
+    box_b.canid = ID_B;
+    box_b.obj_num = 5;
+    box_b.buffer = BufB;
+    box_b.fifo_depth = 0;
+    MIL_InitMailBox(&box_b);
+
+}
+
+static void TestRingFillAndOverrun(void){
+
+    MIL_CAN_Frame_t frame;
+    uint32_t n;
+
+    MIL_CAN_RingInit(&Ring);
+
+    for(n = 0;n < MIL_CAN_RING_SIZE;n++){
+        MakeFrame(&frame, n);
+        MIL_CHECK(MIL_CAN_RingPush(&Ring, &frame));
+    }
+    MIL_CHECK_EQ(MIL_CAN_RingCount(&Ring), MIL_CAN_RING_SIZE);
+
+    //a full ring turns frames away and counts them
+    for(n = 0;n < 5;n++){
+        MakeFrame(&frame, 1000 + n);
+        MIL_CHECK(!MIL_CAN_RingPush(&Ring, &frame));
+        MIL_CHECK(MIL_CAN_RingClaim(&Ring) == 0);
+    }
+    MIL_CHECK_EQ(Ring.dropped, 10);
+
+    //what got in comes out in order
+    for(n = 0;n < MIL_CAN_RING_SIZE;n++){
+        MIL_CHECK(MIL_CAN_RingPop(&Ring, &frame));
+        MIL_CHECK_EQ(frame.timestamp, n);
+    }
+    MIL_CHECK(!MIL_CAN_RingPop(&Ring, &frame));
+    MIL_CHECK(MIL_CAN_RingPeek(&Ring) == 0);
+
+}
+
+static void TestRingIndexWrap(void){
+
+    MIL_CAN_Frame_t frame;
+    uint32_t pushed = 0;
+    uint32_t popped = 0;
+
+    //start just short of the 32 bit wrap
+    MIL_CAN_RingInit(&Ring);
+    Ring.head = 0xFFFFFFF0;
+    Ring.tail = 0xFFFFFFF0;
+
+    //a few frames stay behind so the indexes wrap with the ring part full
+    while(popped < 100){
+
+        for(uint8_t i = 0;i < ((pushed == 0) ? 5 : 2) && pushed < 100;i++){
+            MakeFrame(&frame, pushed);
+            MIL_CHECK(MIL_CAN_RingPush(&Ring, &frame));
+            pushed++;
+        }
+        for(uint8_t i = 0;i < 2 && popped < pushed;i++){
+            MIL_CHECK(MIL_CAN_RingPop(&Ring, &frame));
+            MIL_CHECK_EQ(frame.timestamp, popped);
+            popped++;
+        }
+        if(pushed == 100){
+            while(MIL_CAN_RingPop(&Ring, &frame)){
+                MIL_CHECK_EQ(frame.timestamp, popped);
+                popped++;
+            }
+        }
+        MIL_CHECK_EQ(MIL_CAN_RingCount(&Ring), pushed - popped);
+    }
+
+    MIL_CHECK(Ring.head < 0xFFFFFFF0);
+    MIL_CHECK_EQ(Ring.dropped, 0);
+
+}
+
+static void TestIsrBurstOverrun(void){
+
+    MIL_CAN_Frame_t frame;
+    uint8_t data[8];
+    uint32_t n;
+    const uint32_t burst = MIL_CAN_RING_SIZE + 7;
+
+    SetupCAN();
+
+    //nobody reads the ring while the burst comes in
+    for(n = 0;n < burst;n++){
+        data[0] = (uint8_t)n;
+        data[1] = (uint8_t)(n >> 8);
+        MIL_CHECK(HostCAN_Rx(CAN0_BASE, (n & 1) ? ID_B : ID_A, data, 2) != 0);
+        MIL_CHECK(HostCAN_Interrupt(CAN0_BASE) >= 1);
+    }
+
+    //every object was emptied even though the ring ran out
+    MIL_CHECK_EQ(CANStatusGet(CAN0_BASE, CAN_STS_NEWDAT), 0);
+    MIL_CHECK_EQ(CANIntStatus(CAN0_BASE, CAN_INT_STS_CAUSE), 0);
+
+    MIL_CHECK_EQ(MIL_CAN_RingCount(&Ring), MIL_CAN_RING_SIZE);
+    MIL_CHECK_EQ(Ring.dropped, burst - MIL_CAN_RING_SIZE);
+
+    //the oldest frames were kept, in arrival order
+    for(n = 0;n < MIL_CAN_RING_SIZE;n++){
+        MIL_CHECK_EQ(MIL_CAN_ReadFrame(CAN0_BASE, &frame), MIL_CAN_OK);
+        MIL_CHECK_EQ(frame.data[0] | (frame.data[1] << 8), n);
+        MIL_CHECK_EQ(frame.canid, (n & 1) ? ID_B : ID_A);
+        MIL_CHECK_EQ(frame.obj_num, (n & 1) ? 5 : 1);
+        MIL_CHECK_EQ(frame.timestamp, n);
+        MIL_CHECK_EQ(frame.flags, 0);
+    }
+    MIL_CHECK_EQ(MIL_CAN_ReadFrame(CAN0_BASE, &frame), MIL_CAN_NOK);
+
+    //room again, the next frame gets through
+    data[0] = 0xAB;
+    HostCAN_Rx(CAN0_BASE, ID_A, data, 1);
+    HostCAN_Interrupt(CAN0_BASE);
+    MIL_CHECK_EQ(MIL_CAN_ReadFrame(CAN0_BASE, &frame), MIL_CAN_OK);
+    MIL_CHECK_EQ(frame.data[0], 0xAB);
+    MIL_CHECK_EQ(Ring.dropped, burst - MIL_CAN_RING_SIZE);
+
+}
+
+static void TestIsrLateHardwareOverrun(void){
+
+    MIL_CAN_Frame_t frame;
+    uint8_t data[8] = {0};
+    bool int_off;
+
+    SetupCAN();
+
+    //six frames for a 4 deep FIFO while interrupts are held off
+    int_off = IntMasterDisable();
+    for(uint8_t n = 0;n < 6;n++){
+        data[0] = n;
+        HostCAN_Rx(CAN0_BASE, ID_A, data, 1);
+    }
+    MIL_CHECK_EQ(HostCAN_Interrupt(CAN0_BASE), 0);
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    MIL_CHECK(HostCAN_Interrupt(CAN0_BASE) >= 1);
+
+    //the hardware kept 0 to 2 and the last object was overwritten twice
+    MIL_CHECK_EQ(MIL_CAN_RingCount(&Ring), 4);
+    for(uint8_t n = 0;n < 3;n++){
+        MIL_CAN_ReadFrame(CAN0_BASE, &frame);
+        MIL_CHECK_EQ(frame.data[0], n);
+        MIL_CHECK_EQ(frame.flags, 0);
+    }
+    MIL_CAN_ReadFrame(CAN0_BASE, &frame);
+    MIL_CHECK_EQ(frame.data[0], 5);
+    MIL_CHECK_EQ(frame.obj_num, 4);
+    MIL_CHECK(frame.flags & MIL_CAN_FRAME_LOST_bm);
+    MIL_CHECK_EQ(Ring.dropped, 0);
+
+}
+
+int main(void){
+
+    MIL_RUN(TestRingFillAndOverrun);
+    MIL_RUN(TestRingIndexWrap);
+    MIL_RUN(TestIsrBurstOverrun);
+    MIL_RUN(TestIsrLateHardwareOverrun);
+
+    return MIL_TEST_DONE();
+
+}
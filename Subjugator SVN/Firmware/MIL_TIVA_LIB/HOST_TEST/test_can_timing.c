@@ -0,0 +1,183 @@
+/*
+ * Name: test_can_timing.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host tests for MIL_CAN_SolveBitTiming against a table of
+ *       known-good timings
+ *
+ * Note: Every row was checked by hand against the TM4C CANBIT limits
+ *       and the bit rate it really gives, on top of that each solved
+ *       row is checked against a brute force search of every legal
+ *       setting
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_CAN_Timing.h"
+#include "mil_test.h"
+
+typedef struct{
+
+  uint32_t clk_hz;
+  uint32_t rate;
+  uint16_t sample_point;
+  bool     ok;
+  uint8_t  sync_prop_phase1;
+  uint8_t  phase2;
+  uint8_t  sjw;
+  uint16_t prescaler;
+  uint32_t actual_rate;
+  uint16_t actual_sp;
+
+}timing_row_t;
+
+//clock, rate, asked sp, solvable, spp1, phase2, sjw, prescaler, actual rate, actual sp
+static const timing_row_t Table[] = {
+    {16000000,   50000, 875, true , 14, 2, 2,   20,   50000, 875},
+    {16000000,  100000, 875, true , 14, 2, 2,   10,  100000, 875},
+    {16000000,  125000, 875, true , 14, 2, 2,    8,  125000, 875},
+    {16000000,  250000, 875, true , 14, 2, 2,    4,  250000, 875},
+    {16000000,  500000, 875, true , 14, 2, 2,    2,  500000, 875},
+    {16000000,  800000, 875, true ,  9, 1, 1,    2,  800000, 900},
+    {16000000, 1000000, 875, true , 14, 2, 2,    1, 1000000, 875},
+    {40000000,   50000, 875, true , 14, 2, 2,   50,   50000, 875},
+    {40000000,  100000, 875, true , 14, 2, 2,   25,  100000, 875},
+    {40000000,  125000, 875, true , 14, 2, 2,   20,  125000, 875},
+    {40000000,  250000, 875, true , 14, 2, 2,   10,  250000, 875},
+    {40000000,  500000, 875, true , 14, 2, 2,    5,  500000, 875},
+    {40000000,  800000, 875, true ,  9, 1, 1,    5,  800000, 900},
+    {40000000, 1000000, 875, true ,  7, 1, 1,    5, 1000000, 875},
+    {50000000,   50000, 875, true ,  7, 1, 1,  125,   50000, 875},
+    {50000000,  100000, 875, true ,  9, 1, 1,   50,  100000, 900},
+    {50000000,  125000, 875, true , 14, 2, 2,   25,  125000, 875},
+    {50000000,  250000, 875, true ,  7, 1, 1,   25,  250000, 875},
+    {50000000,  500000, 875, true ,  9, 1, 1,   10,  500000, 900},
+    {50000000,  800000, 875, false,  0, 0, 0,    0,       0,   0},
+    {50000000, 1000000, 875, true ,  9, 1, 1,    5, 1000000, 900},
+    {66666666,  125000, 875, true , 11, 2, 2,   41,  125078, 846},
+    {66666666,  250000, 875, true , 12, 2, 2,   19,  250626, 857},
+    {66666666,  500000, 875, true ,  6, 1, 1,   19,  501253, 857},
+    {66666666,  800000, 875, false,  0, 0, 0,    0,       0,   0},
+    {66666666, 1000000, 875, false,  0, 0, 0,    0,       0,   0},
+    {80000000,   50000, 875, true , 14, 2, 2,  100,   50000, 875},
+    {80000000,  100000, 875, true , 14, 2, 2,   50,  100000, 875},
+    {80000000,  125000, 875, true , 14, 2, 2,   40,  125000, 875},
+    {80000000,  250000, 875, true , 14, 2, 2,   20,  250000, 875},
+    {80000000,  500000, 875, true , 14, 2, 2,   10,  500000, 875},
+    {80000000,  800000, 875, true ,  9, 1, 1,   10,  800000, 900},
+    {80000000, 1000000, 875, true , 14, 2, 2,    5, 1000000, 875},
+    //sample points other than the default
+    {80000000,  500000, 750, true , 15, 5, 4,    8,  500000, 750},
+    {80000000,  500000, 800, true , 16, 4, 4,    8,  500000, 800},
+    {80000000,  500000, 500, true ,  8, 8, 4,   10,  500000, 500},
+    //nothing to solve
+    {16000000,       0, 875, false,  0, 0, 0,    0,       0,   0},
+    {       0,  500000, 875, false,  0, 0, 0,    0,       0,   0},
+    //faster than 4 TQ at the slowest prescaler allows
+    {16000000, 5000000, 875, false,  0, 0, 0,    0,       0,   0},
+    //slower than 24 TQ at the largest prescaler allows
+    {16000000,     500, 875, false,  0, 0, 0,    0,       0,   0},
+};
+
+/*
+ * Desc: bit rate error in ppm, the solver's own measure
+ */
+static uint32_t ErrPpm(uint32_t actual, uint32_t rate){
+
+    uint32_t diff = (actual > rate) ? (actual - rate) : (rate - actual);
+
+    return (uint32_t)(((uint64_t)diff * 1000000) / rate);
+
+}
+
+/*
+ * Desc: smallest error any legal prescaler and bit length give
+ */
+static uint32_t BestPossibleErr(uint32_t clk_hz, uint32_t rate){
+
+    uint32_t best = 0xFFFFFFFF;
+
+    for(uint32_t tq = 4;tq <= 24;tq++){
+        for(uint32_t pre = 1;pre <= 1024;pre++){
+            uint32_t err = ErrPpm(clk_hz / (pre * tq), rate);
+            if(err < best){
+                best = err;
+            }
+        }
+    }
+
+    return best;
+
+}
+
+static void TestKnownGoodTable(void){
+
+    for(uint32_t i = 0;i < sizeof(Table) / sizeof(Table[0]);i++){
+
+        const timing_row_t *prow = &Table[i];
+        MIL_CAN_BitTiming_t t = {0};
+        bool ok = MIL_CAN_SolveBitTiming(prow->clk_hz, prow->rate, prow->sample_point, &t);
+
+        MIL_CHECK_EQ(ok, prow->ok);
+        if(!ok || !prow->ok){
+            continue;
+        }
+
+        MIL_CHECK_EQ(t.sync_prop_phase1, prow->sync_prop_phase1);
+        MIL_CHECK_EQ(t.phase2, prow->phase2);
+        MIL_CHECK_EQ(t.sjw, prow->sjw);
+        MIL_CHECK_EQ(t.prescaler, prow->prescaler);
+        MIL_CHECK_EQ(t.actual_rate, prow->actual_rate);
+        MIL_CHECK_EQ(t.sample_point, prow->actual_sp);
+    }
+
+}
+
+static void TestSolvedRowsAreLegal(void){
+
+    for(uint32_t i = 0;i < sizeof(Table) / sizeof(Table[0]);i++){
+
+        const timing_row_t *prow = &Table[i];
+        MIL_CAN_BitTiming_t t = {0};
+        uint32_t tq;
+
+        if(!MIL_CAN_SolveBitTiming(prow->clk_hz, prow->rate, prow->sample_point, &t)){
+            continue;
+        }
+
+        tq = t.sync_prop_phase1 + t.phase2;
+
+        //TM4C CANBIT limits
+        MIL_CHECK(tq >= 4 && tq <= 24);
+        MIL_CHECK(t.sync_prop_phase1 >= 2 && t.sync_prop_phase1 <= 16);
+        MIL_CHECK(t.phase2 >= 1 && t.phase2 <= 8);
+        MIL_CHECK(t.sjw >= 1 && t.sjw <= 4 && t.sjw <= t.phase2);
+        MIL_CHECK(t.prescaler >= 1 && t.prescaler <= 1024);
+
+        //the reported rate is the one the registers give and nothing better exists
+        MIL_CHECK_EQ(t.actual_rate, prow->clk_hz / (t.prescaler * tq));
+        MIL_CHECK(ErrPpm(t.actual_rate, prow->rate) <= MIL_CAN_RATE_TOL_PPM);
+        MIL_CHECK_EQ(ErrPpm(t.actual_rate, prow->rate), BestPossibleErr(prow->clk_hz, prow->rate));
+    }
+
+}
+
+static void TestFailureLeavesTimingAlone(void){
+
+    MIL_CAN_BitTiming_t t;
+
+    t.prescaler = 0x1234;
+    MIL_CHECK(!MIL_CAN_SolveBitTiming(66666666, 1000000, 875, &t));
+    MIL_CHECK_EQ(t.prescaler, 0x1234);
+
+}
+
+int main(void){
+
+    MIL_RUN(TestKnownGoodTable);
+    MIL_RUN(TestSolvedRowsAreLegal);
+    MIL_RUN(TestFailureLeavesTimingAlone);
+
+    return MIL_TEST_DONE();
+
+}
@@ -0,0 +1,512 @@
+/*
+ * Name: test_can_tp.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host tests and a reassembly benchmark for MIL_CAN_TP
+ *
+ * Note: The bare transport tests run two transports over a model
+ *       TX bank that sends the lowest slot first, the way the TM4C
+ *       picks between loaded objects. Two frames of one ID in the
+ *       bank at once can swap places there
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "inc/hw_memmap.h"
+
+#include "MIL_CAN.h"
+#include "mil_test.h"
+#include "tiva_host.h"
+
+#define ID_AB 0x40  //A to B
+#define ID_BA 0x41  //B to A
+
+#define BANK_SLOTS 4
+
+/*
+ * Desc: one loaded TX slot of the model bank
+ */
+typedef struct{
+
+  bool used;
+  uint32_t canid;
+  uint8_t len;
+  uint8_t data[8];
+
+}slot_t;
+
+static slot_t Bank[BANK_SLOTS];
+static MIL_CAN_TP_t TpA;
+static MIL_CAN_TP_t TpB;
+static uint8_t RxMsg[MIL_CAN_TP_BUF_SIZE];
+static uint16_t RxLen;
+static uint32_t RxCount;
+static uint32_t DoneOk;
+static uint32_t DoneFail;
+
+static bool BankPut(uint32_t canid, uint8_t *data, uint8_t len){
+
+    for(uint8_t i = 0;i < BANK_SLOTS;i++){
+        if(!Bank[i].used){
+            Bank[i].used = true;
+            Bank[i].canid = canid;
+            Bank[i].len = len;
+            memcpy(Bank[i].data, data, len);
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+static bool SendA(uint32_t canid, uint8_t *data, uint8_t len){ return BankPut(canid, data, len); }
+static bool SendB(uint32_t canid, uint8_t *data, uint8_t len){ return BankPut(canid, data, len); }
+
+/*
+ * Desc: number of frames with canid in the bank
+ */
+static uint8_t BankCount(uint32_t canid){
+
+    uint8_t count = 0;
+
+    for(uint8_t i = 0;i < BANK_SLOTS;i++){
+        count += Bank[i].used && (Bank[i].canid == canid);
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: puts the lowest loaded slot on the bus, false if the bank is empty
+ */
+static bool BankStep(uint32_t now){
+
+    for(uint8_t i = 0;i < BANK_SLOTS;i++){
+        if(Bank[i].used){
+            Bank[i].used = false;
+            if(Bank[i].canid == ID_AB){
+                MIL_CAN_TPSent(&TpA, ID_AB);
+                MIL_CAN_TPInput(&TpB, ID_AB, Bank[i].data, Bank[i].len, now);
+            }
+            else{
+                MIL_CAN_TPSent(&TpB, ID_BA);
+                MIL_CAN_TPInput(&TpA, ID_BA, Bank[i].data, Bank[i].len, now);
+            }
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+static void RxB(uint8_t session, uint8_t *data, uint16_t len, void *pctx){
+
+    (void)session;
+    (void)pctx;
+
+    memcpy(RxMsg, data, len);
+    RxLen = len;
+    RxCount++;
+
+}
+
+static void DoneA(uint8_t session, bool ok, void *pctx){
+
+    (void)session;
+    (void)pctx;
+
+    if(ok){
+        DoneOk++;
+    }
+    else{
+        DoneFail++;
+    }
+
+}
+
+static void SetupPair(void){
+
+    memset(Bank, 0, sizeof(Bank));
+    RxLen = 0;
+    RxCount = 0;
+    DoneOk = 0;
+    DoneFail = 0;
+
+    MIL_CAN_TPInit(&TpA, 1000, &SendA);
+    MIL_CAN_TPInit(&TpB, 1000, &SendB);
+    MIL_CHECK_EQ(MIL_CAN_TPOpen(&TpA, ID_BA, ID_AB, 0, &DoneA, 0), 0);
+    MIL_CHECK_EQ(MIL_CAN_TPOpen(&TpB, ID_AB, ID_BA, &RxB, 0, 0), 0);
+
+}
+
+/*
+ * Desc: runs both transports and the bus until A is done sending
+ *
+ * Returns: most A frames that were in the bank at once
+ */
+static uint8_t RunPair(uint32_t *pnow){
+
+    uint8_t most = 0;
+    uint8_t count;
+
+    for(uint32_t step = 0;step < 10000;step++){
+
+        //the main loop comes round several times per frame time
+        for(uint8_t loop = 0;loop < 3;loop++){
+            MIL_CAN_TPService(&TpA, *pnow);
+            MIL_CAN_TPService(&TpB, *pnow);
+        }
+
+        count = BankCount(ID_AB);
+        if(count > most){
+            most = count;
+        }
+
+        if(!BankStep(*pnow) && !MIL_CAN_TPBusy(&TpA, 0)){
+            break;
+        }
+        (*pnow)++;
+    }
+
+    return most;
+
+}
+
+static void FillMsg(uint8_t *msg, uint16_t len, uint32_t seed){
+
+    for(uint16_t i = 0;i < len;i++){
+        msg[i] = (uint8_t)((i * 31) + seed);
+    }
+
+}
+
+static void TestOneConsecutiveFrameOnBus(void){
+
+    static uint8_t msg[MIL_CAN_TP_BUF_SIZE];
+    uint32_t now = 0;
+
+    SetupPair();
+    FillMsg(msg, 200, 7);
+
+    //STmin 0 used to load every consecutive frame back to back
+    MIL_CHECK(MIL_CAN_TPSend(&TpA, 0, msg, 200, now));
+    MIL_CHECK_EQ(RunPair(&now), 1);
+
+    MIL_CHECK_EQ(DoneOk, 1);
+    MIL_CHECK_EQ(DoneFail, 0);
+    MIL_CHECK_EQ(RxCount, 1);
+    MIL_CHECK_EQ(RxLen, 200);
+    MIL_CHECK(memcmp(RxMsg, msg, 200) == 0);
+    MIL_CHECK_EQ(TpB.session[0].stats.rx_errors, 0);
+
+}
+
+static void TestEveryLength(void){
+
+    static uint8_t msg[MIL_CAN_TP_BUF_SIZE];
+    uint32_t now = 0;
+
+    SetupPair();
+
+    for(uint16_t len = 1;len <= MIL_CAN_TP_BUF_SIZE;len++){
+
+        FillMsg(msg, len, len);
+        MIL_CHECK(MIL_CAN_TPSend(&TpA, 0, msg, len, now));
+        MIL_CHECK(RunPair(&now) <= 1);
+
+        MIL_CHECK_EQ(RxCount, len);
+        MIL_CHECK_EQ(RxLen, len);
+        MIL_CHECK(memcmp(RxMsg, msg, len) == 0);
+    }
+
+    MIL_CHECK_EQ(DoneOk, MIL_CAN_TP_BUF_SIZE);
+    MIL_CHECK_EQ(TpA.session[0].stats.tx_errors, 0);
+    MIL_CHECK_EQ(TpB.session[0].stats.rx_errors, 0);
+
+}
+
+static uint32_t QuietSends;
+static bool SendQuiet(uint32_t canid, uint8_t *data, uint8_t len){
+
+    (void)canid;
+    (void)data;
+    (void)len;
+
+    QuietSends++;
+
+    return true;
+
+}
+
+static void TestUnsentFrameTimesOut(void){
+
+    static uint8_t msg[20];
+    uint8_t fc[3] = {0x30, 0, 0};
+
+    DoneOk = 0;
+    DoneFail = 0;
+    QuietSends = 0;
+    MIL_CAN_TPInit(&TpA, 1000, &SendQuiet);
+    MIL_CAN_TPOpen(&TpA, ID_BA, ID_AB, 0, &DoneA, 0);
+
+    //the first frame is taken but never reported as sent
+    MIL_CHECK(MIL_CAN_TPSend(&TpA, 0, msg, sizeof(msg), 0));
+    MIL_CAN_TPInput(&TpA, ID_BA, fc, 3, 5);
+
+    MIL_CAN_TPService(&TpA, 5);
+    MIL_CAN_TPService(&TpA, 1005);
+    MIL_CHECK_EQ(QuietSends, 1);
+    MIL_CHECK_EQ(DoneFail, 0);
+
+    MIL_CAN_TPService(&TpA, 1006);
+    MIL_CHECK_EQ(DoneFail, 1);
+    MIL_CHECK(!MIL_CAN_TPBusy(&TpA, 0));
+
+    //once it leaves after all the next transfer runs normally
+    MIL_CAN_TPSent(&TpA, ID_AB);
+    MIL_CHECK(MIL_CAN_TPSend(&TpA, 0, msg, sizeof(msg), 2000));
+    MIL_CAN_TPSent(&TpA, ID_AB);
+    MIL_CAN_TPInput(&TpA, ID_BA, fc, 3, 2001);
+    MIL_CAN_TPService(&TpA, 2001);
+    MIL_CAN_TPSent(&TpA, ID_AB);
+    MIL_CAN_TPService(&TpA, 2002);
+    MIL_CHECK_EQ(QuietSends, 4);
+    MIL_CHECK_EQ(DoneOk, 1);
+
+}
+
+//psend takes the first frame and refuses everything after it
+static bool SendRefuse(uint32_t canid, uint8_t *data, uint8_t len){
+
+    return SendQuiet(canid, data, len) && (QuietSends == 1);
+
+}
+
+static void TestRefusedFrameTimesOut(void){
+
+    static uint8_t msg[20];
+    uint8_t fc[3] = {0x30, 0, 0};
+
+    DoneOk = 0;
+    DoneFail = 0;
+    QuietSends = 0;
+    MIL_CAN_TPInit(&TpA, 1000, &SendRefuse);
+    MIL_CAN_TPOpen(&TpA, ID_BA, ID_AB, 0, &DoneA, 0);
+
+    MIL_CHECK(MIL_CAN_TPSend(&TpA, 0, msg, sizeof(msg), 0));
+    MIL_CAN_TPSent(&TpA, ID_AB);
+    MIL_CAN_TPInput(&TpA, ID_BA, fc, 3, 5);
+
+    //nothing is on the bus, the consecutive frame is just never taken
+    for(uint32_t now = 5;now <= 1005;now += 50){
+        MIL_CAN_TPService(&TpA, now);
+    }
+    MIL_CHECK_EQ(DoneFail, 0);
+    MIL_CHECK(MIL_CAN_TPBusy(&TpA, 0));
+
+    MIL_CAN_TPService(&TpA, 1006);
+    MIL_CHECK_EQ(DoneFail, 1);
+    MIL_CHECK(!MIL_CAN_TPBusy(&TpA, 0));
+    MIL_CHECK_EQ(TpA.session[0].stats.tx_errors, 1);
+
+}
+
+static void TestTooManyWaits(void){
+
+    static uint8_t msg[20];
+    uint8_t wait[3] = {0x31, 0, 0};
+    uint8_t cts[3] = {0x30, 1, 0};
+    uint32_t now = 0;
+
+    DoneOk = 0;
+    DoneFail = 0;
+    QuietSends = 0;
+    MIL_CAN_TPInit(&TpA, 1000, &SendQuiet);
+    MIL_CAN_TPOpen(&TpA, ID_BA, ID_AB, 0, &DoneA, 0);
+
+    MIL_CHECK(MIL_CAN_TPSend(&TpA, 0, msg, sizeof(msg), now));
+    MIL_CAN_TPSent(&TpA, ID_AB);
+
+    //every WAIT restarts the timeout, the limit is all that ends it
+    for(uint8_t i = 0;i < MIL_CAN_TP_WFT_MAX;i++){
+        now += 900;
+        MIL_CAN_TPInput(&TpA, ID_BA, wait, 3, now);
+        MIL_CAN_TPService(&TpA, now);
+    }
+    MIL_CHECK(MIL_CAN_TPBusy(&TpA, 0));
+
+    //a CTS for one frame starts the count again
+    MIL_CAN_TPInput(&TpA, ID_BA, cts, 3, now);
+    MIL_CAN_TPService(&TpA, now);
+    MIL_CAN_TPSent(&TpA, ID_AB);
+    MIL_CHECK_EQ(QuietSends, 2);
+
+    for(uint8_t i = 0;i < MIL_CAN_TP_WFT_MAX;i++){
+        MIL_CAN_TPInput(&TpA, ID_BA, wait, 3, ++now);
+    }
+    MIL_CHECK(MIL_CAN_TPBusy(&TpA, 0));
+    MIL_CHECK_EQ(DoneFail, 0);
+
+    MIL_CAN_TPInput(&TpA, ID_BA, wait, 3, ++now);
+    MIL_CHECK(!MIL_CAN_TPBusy(&TpA, 0));
+    MIL_CHECK_EQ(DoneFail, 1);
+    MIL_CHECK_EQ(DoneOk, 0);
+
+}
+
+static uint32_t Ticks;
+static uint32_t TestClock(void){
+
+    return Ticks;
+
+}
+
+static void TestMilCanConsecutiveOrder(void){
+
+    static MIL_CAN_TxQ_t q;
+    static MIL_CAN_Dispatch_t disp;
+    static MIL_CAN_MailBox_t box;
+    static MIL_CAN_TP_t tp;
+    static uint8_t buf[8];
+    static uint8_t msg[120];
+    uint8_t fc[3] = {0x30, 0, 0};
+    host_can_frame_t wire;
+    uint8_t sn = 1;
+    uint16_t pos = 6;
+
+    HostReset();
+    DoneOk = 0;
+    MIL_InitCAN(MIL_CAN_PORT_B, CAN0_BASE);
+    MIL_CAN_SetTimeSource(&TestClock);
+    MIL_CAN_TxQueueInit(CAN0_BASE, &q, 20, 4);
+    MIL_CAN_DispatchEnable(CAN0_BASE, &disp, false);
+
+    box.canid = ID_BA;
+    box.filt_mask = 0x7FF;
+    box.base = CAN0_BASE;
+    box.msg_len = 8;
+    box.obj_num = 1;
+    box.buffer = buf;
+    box.fifo_depth = 4;
+    MIL_InitMailBox(&box);
+
+    MIL_CHECK_EQ(MIL_CAN_TPEnable(&box, &tp, 1000), MIL_CAN_OK);
+    MIL_CHECK_EQ(MIL_CAN_TPOpen(&tp, ID_BA, ID_AB, 0, &DoneA, 0), 0);
+
+    FillMsg(msg, sizeof(msg), 3);
+    MIL_CHECK_EQ(MIL_CAN_TPWrite(CAN0_BASE, 0, msg, sizeof(msg)), MIL_CAN_OK);
+
+    MIL_CHECK(HostCAN_TxOne(CAN0_BASE, &wire));
+    MIL_CHECK_EQ(wire.data[0], 0x10);
+    HostCAN_Interrupt(CAN0_BASE);
+
+    //the peer answers with no block limit and no separation time
+    HostCAN_Rx(CAN0_BASE, ID_BA, fc, 3);
+
+    while(pos < sizeof(msg)){
+
+        Ticks++;
+        MIL_CAN_DispatchPoll(CAN0_BASE);
+        MIL_CAN_DispatchPoll(CAN0_BASE);
+
+        //never more than one consecutive frame waiting in the bank
+        MIL_CHECK_EQ(CANStatusGet(CAN0_BASE, CAN_STS_TXREQUEST) & (0x0FUL << 19), 0x01UL << 19);
+
+        if(!HostCAN_TxOne(CAN0_BASE, &wire)){
+            MIL_CHECK(false);
+            break;
+        }
+        MIL_CHECK_EQ(wire.canid, ID_AB);
+        MIL_CHECK_EQ(wire.data[0], 0x20 | sn);
+        MIL_CHECK_EQ(wire.data[1], msg[pos]);
+        sn = (sn + 1) & 0x0F;
+        pos += 7;
+
+        HostCAN_Interrupt(CAN0_BASE);
+    }
+
+    MIL_CAN_DispatchPoll(CAN0_BASE);
+    MIL_CHECK_EQ(DoneOk, 1);
+    MIL_CHECK(!HostCAN_TxOne(CAN0_BASE, &wire));
+
+}
+
+static bool SendDiscard(uint32_t canid, uint8_t *data, uint8_t len){
+
+    (void)canid;
+    (void)data;
+    (void)len;
+
+    return true;
+
+}
+
+/*
+ * Desc: how fast a receiver puts full size messages back together
+ */
+static void BenchReassembly(void){
+
+    static uint8_t msg[MIL_CAN_TP_BUF_SIZE];
+    static uint8_t frames[64][8];
+    static uint8_t lens[64];
+    const uint32_t rounds = 20000;
+    uint16_t len = MIL_CAN_TP_BUF_SIZE;
+    uint16_t pos = 6;
+    uint8_t nframes = 1;
+    clock_t start;
+    double secs;
+
+    FillMsg(msg, len, 1);
+
+    frames[0][0] = 0x10 | (len >> 8);
+    frames[0][1] = len & 0xFF;
+    memcpy(&frames[0][2], msg, 6);
+    lens[0] = 8;
+    for(uint8_t sn = 1;pos < len;sn = (sn + 1) & 0x0F){
+        uint8_t n = ((len - pos) > 7) ? 7 : (len - pos);
+        frames[nframes][0] = 0x20 | sn;
+        memcpy(&frames[nframes][1], &msg[pos], n);
+        lens[nframes++] = n + 1;
+        pos += n;
+    }
+
+    RxCount = 0;
+    MIL_CAN_TPInit(&TpB, 0, &SendDiscard);
+    MIL_CAN_TPOpen(&TpB, ID_AB, ID_BA, &RxB, 0, 0);
+
+    start = clock();
+    for(uint32_t r = 0;r < rounds;r++){
+        for(uint8_t f = 0;f < nframes;f++){
+            MIL_CAN_TPInput(&TpB, ID_AB, frames[f], lens[f], r);
+        }
+    }
+    secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    MIL_CHECK_EQ(RxCount, rounds);
+    MIL_CHECK(memcmp(RxMsg, msg, len) == 0);
+
+    if(secs > 0){
+        printf("  reassembly: %u byte messages, %.1f MB/s, %.1f ns per frame\n", len,
+               ((double)rounds * len) / secs / 1e6, secs * 1e9 / ((double)rounds * nframes));
+    }
+
+}
+
+int main(void){
+
+    MIL_RUN(TestOneConsecutiveFrameOnBus);
+    MIL_RUN(TestEveryLength);
+    MIL_RUN(TestUnsentFrameTimesOut);
+    MIL_RUN(TestRefusedFrameTimesOut);
+    MIL_RUN(TestTooManyWaits);
+    MIL_RUN(TestMilCanConsecutiveOrder);
+    MIL_RUN(BenchReassembly);
+
+    return MIL_TEST_DONE();
+
+}
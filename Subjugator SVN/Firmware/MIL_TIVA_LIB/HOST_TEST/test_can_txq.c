@@ -0,0 +1,315 @@
+/*
+ * Name: test_can_txq.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host tests for MIL_CAN_TxQ and the MIL_CAN transmit path
+ *
+ * Note: The bare queue tests model the controller the way the TM4C
+ *       behaves, every loaded object requests to send and the lowest
+ *       requesting object number goes first
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "inc/hw_memmap.h"
+
+#include "MIL_CAN.h"
+#include "mil_test.h"
+#include "tiva_host.h"
+
+#define MAX_SENT 512
+
+/*
+ * Desc: a queue plus the TXRQST bits of its bank
+ */
+typedef struct{
+
+  MIL_CAN_TxQ_t q;
+  uint32_t txrqst;
+  uint32_t sent_id[MAX_SENT];
+  uint32_t sent_seq[MAX_SENT];
+  uint32_t nsent;
+
+}model_t;
+
+static void ModelInit(model_t *pm, uint8_t first_obj, uint8_t num_obj){
+
+    MIL_CAN_TxQInit(&pm->q, first_obj, num_obj);
+    pm->txrqst = 0;
+    pm->nsent = 0;
+
+}
+
+/*
+ * Desc: queues a frame, seq goes in the first two data bytes
+ */
+static mil_can_txq_res_t ModelSubmit(model_t *pm, uint32_t canid, uint32_t seq){
+
+    MIL_CAN_TxFrame_t frame = {0};
+    mil_can_txq_res_t res;
+    uint8_t obj;
+
+    frame.canid = canid;
+    frame.len = 2;
+    frame.data[0] = (uint8_t)seq;
+    frame.data[1] = (uint8_t)(seq >> 8);
+
+    res = MIL_CAN_TxQSubmit(&pm->q, &frame, &obj);
+    if(res == MIL_CAN_TXQ_LOAD){
+        pm->txrqst |= 0x01UL << (obj - 1);
+    }
+
+    return res;
+
+}
+
+/*
+ * Desc: the controller sends its lowest requesting object and the
+ *       TX interrupt completes it
+ */
+static bool ModelSendOne(model_t *pm){
+
+    MIL_CAN_TxFrame_t done;
+    uint8_t obj;
+
+    if(!pm->txrqst){
+        return false;
+    }
+
+    obj = MIL_CAN_CTZ(pm->txrqst) + 1;
+    pm->txrqst &= ~(0x01UL << (obj - 1));
+
+    if(MIL_CAN_TxQComplete(&pm->q, obj, &done)){
+        pm->txrqst |= 0x01UL << (obj - 1);
+    }
+
+    if(pm->nsent < MAX_SENT){
+        pm->sent_id[pm->nsent] = done.canid;
+        pm->sent_seq[pm->nsent] = done.data[0] | (done.data[1] << 8);
+    }
+    pm->nsent++;
+
+    return true;
+
+}
+
+/*
+ * Desc: true if no two bank objects hold the same ID
+ */
+static bool ModelOnePerId(model_t *pm){
+
+    for(uint8_t a = 0;a < pm->q.num_obj;a++){
+        for(uint8_t b = a + 1;b < pm->q.num_obj;b++){
+            MIL_CAN_TxFrame_t *pa = MIL_CAN_TxQInflight(&pm->q, pm->q.first_obj + a);
+            MIL_CAN_TxFrame_t *pb = MIL_CAN_TxQInflight(&pm->q, pm->q.first_obj + b);
+            if(pa && pb && pa->canid == pb->canid){
+                return false;
+            }
+        }
+    }
+
+    return true;
+
+}
+
+static model_t M;
+
+/*
+ * Desc: the case from review, f4 must not go out ahead of f2 and f3
+ */
+static void TestSameIdOrderAfterRefill(void){
+
+    ModelInit(&M, 10, 3);
+
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x12, 1), MIL_CAN_TXQ_LOAD);
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x12, 2), MIL_CAN_TXQ_PARKED);
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x12, 3), MIL_CAN_TXQ_PARKED);
+
+    MIL_CHECK(ModelSendOne(&M));
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x12, 4), MIL_CAN_TXQ_PARKED);
+
+    while(ModelSendOne(&M));
+
+    MIL_CHECK_EQ(M.nsent, 4);
+    for(uint32_t i = 0;i < 4;i++){
+        MIL_CHECK_EQ(M.sent_seq[i], i + 1);
+    }
+
+}
+
+static void TestOtherIdsUseFreeObjects(void){
+
+    ModelInit(&M, 10, 3);
+
+    //0x12 is blocked behind itself, 0x20 and 0x30 still get objects
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x12, 1), MIL_CAN_TXQ_LOAD);
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x12, 2), MIL_CAN_TXQ_PARKED);
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x20, 3), MIL_CAN_TXQ_LOAD);
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x30, 4), MIL_CAN_TXQ_LOAD);
+    MIL_CHECK_EQ(ModelSubmit(&M, 0x05, 5), MIL_CAN_TXQ_PARKED);
+    MIL_CHECK(ModelOnePerId(&M));
+
+    //the freed 0x12 object goes to 0x05, the lowest ID allowed in
+    MIL_CHECK(ModelSendOne(&M));
+    MIL_CHECK_EQ(M.sent_seq[0], 1);
+    MIL_CHECK_EQ(MIL_CAN_TxQInflight(&M.q, 10)->canid, 0x05);
+
+    //object 10 keeps the lowest number so 2 follows 5 out of it
+    while(ModelSendOne(&M));
+    MIL_CHECK_EQ(M.nsent, 5);
+    MIL_CHECK_EQ(M.sent_seq[1], 5);
+    MIL_CHECK_EQ(M.sent_seq[2], 2);
+    MIL_CHECK_EQ(M.sent_seq[3], 3);
+    MIL_CHECK_EQ(M.sent_seq[4], 4);
+    MIL_CHECK_EQ(M.q.stats.sent, 5);
+    MIL_CHECK_EQ(M.q.stats.parked, 2);
+    MIL_CHECK_EQ(M.q.busy, 0);
+
+}
+
+static void TestParkedOnlyLeavesWhenIdClears(void){
+
+    MIL_CAN_TxFrame_t done;
+
+    ModelInit(&M, 1, 2);
+
+    ModelSubmit(&M, 0x40, 1);
+    ModelSubmit(&M, 0x50, 2);
+    ModelSubmit(&M, 0x50, 3);
+
+    //0x40 leaves, the parked 0x50 must not join the 0x50 still in hardware
+    MIL_CHECK(!MIL_CAN_TxQComplete(&M.q, 1, &done));
+    MIL_CHECK_EQ(done.canid, 0x40);
+    MIL_CHECK_EQ(M.q.ovf_count, 1);
+    MIL_CHECK_EQ(MIL_CAN_TxQBusyMask(&M.q), 0x02);
+
+    MIL_CHECK(MIL_CAN_TxQComplete(&M.q, 2, &done));
+    MIL_CHECK_EQ(MIL_CAN_TxQInflight(&M.q, 2)->data[0], 3);
+    MIL_CHECK_EQ(M.q.ovf_count, 0);
+
+}
+
+static void TestRandomTrafficKeepsIdOrder(void){
+
+    uint32_t next_seq[8] = {0};
+    uint32_t seen_seq[8] = {0};
+    uint32_t queued = 0;
+    uint32_t dropped = 0;
+
+    srand(1234);
+    ModelInit(&M, 5, 4);
+
+    for(uint32_t step = 0;step < 20000;step++){
+
+        if(rand() % 3){
+            uint32_t id = 0x10 + (rand() % 8);
+            if(ModelSubmit(&M, id, next_seq[id - 0x10]) == MIL_CAN_TXQ_FULL){
+                dropped++;
+            }
+            else{
+                next_seq[id - 0x10]++;
+                queued++;
+            }
+        }
+        else{
+            ModelSendOne(&M);
+        }
+
+        MIL_CHECK(ModelOnePerId(&M));
+
+        //check the last frame sent against its ID's count
+        if(M.nsent && M.nsent <= MAX_SENT){
+            uint32_t i = M.nsent - 1;
+            uint32_t id = M.sent_id[i] - 0x10;
+            MIL_CHECK_EQ(M.sent_seq[i], seen_seq[id]);
+            seen_seq[id]++;
+            M.nsent = 0;
+        }
+    }
+
+    while(ModelSendOne(&M)){
+        uint32_t id = M.sent_id[0] - 0x10;
+        MIL_CHECK_EQ(M.sent_seq[0], seen_seq[id]);
+        seen_seq[id]++;
+        M.nsent = 0;
+    }
+
+    for(uint8_t id = 0;id < 8;id++){
+        MIL_CHECK_EQ(seen_seq[id], next_seq[id]);
+    }
+    MIL_CHECK_EQ(M.q.stats.sent, queued);
+    MIL_CHECK_EQ(M.q.stats.dropped, dropped);
+
+}
+
+static uint32_t DoneSeq[64];
+static uint32_t DoneCount;
+
+static void TxDone(uint32_t canid, void *pctx){
+
+    (void)canid;
+    DoneSeq[DoneCount++ % 64] = (uint32_t)(uintptr_t)pctx;
+
+}
+
+/*
+ * Desc: same order case through MIL_CANQueueTX, the real ISR and
+ *       the simulated controller
+ */
+static void TestMilCanWireOrder(void){
+
+    static MIL_CAN_TxQ_t q;
+    host_can_frame_t wire;
+    uint32_t seq_a = 0;
+    uint32_t seq_b = 0;
+    uint8_t data[2];
+
+    HostReset();
+    DoneCount = 0;
+    MIL_InitCAN(MIL_CAN_PORT_B, CAN0_BASE);
+    MIL_CAN_TxQueueInit(CAN0_BASE, &q, 20, 4);
+
+    for(uint32_t n = 0;n < 12;n++){
+        data[0] = (uint8_t)n;
+        data[1] = 0;
+        MIL_CHECK_EQ(MIL_CANQueueTX((n % 3) ? 0x12 : 0x30, data, 2, CAN0_BASE,
+                                    &TxDone, (void *)(uintptr_t)n), MIL_CAN_OK);
+    }
+
+    //the 0x12 frames after the first one wait in software
+    MIL_CHECK_EQ(CANStatusGet(CAN0_BASE, CAN_STS_TXREQUEST), (0x01UL << 19) | (0x01UL << 20));
+
+    while(HostCAN_TxOne(CAN0_BASE, &wire)){
+
+        MIL_CHECK(wire.obj_num >= 20 && wire.obj_num < 24);
+        if(wire.canid == 0x12){
+            MIL_CHECK_EQ(wire.data[0] % 3 != 0, 1);
+            MIL_CHECK(wire.data[0] >= seq_a);
+            seq_a = wire.data[0] + 1;
+        }
+        else{
+            MIL_CHECK(wire.data[0] >= seq_b);
+            seq_b = wire.data[0] + 1;
+        }
+
+        HostCAN_Interrupt(CAN0_BASE);
+    }
+
+    MIL_CHECK_EQ(DoneCount, 12);
+    MIL_CHECK_EQ(seq_a, 12);
+    MIL_CHECK_EQ(seq_b, 10);
+    MIL_CHECK_EQ(HostCAN_Obj0Count(CAN0_BASE), 0);
+
+}
+
+int main(void){
+
+    MIL_RUN(TestSameIdOrderAfterRefill);
+    MIL_RUN(TestOtherIdsUseFreeObjects);
+    MIL_RUN(TestParkedOnlyLeavesWhenIdClears);
+    MIL_RUN(TestRandomTrafficKeepsIdOrder);
+    MIL_RUN(TestMilCanWireOrder);
+
+    return MIL_TEST_DONE();
+
+}
@@ -0,0 +1,187 @@
+/*
+ * Name: test_dsp.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Every MIL_DSP filter against the golden vectors in dsp_golden.h
+ *
+ * Note: On the PC this runs the C MIL_DSP_SMLAD/MIL_DSP_QADD16. The file
+ *       also builds for the M4(arm-none-eabi-gcc -mcpu=cortex-m4), where
+ *       the __smlad/__qadd16 build has to match the same tables
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "MIL_DSP.h"
+#include "dsp_golden.h"
+#include "mil_test.h"
+
+/*
+ * Desc: counts the outputs that differ from the golden ones
+ */
+static uint32_t Diff16(const int16_t *got, const int16_t *want, uint16_t count){
+
+    uint32_t bad = 0;
+
+    for(uint16_t i = 0;i < count;i++){
+        bad += got[i] != want[i];
+    }
+
+    return bad;
+
+}
+
+static uint32_t Diff32(const int32_t *got, const int32_t *want, uint16_t count){
+
+    uint32_t bad = 0;
+
+    for(uint16_t i = 0;i < count;i++){
+        bad += got[i] != want[i];
+    }
+
+    return bad;
+
+}
+
+static void TestFromADC(void){
+
+    int16_t out[GOLD_COUNT];
+
+    MIL_DSP_FromADC(&GoldADCRaw[2], 4, out, GOLD_COUNT - 1);
+    MIL_CHECK_EQ(Diff16(out, GoldFromADC, GOLD_COUNT - 1), 0);
+
+}
+
+static void TestMean(void){
+
+    uint32_t bad = 0;
+
+    //every length, odd ones end on the tail
+    for(uint16_t n = 1;n <= GOLD_COUNT;n++){
+        bad += MIL_DSP_MeanQ15(GoldQ15In, n) != GoldMean[n - 1];
+    }
+    MIL_CHECK_EQ(bad, 0);
+
+}
+
+static void TestAdd(void){
+
+    int16_t out[GOLD_COUNT];
+
+    MIL_DSP_AddQ15(GoldQ15In, GoldQ15InB, out, GOLD_COUNT);
+    MIL_CHECK_EQ(Diff16(out, GoldAdd, GOLD_COUNT), 0);
+
+}
+
+static void TestMAvg(void){
+
+    MIL_DSP_MAvgQ15_t f15;
+    MIL_DSP_MAvgQ31_t f31;
+    int16_t hist15[8];
+    int32_t hist31[16];
+    int16_t out15[GOLD_COUNT];
+    int32_t out31[GOLD_COUNT];
+
+    MIL_CHECK(MIL_DSP_MAvgQ15Init(&f15, hist15, 8, 1000));
+    MIL_DSP_MAvgQ15(&f15, GoldQ15In, out15, GOLD_SPLIT);
+    MIL_DSP_MAvgQ15(&f15, &GoldQ15In[GOLD_SPLIT], &out15[GOLD_SPLIT], GOLD_COUNT - GOLD_SPLIT);
+    MIL_CHECK_EQ(Diff16(out15, GoldMAvgQ15, GOLD_COUNT), 0);
+
+    MIL_CHECK(MIL_DSP_MAvgQ31Init(&f31, hist31, 16, -500000000));
+    MIL_DSP_MAvgQ31(&f31, GoldQ31In, out31, GOLD_SPLIT);
+    MIL_DSP_MAvgQ31(&f31, &GoldQ31In[GOLD_SPLIT], &out31[GOLD_SPLIT], GOLD_COUNT - GOLD_SPLIT);
+    MIL_CHECK_EQ(Diff32(out31, GoldMAvgQ31, GOLD_COUNT), 0);
+
+}
+
+static void TestEma(void){
+
+    MIL_DSP_EmaQ15_t f15;
+    MIL_DSP_EmaQ31_t f31;
+    int16_t out15[GOLD_COUNT];
+    int32_t out31[GOLD_COUNT];
+
+    MIL_DSP_EmaQ15Init(&f15, 3, -2000);
+    MIL_DSP_EmaQ15(&f15, GoldQ15In, out15, GOLD_SPLIT);
+    MIL_DSP_EmaQ15(&f15, &GoldQ15In[GOLD_SPLIT], &out15[GOLD_SPLIT], GOLD_COUNT - GOLD_SPLIT);
+    MIL_CHECK_EQ(Diff16(out15, GoldEmaQ15, GOLD_COUNT), 0);
+
+    MIL_DSP_EmaQ31Init(&f31, 5, 0);
+    MIL_DSP_EmaQ31(&f31, GoldQ31In, out31, GOLD_SPLIT);
+    MIL_DSP_EmaQ31(&f31, &GoldQ31In[GOLD_SPLIT], &out31[GOLD_SPLIT], GOLD_COUNT - GOLD_SPLIT);
+    MIL_CHECK_EQ(Diff32(out31, GoldEmaQ31, GOLD_COUNT), 0);
+
+}
+
+static void TestBiquad(void){
+
+    MIL_DSP_BiquadQ15_t f15;
+    MIL_DSP_BiquadQ31_t f31;
+    int16_t out15[GOLD_COUNT];
+    int32_t out31[GOLD_COUNT];
+
+    //Butterworth low pass at 0.1 fs
+    MIL_DSP_BiquadQ15Init(&f15, 1106, 2210, 1106, 18727, -6763);
+    MIL_DSP_BiquadQ15(&f15, GoldQ15In, out15, GOLD_SPLIT);
+    MIL_DSP_BiquadQ15(&f15, &GoldQ15In[GOLD_SPLIT], &out15[GOLD_SPLIT], GOLD_COUNT - GOLD_SPLIT);
+    MIL_CHECK_EQ(Diff16(out15, GoldBiquadQ15, GOLD_COUNT), 0);
+
+    //a gain near 6, full scale input wraps the SMLAD sum
+    MIL_DSP_BiquadQ15Init(&f15, 31130, 31130, 31130, 0, 0);
+    MIL_DSP_BiquadQ15(&f15, GoldQ15In, out15, GOLD_SPLIT);
+    MIL_DSP_BiquadQ15(&f15, &GoldQ15In[GOLD_SPLIT], &out15[GOLD_SPLIT], GOLD_COUNT - GOLD_SPLIT);
+    MIL_CHECK_EQ(Diff16(out15, GoldBiquadQ15Hot, GOLD_COUNT), 0);
+
+    //in place
+    memcpy(out15, GoldQ15In, sizeof(out15));
+    MIL_DSP_BiquadQ15Init(&f15, 1106, 2210, 1106, 18727, -6763);
+    MIL_DSP_BiquadQ15(&f15, out15, out15, GOLD_COUNT);
+    MIL_CHECK_EQ(Diff16(out15, GoldBiquadQ15, GOLD_COUNT), 0);
+
+    MIL_DSP_BiquadQ31Init(&f31, 72416791, 144833582, 72416791, 1227261013, -443185484);
+    MIL_DSP_BiquadQ31(&f31, GoldQ31In, out31, GOLD_SPLIT);
+    MIL_DSP_BiquadQ31(&f31, &GoldQ31In[GOLD_SPLIT], &out31[GOLD_SPLIT], GOLD_COUNT - GOLD_SPLIT);
+    MIL_CHECK_EQ(Diff32(out31, GoldBiquadQ31, GOLD_COUNT), 0);
+
+}
+
+/*
+ * Desc: runs GoldQ15In through a CIC GOLD_CIC_LAPS times, two blocks a lap
+ */
+static void CheckCic(uint8_t order, uint16_t rate, const int16_t *want, uint16_t count){
+
+    MIL_DSP_CicQ15_t f;
+    int16_t out[GOLD_CIC_LAPS * GOLD_COUNT];
+    uint16_t n = 0;
+
+    MIL_CHECK(MIL_DSP_CicQ15Init(&f, order, rate));
+    for(uint8_t lap = 0;lap < GOLD_CIC_LAPS;lap++){
+        n += MIL_DSP_CicQ15(&f, GoldQ15In, &out[n], GOLD_SPLIT);
+        n += MIL_DSP_CicQ15(&f, &GoldQ15In[GOLD_SPLIT], &out[n], GOLD_COUNT - GOLD_SPLIT);
+    }
+
+    MIL_CHECK_EQ(n, count);
+    MIL_CHECK_EQ(Diff16(out, want, count), 0);
+
+}
+
+static void TestCic(void){
+
+    CheckCic(3, 8, GoldCic3, sizeof(GoldCic3) / sizeof(GoldCic3[0]));
+    CheckCic(4, 16, GoldCic4, sizeof(GoldCic4) / sizeof(GoldCic4[0]));
+
+}
+
+int main(void){
+
+    MIL_RUN(TestFromADC);
+    MIL_RUN(TestMean);
+    MIL_RUN(TestAdd);
+    MIL_RUN(TestMAvg);
+    MIL_RUN(TestEma);
+    MIL_RUN(TestBiquad);
+    MIL_RUN(TestCic);
+
+    return MIL_TEST_DONE();
+
+}
@@ -0,0 +1,322 @@
+/*
+ * Name: test_tkb_kill.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host simulation of the kill board's kill state machine(TKB_Kill)
+ *
+ * Note: The outputs go to a fake ops table and the clock is stepped
+ *       10 ms at a time with the hall levels set every tick, the way
+ *       TIM0_ISR in the kill board's main.c drives it
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "TKB_Kill.h"
+#include "mil_test.h"
+
+#define TICK_MS 10
+
+//what the fake outputs were last told
+static bool MainOn;
+static bool ThrustOn;
+static uint32_t Stops;
+static uint32_t Reports;
+static tkb_kill_state_t ReportState;
+static uint8_t ReportSources;
+
+static void FakeMainPower(bool on){ MainOn = on; }
+static void FakeThrustPower(bool on){ ThrustOn = on; }
+static void FakeStopThrust(void){ Stops++; }
+static void FakeReport(tkb_kill_state_t state, uint8_t sources){
+
+    Reports++;
+    ReportState = state;
+    ReportSources = sources;
+
+}
+
+static const tkb_kill_ops_t FakeOps = {
+    .pmain_power = &FakeMainPower,
+    .pthrust_power = &FakeThrustPower,
+    .pstop_thrust = &FakeStopThrust,
+    .preport = &FakeReport
+};
+
+//the simulated board
+static tkb_kill_t Kill;
+static uint32_t Now;
+static bool HallHard;           //true is magnet out(kill)
+static bool HallSoft;
+
+static void Start(uint32_t now_ms){
+
+    MainOn = false;
+    ThrustOn = false;
+    Stops = 0;
+    Reports = 0;
+    HallHard = false;
+    HallSoft = false;
+    Now = now_ms;
+
+    TKB_KillInit(&Kill, &FakeOps, Now);
+
+}
+
+/*
+ * Desc: runs ms worth of ticks
+ */
+static void Run(uint32_t ms){
+
+    for(uint32_t t = 0;t < ms;t += TICK_MS){
+        Now += TICK_MS;
+        TKB_KillSet(&Kill, TKB_KILL_SRC_HARD_HALL, HallHard, Now);
+        TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_HALL, HallSoft, Now);
+        TKB_KillStep(&Kill, Now);
+    }
+
+}
+
+/*
+ * Desc: runs until the state is not the one given
+ *
+ * Returns: ms it took(0xFFFFFFFF if it never left)
+ */
+static uint32_t RunWhile(tkb_kill_state_t state, uint32_t limit_ms){
+
+    uint32_t ms = 0;
+
+    while(TKB_KillState(&Kill) == state){
+        if(ms >= limit_ms){
+            return 0xFFFFFFFF;
+        }
+        Run(TICK_MS);
+        ms += TICK_MS;
+    }
+
+    return ms;
+
+}
+
+/*
+ * Desc: from power up to RUN
+ */
+static void BootToRun(void){
+
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_ESC_POWER, 60000), TKB_KILL_ESC_BOOT_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_ESC_ARM);
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_ESC_ARM, 60000), TKB_KILL_ESC_ARM_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_RUN);
+
+}
+
+static void TestBoot(void){
+
+    Start(0);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_ESC_POWER);
+    MIL_CHECK(MainOn && ThrustOn);
+    MIL_CHECK(!TKB_KillCanThrust(&Kill));
+
+    BootToRun();
+    MIL_CHECK(MainOn && ThrustOn);
+    MIL_CHECK_EQ(Stops, 1);
+    MIL_CHECK(TKB_KillCanThrust(&Kill));
+    MIL_CHECK_EQ(ReportState, TKB_KILL_RUN);
+    MIL_CHECK_EQ(ReportSources, 0);
+
+    //nothing moves while nothing kills
+    Reports = 0;
+    Run(60000);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_RUN);
+    MIL_CHECK_EQ(Reports, 0);
+
+}
+
+/*
+ * Desc: HARD_PENDING -> HARD -> ESC_POWER with the hard hall held
+ *       well past the off time, then let go
+ */
+static void TestHardHallHeld(void){
+
+    Start(0);
+    BootToRun();
+
+    HallHard = true;
+    Run(TICK_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_HARD_PENDING);
+    MIL_CHECK_EQ(ReportSources, TKB_KILL_SRC_HARD_HALL);
+    MIL_CHECK(MainOn);
+    MIL_CHECK(!ThrustOn);
+    MIL_CHECK(!TKB_KillCanThrust(&Kill));
+
+    //main is cut once the grace time is up, not a tick sooner
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_HARD_PENDING, 60000), TKB_KILL_HARD_GRACE_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_HARD);
+    MIL_CHECK(!MainOn && !ThrustOn);
+
+    //held three times the off time, the board stays dark
+    Run(3 * TKB_KILL_HARD_OFF_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_HARD);
+    MIL_CHECK(!MainOn && !ThrustOn);
+
+    //let go, the off time is long over so power comes straight back
+    HallHard = false;
+    Run(TICK_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_ESC_POWER);
+    MIL_CHECK(MainOn && ThrustOn);
+    MIL_CHECK_EQ(ReportSources, 0);
+    BootToRun();
+
+    //let go before the off time is up, it still waits it out
+    HallHard = true;
+    Run(TICK_MS);
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_HARD_PENDING, 60000), TKB_KILL_HARD_GRACE_MS);
+    Run(TKB_KILL_HARD_OFF_MS / 2);
+    HallHard = false;
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_HARD, 60000), TKB_KILL_HARD_OFF_MS / 2);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_ESC_POWER);
+
+    //a hall blip during the grace time still ends in a main cut
+    BootToRun();
+    HallHard = true;
+    Run(TICK_MS);
+    HallHard = false;
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_HARD_PENDING, 60000), TKB_KILL_HARD_GRACE_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_HARD);
+    MIL_CHECK(!MainOn);
+
+}
+
+/*
+ * Desc: the motherboard hard kill is a command, done once main is cut
+ */
+static void TestHardMobo(void){
+
+    Start(0);
+    BootToRun();
+
+    TKB_KillSet(&Kill, TKB_KILL_SRC_HARD_MOBO, true, Now);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_HARD_PENDING);
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_HARD_PENDING, 60000), TKB_KILL_HARD_GRACE_MS);
+    MIL_CHECK_EQ(TKB_KillSources(&Kill), 0);
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_HARD, 60000), TKB_KILL_HARD_OFF_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_ESC_POWER);
+    BootToRun();
+
+}
+
+/*
+ * Desc: motherboard and hall soft kills on top of each other, the
+ *       board stays soft killed until the last one clears
+ */
+static void TestSoftOverlap(void){
+
+    uint32_t stops;
+
+    Start(0);
+    BootToRun();
+
+    TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_MOBO, true, Now);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_SOFT);
+    MIL_CHECK(MainOn && !ThrustOn);
+    stops = Stops;
+
+    //the hall joins in, reported but no new entry to SOFT
+    Reports = 0;
+    HallSoft = true;
+    Run(TICK_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_SOFT);
+    MIL_CHECK_EQ(Reports, 1);
+    MIL_CHECK_EQ(ReportSources, TKB_KILL_SRC_SOFT_bm);
+    MIL_CHECK_EQ(Stops, stops);
+
+    //the motherboard lets go first, the hall still holds it
+    TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_MOBO, false, Now);
+    Run(30000);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_SOFT);
+    MIL_CHECK(!ThrustOn);
+    MIL_CHECK_EQ(ReportSources, TKB_KILL_SRC_SOFT_HALL);
+
+    //the motherboard comes back, then the hall lets go
+    TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_MOBO, true, Now);
+    HallSoft = false;
+    Run(30000);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_SOFT);
+    MIL_CHECK_EQ(ReportSources, TKB_KILL_SRC_SOFT_MOBO);
+
+    //last one out, the ESCs boot again
+    TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_MOBO, false, Now);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_ESC_POWER);
+    MIL_CHECK(MainOn && ThrustOn);
+    BootToRun();
+
+    //a soft kill during ESC_POWER starts the boot over
+    HallSoft = true;
+    Run(TICK_MS);
+    HallSoft = false;
+    Run(TICK_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_ESC_POWER);
+    Run(TKB_KILL_ESC_BOOT_MS / 2);
+    HallSoft = true;
+    Run(TICK_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_SOFT);
+    HallSoft = false;
+    Run(TICK_MS);
+    BootToRun();
+
+    //a hard kill beats the soft ones
+    HallSoft = true;
+    TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_MOBO, true, Now);
+    Run(TICK_MS);
+    HallHard = true;
+    Run(TICK_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_HARD_PENDING);
+    MIL_CHECK_EQ(ReportSources, TKB_KILL_SRC_SOFT_bm | TKB_KILL_SRC_HARD_HALL);
+
+    //and once it is over the soft ones still hold
+    HallHard = false;
+    Run(TKB_KILL_HARD_GRACE_MS + TKB_KILL_HARD_OFF_MS);
+    MIL_CHECK_EQ(TKB_KillState(&Kill), TKB_KILL_SOFT);
+    MIL_CHECK(MainOn && !ThrustOn);
+
+}
+
+/*
+ * Desc: every wait across the point where now_ms wraps
+ */
+static void TestClockWrap(void){
+
+    //boot straddles the wrap
+    Start(0xFFFFFFFF - TKB_KILL_ESC_BOOT_MS / 2);
+    BootToRun();
+    MIL_CHECK(Now < 0x80000000);
+
+    //a hard kill whose grace and off times straddle it
+    Start(0xFFFFFFFF - 2 * TKB_KILL_ESC_BOOT_MS - TKB_KILL_ESC_ARM_MS - TKB_KILL_HARD_GRACE_MS / 2);
+    BootToRun();
+    HallHard = true;
+    Run(TICK_MS);
+    MIL_CHECK(Now > 0x80000000);
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_HARD_PENDING, 60000), TKB_KILL_HARD_GRACE_MS);
+    MIL_CHECK(Now < 0x80000000);
+    HallHard = false;
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_HARD, 60000), TKB_KILL_HARD_OFF_MS);
+
+    //the state is entered exactly at the wrap
+    Start(0xFFFFFFFF - TICK_MS + 1);
+    Run(TICK_MS);
+    MIL_CHECK_EQ(Now, 0);
+    MIL_CHECK_EQ(RunWhile(TKB_KILL_ESC_POWER, 60000), TKB_KILL_ESC_BOOT_MS - TICK_MS);
+
+}
+
+int main(void){
+
+    MIL_RUN(TestBoot);
+    MIL_RUN(TestHardHallHeld);
+    MIL_RUN(TestHardMobo);
+    MIL_RUN(TestSoftOverlap);
+    MIL_RUN(TestClockWrap);
+
+    return MIL_TEST_DONE();
+
+}
@@ -0,0 +1,309 @@
+/*
+ * Name: test_uart_pkt.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Round trip fuzz and throughput for MIL_UART_Pkt
+ *
+ * Note: Built with a MIL_UART_PKT_MAX_PAYLOAD big enough for
+ *       payloads that span more than one full COBS block
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "MIL_UART_Pkt.h"
+#include "mil_test.h"
+
+#define MAX_PKTS 64
+
+static uint32_t Seed = 0x1234567;
+
+//xorshift32, the same sequence on every run
+static uint32_t Rand(void){
+
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+
+    return Seed;
+
+}
+
+static uint8_t Got[MAX_PKTS][MIL_UART_PKT_MAX_PAYLOAD];
+static uint16_t GotLen[MAX_PKTS];
+static uint32_t GotCount;
+
+static void Rx(const uint8_t *data, uint16_t len, void *pctx){
+
+    (void)pctx;
+
+    if(GotCount < MAX_PKTS){
+        memcpy(Got[GotCount], data, len);
+        GotLen[GotCount] = len;
+    }
+    GotCount++;
+
+}
+
+/*
+ * Desc: payload with a mix of runs, zeros and random bytes
+ */
+static void MakePayload(uint8_t *data, uint16_t len){
+
+    uint8_t zero_odds = (uint8_t)(Rand() % 4);
+
+    for(uint16_t i = 0;i < len;i++){
+        if(zero_odds && (Rand() % (4 * zero_odds)) == 0){
+            data[i] = 0;
+        }
+        else{
+            data[i] = (uint8_t)(Rand() | 1);
+        }
+    }
+
+}
+
+/*
+ * Desc: feeds a stream in random sized pieces
+ */
+static void FeedSplit(MIL_UART_Pkt_t *pp, const uint8_t *stream, uint32_t len){
+
+    while(len){
+        uint32_t n = (Rand() % 40) + 1;
+
+        if(n > len){
+            n = len;
+        }
+        MIL_UART_PktFeed(pp, stream, (uint16_t)n);
+        stream += n;
+        len -= n;
+    }
+
+}
+
+static void TestKnownEncoding(void){
+
+    uint8_t data[3] = {0x11, 0x00, 0x22};
+    uint8_t out[16];
+    uint16_t crc = MIL_UART_PktCRC16(0xFFFF, data, 3);
+    uint16_t n;
+
+    //CRC-16/CCITT-FALSE check value
+    MIL_CHECK_EQ(MIL_UART_PktCRC16(0xFFFF, (const uint8_t *)"123456789", 9), 0x29B1);
+
+    n = MIL_UART_PktEncode(data, 3, out, sizeof(out));
+    MIL_CHECK_EQ(n, 7);
+    MIL_CHECK_EQ(out[0], 0x02);
+    MIL_CHECK_EQ(out[1], 0x11);
+    MIL_CHECK_EQ(out[2], 0x04);
+    MIL_CHECK_EQ(out[3], 0x22);
+    MIL_CHECK_EQ(out[4], crc >> 8);
+    MIL_CHECK_EQ(out[5], crc & 0xFF);
+    MIL_CHECK_EQ(out[6], 0x00);
+
+    //too small for the worst case is refused
+    MIL_CHECK_EQ(MIL_UART_PktEncode(data, 3, out, MIL_UART_PKT_ENCODED_SIZE(3) - 1), 0);
+
+}
+
+/*
+ * Desc: payload plus CRC right around one and two full COBS blocks
+ */
+static void TestFullBlockEdges(void){
+
+    static uint8_t data[MIL_UART_PKT_MAX_PAYLOAD];
+    static uint8_t out[MIL_UART_PKT_ENCODED_SIZE(MIL_UART_PKT_MAX_PAYLOAD)];
+    MIL_UART_Pkt_t parser;
+    uint16_t n;
+
+    MIL_UART_PktInit(&parser, &Rx, 0);
+
+    for(uint16_t len = 248;len <= 512;len++){
+
+        if(len > 260 && len < 502){
+            continue;
+        }
+
+        //no zeros, every block runs to its full 254 bytes
+        for(uint16_t i = 0;i < len;i++){
+            data[i] = (uint8_t)((i % 255) + 1);
+        }
+        //and a CRC with no zero in it either, the worst case for the block count
+        for(uint16_t crc = 0;((crc >> 8) == 0) || ((crc & 0xFF) == 0);){
+            data[0] = (uint8_t)((Rand() % 255) + 1);
+            crc = MIL_UART_PktCRC16(0xFFFF, data, len);
+        }
+
+        n = MIL_UART_PktEncode(data, len, out, sizeof(out));
+        MIL_CHECK(n != 0);
+        MIL_CHECK(n <= MIL_UART_PKT_ENCODED_SIZE(len));
+        MIL_CHECK(memchr(out, 0, n - 1) == 0);
+
+        GotCount = 0;
+        FeedSplit(&parser, out, n);
+        MIL_CHECK_EQ(GotCount, 1);
+        MIL_CHECK_EQ(GotLen[0], len);
+        MIL_CHECK(memcmp(Got[0], data, len) == 0);
+    }
+
+    MIL_CHECK_EQ(parser.stats.crc_errors, 0);
+    MIL_CHECK_EQ(parser.stats.frame_errors, 0);
+
+}
+
+/*
+ * Desc: streams of packets, some damaged, fed in random pieces
+ *
+ * Notes: a damaged packet must never come out, and every good packet
+ *        must come out unless the damage ate the 0x00 in front of it
+ */
+static void TestRoundTripFuzz(void){
+
+    static uint8_t payload[MAX_PKTS][MIL_UART_PKT_MAX_PAYLOAD];
+    static uint16_t plen[MAX_PKTS];
+    static bool damaged[MAX_PKTS];
+    static uint8_t stream[MAX_PKTS * MIL_UART_PKT_ENCODED_SIZE(MIL_UART_PKT_MAX_PAYLOAD)];
+    MIL_UART_Pkt_t parser;
+    uint32_t expected = 0;
+    uint32_t missed = 0;
+
+    for(uint32_t round = 0;round < 2000;round++){
+
+        uint8_t npkts = (uint8_t)((Rand() % 16) + 1);
+        uint32_t slen = 0;
+        uint32_t g = 0;
+
+        MIL_UART_PktInit(&parser, &Rx, 0);
+        GotCount = 0;
+
+        for(uint8_t p = 0;p < npkts;p++){
+
+            uint32_t start = slen;
+            uint16_t n;
+
+            plen[p] = (uint16_t)(Rand() % (((Rand() & 7) == 0) ? (MIL_UART_PKT_MAX_PAYLOAD + 1) : 40));
+            MakePayload(payload[p], plen[p]);
+
+            n = MIL_UART_PktEncode(payload[p], plen[p], &stream[slen], MIL_UART_PKT_ENCODED_SIZE(plen[p]));
+            MIL_CHECK(n != 0);
+            slen += n;
+
+            //one packet in four gets a byte changed, the 0x00 at the end included
+            damaged[p] = (Rand() % 4) == 0;
+            if(damaged[p]){
+                uint32_t at = start + (Rand() % n);
+                stream[at] ^= (uint8_t)((Rand() % 255) + 1);
+            }
+        }
+
+        FeedSplit(&parser, stream, slen);
+
+        //what came out is the good packets in order, nothing else
+        for(uint8_t p = 0;p < npkts;p++){
+
+            bool must = !damaged[p] && (p == 0 || !damaged[p - 1]);
+
+            if(damaged[p]){
+                continue;
+            }
+            if(g < GotCount && GotLen[g] == plen[p] && memcmp(Got[g], payload[p], plen[p]) == 0){
+                g++;
+                expected += must;
+            }
+            else{
+                MIL_CHECK(!must);
+                missed++;
+            }
+        }
+        MIL_CHECK_EQ(g, GotCount);
+        MIL_CHECK_EQ(parser.stats.packets, GotCount);
+    }
+
+    MIL_CHECK(expected > 8000);
+    MIL_CHECK(missed < expected / 10);
+
+}
+
+/*
+ * Desc: a payload over the limit is thrown away without
+ *       writing past the buffer, the next one still gets through
+ */
+static void TestOversizeThenGood(void){
+
+    static uint8_t data[MIL_UART_PKT_MAX_PAYLOAD + 10];
+    static uint8_t out[MIL_UART_PKT_ENCODED_SIZE(MIL_UART_PKT_MAX_PAYLOAD + 10)];
+    MIL_UART_Pkt_t parser;
+    uint16_t n;
+
+    MIL_UART_PktInit(&parser, &Rx, 0);
+    GotCount = 0;
+
+    MakePayload(data, sizeof(data));
+    n = MIL_UART_PktEncode(data, sizeof(data), out, sizeof(out));
+    MIL_UART_PktFeed(&parser, out, n);
+    MIL_CHECK_EQ(GotCount, 0);
+    MIL_CHECK_EQ(parser.stats.frame_errors, 1);
+
+    n = MIL_UART_PktEncode(data, 10, out, sizeof(out));
+    MIL_UART_PktFeed(&parser, out, n);
+    MIL_CHECK_EQ(GotCount, 1);
+    MIL_CHECK_EQ(GotLen[0], 10);
+
+}
+
+/*
+ * Desc: encode and decode speed for a typical small packet
+ */
+static void BenchThroughput(void){
+
+    static uint8_t data[64];
+    static uint8_t out[MIL_UART_PKT_ENCODED_SIZE(64)];
+    const uint32_t rounds = 200000;
+    MIL_UART_Pkt_t parser;
+    uint32_t bytes = 0;
+    uint16_t n = 0;
+    clock_t start;
+    double enc_secs;
+    double dec_secs;
+
+    MakePayload(data, sizeof(data));
+    MIL_UART_PktInit(&parser, &Rx, 0);
+    GotCount = 0;
+
+    start = clock();
+    for(uint32_t r = 0;r < rounds;r++){
+        data[0] = (uint8_t)r;
+        n = MIL_UART_PktEncode(data, sizeof(data), out, sizeof(out));
+        bytes += n;
+    }
+    enc_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for(uint32_t r = 0;r < rounds;r++){
+        MIL_UART_PktFeed(&parser, out, n);
+    }
+    dec_secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    MIL_CHECK_EQ(GotCount, rounds);
+    MIL_CHECK(bytes >= rounds * sizeof(data));
+
+    if(enc_secs > 0 && dec_secs > 0){
+        printf("  encode: %.1f MB/s of payload, decode: %.1f MB/s on the wire(64 byte payloads)\n",
+               ((double)rounds * sizeof(data)) / enc_secs / 1e6, ((double)rounds * n) / dec_secs / 1e6);
+    }
+
+}
+
+int main(void){
+
+    MIL_RUN(TestKnownEncoding);
+    MIL_RUN(TestFullBlockEdges);
+    MIL_RUN(TestRoundTripFuzz);
+    MIL_RUN(TestOversizeThenGood);
+    MIL_RUN(BenchThroughput);
+
+    return MIL_TEST_DONE();
+
+}
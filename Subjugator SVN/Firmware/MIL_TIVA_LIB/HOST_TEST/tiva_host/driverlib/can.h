@@ -0,0 +1,90 @@
+/*
+ * Name: can.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses), tiva_host.c simulates the
+ *       controller behind it
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef HOST_CAN_H_
+#define HOST_CAN_H_
+
+typedef struct{
+
+  uint32_t ui32MsgID;
+  uint32_t ui32MsgIDMask;
+  uint32_t ui32Flags;
+  uint32_t ui32MsgLen;
+  uint8_t *pui8MsgData;
+
+}tCANMsgObject;
+
+typedef struct{
+
+  uint32_t ui32SyncPropPhase1Seg;
+  uint32_t ui32Phase2Seg;
+  uint32_t ui32SJW;
+  uint32_t ui32QuantumPrescaler;
+
+}tCANBitClkParms;
+
+typedef enum{
+    CAN_INT_STS_CAUSE,
+    CAN_INT_STS_OBJECT
+}tCANIntStsReg;
+
+typedef enum{
+    CAN_STS_CONTROL,
+    CAN_STS_TXREQUEST,
+    CAN_STS_NEWDAT,
+    CAN_STS_MSGVAL
+}tCANStsReg;
+
+typedef enum{
+    MSG_OBJ_TYPE_TX,
+    MSG_OBJ_TYPE_TX_REMOTE,
+    MSG_OBJ_TYPE_RX,
+    MSG_OBJ_TYPE_RX_REMOTE,
+    MSG_OBJ_TYPE_RXTX_REMOTE
+}tMsgObjType;
+
+#define MSG_OBJ_NO_FLAGS        0x00000000
+#define MSG_OBJ_TX_INT_ENABLE   0x00000001
+#define MSG_OBJ_RX_INT_ENABLE   0x00000002
+#define MSG_OBJ_EXTENDED_ID     0x00000004
+#define MSG_OBJ_USE_ID_FILTER   0x00000008
+#define MSG_OBJ_NEW_DATA        0x00000080
+#define MSG_OBJ_DATA_LOST       0x00000100
+#define MSG_OBJ_FIFO            0x00000200
+
+#define CAN_INT_ERROR           0x00000008
+#define CAN_INT_STATUS          0x00000004
+#define CAN_INT_MASTER          0x00000002
+#define CAN_INT_INTID_STATUS    0x00008000
+
+#define CAN_STATUS_BUS_OFF      0x00000080
+#define CAN_STATUS_EWARN        0x00000040
+#define CAN_STATUS_EPASS        0x00000020
+#define CAN_STATUS_RXOK         0x00000010
+#define CAN_STATUS_TXOK         0x00000008
+
+void CANInit(uint32_t ui32Base);
+void CANEnable(uint32_t ui32Base);
+void CANDisable(uint32_t ui32Base);
+void CANBitTimingSet(uint32_t ui32Base, tCANBitClkParms *psClkParms);
+void CANRetrySet(uint32_t ui32Base, bool bAutoRetry);
+bool CANErrCntrGet(uint32_t ui32Base, uint32_t *pui32RxCount, uint32_t *pui32TxCount);
+void CANIntRegister(uint32_t ui32Base, void (*pfnHandler)(void));
+void CANIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t CANIntStatus(uint32_t ui32Base, tCANIntStsReg eIntStsReg);
+void CANIntClear(uint32_t ui32Base, uint32_t ui32IntClr);
+uint32_t CANStatusGet(uint32_t ui32Base, tCANStsReg eStatusReg);
+void CANMessageSet(uint32_t ui32Base, uint32_t ui32ObjID, tCANMsgObject *psMsgObject, tMsgObjType eMsgType);
+void CANMessageGet(uint32_t ui32Base, uint32_t ui32ObjID, tCANMsgObject *psMsgObject, bool bClrPendingInt);
+void CANMessageClear(uint32_t ui32Base, uint32_t ui32ObjID);
+
+#endif /* HOST_CAN_H_ */
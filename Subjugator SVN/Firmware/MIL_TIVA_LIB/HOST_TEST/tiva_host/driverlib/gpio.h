@@ -0,0 +1,26 @@
+/*
+ * Name: gpio.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ */
+
+#include <stdint.h>
+
+#ifndef HOST_GPIO_H_
+#define HOST_GPIO_H_
+
+#define GPIO_PIN_0 0x01
+#define GPIO_PIN_1 0x02
+#define GPIO_PIN_2 0x04
+#define GPIO_PIN_3 0x08
+#define GPIO_PIN_4 0x10
+#define GPIO_PIN_5 0x20
+#define GPIO_PIN_6 0x40
+#define GPIO_PIN_7 0x80
+
+void GPIOPinConfigure(uint32_t ui32PinConfig);
+void GPIOPinTypeCAN(uint32_t ui32Port, uint8_t ui8Pins);
+
+#endif /* HOST_GPIO_H_ */
@@ -0,0 +1,20 @@
+/*
+ * Name: interrupt.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef HOST_INTERRUPT_H_
+#define HOST_INTERRUPT_H_
+
+bool IntMasterEnable(void);
+bool IntMasterDisable(void);
+void IntEnable(uint32_t ui32Interrupt);
+void IntDisable(uint32_t ui32Interrupt);
+
+#endif /* HOST_INTERRUPT_H_ */
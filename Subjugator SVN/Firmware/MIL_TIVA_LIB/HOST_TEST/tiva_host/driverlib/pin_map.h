@@ -0,0 +1,21 @@
+/*
+ * Name: pin_map.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ */
+
+#ifndef HOST_PIN_MAP_H_
+#define HOST_PIN_MAP_H_
+
+#define GPIO_PA0_CAN1RX 0x00000008
+#define GPIO_PA1_CAN1TX 0x00000408
+#define GPIO_PB4_CAN0RX 0x00011008
+#define GPIO_PB5_CAN0TX 0x00011408
+#define GPIO_PE4_CAN0RX 0x00041008
+#define GPIO_PE5_CAN0TX 0x00041408
+#define GPIO_PF0_CAN0RX 0x00050003
+#define GPIO_PF3_CAN0TX 0x00050C03
+
+#endif /* HOST_PIN_MAP_H_ */
@@ -0,0 +1,41 @@
+/*
+ * Name: pwm.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef HOST_PWM_H_
+#define HOST_PWM_H_
+
+#define PWM_GEN_0 0x00000040
+#define PWM_GEN_1 0x00000080
+#define PWM_GEN_2 0x000000C0
+#define PWM_GEN_3 0x00000100
+
+#define PWM_GEN_0_BIT 0x00000001
+#define PWM_GEN_1_BIT 0x00000002
+#define PWM_GEN_2_BIT 0x00000004
+#define PWM_GEN_3_BIT 0x00000008
+
+#define PWM_OUT_0 0x00000040
+#define PWM_OUT_1 0x00000041
+#define PWM_OUT_2 0x00000082
+#define PWM_OUT_3 0x00000083
+#define PWM_OUT_4 0x000000C4
+#define PWM_OUT_5 0x000000C5
+#define PWM_OUT_6 0x00000106
+#define PWM_OUT_7 0x00000107
+
+#define PWM_GEN_MODE_SYNC            0x00000038
+#define PWM_GEN_MODE_GEN_SYNC_GLOBAL 0x000003C0
+
+uint32_t PWMGenPeriodGet(uint32_t ui32Base, uint32_t ui32Gen);
+void PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width);
+void PWMSyncUpdate(uint32_t ui32Base, uint32_t ui32GenBits);
+
+#endif /* HOST_PWM_H_ */
@@ -0,0 +1,41 @@
+/*
+ * Name: sysctl.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef HOST_SYSCTL_H_
+#define HOST_SYSCTL_H_
+
+#define SYSCTL_PERIPH_CAN0  0xf0003400
+#define SYSCTL_PERIPH_CAN1  0xf0003401
+#define SYSCTL_PERIPH_GPIOA 0xf0000800
+#define SYSCTL_PERIPH_GPIOB 0xf0000801
+#define SYSCTL_PERIPH_GPIOC 0xf0000802
+#define SYSCTL_PERIPH_GPIOD 0xf0000803
+#define SYSCTL_PERIPH_GPIOE 0xf0000804
+#define SYSCTL_PERIPH_GPIOF 0xf0000805
+
+#define SYSCTL_SYSDIV_1     0x07800000
+#define SYSCTL_SYSDIV_2_5   0xC1000000
+#define SYSCTL_SYSDIV_3     0x01400000
+#define SYSCTL_SYSDIV_4     0x01C00000
+#define SYSCTL_SYSDIV_5     0x02400000
+#define SYSCTL_USE_PLL      0x00000000
+#define SYSCTL_USE_OSC      0x00003800
+#define SYSCTL_OSC_MAIN     0x00000000
+#define SYSCTL_OSC_INT      0x00000010
+#define SYSCTL_XTAL_16MHZ   0x00000540
+
+void SysCtlClockSet(uint32_t ui32Config);
+uint32_t SysCtlClockGet(void);
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral);
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral);
+void SysCtlDelay(uint32_t ui32Count);
+
+#endif /* HOST_SYSCTL_H_ */
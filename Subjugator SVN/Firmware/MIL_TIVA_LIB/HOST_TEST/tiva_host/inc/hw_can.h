@@ -0,0 +1,12 @@
+/*
+ * Name: hw_can.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ */
+
+#ifndef HOST_HW_CAN_H_
+#define HOST_HW_CAN_H_
+
+#endif /* HOST_HW_CAN_H_ */
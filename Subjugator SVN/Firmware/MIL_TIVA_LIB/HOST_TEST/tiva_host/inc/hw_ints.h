@@ -0,0 +1,15 @@
+/*
+ * Name: hw_ints.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ */
+
+#ifndef HOST_HW_INTS_H_
+#define HOST_HW_INTS_H_
+
+#define INT_CAN0 55
+#define INT_CAN1 56
+
+#endif /* HOST_HW_INTS_H_ */
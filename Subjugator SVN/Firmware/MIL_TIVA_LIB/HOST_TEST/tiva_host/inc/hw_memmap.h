@@ -0,0 +1,26 @@
+/*
+ * Name: hw_memmap.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ *
+ * Note: The values match the TM4C123 so base compares work the same,
+ *       nothing on the host ever dereferences them
+ */
+
+#ifndef HOST_HW_MEMMAP_H_
+#define HOST_HW_MEMMAP_H_
+
+#define GPIO_PORTA_BASE 0x40004000
+#define GPIO_PORTB_BASE 0x40005000
+#define GPIO_PORTC_BASE 0x40006000
+#define GPIO_PORTD_BASE 0x40007000
+#define GPIO_PORTE_BASE 0x40024000
+#define GPIO_PORTF_BASE 0x40025000
+#define CAN0_BASE       0x40040000
+#define CAN1_BASE       0x40041000
+#define PWM0_BASE       0x40028000
+#define PWM1_BASE       0x40029000
+
+#endif /* HOST_HW_MEMMAP_H_ */
@@ -0,0 +1,18 @@
+/*
+ * Name: hw_types.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Host stand-in for the TivaWare header of the same name
+ *       (only what MIL_TIVA_LIB uses)
+ */
+
+#include <stdint.h>
+
+#ifndef HOST_HW_TYPES_H_
+#define HOST_HW_TYPES_H_
+
+#define HWREG(x)  (*((volatile uint32_t *)(uintptr_t)(x)))
+#define HWREGH(x) (*((volatile uint16_t *)(uintptr_t)(x)))
+#define HWREGB(x) (*((volatile uint8_t *)(uintptr_t)(x)))
+
+#endif /* HOST_HW_TYPES_H_ */
@@ -0,0 +1,411 @@
+/*
+ * Name: tiva_host.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Simulated TIVA peripherals behind the host driverlib headers
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/can.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+
+#include "tiva_host.h"
+
+//stops a broken ISR that never releases its interrupt from hanging a test
+#define HOST_ISR_LIMIT 1000
+
+typedef struct{
+
+  bool     valid;
+  bool     tx;
+  uint32_t id;
+  uint32_t mask;
+  uint32_t flags;
+  uint8_t  len;
+  uint8_t  data[8];
+  bool     newdat;
+  bool     txrqst;
+  bool     intpnd;
+  bool     lost;
+
+}host_can_obj_t;
+
+typedef struct{
+
+  host_can_obj_t obj[32];
+  void (*pisr)(void);
+  uint32_t status;
+  bool status_int;
+  uint32_t obj0_count;
+
+}host_can_t;
+
+typedef struct{
+
+  uint32_t period[4];
+  uint32_t pending[8];
+  uint32_t width[8];
+  uint32_t sync_count[2];     //unmasked, masked
+
+}host_pwm_t;
+
+static bool IntOff;
+static uint32_t ClockHz = 16000000;
+static host_can_t Can[2];
+static host_pwm_t Pwm[2];
+
+static host_can_t *HostCAN_Of(uint32_t base){
+
+    return &Can[(base == CAN1_BASE) ? 1 : 0];
+
+}
+
+static host_pwm_t *HostPWM_Of(uint32_t base){
+
+    return &Pwm[(base == PWM1_BASE) ? 1 : 0];
+
+}
+
+/* TEST SIDE */
+
+void HostReset(void){
+
+    memset(Can, 0, sizeof(Can));
+    memset(Pwm, 0, sizeof(Pwm));
+    IntOff = false;
+    ClockHz = 16000000;
+
+}
+
+bool HostIntMasked(void){
+
+    return IntOff;
+
+}
+
+uint8_t HostCAN_Rx(uint32_t base, uint32_t canid, const uint8_t *data, uint8_t len){
+
+    host_can_t *pcan = HostCAN_Of(base);
+    host_can_obj_t *pobj;
+    uint8_t i;
+
+    for(i = 0;i < 32;i++){
+
+        pobj = &pcan->obj[i];
+        if(!pobj->valid || pobj->tx || ((canid ^ pobj->id) & pobj->mask)){
+            continue;
+        }
+
+        //walk a FIFO chain to its first empty object, the last one is overwritten
+        while(pobj->newdat && (pobj->flags & MSG_OBJ_FIFO) && i < 31){
+            i++;
+            pobj = &pcan->obj[i];
+        }
+
+        pobj->lost = pobj->newdat;
+        pobj->id = canid;
+        pobj->len = (len > 8) ? 8 : len;
+        memcpy(pobj->data, data, pobj->len);
+        pobj->newdat = true;
+        if(pobj->flags & MSG_OBJ_RX_INT_ENABLE){
+            pobj->intpnd = true;
+        }
+
+        return i + 1;
+    }
+
+    return 0;
+
+}
+
+bool HostCAN_TxOne(uint32_t base, host_can_frame_t *pframe){
+
+    host_can_t *pcan = HostCAN_Of(base);
+
+    for(uint8_t i = 0;i < 32;i++){
+
+        host_can_obj_t *pobj = &pcan->obj[i];
+
+        if(pobj->valid && pobj->tx && pobj->txrqst){
+            pframe->canid = pobj->id;
+            pframe->len = pobj->len;
+            memcpy(pframe->data, pobj->data, pobj->len);
+            pframe->obj_num = i + 1;
+
+            pobj->txrqst = false;
+            if(pobj->flags & MSG_OBJ_TX_INT_ENABLE){
+                pobj->intpnd = true;
+            }
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+void HostCAN_Status(uint32_t base, uint32_t status){
+
+    host_can_t *pcan = HostCAN_Of(base);
+
+    pcan->status = status;
+    pcan->status_int = true;
+
+}
+
+uint32_t HostCAN_Interrupt(uint32_t base){
+
+    host_can_t *pcan = HostCAN_Of(base);
+    uint32_t runs = 0;
+
+    while(pcan->pisr && !IntOff && CANIntStatus(base, CAN_INT_STS_CAUSE) && runs < HOST_ISR_LIMIT){
+        pcan->pisr();
+        runs++;
+    }
+
+    return runs;
+
+}
+
+uint32_t HostCAN_Obj0Count(uint32_t base){
+
+    return HostCAN_Of(base)->obj0_count;
+
+}
+
+void HostPWM_SetPeriod(uint32_t base, uint32_t gen, uint32_t period){
+
+    HostPWM_Of(base)->period[(gen >> 6) - 1] = period;
+
+}
+
+uint32_t HostPWM_Width(uint32_t base, uint32_t out){
+
+    return HostPWM_Of(base)->width[out & 0x07];
+
+}
+
+uint32_t HostPWM_SyncCount(uint32_t base, bool masked){
+
+    return HostPWM_Of(base)->sync_count[masked ? 1 : 0];
+
+}
+
+/* driverlib/interrupt.h */
+
+bool IntMasterEnable(void){
+
+    bool was_off = IntOff;
+
+    IntOff = false;
+    return was_off;
+
+}
+
+bool IntMasterDisable(void){
+
+    bool was_off = IntOff;
+
+    IntOff = true;
+    return was_off;
+
+}
+
+void IntEnable(uint32_t ui32Interrupt){ (void)ui32Interrupt; }
+void IntDisable(uint32_t ui32Interrupt){ (void)ui32Interrupt; }
+
+/* driverlib/sysctl.h */
+
+void SysCtlClockSet(uint32_t ui32Config){ (void)ui32Config; }
+uint32_t SysCtlClockGet(void){ return ClockHz; }
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral){ (void)ui32Peripheral; }
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral){ (void)ui32Peripheral; return true; }
+void SysCtlDelay(uint32_t ui32Count){ (void)ui32Count; }
+
+/* driverlib/pwm.h */
+
+uint32_t PWMGenPeriodGet(uint32_t ui32Base, uint32_t ui32Gen){
+
+    return HostPWM_Of(ui32Base)->period[(ui32Gen >> 6) - 1];
+
+}
+
+void PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width){
+
+    HostPWM_Of(ui32Base)->pending[ui32PWMOut & 0x07] = ui32Width;
+
+}
+
+void PWMSyncUpdate(uint32_t ui32Base, uint32_t ui32GenBits){
+
+    host_pwm_t *ppwm = HostPWM_Of(ui32Base);
+
+    //both outputs of a generator take their pending widths
+    for(uint8_t out = 0;out < 8;out++){
+        if(ui32GenBits & (1 << (out >> 1))){
+            ppwm->width[out] = ppwm->pending[out];
+        }
+    }
+    ppwm->sync_count[IntOff ? 1 : 0]++;
+
+}
+
+/* driverlib/gpio.h */
+
+void GPIOPinConfigure(uint32_t ui32PinConfig){ (void)ui32PinConfig; }
+void GPIOPinTypeCAN(uint32_t ui32Port, uint8_t ui8Pins){ (void)ui32Port; (void)ui8Pins; }
+
+/* driverlib/can.h */
+
+void CANInit(uint32_t ui32Base){
+
+    memset(HostCAN_Of(ui32Base)->obj, 0, sizeof(HostCAN_Of(ui32Base)->obj));
+
+}
+
+void CANEnable(uint32_t ui32Base){
+
+    HostCAN_Of(ui32Base)->status &= ~CAN_STATUS_BUS_OFF;
+
+}
+
+void CANDisable(uint32_t ui32Base){ (void)ui32Base; }
+void CANBitTimingSet(uint32_t ui32Base, tCANBitClkParms *psClkParms){ (void)ui32Base; (void)psClkParms; }
+void CANRetrySet(uint32_t ui32Base, bool bAutoRetry){ (void)ui32Base; (void)bAutoRetry; }
+void CANIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags){ (void)ui32Base; (void)ui32IntFlags; }
+
+bool CANErrCntrGet(uint32_t ui32Base, uint32_t *pui32RxCount, uint32_t *pui32TxCount){
+
+    (void)ui32Base;
+    *pui32RxCount = 0;
+    *pui32TxCount = 0;
+    return false;
+
+}
+
+void CANIntRegister(uint32_t ui32Base, void (*pfnHandler)(void)){
+
+    HostCAN_Of(ui32Base)->pisr = pfnHandler;
+
+}
+
+uint32_t CANIntStatus(uint32_t ui32Base, tCANIntStsReg eIntStsReg){
+
+    host_can_t *pcan = HostCAN_Of(ui32Base);
+    uint32_t mask = 0;
+
+    for(uint8_t i = 0;i < 32;i++){
+        if(pcan->obj[i].intpnd){
+            if(eIntStsReg == CAN_INT_STS_CAUSE && !pcan->status_int){
+                return i + 1;
+            }
+            mask |= 0x01UL << i;
+        }
+    }
+
+    if(eIntStsReg == CAN_INT_STS_CAUSE){
+        return pcan->status_int ? CAN_INT_INTID_STATUS : 0;
+    }
+
+    return mask;
+
+}
+
+void CANIntClear(uint32_t ui32Base, uint32_t ui32IntClr){
+
+    host_can_t *pcan = HostCAN_Of(ui32Base);
+
+    if(ui32IntClr == CAN_INT_INTID_STATUS){
+        pcan->status_int = false;
+    }
+    else if(ui32IntClr >= 1 && ui32IntClr <= 32){
+        pcan->obj[ui32IntClr - 1].intpnd = false;
+    }
+
+}
+
+uint32_t CANStatusGet(uint32_t ui32Base, tCANStsReg eStatusReg){
+
+    host_can_t *pcan = HostCAN_Of(ui32Base);
+    uint32_t mask = 0;
+
+    if(eStatusReg == CAN_STS_CONTROL){
+        //reading the status register releases the status interrupt
+        pcan->status_int = false;
+        return pcan->status;
+    }
+
+    for(uint8_t i = 0;i < 32;i++){
+
+        host_can_obj_t *pobj = &pcan->obj[i];
+        bool set = (eStatusReg == CAN_STS_TXREQUEST) ? pobj->txrqst :
+                   (eStatusReg == CAN_STS_NEWDAT) ? pobj->newdat : pobj->valid;
+
+        if(set){
+            mask |= 0x01UL << i;
+        }
+    }
+
+    return mask;
+
+}
+
+void CANMessageSet(uint32_t ui32Base, uint32_t ui32ObjID, tCANMsgObject *psMsgObject, tMsgObjType eMsgType){
+
+    host_can_t *pcan = HostCAN_Of(ui32Base);
+    host_can_obj_t *pobj;
+
+    //object 0 does not exist, the frame is counted and goes nowhere
+    if(ui32ObjID < 1 || ui32ObjID > 32){
+        pcan->obj0_count++;
+        return;
+    }
+
+    pobj = &pcan->obj[ui32ObjID - 1];
+    memset(pobj, 0, sizeof(*pobj));
+
+    pobj->valid = true;
+    pobj->tx = (eMsgType == MSG_OBJ_TYPE_TX);
+    pobj->id = psMsgObject->ui32MsgID;
+    pobj->flags = psMsgObject->ui32Flags;
+    pobj->len = (psMsgObject->ui32MsgLen > 8) ? 8 : psMsgObject->ui32MsgLen;
+
+    if(pobj->tx){
+        memcpy(pobj->data, psMsgObject->pui8MsgData, pobj->len);
+        pobj->txrqst = true;
+    }
+    else{
+        //without the filter flag every ID bit has to match
+        pobj->mask = (psMsgObject->ui32Flags & MSG_OBJ_USE_ID_FILTER) ? psMsgObject->ui32MsgIDMask : 0x1FFFFFFF;
+    }
+
+}
+
+void CANMessageGet(uint32_t ui32Base, uint32_t ui32ObjID, tCANMsgObject *psMsgObject, bool bClrPendingInt){
+
+    host_can_obj_t *pobj = &HostCAN_Of(ui32Base)->obj[ui32ObjID - 1];
+
+    psMsgObject->ui32MsgID = pobj->id;
+    psMsgObject->ui32MsgLen = pobj->len;
+    psMsgObject->ui32Flags = pobj->flags | (pobj->newdat ? MSG_OBJ_NEW_DATA : 0) |
+                             (pobj->lost ? MSG_OBJ_DATA_LOST : 0);
+    memcpy(psMsgObject->pui8MsgData, pobj->data, pobj->len);
+
+    pobj->newdat = false;
+    pobj->lost = false;
+    if(bClrPendingInt){
+        pobj->intpnd = false;
+    }
+
+}
+
+void CANMessageClear(uint32_t ui32Base, uint32_t ui32ObjID){
+
+    memset(&HostCAN_Of(ui32Base)->obj[ui32ObjID - 1], 0, sizeof(host_can_obj_t));
+
+}
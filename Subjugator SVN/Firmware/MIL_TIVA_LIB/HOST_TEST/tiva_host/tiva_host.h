@@ -0,0 +1,110 @@
+/*
+ * Name: tiva_host.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Simulated TIVA peripherals behind the host driverlib headers
+ *
+ * What to understand: MIL_TIVA_LIB code is built unchanged against the
+ *                     headers in this folder. The calls it makes land in
+ *                     tiva_host.c, which keeps just enough state to act
+ *                     like the hardware. Tests drive the other side:
+ *
+ *                     HostCAN_Rx        - a frame arrives off the bus
+ *                     HostCAN_TxOne     - the controller sends one frame
+ *                     HostCAN_Interrupt - the CAN interrupt fires
+ *
+ * CAN NOTE: Like the TM4C, a frame goes into the lowest valid RX object
+ *           its filter matches, a FIFO chain(MSG_OBJ_FIFO) fills its
+ *           lowest empty object and the last object is overwritten
+ *           (MSG_OBJ_DATA_LOST) when the chain is full. Pending TX
+ *           objects go out lowest object number first
+ *
+ * PWM NOTE: Every generator acts as if it was set up with
+ *           PWM_GEN_MODE_SYNC, a pulse width waits until PWMSyncUpdate
+ *           names its generator. Set the periods with HostPWM_SetPeriod
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef TIVA_HOST_H_
+#define TIVA_HOST_H_
+
+/*
+ * Desc: one frame on the simulated bus
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint8_t  len;
+  uint8_t  data[8];
+  uint8_t  obj_num;     //object it left from(0 for MIL_CANSimpleTX's object 0)
+
+}host_can_frame_t;
+
+/*
+ * Desc: Clears every simulated peripheral and turns interrupts on
+ */
+void HostReset(void);
+
+/*
+ * Desc: true while IntMasterDisable is in effect
+ */
+bool HostIntMasked(void);
+
+/*
+ * Desc: A frame arrives at a controller
+ *
+ * Returns: message object it landed in, 0 if no filter took it
+ */
+uint8_t HostCAN_Rx(uint32_t base, uint32_t canid, const uint8_t *data, uint8_t len);
+
+/*
+ * Desc: The controller sends its lowest pending TX object
+ *
+ * Returns: false if nothing was pending
+ */
+bool HostCAN_TxOne(uint32_t base, host_can_frame_t *pframe);
+
+/*
+ * Desc: Raises the controller's status interrupt with these
+ *       CAN_STATUS_ bits(bus-off, error passive...)
+ */
+void HostCAN_Status(uint32_t base, uint32_t status);
+
+/*
+ * Desc: Runs the registered ISR for as long as the controller
+ *       has an interrupt pending(like the NVIC would)
+ *
+ * Returns: times the ISR ran
+ */
+uint32_t HostCAN_Interrupt(uint32_t base);
+
+/*
+ * Desc: Frames sent through object 0(MIL_CANSimpleTX without a queue)
+ */
+uint32_t HostCAN_Obj0Count(uint32_t base);
+
+/*
+ * Desc: Sets the period(PWM clocks) PWMGenPeriodGet reads back
+ *
+ * Parameters:
+ * base - PWM0_BASE or PWM1_BASE
+ * gen - PWM_GEN_x
+ */
+void HostPWM_SetPeriod(uint32_t base, uint32_t gen, uint32_t period);
+
+/*
+ * Desc: Pulse width an output is running with(0 until the first sync)
+ *
+ * Parameters:
+ * out - PWM_OUT_x
+ */
+uint32_t HostPWM_Width(uint32_t base, uint32_t out);
+
+/*
+ * Desc: Times PWMSyncUpdate ran with interrupts masked and unmasked
+ */
+uint32_t HostPWM_SyncCount(uint32_t base, bool masked);
+
+#endif /* TIVA_HOST_H_ */
@@ -0,0 +1,94 @@
+/*
+ * Name: MIL_ADC_Cal.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Calibrated fixed point conversion of raw ADC counts to millivolts
+ *
+ * Note: The product is 64 bits(one SMLAL on the M4) so a gain of
+ *       a whole volt per count still cannot overflow
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include"MIL_ADC_Cal.h"
+
+//0.5 in Q16, rounds to the nearest millivolt
+#define MIL_ADC_CAL_HALF 0x8000
+
+/*
+ * Desc: Calibration from the reference and the input divider alone
+ */
+void MIL_ADC_CalIdeal(MIL_ADC_Cal_t *pcal, uint32_t r_top, uint32_t r_bottom){
+
+    uint64_t num = (uint64_t)MIL_ADC_VREF_MV << 16;
+    uint64_t den = MIL_ADC_FULL_SCALE;
+
+    //divider scales the pin voltage back up by (top + bottom) / bottom
+    if(r_top && r_bottom){
+        num *= (uint64_t)r_top + r_bottom;
+        den *= r_bottom;
+    }
+
+    pcal->gain = (int32_t)((num + (den / 2)) / den);
+    pcal->offset = 0;
+
+}
+
+/*
+ * Desc: Calibration from two measured points
+ *
+ * Returns: false if raw_hi is not above raw_lo or the gain/offset
+ *          do not fit(pcal is left alone)
+ */
+bool MIL_ADC_CalTwoPoint(MIL_ADC_Cal_t *pcal, uint16_t raw_lo, int32_t mv_lo,
+                         uint16_t raw_hi, int32_t mv_hi){
+
+    int64_t span = (int64_t)raw_hi - raw_lo;
+    int64_t gain;
+    int64_t offset;
+
+    if(span <= 0){
+        return false;
+    }
+
+    gain = (((int64_t)mv_hi - mv_lo) * 65536) / span;
+    offset = ((int64_t)mv_lo * 65536) - (gain * raw_lo);
+
+    //the line has to cross raw 0 within the Q16 range(about +-32.7V)
+    if(gain < INT32_MIN || gain > INT32_MAX || offset < INT32_MIN || offset > INT32_MAX){
+        return false;
+    }
+
+    pcal->gain = (int32_t)gain;
+    pcal->offset = (int32_t)offset;
+
+    return true;
+
+}
+
+/*
+ * Desc: Converts one raw result to millivolts
+ */
+int32_t MIL_ADC_CalToMilliVolts(const MIL_ADC_Cal_t *pcal, uint16_t raw){
+
+    return (int32_t)(((int64_t)raw * pcal->gain + pcal->offset + MIL_ADC_CAL_HALF) >> 16);
+
+}
+
+/*
+ * Desc: Converts a block of raw results to millivolts
+ */
+void MIL_ADC_CalBlock(const MIL_ADC_Cal_t *pcal, uint8_t steps,
+                      const uint16_t *raw, int32_t *pmv, uint16_t count){
+
+    uint16_t i;
+    uint8_t step = 0;
+
+    for(i = 0;i < count;i++){
+        pmv[i] = (int32_t)(((int64_t)raw[i] * pcal[step].gain + pcal[step].offset + MIL_ADC_CAL_HALF) >> 16);
+        if(++step == steps){
+            step = 0;
+        }
+    }
+
+}
@@ -0,0 +1,103 @@
+/*
+ * Name: MIL_ADC_Cal.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Calibrated fixed point conversion of raw ADC counts to millivolts
+ *
+ * What to understand: Every input goes through its own divider and its
+ *                     own error, so one slope for all 12 channels is
+ *                     never quite right, and float maths in an ISR is
+ *                     slow. Each channel here gets a gain and an offset
+ *                     in Q16(16 integer bits . 16 fraction bits):
+ *
+ *                     mV = (raw * gain + offset) >> 16   (rounded)
+ *
+ *                     gain - millivolts per count in Q16
+ *                     offset - millivolts in Q16
+ *
+ *                     One multiply and one shift per sample, no division
+ *                     and no floats. The divisions happen once, when you
+ *                     build a table with MIL_ADC_CalIdeal or
+ *                     MIL_ADC_CalTwoPoint.
+ *
+ * Note: raw is the 12 bit result, with or without hardware
+ *       oversampling(MIL_ADCOversample averages in the ADC and
+ *       still hands back 12 bits)
+ *
+ * Note: This file only depends on stdint/stdbool so the same tables
+ *       can be checked on a PC as well as the TIVA
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_ADC_CAL_H_
+#define MIL_ADC_CAL_H_
+
+//ADC reference in millivolts(VDDA on the TM4C123)
+#ifndef MIL_ADC_VREF_MV
+#define MIL_ADC_VREF_MV 3300
+#endif
+
+//largest raw result
+#define MIL_ADC_FULL_SCALE 0xFFF
+
+/*
+ * Desc: calibration of one channel
+ */
+typedef struct{
+
+  int32_t gain;     //mV per count, Q16
+  int32_t offset;   //mV, Q16
+
+}MIL_ADC_Cal_t;
+
+/*
+ * Desc: Calibration from the reference and the input divider alone
+ *
+ * Parameters:
+ * pcal - calibration to fill in
+ * r_top - divider resistor from the signal to the pin(0 for none)
+ * r_bottom - divider resistor from the pin to ground(ignored if r_top is 0)
+ *
+ * Para Note: Only the ratio matters, use ohms or kilo-ohms
+ */
+void MIL_ADC_CalIdeal(MIL_ADC_Cal_t *pcal, uint32_t r_top, uint32_t r_bottom);
+
+/*
+ * Desc: Calibration from two measured points
+ *
+ * Notes: Apply two known voltages to the input and note the raw
+ *        results, the further apart the better
+ *
+ * Parameters:
+ * pcal - calibration to fill in
+ * raw_lo/mv_lo - raw result at the lower voltage
+ * raw_hi/mv_hi - raw result at the higher voltage
+ *
+ * Returns: false if raw_hi is not above raw_lo, or the line through the
+ *          two points reads more than about +-32.7V at raw 0(the offset
+ *          would not fit Q16), pcal is left alone
+ */
+bool MIL_ADC_CalTwoPoint(MIL_ADC_Cal_t *pcal, uint16_t raw_lo, int32_t mv_lo,
+                         uint16_t raw_hi, int32_t mv_hi);
+
+/*
+ * Desc: Converts one raw result to millivolts
+ */
+int32_t MIL_ADC_CalToMilliVolts(const MIL_ADC_Cal_t *pcal, uint16_t raw);
+
+/*
+ * Desc: Converts a block of raw results(for example from MIL_ADC_DMA)
+ *       to millivolts
+ *
+ * Parameters:
+ * pcal - one calibration per sequence step, in step order
+ * steps - steps in the sequence
+ * raw - count raw results, scan after scan
+ * pmv - count results in millivolts
+ */
+void MIL_ADC_CalBlock(const MIL_ADC_Cal_t *pcal, uint8_t steps,
+                      const uint16_t *raw, int32_t *pmv, uint16_t count);
+
+#endif /* MIL_ADC_CAL_H_ */
@@ -0,0 +1,205 @@
+/*
+ * Name: MIL_ADC_DMA.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Streams ADC sequences into RAM with the uDMA
+ *
+ * Note: On the TM4C123 a finished uDMA transfer raises the sequence's
+ *       own interrupt even while the sequence interrupt is masked in
+ *       the ADC, so the ISR only runs once per block
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_adc.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/adc.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/udma.h"
+
+#include"MIL_DMA.h"
+#include"MIL_ADC.h"
+#include"MIL_ADC_DMA.h"
+
+//ADC0_BASE and ADC1_BASE are 0x1000 apart, 4 sequences each
+#define MIL_ADC_IDX(base, seq_num) ((((base) - ADC0_BASE) >> 12) * 4 + (seq_num))
+
+//sequence FIFOs are 0x20 apart
+#define MIL_ADC_FIFO(base, seq_num) ((base) + ADC_O_SSFIFO0 + ((seq_num) * (ADC_O_SSFIFO1 - ADC_O_SSFIFO0)))
+
+//uDMA channel of every sequence
+static const uint32_t DMAMap[8] = {
+    UDMA_CH14_ADC0_0, UDMA_CH15_ADC0_1, UDMA_CH16_ADC0_2, UDMA_CH17_ADC0_3,
+    UDMA_CH24_ADC1_0, UDMA_CH25_ADC1_1, UDMA_CH26_ADC1_2, UDMA_CH27_ADC1_3
+};
+
+static MIL_ADC_DMA_t *pADC[8];          //0 while a sequence is not streaming
+
+static void MIL_ADC_DMAISR(uint8_t idx);
+static void MIL_ADC0_0_DMAISR(void){ MIL_ADC_DMAISR(0); }
+static void MIL_ADC0_1_DMAISR(void){ MIL_ADC_DMAISR(1); }
+static void MIL_ADC0_2_DMAISR(void){ MIL_ADC_DMAISR(2); }
+static void MIL_ADC0_3_DMAISR(void){ MIL_ADC_DMAISR(3); }
+static void MIL_ADC1_0_DMAISR(void){ MIL_ADC_DMAISR(4); }
+static void MIL_ADC1_1_DMAISR(void){ MIL_ADC_DMAISR(5); }
+static void MIL_ADC1_2_DMAISR(void){ MIL_ADC_DMAISR(6); }
+static void MIL_ADC1_3_DMAISR(void){ MIL_ADC_DMAISR(7); }
+static void (*const DMAISR[8])(void) = {
+    MIL_ADC0_0_DMAISR, MIL_ADC0_1_DMAISR, MIL_ADC0_2_DMAISR, MIL_ADC0_3_DMAISR,
+    MIL_ADC1_0_DMAISR, MIL_ADC1_1_DMAISR, MIL_ADC1_2_DMAISR, MIL_ADC1_3_DMAISR
+};
+static void MIL_ADC_DMAArm(MIL_ADC_DMA_t *pdma, uint32_t select);
+
+/*
+ * Desc: Starts streaming a sequence into buf
+ *
+ * Returns:
+ * MIL_ADC_OK if the sequence is streaming
+ * MIL_ADC_NOK if a parameter is not valid
+ */
+mil_adc_stat_t MIL_ADC_DMAInit(MIL_ADC_DMA_t *pdma, uint32_t base, uint8_t seq_num,
+                               uint16_t *buf, uint16_t block, mil_adc_block_t pblock, void *pctx){
+
+    uint8_t idx;
+
+    if((base != ADC0_BASE && base != ADC1_BASE) || seq_num > MIL_ADC_SEQ3){
+        return MIL_ADC_NOK;
+    }
+    if(!buf || !block || block > MIL_ADC_DMA_MAX_BLOCK){
+        return MIL_ADC_NOK;
+    }
+    idx = MIL_ADC_IDX(base, seq_num);
+
+    pdma->base = base;
+    pdma->seq_num = seq_num;
+    pdma->buf = buf;
+    pdma->block = block;
+    pdma->alt = false;
+    pdma->plast = 0;
+    pdma->pblock = pblock;
+    pdma->pctx = pctx;
+    pdma->stats.blocks = 0;
+    pdma->stats.overflows = 0;
+
+    MIL_DMAInit();
+    pdma->ch = MIL_DMAChannelAssign(DMAMap[idx]);
+
+    //both blocks armed, the ADC asks for every result on its own
+    uDMAChannelAttributeDisable(pdma->ch, UDMA_ATTR_ALL);
+    uDMAChannelAttributeEnable(pdma->ch, UDMA_ATTR_HIGH_PRIORITY);
+    MIL_ADC_DMAArm(pdma, UDMA_PRI_SELECT);
+    MIL_ADC_DMAArm(pdma, UDMA_ALT_SELECT);
+
+    pADC[idx] = pdma;
+
+    //left masked in the ADC, only finished blocks interrupt
+    ADCIntDisable(base, seq_num);
+    ADCIntClear(base, seq_num);
+    ADCSequenceOverflowClear(base, seq_num);
+    ADCIntRegister(base, seq_num, DMAISR[idx]);
+
+    uDMAChannelEnable(pdma->ch);
+    ADCSequenceDMAEnable(base, seq_num);
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: Stops streaming, the sequence itself stays set up
+ */
+void MIL_ADC_DMAStop(MIL_ADC_DMA_t *pdma){
+
+    ADCSequenceDMADisable(pdma->base, pdma->seq_num);
+    uDMAChannelDisable(pdma->ch);
+
+    pADC[MIL_ADC_IDX(pdma->base, pdma->seq_num)] = 0;
+
+}
+
+/*
+ * Desc: Newest finished block
+ *
+ * Returns: block samples, 0 if no block finished yet
+ */
+const uint16_t *MIL_ADC_DMALatest(MIL_ADC_DMA_t *pdma){
+
+    return pdma->plast;
+
+}
+
+/*
+ * Desc: Copies out the counters
+ */
+void MIL_ADC_DMAStatsGet(MIL_ADC_DMA_t *pdma, MIL_ADC_DMAStats_t *pstats){
+
+    bool int_off = IntMasterDisable();
+
+    *pstats = pdma->stats;
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+}
+
+/*
+ * Desc: Points one half of the ping-pong at its block
+ *
+ * Parameters:
+ * select - UDMA_PRI_SELECT(first block) or UDMA_ALT_SELECT(second block)
+ */
+static void MIL_ADC_DMAArm(MIL_ADC_DMA_t *pdma, uint32_t select){
+
+    uint16_t *pdst = pdma->buf + ((select == UDMA_ALT_SELECT) ? pdma->block : 0);
+
+    //the FIFO is 32 bits wide, the result sits in the low 16
+    uDMAChannelControlSet(pdma->ch | select,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+    uDMAChannelTransferSet(pdma->ch | select, UDMA_MODE_PINGPONG,
+                           (void *)MIL_ADC_FIFO(pdma->base, pdma->seq_num), pdst, pdma->block);
+
+}
+
+/*
+ * Desc: Re-arms every finished half and hands its block over
+ *
+ * Notes: Halves finish in turn, the ISR starts with the one
+ *        due first in case it was held off for a whole block
+ */
+static void MIL_ADC_DMAISR(uint8_t idx){
+
+    MIL_ADC_DMA_t *pdma = pADC[idx];
+    uint32_t select;
+    const uint16_t *pdone;
+
+    if(!pdma){
+        ADCIntClear((idx < 4) ? ADC0_BASE : ADC1_BASE, idx & 3);
+        return;
+    }
+
+    ADCIntClear(pdma->base, pdma->seq_num);
+
+    if(ADCSequenceOverflow(pdma->base, pdma->seq_num)){
+        ADCSequenceOverflowClear(pdma->base, pdma->seq_num);
+        pdma->stats.overflows++;
+    }
+
+    for(;;){
+        select = pdma->alt ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+        if(uDMAChannelModeGet(pdma->ch | select) != UDMA_MODE_STOP){
+            break;
+        }
+
+        pdone = pdma->buf + (pdma->alt ? pdma->block : 0);
+        MIL_ADC_DMAArm(pdma, select);
+        pdma->alt = !pdma->alt;
+        pdma->plast = pdone;
+        pdma->stats.blocks++;
+
+        if(pdma->pblock){
+            pdma->pblock(pdone, pdma->block, pdma->pctx);
+        }
+    }
+
+}
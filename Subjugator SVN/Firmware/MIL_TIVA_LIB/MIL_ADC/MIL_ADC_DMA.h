@@ -0,0 +1,133 @@
+/*
+ * Name: MIL_ADC_DMA.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Streams ADC sequences into RAM with the uDMA
+ *
+ * What to understand: MIL_ADCGetData waits on the ADC every time you
+ *                     want a sample, so the sample rate is stuck at
+ *                     whatever the code calling it can manage.
+ *
+ *                     Here a timer starts the sequence(MIL_ADC_TimTrig,
+ *                     MIL_ADCTimerTrigInit) and the uDMA copies every
+ *                     result out of the sequencer FIFO into a buffer you
+ *                     give it, split into two blocks(ping-pong mode).
+ *                     While one block fills the other one is yours, your
+ *                     callback runs once per finished block:
+ *
+ *                     buf: | block A(filling) | block B(yours) |
+ *                          | block A(yours)   | block B(filling) | ...
+ *
+ *                     Samples are 16 bits(the 12 bit result), one per
+ *                     sequence step in step order, scan after scan.
+ *
+ * Interrupt Note: This installs its own ISR on the sequence, do not use
+ *                 MIL_ADCIntEnable on the same sequence. A finished
+ *                 uDMA block raises the sequence's interrupt, single
+ *                 scans do not
+ *
+ * BLOCK NOTE: Make block a multiple of the steps in your sequence so
+ *             every block starts with the first step. You have one
+ *             block time(block / steps / rate) to use a block before
+ *             it is written over
+ *
+ * HOW TO USE:
+ *   static uint16_t samples[2 * 64];
+ *   static MIL_ADC_DMA_t adc_dma;
+ *
+ *   MIL_ADCPinConfig(MIL_ADC_PIN4_bm | MIL_ADC_PIN5_bm);
+ *   MIL_ADCSeqInit(ADC0_BASE, MIL_ADC_SEQ1, MIL_ADC_PIN4_bm | MIL_ADC_PIN5_bm, MIL_ADC_TimTrig);
+ *   MIL_ADC_DMAInit(&adc_dma, ADC0_BASE, MIL_ADC_SEQ1, samples, 64, &BlockDone, 0);
+ *   MIL_ADCTimerTrigInit(TIMER1_BASE, 10000);      //10k scans per second
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "MIL_ADC.h"
+
+#ifndef MIL_ADC_DMA_H_
+#define MIL_ADC_DMA_H_
+
+//most samples in one block(one uDMA transfer)
+#define MIL_ADC_DMA_MAX_BLOCK 1024
+
+/*
+ * Desc: called from the ISR with every finished block
+ *
+ * Notes: samples stays valid until the block after it finishes
+ */
+typedef void (*mil_adc_block_t)(const uint16_t *samples, uint16_t count, void *pctx);
+
+/*
+ * Desc: counters, all counters only go up
+ *
+ * blocks - blocks finished
+ * overflows - times the sequencer FIFO overflowed(samples were lost)
+ */
+typedef struct{
+
+  uint32_t blocks;
+  uint32_t overflows;
+
+}MIL_ADC_DMAStats_t;
+
+/*
+ * Desc: state of one streaming sequence(do not touch fields directly)
+ */
+typedef struct{
+
+  uint32_t base;
+  uint8_t  seq_num;
+  uint32_t ch;
+  uint16_t *buf;
+  uint16_t block;
+  volatile bool alt;                //the alternate block finishes next
+  const uint16_t *volatile plast;   //newest finished block, 0 before the first
+  mil_adc_block_t pblock;
+  void *pctx;
+
+  MIL_ADC_DMAStats_t stats;
+
+}MIL_ADC_DMA_t;
+
+/*
+ * Desc: Starts streaming a sequence into buf
+ *
+ * Notes: CALL MIL_ADCSeqInit FIRST. Sampling starts with the
+ *        sequence's trigger, usually MIL_ADCTimerTrigInit
+ *
+ * Parameters:
+ * pdma - storage you declare(one per sequence)
+ * base - ADC0_BASE or ADC1_BASE
+ * seq_num - MIL_ADC_SEQx
+ * buf - 2 * block samples
+ * block - samples per block, 1 to MIL_ADC_DMA_MAX_BLOCK
+ * pblock - called with every finished block(can be 0 to poll
+ *          with MIL_ADC_DMALatest)
+ * pctx - handed back to pblock
+ *
+ * Returns:
+ * MIL_ADC_OK if the sequence is streaming
+ * MIL_ADC_NOK if a parameter is not valid
+ */
+mil_adc_stat_t MIL_ADC_DMAInit(MIL_ADC_DMA_t *pdma, uint32_t base, uint8_t seq_num,
+                               uint16_t *buf, uint16_t block, mil_adc_block_t pblock, void *pctx);
+
+/*
+ * Desc: Stops streaming, the sequence itself stays set up
+ */
+void MIL_ADC_DMAStop(MIL_ADC_DMA_t *pdma);
+
+/*
+ * Desc: Newest finished block
+ *
+ * Returns: block samples, 0 if no block finished yet
+ */
+const uint16_t *MIL_ADC_DMALatest(MIL_ADC_DMA_t *pdma);
+
+/*
+ * Desc: Copies out the counters
+ */
+void MIL_ADC_DMAStatsGet(MIL_ADC_DMA_t *pdma, MIL_ADC_DMAStats_t *pstats);
+
+#endif /* MIL_ADC_DMA_H_ */
@@ -0,0 +1,175 @@
+/*
+ * Name: MIL_CAN_Diag.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: CAN bus load and error bookkeeping
+ *
+ * What to understand: MIL_CAN feeds this module every frame it
+ *                     receives or finishes sending and every change
+ *                     of the controller's error state. From that it
+ *                     keeps:
+ *                     - RX/TX counts per CAN ID
+ *                     - time from queuing a frame to it leaving(latency)
+ *                     - bus-off events and how long recovery took
+ *                     - bus utilisation, bits on the wire divided by
+ *                       the bits the bit rate allows in the same time
+ *
+ *                     MIL_CAN_DiagEncode packs the headline numbers
+ *                     into one 8 byte 'D' frame so every node can
+ *                     report them the same way
+ *
+ * UTILISATION NOTE: Only frames this node sees are counted, which is
+ *                   whatever passes its mailbox filters plus what it
+ *                   sends. Give a spare mailbox a filt_mask of 0 if
+ *                   you want the load of the whole bus.
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA. Times are in ticks
+ *       of the MIL_CAN time source(see MIL_CAN_SetTimeSource)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_CAN_DIAG_H_
+#define MIL_CAN_DIAG_H_
+
+//CAN IDs tracked one by one, anything past this lands in other
+#ifndef MIL_CAN_DIAG_IDS
+#define MIL_CAN_DIAG_IDS 16
+#endif
+
+//first byte of the diagnostic frame
+#define MIL_CAN_DIAG_BYTE 0x44 //ASCII: 'D'
+
+//controller state passed to MIL_CAN_DiagStatus
+#define MIL_CAN_DIAG_BOFF_bm    0x01 //bus-off
+#define MIL_CAN_DIAG_PASSIVE_bm 0x02 //error passive
+#define MIL_CAN_DIAG_WARN_bm    0x04 //an error counter passed 96
+
+/*
+ * Desc: counters for one CAN ID
+ *
+ * lat_sum/lat_max - TX latency in ticks, lat_sum / tx is the average
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint32_t rx;
+  uint32_t tx;
+  uint32_t lat_sum;
+  uint32_t lat_max;
+
+}MIL_CAN_DiagId_t;
+
+/*
+ * Desc: everything the module tracks
+ *
+ * ids/num_ids - per ID counters
+ * other - counters for IDs that did not fit(canid is unused)
+ * tec/rec - error counters from the last snapshot
+ * state - MIL_CAN_DIAG bits from the last status change
+ * boff_count - times the controller went bus-off
+ * boff_start - tick the current bus-off started
+ * recover_last/recover_max - bus-off to back on the bus in ticks
+ * util_permille - utilisation over the last snapshot window(0 to 1000)
+ * window_bits - bits counted since the last snapshot
+ * window_start - tick the window started
+ */
+typedef struct{
+
+  MIL_CAN_DiagId_t ids[MIL_CAN_DIAG_IDS];
+  uint8_t  num_ids;
+  MIL_CAN_DiagId_t other;
+
+  uint8_t  tec;
+  uint8_t  rec;
+  uint8_t  state;
+  uint32_t boff_count;
+  uint32_t boff_start;
+  uint32_t recover_last;
+  uint32_t recover_max;
+
+  uint16_t util_permille;
+  uint32_t window_bits;
+  uint32_t window_start;
+
+  uint32_t tick_hz;
+
+}MIL_CAN_Diag_t;
+
+/*
+ * Desc: clears everything
+ *
+ * Parameters:
+ * pd - your diag struct
+ * tick_hz - ticks per second of the time source
+ * now - current tick
+ */
+void MIL_CAN_DiagInit(MIL_CAN_Diag_t *pd, uint32_t tick_hz, uint32_t now);
+
+/*
+ * Desc: bits a data frame takes on the wire including
+ *       worst case bit stuffing and the 3 bit gap after it
+ *
+ * Parameters:
+ * len - data bytes(0 to 8)
+ * extended - true for 29 bit IDs
+ */
+uint32_t MIL_CAN_DiagFrameBits(uint8_t len, bool extended);
+
+/*
+ * Desc: returns the counters for a CAN ID, the
+ *       other bucket if the table is full
+ */
+MIL_CAN_DiagId_t *MIL_CAN_DiagFind(MIL_CAN_Diag_t *pd, uint32_t canid);
+
+/*
+ * Desc: records a received frame
+ */
+void MIL_CAN_DiagRx(MIL_CAN_Diag_t *pd, uint32_t canid, uint8_t len);
+
+/*
+ * Desc: records a sent frame and how long it waited
+ */
+void MIL_CAN_DiagTx(MIL_CAN_Diag_t *pd, uint32_t canid, uint8_t len, uint32_t latency);
+
+/*
+ * Desc: records a change in controller state
+ *
+ * Parameters:
+ * state - MIL_CAN_DIAG bits
+ * now - current tick
+ */
+void MIL_CAN_DiagStatus(MIL_CAN_Diag_t *pd, uint8_t state, uint32_t now);
+
+/*
+ * Desc: closes the utilisation window and stores the error counters
+ *
+ * Parameters:
+ * now - current tick
+ * bit_rate - bus bit rate
+ * tec/rec - error counters from the controller
+ */
+void MIL_CAN_DiagSnapshot(MIL_CAN_Diag_t *pd, uint32_t now, uint32_t bit_rate,
+                          uint8_t tec, uint8_t rec);
+
+/*
+ * Desc: packs the last snapshot into a diagnostic frame
+ *
+ *  BYTE | MEANING
+ *  0    | 'D'
+ *  1    | TEC
+ *  2    | REC
+ *  3    | MIL_CAN_DIAG state bits
+ *  4    | bus-off count(stops at 255)
+ *  5    | utilisation in 0.5% steps(200 = 100%)
+ *  6    | worst bus-off recovery in ms(stops at 255)
+ *  7    | worst TX latency of any ID in ms(stops at 255)
+ *
+ * Parameters:
+ * data - 8 byte buffer
+ */
+void MIL_CAN_DiagEncode(MIL_CAN_Diag_t *pd, uint8_t *data);
+
+#endif /* MIL_CAN_DIAG_H_ */
@@ -0,0 +1,161 @@
+/*
+ * Name: MIL_CAN_Ring.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Fixed size single producer/single consumer
+ *       frame ring used by the MIL_CAN receive ISR
+ *
+ * What to understand: The CAN ISR is the only code that
+ *                     ever writes head and the main loop is
+ *                     the only code that ever writes tail.
+ *                     Because each index only has one writer
+ *                     no interrupt masking is needed on either
+ *                     side.
+ *
+ *                     Indexes are free running and wrap on their
+ *                     own, the slot is index & (MIL_CAN_RING_SIZE - 1)
+ *                     which is why the size has to be a power of 2
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_CAN_RING_H_
+#define MIL_CAN_RING_H_
+
+//number of frames a ring can hold(MUST BE A POWER OF 2)
+#ifndef MIL_CAN_RING_SIZE
+#define MIL_CAN_RING_SIZE 32
+#endif
+
+//frame flags
+#define MIL_CAN_FRAME_LOST_bm 0x01 //hardware overwrote a frame on this object before this one
+
+/*
+ * Desc: compiler/memory barrier so frame data is
+ *       written before the index that publishes it
+ */
+#if defined(__GNUC__)
+#define MIL_CAN_RING_BARRIER() __asm__ volatile("" ::: "memory")
+#else
+#define MIL_CAN_RING_BARRIER() __asm("    dmb\n")
+#endif
+
+/*
+ * Desc: index of the lowest set bit of a message object
+ *       mask(x must not be 0), so object = MIL_CAN_CTZ(mask) + 1
+ *
+ * Notes: GCC turns this into RBIT + CLZ on the M4, other
+ *        compilers get a de Bruijn lookup(one multiply)
+ */
+#if defined(__GNUC__)
+#define MIL_CAN_CTZ(x) ((uint8_t)__builtin_ctz(x))
+#else
+static inline uint8_t MIL_CAN_CTZ(uint32_t x){
+
+    static const uint8_t debruijn[32] = {
+        0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+        31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+    };
+
+    return debruijn[(uint32_t)((x & (0 - x)) * 0x077CB531U) >> 27];
+
+}
+#endif
+
+/*
+ * Desc: one received CAN frame
+ *
+ * PARAMETERS:
+ * canid - ID the frame was received with
+ * timestamp - value of the MIL_CAN time source when the ISR read it
+ * len - number of valid bytes in data(0 to 8)
+ * obj_num - message object(1 to 32) the frame arrived in
+ * flags - see MIL_CAN_FRAME defines
+ * data - frame payload
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint32_t timestamp;
+  uint8_t  len;
+  uint8_t  obj_num;
+  uint8_t  flags;
+  uint8_t  data[8];
+
+}MIL_CAN_Frame_t;
+
+/*
+ * Desc: the ring itself, declare one of these
+ *       per CAN controller and hand it to
+ *       MIL_CAN_RxRingEnable
+ *
+ * dropped - frames thrown away because the ring was full
+ */
+typedef struct{
+
+  volatile uint32_t head;        //written by producer(ISR) only
+  volatile uint32_t tail;        //written by consumer only
+  volatile uint32_t dropped;     //written by producer only
+  MIL_CAN_Frame_t frames[MIL_CAN_RING_SIZE];
+
+}MIL_CAN_Ring_t;
+
+/*
+ * Desc: empties the ring and clears the drop counter
+ *
+ * Note: only call this while the producer is stopped
+ */
+void MIL_CAN_RingInit(MIL_CAN_Ring_t *pring);
+
+/*
+ * Desc: PRODUCER SIDE. Returns the next free slot for the
+ *       producer to fill in place or 0 if the ring is full.
+ *       A full ring counts the frame as dropped.
+ *
+ *       The slot is not visible to the consumer until
+ *       MIL_CAN_RingCommit is called
+ */
+MIL_CAN_Frame_t *MIL_CAN_RingClaim(MIL_CAN_Ring_t *pring);
+
+/*
+ * Desc: PRODUCER SIDE. Publishes the slot returned by
+ *       the last MIL_CAN_RingClaim
+ */
+void MIL_CAN_RingCommit(MIL_CAN_Ring_t *pring);
+
+/*
+ * Desc: PRODUCER SIDE. Copies a whole frame into the ring
+ *
+ * Returns: true if the frame was stored, false if it was dropped
+ */
+bool MIL_CAN_RingPush(MIL_CAN_Ring_t *pring, const MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: CONSUMER SIDE. Returns the oldest frame without
+ *       removing it or 0 if the ring is empty
+ */
+MIL_CAN_Frame_t *MIL_CAN_RingPeek(MIL_CAN_Ring_t *pring);
+
+/*
+ * Desc: CONSUMER SIDE. Removes the oldest frame
+ *       (the one MIL_CAN_RingPeek returned)
+ */
+void MIL_CAN_RingDrop(MIL_CAN_Ring_t *pring);
+
+/*
+ * Desc: CONSUMER SIDE. Copies the oldest frame out and removes it
+ *
+ * Returns: true if there was a frame, false if the ring was empty
+ */
+bool MIL_CAN_RingPop(MIL_CAN_Ring_t *pring, MIL_CAN_Frame_t *pframe);
+
+/*
+ * Desc: number of frames waiting in the ring
+ */
+uint32_t MIL_CAN_RingCount(MIL_CAN_Ring_t *pring);
+
+#endif /* MIL_CAN_RING_H_ */
@@ -0,0 +1,95 @@
+/*
+ * Name: MIL_CAN_SocketCAN.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Linux SocketCAN backend for the MIL_CAN API
+ *
+ * What to understand: Building with MIL_CAN_SOCKETCAN defined swaps
+ *                     MIL_CAN.c for MIL_CAN_SocketCAN.c. Every MIL_CAN
+ *                     function keeps its name and behaviour but sends
+ *                     and receives on a Linux CAN interface(a real
+ *                     adapter or a vcan) instead of the TIVA controller,
+ *                     so board code can run on a PC and talk to
+ *                     candump/cangen or to other boards running on the
+ *                     same machine.
+ *
+ *                     The 32 message objects of each controller are
+ *                     emulated in software with the same filter, FIFO
+ *                     and overwrite rules as the hardware.
+ *
+ * INTERRUPT NOTE: There are no CAN interrupts on a PC. Whatever the MIL
+ *                 CAN ISR would do(fill the ring, run ISR handlers,
+ *                 refill the TX queue) happens inside the MIL_CAN calls
+ *                 that look for mail: MIL_CAN_GetMail, MIL_CAN_CheckMail,
+ *                 MIL_CAN_ReadFrame, MIL_CAN_DispatchPoll and
+ *                 MIL_CAN_DiagService. ISR handlers therefore run from
+ *                 your main loop. MIL_CANIntEnable does nothing.
+ *
+ * BIT RATE NOTE: The bit rate of a real adapter is set with
+ *                ip link set can0 type can bitrate 250000
+ *                the rate passed to MIL_InitCANRate is only remembered
+ *                for MIL_CAN_GetBitRate and the bus load telemetry
+ *
+ * HOW TO USE:
+ *   sudo modprobe vcan
+ *   sudo ip link add dev vcan0 type vcan
+ *   sudo ip link set up vcan0
+ *   gcc -DMIL_CAN_SOCKETCAN -I. your_app.c MIL_CAN*.c -o your_app
+ *   candump vcan0
+ *
+ *   CAN0_BASE and CAN1_BASE both use vcan0 unless MIL_CAN_SocketCANBind
+ *   or the MIL_CAN0_IF/MIL_CAN1_IF environment variables pick another
+ *   interface. Time stamps and latency stay 0 until
+ *   MIL_CAN_SetTimeSource is given a clock(clock_gettime works)
+ *
+ * Note: Only built with MIL_CAN_SOCKETCAN defined, the TIVA build
+ *       compiles MIL_CAN_SocketCAN.c to nothing
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_CAN_SOCKETCAN_H_
+#define MIL_CAN_SOCKETCAN_H_
+
+//interface used when nothing else was picked
+#ifndef MIL_CAN_SOCKETCAN_IF
+#define MIL_CAN_SOCKETCAN_IF "vcan0"
+#endif
+
+//controller bases, same values as inc/hw_memmap.h
+#ifndef CAN0_BASE
+#define CAN0_BASE 0x40040000
+#endif
+#ifndef CAN1_BASE
+#define CAN1_BASE 0x40041000
+#endif
+
+/*
+ * Desc: stand in for the TivaWare message object(driverlib/can.h)
+ *       so MIL_CAN_MailBox_t keeps the same layout on a PC
+ */
+#ifndef __DRIVERLIB_CAN_H__
+typedef struct{
+
+  uint32_t ui32MsgID;
+  uint32_t ui32MsgIDMask;
+  uint32_t ui32Flags;
+  uint32_t ui32MsgLen;
+  uint8_t *pui8MsgData;
+
+}tCANMsgObject;
+#endif
+
+/*
+ * Desc: Picks the Linux interface a controller uses
+ *
+ * Notes: CALL THIS BEFORE MIL_InitCAN, the interface is opened there
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * ifname - interface name, for example "vcan0" or "can1"(kept, not copied)
+ */
+void MIL_CAN_SocketCANBind(uint32_t base, const char *ifname);
+
+#endif /* MIL_CAN_SOCKETCAN_H_ */
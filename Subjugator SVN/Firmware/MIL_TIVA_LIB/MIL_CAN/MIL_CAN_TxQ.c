@@ -0,0 +1,249 @@
+/*
+ * Name: MIL_CAN_TxQ.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Bookkeeping for the MIL_CAN transmit queue
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA. It does no locking,
+ *       MIL_CAN.c calls it with interrupts disabled.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_CAN_TxQ.h"
+
+//no parked frame can go
+#define MIL_CAN_TXQ_NONE 0xFF
+
+/*
+ * Desc: counts busy objects for the high water mark
+ */
+static uint8_t MIL_CAN_TxQBusyCount(uint32_t busy){
+
+    uint8_t count = 0;
+
+    while(busy){
+        busy &= busy - 1; //clear lowest set bit
+        count++;
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: true if a bank object already holds a frame with this ID
+ */
+static bool MIL_CAN_TxQIdInflight(MIL_CAN_TxQ_t *pq, uint32_t canid){
+
+    for(uint8_t i = 0;i < pq->num_obj;i++){
+        if((pq->busy & (0x01UL << i)) && pq->inflight[i].canid == canid){
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+/*
+ * Desc: true if a frame with this ID is parked
+ */
+static bool MIL_CAN_TxQIdParked(MIL_CAN_TxQ_t *pq, uint32_t canid){
+
+    for(uint8_t i = 0;i < pq->ovf_count;i++){
+        if(pq->ovf[(pq->ovf_head + i) % MIL_CAN_TXQ_OVF_SIZE].canid == canid){
+            return true;
+        }
+    }
+
+    return false;
+
+}
+
+/*
+ * Desc: index(0 based from ovf_head) of the parked frame that
+ *       should go next, lowest ID wins and the oldest wins a tie.
+ *       IDs still in hardware are skipped
+ *
+ * Returns: MIL_CAN_TXQ_NONE if every parked ID is in hardware
+ */
+static uint8_t MIL_CAN_TxQBestParked(MIL_CAN_TxQ_t *pq){
+
+    uint8_t best = MIL_CAN_TXQ_NONE;
+    uint32_t best_id = 0;
+
+    for(uint8_t i = 0;i < pq->ovf_count;i++){
+
+        uint32_t id = pq->ovf[(pq->ovf_head + i) % MIL_CAN_TXQ_OVF_SIZE].canid;
+
+        //strictly lower so equal IDs keep arrival order
+        if((best == MIL_CAN_TXQ_NONE || id < best_id) && !MIL_CAN_TxQIdInflight(pq, id)){
+            best = i;
+            best_id = id;
+        }
+    }
+
+    return best;
+
+}
+
+/*
+ * Desc: takes entry n(0 based from ovf_head) out of the overflow
+ *       ring, the older entries in front of it slide back one slot
+ */
+static void MIL_CAN_TxQUnpark(MIL_CAN_TxQ_t *pq, uint8_t n, MIL_CAN_TxFrame_t *pout){
+
+    uint8_t slot = (pq->ovf_head + n) % MIL_CAN_TXQ_OVF_SIZE;
+
+    *pout = pq->ovf[slot];
+
+    while(n){
+        uint8_t prev = (pq->ovf_head + n - 1) % MIL_CAN_TXQ_OVF_SIZE;
+        pq->ovf[slot] = pq->ovf[prev];
+        slot = prev;
+        n--;
+    }
+
+    pq->ovf_head = (pq->ovf_head + 1) % MIL_CAN_TXQ_OVF_SIZE;
+    pq->ovf_count--;
+
+}
+
+/*
+ * Desc: sets up an empty queue
+ */
+void MIL_CAN_TxQInit(MIL_CAN_TxQ_t *pq, uint8_t first_obj, uint8_t num_obj){
+
+    if(first_obj < 1){
+        first_obj = 1;
+    }
+    if(first_obj > 32){
+        first_obj = 32;
+    }
+    if(num_obj > MIL_CAN_TXQ_MAX_BANK){
+        num_obj = MIL_CAN_TXQ_MAX_BANK;
+    }
+    if(num_obj > (33 - first_obj)){
+        num_obj = 33 - first_obj;
+    }
+
+    pq->first_obj = first_obj;
+    pq->num_obj = num_obj;
+    pq->busy = 0;
+    pq->ovf_head = 0;
+    pq->ovf_count = 0;
+
+    pq->stats.sent = 0;
+    pq->stats.parked = 0;
+    pq->stats.dropped = 0;
+    pq->stats.hw_high_water = 0;
+    pq->stats.ovf_high_water = 0;
+
+}
+
+/*
+ * Desc: hands a frame to the queue
+ */
+mil_can_txq_res_t MIL_CAN_TxQSubmit(MIL_CAN_TxQ_t *pq,
+                                    const MIL_CAN_TxFrame_t *pframe,
+                                    uint8_t *pobj){
+
+    /*
+     * Only one frame per ID in hardware and parked frames with the
+     * same ID go first, otherwise a new frame could overtake an
+     * older one with the same ID
+     */
+    if(!MIL_CAN_TxQIdInflight(pq, pframe->canid) && !MIL_CAN_TxQIdParked(pq, pframe->canid)){
+
+        for(uint8_t i = 0;i < pq->num_obj;i++){
+
+            if(!(pq->busy & (0x01UL << i))){
+
+                pq->busy |= (0x01UL << i);
+                pq->inflight[i] = *pframe;
+
+                uint8_t busy_cnt = MIL_CAN_TxQBusyCount(pq->busy);
+                if(busy_cnt > pq->stats.hw_high_water){
+                    pq->stats.hw_high_water = busy_cnt;
+                }
+
+                *pobj = pq->first_obj + i;
+                return MIL_CAN_TXQ_LOAD;
+            }
+        }
+    }
+
+    if(pq->ovf_count >= MIL_CAN_TXQ_OVF_SIZE){
+        pq->stats.dropped++;
+        return MIL_CAN_TXQ_FULL;
+    }
+
+    pq->ovf[(pq->ovf_head + pq->ovf_count) % MIL_CAN_TXQ_OVF_SIZE] = *pframe;
+    pq->ovf_count++;
+    pq->stats.parked++;
+
+    if(pq->ovf_count > pq->stats.ovf_high_water){
+        pq->stats.ovf_high_water = pq->ovf_count;
+    }
+
+    return MIL_CAN_TXQ_PARKED;
+
+}
+
+/*
+ * Desc: returns the frame currently held by a bank object
+ */
+MIL_CAN_TxFrame_t *MIL_CAN_TxQInflight(MIL_CAN_TxQ_t *pq, uint8_t obj){
+
+    uint8_t i = obj - pq->first_obj;
+
+    if((obj < pq->first_obj) || (i >= pq->num_obj) || !(pq->busy & (0x01UL << i))){
+        return 0;
+    }
+
+    return &pq->inflight[i];
+
+}
+
+/*
+ * Desc: marks a bank object as sent and refills it from
+ *       the overflow ring
+ */
+bool MIL_CAN_TxQComplete(MIL_CAN_TxQ_t *pq, uint8_t obj, MIL_CAN_TxFrame_t *pdone){
+
+    uint8_t i = obj - pq->first_obj;
+    uint8_t best;
+
+    if((obj < pq->first_obj) || (i >= pq->num_obj) || !(pq->busy & (0x01UL << i))){
+        return false;
+    }
+
+    *pdone = pq->inflight[i];
+    pq->stats.sent++;
+
+    //free first so parked frames with the finished frame's ID may go
+    pq->busy &= ~(0x01UL << i);
+
+    best = MIL_CAN_TxQBestParked(pq);
+    if(best == MIL_CAN_TXQ_NONE){
+        return false;
+    }
+
+    //object goes straight back out with the next frame
+    MIL_CAN_TxQUnpark(pq, best, &pq->inflight[i]);
+    pq->busy |= (0x01UL << i);
+
+    return true;
+
+}
+
+/*
+ * Desc: busy objects as a NEWDAT/TXRQST style mask
+ */
+uint32_t MIL_CAN_TxQBusyMask(MIL_CAN_TxQ_t *pq){
+
+    return pq->busy << (pq->first_obj - 1);
+
+}
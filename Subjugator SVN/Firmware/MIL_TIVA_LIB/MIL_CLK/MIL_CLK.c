@@ -25,6 +25,9 @@
 
 #include "MIL_CLK.h"
 
+//what MIL_ClkGetHz reports, 0 until known
+static uint32_t ClkHz;
+
 /*
  * Name: MIL_ClkSetInt_16MHz
  * Desc: configures the systems clock to
@@ -33,14 +36,75 @@
  */
 void MIL_ClkSetInt_16MHz(void){
 
+    MIL_ClkSetProfile(MIL_CLK_INT_16MHz);
+
+}
+
+/*
+ * Name: MIL_ClkSetPLL_80MHz
+ * Desc: configures the systems clock to
+ *       run the crystal through the PLL at 80 MHz
+ */
+void MIL_ClkSetPLL_80MHz(void){
+
+    MIL_ClkSetProfile(MIL_CLK_PLL_80MHz);
+
+}
+
+/*
+ * Name: MIL_ClkSetProfile
+ * Desc: configures the systems clock to one of
+ *       the profiles in mil_clk_profile_t
+ */
+void MIL_ClkSetProfile(mil_clk_profile_t profile){
+
     /*
-     * use 16MHz internal oscillator(see page 487 of TivaWare manu)
-     * use the oscillator directly( as opposed to the PLL clock div circuit)
-     * desired frequency is 16 MHz
+     * SysCtlClockSet(see the TivaWare manual) picks the source, whether
+     * the PLL is used and the divider. The PLL runs at 400MHz and is
+     * halved before the divider, so SYSDIV_2_5 gives 200/2.5 = 80MHz
      */
-    SysCtlClockFreqSet(SYSCTL_OSC_INT |
-                       SYSCTL_USE_OSC,
-                       MIL_16MHz);
+    switch(profile){
+        case MIL_CLK_XTAL_16MHz:
+            SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_MAIN | MIL_CLK_XTAL);
+            ClkHz = MIL_CLK_XTAL_HZ;
+            break;
+        case MIL_CLK_PLL_40MHz:
+            SysCtlClockSet(SYSCTL_SYSDIV_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | MIL_CLK_XTAL);
+            ClkHz = 40000000;
+            break;
+        case MIL_CLK_PLL_50MHz:
+            SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | MIL_CLK_XTAL);
+            ClkHz = 50000000;
+            break;
+        case MIL_CLK_PLL_66MHz:
+            SysCtlClockSet(SYSCTL_SYSDIV_3 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | MIL_CLK_XTAL);
+            ClkHz = 66666666;
+            break;
+        case MIL_CLK_PLL_80MHz:
+            SysCtlClockSet(SYSCTL_SYSDIV_2_5 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | MIL_CLK_XTAL);
+            ClkHz = MIL_80MHz;
+            break;
+        case MIL_CLK_INT_16MHz:
+        default:
+            //use the 16MHz internal oscillator directly(as opposed to the PLL clock div circuit)
+            SysCtlClockSet(SYSCTL_SYSDIV_1 | SYSCTL_USE_OSC | SYSCTL_OSC_INT);
+            ClkHz = MIL_16MHz;
+            break;
+    }
 
 }
 
+/*
+ * Name: MIL_ClkGetHz
+ * Desc: system clock in Hz
+ */
+uint32_t MIL_ClkGetHz(void){
+
+    //never set through MIL_CLK, ask the hardware once
+    if(!ClkHz){
+        ClkHz = SysCtlClockGet();
+    }
+
+    return ClkHz;
+
+}
@@ -0,0 +1,61 @@
+/*
+ * Name: MIL_DMA.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Shared set up for the TIVA uDMA controller
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+
+#include"MIL_DMA.h"
+
+//primary and alternate structures for all 32 channels
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(MIL_DMAControlTable, 1024)
+static tDMAControlTable MIL_DMAControlTable[64];
+#else
+static tDMAControlTable MIL_DMAControlTable[64] __attribute__((aligned(1024)));
+#endif
+
+static bool DMAReady;
+
+/*
+ * Desc: Turns on the uDMA controller and sets the control
+ *       table, safe to call as many times as you like
+ */
+void MIL_DMAInit(void){
+
+    if(DMAReady){
+        return;
+    }
+
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while(!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA));
+
+    uDMAEnable();
+
+    //keep a table the project set up itself
+    if(!uDMAControlBaseGet()){
+        uDMAControlBaseSet(MIL_DMAControlTable);
+    }
+
+    DMAReady = true;
+
+}
+
+/*
+ * Desc: Points a channel at the peripheral it serves
+ *
+ * Returns: the channel number to use with the other uDMA functions
+ */
+uint32_t MIL_DMAChannelAssign(uint32_t mapping){
+
+    uDMAChannelAssign(mapping);
+
+    return mapping & 0xFF;
+
+}
@@ -0,0 +1,45 @@
+/*
+ * Name: MIL_DMA.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Shared set up for the TIVA uDMA controller
+ *
+ * What to understand: The uDMA moves data between peripherals and RAM
+ *                     without the CPU. Every channel keeps its settings
+ *                     in one control table in RAM that must be 1024 byte
+ *                     aligned, and the whole chip can only have one.
+ *
+ *                     MIL_DMA owns that table so every MIL module that
+ *                     uses the uDMA(MIL_UART_DMA, MIL_ADC...) shares it.
+ *                     Modules call MIL_DMAInit themselves, you only need
+ *                     it if your own code uses a uDMA channel too.
+ *
+ * TABLE NOTE: If your project already declares its own control table,
+ *             set it with uDMAControlBaseSet BEFORE any MIL module starts
+ *             and MIL_DMAInit will leave it alone
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/udma.h"
+
+#ifndef MIL_DMA_H_
+#define MIL_DMA_H_
+
+/*
+ * Desc: Turns on the uDMA controller and sets the control
+ *       table, safe to call as many times as you like
+ */
+void MIL_DMAInit(void);
+
+/*
+ * Desc: Points a channel at the peripheral it serves
+ *
+ * Parameters:
+ * mapping - a UDMA_CHx_ define from driverlib/udma.h(for example UDMA_CH16_UART3RX)
+ *
+ * Returns: the channel number to use with the other uDMA functions
+ */
+uint32_t MIL_DMAChannelAssign(uint32_t mapping);
+
+#endif /* MIL_DMA_H_ */
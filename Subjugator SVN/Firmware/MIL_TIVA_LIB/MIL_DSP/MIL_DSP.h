@@ -0,0 +1,242 @@
+/*
+ * Name: MIL_DSP.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Fixed point filters for sampled sensor streams
+ *
+ * What to understand: Boards have been filtering by summing whole
+ *                     buffers every pass or by accumulating floats.
+ *                     These filters keep their state between calls
+ *                     and work through a block of samples at a time,
+ *                     straight out of a MIL_ADC_DMA block.
+ *
+ *                     Q15 - int16_t, -1.0 to 0.99997(value / 32768)
+ *                     Q31 - int32_t, -1.0 to 1.0(value / 2^31)
+ *
+ *                     MIL_DSP_FromADC picks one channel out of a DMA
+ *                     block and scales its 12 bit results to Q15.
+ *
+ *                     FILTER                | USE
+ *                     moving average(MAvg)  | plain smoothing, N samples
+ *                     exponential(Ema)      | smoothing with one word of state
+ *                     biquad                | any 2nd order low/high/band pass
+ *                     CIC                   | decimating a fast stream
+ *
+ * SIMD Note: On the TIVA(Cortex-M4) the Q15 loops use the DSP
+ *            instructions SMLAD(two multiply-adds at once) and QADD16
+ *            (two saturating adds at once). Everywhere else plain C
+ *            does the same maths, bit for bit, so results checked on
+ *            a PC hold on the TIVA
+ *
+ * Note: This file only depends on stdint/stdbool so it can be
+ *       built on a PC as well as the TIVA
+ *
+ * HOW TO USE:
+ *   static int16_t cell[64];
+ *   static int16_t smooth[64];
+ *   static int16_t hist[16];
+ *   static MIL_DSP_MAvgQ15_t avg;
+ *
+ *   MIL_DSP_MAvgQ15Init(&avg, hist, 16);
+ *
+ *   //in the MIL_ADC_DMA block callback, channel 2 of a 4 step sequence
+ *   MIL_DSP_FromADC(samples + 2, 4, cell, count / 4);
+ *   MIL_DSP_MAvgQ15(&avg, cell, smooth, count / 4);
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_DSP_H_
+#define MIL_DSP_H_
+
+//most stages in one CIC decimator
+#define MIL_DSP_CIC_MAX_ORDER 4
+
+/*
+ * Desc: moving average of the last len samples(do not touch fields directly)
+ */
+typedef struct{
+
+  int16_t *hist;
+  uint16_t mask;
+  uint16_t pos;
+  uint8_t  shift;
+  int32_t  sum;
+
+}MIL_DSP_MAvgQ15_t;
+
+typedef struct{
+
+  int32_t *hist;
+  uint16_t mask;
+  uint16_t pos;
+  uint8_t  shift;
+  int64_t  sum;
+
+}MIL_DSP_MAvgQ31_t;
+
+/*
+ * Desc: exponential average y += (x - y) / 2^k(do not touch fields directly)
+ *
+ * Notes: The Q15 filter keeps y in Q31 so small steps are not lost
+ */
+typedef struct{
+
+  int32_t y;
+  uint8_t k;
+
+}MIL_DSP_EmaQ15_t;
+
+typedef struct{
+
+  int32_t y;
+  uint8_t k;
+
+}MIL_DSP_EmaQ31_t;
+
+/*
+ * Desc: one biquad stage
+ *
+ *       y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2]
+ *
+ * COEFFICIENT NOTE: Coefficients are Q14 for the Q15 filter and Q30 for
+ *                   the Q31 filter(1.0 is 16384 / 2^30) so values up to
+ *                   +-2 fit. a1 and a2 are the NEGATED denominator of
+ *                   the usual design tools(scipy/MATLAB give a1 = -1.8,
+ *                   use +1.8 here). Chain stages for higher orders
+ */
+typedef struct{
+
+  uint32_t b0b1;            //packed for SMLAD
+  uint32_t b2a1;
+  int16_t  a2;
+  int16_t  x1, x2, y1, y2;
+
+}MIL_DSP_BiquadQ15_t;
+
+typedef struct{
+
+  int32_t b0, b1, b2, a1, a2;
+  int32_t x1, x2, y1, y2;
+
+}MIL_DSP_BiquadQ31_t;
+
+/*
+ * Desc: CIC(cascaded integrator comb) decimator(do not touch fields directly)
+ *
+ * Notes: Averages and decimates without a single multiply. The
+ *        registers wrap on purpose, the comb stages undo it
+ */
+typedef struct{
+
+  uint32_t integ[MIL_DSP_CIC_MAX_ORDER];
+  uint32_t comb[MIL_DSP_CIC_MAX_ORDER];
+  uint8_t  order;
+  uint8_t  shift;
+  uint16_t rate;
+  uint16_t phase;
+
+}MIL_DSP_CicQ15_t;
+
+/*
+ * Desc: Takes one channel out of a MIL_ADC_DMA block as Q15
+ *
+ * Parameters:
+ * raw - first result of the channel in the block
+ * stride - steps in the sequence
+ * out/count - count Q15 samples(0x000 is 0, 0xFFF is 0.99976)
+ */
+void MIL_DSP_FromADC(const uint16_t *raw, uint8_t stride, int16_t *out, uint16_t count);
+
+/*
+ * Desc: Mean of a block
+ */
+int16_t MIL_DSP_MeanQ15(const int16_t *in, uint16_t count);
+
+/*
+ * Desc: out = a + b, saturated to Q15
+ */
+void MIL_DSP_AddQ15(const int16_t *a, const int16_t *b, int16_t *out, uint16_t count);
+
+/*
+ * Desc: Sets up a moving average
+ *
+ * Parameters:
+ * pf - your filter
+ * hist - len words of history you declare
+ * len - samples averaged, a power of 2 from 1 to 32768
+ * start - value the history starts full of(avoids a ramp at start up)
+ *
+ * Returns: false if len is not valid
+ */
+bool MIL_DSP_MAvgQ15Init(MIL_DSP_MAvgQ15_t *pf, int16_t *hist, uint16_t len, int16_t start);
+bool MIL_DSP_MAvgQ31Init(MIL_DSP_MAvgQ31_t *pf, int32_t *hist, uint16_t len, int32_t start);
+
+/*
+ * Desc: Filters a block, in and out can be the same buffer
+ */
+void MIL_DSP_MAvgQ15(MIL_DSP_MAvgQ15_t *pf, const int16_t *in, int16_t *out, uint16_t count);
+void MIL_DSP_MAvgQ31(MIL_DSP_MAvgQ31_t *pf, const int32_t *in, int32_t *out, uint16_t count);
+
+/*
+ * Desc: Sets up an exponential average
+ *
+ * Parameters:
+ * pf - your filter
+ * k - 1 to 15, the filter follows about 1/2^k of every step per sample
+ * start - first output
+ */
+void MIL_DSP_EmaQ15Init(MIL_DSP_EmaQ15_t *pf, uint8_t k, int16_t start);
+void MIL_DSP_EmaQ31Init(MIL_DSP_EmaQ31_t *pf, uint8_t k, int32_t start);
+
+/*
+ * Desc: Filters a block, in and out can be the same buffer
+ */
+void MIL_DSP_EmaQ15(MIL_DSP_EmaQ15_t *pf, const int16_t *in, int16_t *out, uint16_t count);
+void MIL_DSP_EmaQ31(MIL_DSP_EmaQ31_t *pf, const int32_t *in, int32_t *out, uint16_t count);
+
+/*
+ * Desc: Sets up a biquad stage with cleared history
+ *
+ * Parameters: see COEFFICIENT NOTE
+ */
+void MIL_DSP_BiquadQ15Init(MIL_DSP_BiquadQ15_t *pf, int16_t b0, int16_t b1, int16_t b2,
+                           int16_t a1, int16_t a2);
+void MIL_DSP_BiquadQ31Init(MIL_DSP_BiquadQ31_t *pf, int32_t b0, int32_t b1, int32_t b2,
+                           int32_t a1, int32_t a2);
+
+/*
+ * Desc: Filters a block, in and out can be the same buffer
+ *
+ * Notes: The output saturates, the sum inside wraps like the
+ *        SMLAD it runs on, keep the gain of the stage below 1
+ */
+void MIL_DSP_BiquadQ15(MIL_DSP_BiquadQ15_t *pf, const int16_t *in, int16_t *out, uint16_t count);
+void MIL_DSP_BiquadQ31(MIL_DSP_BiquadQ31_t *pf, const int32_t *in, int32_t *out, uint16_t count);
+
+/*
+ * Desc: Sets up a CIC decimator
+ *
+ * Parameters:
+ * pf - your filter
+ * order - stages, 1 to MIL_DSP_CIC_MAX_ORDER
+ * rate - one output every rate inputs, a power of 2 from 2 up
+ *        with order * log2(rate) at most 16
+ *
+ * Returns: false if order or rate is not valid
+ */
+bool MIL_DSP_CicQ15Init(MIL_DSP_CicQ15_t *pf, uint8_t order, uint16_t rate);
+
+/*
+ * Desc: Decimates a block
+ *
+ * Parameters:
+ * in/count - input samples
+ * out - room for count / rate + 1 outputs
+ *
+ * Returns: number of outputs written
+ */
+uint16_t MIL_DSP_CicQ15(MIL_DSP_CicQ15_t *pf, const int16_t *in, int16_t *out, uint16_t count);
+
+#endif /* MIL_DSP_H_ */
@@ -34,7 +34,7 @@
 /*
  * WHAT YOU NEED TO UNDERSTAND WITHOUT READING THE ADC SECTION:
  * Refer to pages 800-801 of the TM4C123GH6PM manual
- * for tables to descibe sequences
+ * for tables to describe sequences
  *
  * the Tiva has two possible ADC modules(ADC0 and ADC1)
  * Within these modules, you have multiple sequencers
@@ -75,12 +75,12 @@
  *
  * TIVA ADC Notes:
  * The TM4C123G has 12 possible ADC input pins
- * The ports are verying
+ * The ports are varying
  * Please refer to table 23-3 for enumeration of pins
  *
  * Define Notes: On the right of each define
  *               I've indicated it's Pin name
- *               and the port and pin it's assoicated
+ *               and the port and pin it's associated
  *               with. These are based on the TIVA
  *               semantics
  */
@@ -119,9 +119,9 @@
 
 /*
  * Refer to pages 800-801 of the TM4C123GH6PM manual
- * for tables to descibe sequences
+ * for tables to describe sequences
  *
- * From an abstract perspect, each ADC module(ADC0 and ADC1)
+ * From an abstract perspective, each ADC module(ADC0 and ADC1)
  * have 4 sequencers attached to them. The sequencers are
  * what actually d
  *
@@ -203,10 +203,10 @@ void MIL_ADCPinConfig(uint16_t bitfield);
  *                If you input more pins than are available to that sequence
  *                the function will disregard those pins
  *
- *                Sequence 0 - 1 step/channel
+ *                Sequence 0 - 8 step/channel
  *                Sequence 1 - 4 steps/channels
  *                Sequence 2 - 4 steps/channels
- *                Sequence 3 - 8 steps/channels
+ *                Sequence 3 - 1 steps/channels
  *
  * Interrupts Note: This function will always configure the
  *              ADC to set it's ISR flag without enabling the
@@ -269,6 +269,203 @@ void MIL_ADCIntEnable(void (*isr_ptr)(void),
                       uint32_t base,
                       uint8_t seq_num);
 
+/*
+ * Desc: Sets up a timer to trigger every sequence you
+ *       initialized with MIL_ADC_TimTrig
+ *
+ * Note: The timer runs as one 32 bit periodic timer(timer A)
+ *       and starts sampling right away. Every sequence on
+ *       MIL_ADC_TimTrig, on both ADCs, fires together
+ *
+ *       Pair it with MIL_ADC_DMAInit(MIL_ADC_DMA.h) and the
+ *       samples reach RAM with no CPU work at all
+ *
+ * Parameters:
+ *  timer_base - TIMER0_BASE to TIMER5_BASE
+ *  rate_hz - sequences per second
+ *
+ * Returns:
+ *  MIL_ADC_OK if the timer is running
+ *  MIL_ADC_NOK if timer_base is not valid or rate_hz is 0 or
+ *              faster than the system clock
+ */
+mil_adc_stat_t MIL_ADCTimerTrigInit(uint32_t timer_base,
+                                    uint32_t rate_hz);
+
+/*
+ * Desc: Turns on hardware averaging for a whole ADC module
+ *
+ * Note: The ADC takes factor conversions per sequence step and
+ *       hands back their average, still 12 bits. That costs no CPU
+ *       time but divides the fastest sample rate by factor, and it
+ *       applies to every sequence of that module
+ *
+ *       Convert the results with MIL_ADC_Cal.h for millivolts
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  factor - 0(off), 2, 4, 8, 16, 32 or 64
+ *
+ * Returns:
+ *  MIL_ADC_OK if averaging is set
+ *  MIL_ADC_NOK if base or factor is not valid
+ */
+mil_adc_stat_t MIL_ADCOversample(uint32_t base,
+                                 uint8_t factor);
+
+/*
+ * Desc: A set of channels sampled together(see MIL_ADCScanInit),
+ *       do not touch fields directly
+ */
+typedef struct{
+
+    uint32_t base;
+    uint8_t  count;             //channels in the scan
+    uint8_t  channel[12];       //channel of every step, SS0 steps first
+    uint8_t  seq_steps[4];      //steps used in each sequencer
+    uint8_t  seq_bm;            //sequencers used
+    uint8_t  last_seq;          //sequencer that finishes last
+
+}MIL_ADC_Scan_t;
+
+/*
+ * Desc: Spreads a set of channels over the sequencers of one ADC
+ *       so one trigger samples all of them
+ *
+ * Note: One sequencer only holds 8 steps(SS0), 4(SS1, SS2) or
+ *       1(SS3), so 12 channels do not fit in any of them. This
+ *       fills SS0 first, then SS1, SS2 and SS3, and puts all of
+ *       them on the same trigger. They run back to back, so every
+ *       channel is sampled within a few microseconds of the others
+ *
+ *       Up to 8 channels use SS0 only, up to 12 SS0 and SS1. The
+ *       rest stay free but THIS RESETS THE WHOLE ADC MODULE, set up
+ *       other sequences(MIL_ADCSeqInit also resets it) afterwards
+ *       by hand or on the other ADC
+ *
+ * Parameters:
+ *  pscan - storage you declare
+ *  base - ADC0_BASE or ADC1_BASE
+ *  pin_bitfield - channels to scan(see pin defines in this header)
+ *  trig - MIL_ADC_SoftTrig to start scans with MIL_ADCScanStart,
+ *         MIL_ADC_TimTrig for MIL_ADCTimerTrigInit
+ *
+ * Returns:
+ *  MIL_ADC_OK if the scan is set up
+ *  MIL_ADC_NOK if base is not valid or pin_bitfield is empty
+ */
+mil_adc_stat_t MIL_ADCScanInit(MIL_ADC_Scan_t *pscan,
+                               uint32_t base,
+                               uint16_t pin_bitfield,
+                               mil_trig_t trig);
+
+/*
+ * Desc: Starts a scan set up with MIL_ADC_SoftTrig
+ *
+ * Note: All sequencers are started by one signal so they
+ *       cannot drift apart
+ */
+void MIL_ADCScanStart(MIL_ADC_Scan_t *pscan);
+
+/*
+ * Desc: Interrupt at the end of every scan
+ *
+ * Note: Only the sequencer that finishes last interrupts,
+ *       call MIL_ADCScanRead in your ISR
+ *
+ * Parameters:
+ *  pscan - your scan
+ *  isr_ptr - pointer to your isr
+ */
+void MIL_ADCScanIntEnable(MIL_ADC_Scan_t *pscan,
+                          void (*isr_ptr)(void));
+
+/*
+ * Desc: Reads a finished scan without waiting
+ *
+ * Parameters:
+ *  pscan - your scan
+ *  psamples - 12 entries, indexed by channel(psamples[5] is AIN5),
+ *             entries of channels not in the scan are left alone
+ *
+ * Returns:
+ *  MIL_ADC_OK if psamples holds a new scan
+ *  MIL_ADC_NOK if the scan has not finished(psamples is left alone)
+ */
+mil_adc_stat_t MIL_ADCScanRead(MIL_ADC_Scan_t *pscan,
+                               uint16_t *psamples);
+
+/*
+ * Desc: one channel watched by the digital comparators
+ *       (see MIL_ADCAlarmInit)
+ *
+ * channel - AINx(0 to 11)
+ * low - alarm when a result drops below this(0 for no low alarm)
+ * high - alarm when a result reaches this(0 or above 0xFFF for no high alarm)
+ * hyst - counts a result has to come back inside the band by
+ *        before the same alarm can fire again
+ */
+typedef struct{
+
+    uint8_t  channel;
+    uint16_t low;
+    uint16_t high;
+    uint16_t hyst;
+
+}MIL_ADC_Alarm_t;
+
+/*
+ * Desc: called from the ADC ISR when an alarm fires
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  idx - entry of the palarms table passed to MIL_ADCAlarmInit
+ *  over - true for the high alarm, false for the low one
+ */
+typedef void (*mil_adc_alarm_t)(uint32_t base, uint8_t idx, bool over);
+
+/*
+ * Desc: Watches channels against low/high thresholds in hardware
+ *
+ * Note: Every ADC has 8 digital comparators. A sequence step can
+ *       hand its result to one instead of the FIFO, and the
+ *       comparator raises an interrupt when the result leaves the
+ *       band. No CPU time is spent on results that are fine, and
+ *       the alarm fires on the very sample that crossed
+ *
+ *       Every low and every high threshold takes one step and one
+ *       comparator, so a whole ADC can watch at most 8 thresholds
+ *       and seq_num must have a step for each(SS0 8, SS1/SS2 4, SS3 1).
+ *       seq_num only does alarms, its results never reach the FIFO
+ *
+ *       The alarm fires once when the band is left and again only
+ *       after the result came back inside by hyst counts
+ *
+ * Sequence Note: MIL_ADCSeqInit and MIL_ADCScanInit reset the whole ADC,
+ *                call this after them. Use a sequence they do not use
+ *                and trigger it with MIL_ADC_TimTrig(MIL_ADCTimerTrigInit)
+ *                or MIL_ADC_AlwaysTrig(lowest priority, samples
+ *                whenever the other sequences are idle)
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  seq_num - sequence that does the watching
+ *  palarms/count - channels to watch
+ *  trig - from mil_trig_t, what starts seq_num
+ *  palarm - your callback
+ *
+ * Returns:
+ *  MIL_ADC_OK if the alarms are armed
+ *  MIL_ADC_NOK if a parameter is not valid or the thresholds need
+ *              more steps or comparators than there are
+ */
+mil_adc_stat_t MIL_ADCAlarmInit(uint32_t base,
+                                uint8_t seq_num,
+                                const MIL_ADC_Alarm_t *palarms,
+                                uint8_t count,
+                                mil_trig_t trig,
+                                mil_adc_alarm_t palarm);
+
 /*
  * Desc: Runs get data sequence specified in the ADCSeqInit function
  *       This function can also be called in interrupts if need be
@@ -277,7 +474,7 @@ void MIL_ADCIntEnable(void (*isr_ptr)(void),
  *      This includes a wait function that will wait for new data or
  *      the user specified timer is reached
  *
- *      You can also implment there to be no wait, in which case the function
+ *      You can also implement there to be no wait, in which case the function
  *      will exit immediately if there is no new data
  *
  * Sequence:
@@ -318,6 +515,8 @@ mil_adc_stat_t MIL_ADCGetData(uint32_t base,
  *       m = 3V/0xFFF
  *
  *       Voltage = m*(raw ADC)
+ *
+ * Note: For calibrated results without floats use MIL_ADC_Cal.h
  */
 float MIL_ADC_HextoFloat(uint16_t adc_value);
 
@@ -0,0 +1,128 @@
+/*
+ * Name: MIL_CAN_Dispatch.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Jump table that hands received CAN frames
+ *       straight to the function that handles them
+ *
+ * What to understand: The ID/mask match is already done by the
+ *                     message object filters, so a frame's obj_num
+ *                     tells us which mailbox(route) it belongs to.
+ *                     Every route owns a 256 entry table indexed by
+ *                     the first data byte(the 'K','T','H' style
+ *                     message type) that holds the handler to call.
+ *
+ *                     Finding a handler is two array reads no
+ *                     matter how many message types are registered:
+ *                         route = route_of[obj_num - 1]
+ *                         handler = jump[route][data[0]]
+ *
+ *                     MIL_CAN_ANY_TYPE registers a catch all for a
+ *                     route. It is copied into every empty table entry
+ *                     when registered so lookups never fall back.
+ *
+ * Note: This file only depends on stdint/stdbool and MIL_CAN_Ring.h
+ *       so it can be built on a PC as well as the TIVA
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "MIL_CAN_Ring.h"
+
+#ifndef MIL_CAN_DISPATCH_H_
+#define MIL_CAN_DISPATCH_H_
+
+//mailboxes that can have handlers(each costs 256 bytes of RAM)
+#ifndef MIL_CAN_DISPATCH_ROUTES
+#define MIL_CAN_DISPATCH_ROUTES 4
+#endif
+
+//handlers that can be registered across all routes(up to 255)
+#ifndef MIL_CAN_DISPATCH_HANDLERS
+#define MIL_CAN_DISPATCH_HANDLERS 16
+#endif
+
+//pass as msg_type to catch every type without its own handler
+#define MIL_CAN_ANY_TYPE (-1)
+
+/*
+ * Desc: handler signature
+ *
+ * pframe - the frame(data[0] is the message type)
+ * pctx - whatever was passed in when registering
+ */
+typedef void (*mil_can_handler_t)(MIL_CAN_Frame_t *pframe, void *pctx);
+
+/*
+ * Desc: the dispatch table(do not touch fields directly)
+ *
+ * unhandled - frames nobody had a handler for
+ */
+typedef struct{
+
+  uint8_t route_of[32];     //per message object, route + 1(0 = no route)
+  uint8_t jump[MIL_CAN_DISPATCH_ROUTES][256]; //handler + 1(0 = none)
+  uint8_t any[MIL_CAN_DISPATCH_ROUTES];       //catch all handler + 1, used for empty frames
+  uint8_t num_routes;
+  uint8_t num_handlers;
+  mil_can_handler_t handler[MIL_CAN_DISPATCH_HANDLERS];
+  void   *ctx[MIL_CAN_DISPATCH_HANDLERS];
+  volatile uint32_t unhandled;
+
+}MIL_CAN_Dispatch_t;
+
+/*
+ * Desc: empties the table
+ */
+void MIL_CAN_DispatchInit(MIL_CAN_Dispatch_t *pd);
+
+/*
+ * Desc: registers a handler for one message type on one mailbox
+ *
+ * Notes: registering the same type twice replaces the old handler
+ *
+ * Parameters:
+ * pd - your table
+ * obj_num - message object of the mailbox(1 to 32)
+ * msg_type - first data byte(0 to 255) or MIL_CAN_ANY_TYPE
+ * phandler - function to call
+ * pctx - handed back to phandler
+ *
+ * Returns: false if the table is out of routes/handlers
+ */
+bool MIL_CAN_DispatchAdd(MIL_CAN_Dispatch_t *pd, uint8_t obj_num, int16_t msg_type,
+                         mil_can_handler_t phandler, void *pctx);
+
+/*
+ * Desc: registers one handler for a range of message types
+ *       (one handler slot no matter how wide the range is)
+ *
+ * Parameters:
+ * first_type/last_type - first data bytes the handler takes(inclusive)
+ *
+ * Returns: false if the table is out of routes/handlers
+ */
+bool MIL_CAN_DispatchAddRange(MIL_CAN_Dispatch_t *pd, uint8_t obj_num, uint8_t first_type,
+                              uint8_t last_type, mil_can_handler_t phandler, void *pctx);
+
+/*
+ * Desc: makes the message objects after obj_num share its
+ *       handlers(for mailboxes that span several objects)
+ *
+ * Parameters:
+ * pd - your table
+ * obj_num - first message object, must already have a handler
+ * count - total objects including obj_num
+ *
+ * Returns: false if obj_num has no handlers yet
+ */
+bool MIL_CAN_DispatchLink(MIL_CAN_Dispatch_t *pd, uint8_t obj_num, uint8_t count);
+
+/*
+ * Desc: calls the handler registered for a frame
+ *
+ * Returns: true if a handler ran, false if the frame was unhandled
+ */
+bool MIL_CAN_DispatchFrame(MIL_CAN_Dispatch_t *pd, MIL_CAN_Frame_t *pframe);
+
+#endif /* MIL_CAN_DISPATCH_H_ */
@@ -0,0 +1,121 @@
+/*
+ * Name: MIL_LOG.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Tokenised logging that is cheap enough for ISRs
+ *
+ * What to understand: UARTprintf formats the whole string on the spot
+ *                     and waits on the UART, far too slow for a timer
+ *                     ISR. MIL_LOG does not format anything on the TIVA.
+ *
+ *                     MIL_LOG2("speed %d dir %u", speed, dir) only writes
+ *                     a few words into a RAM ring:
+ *
+ *                     WORD | CONTENT
+ *                     0    | 0xA5 | nargs | 16 bit sequence number
+ *                     1    | address of the format string(its ID)
+ *                     2    | time stamp(0 without a time source)
+ *                     3..  | the arguments, one 32 bit word each
+ *
+ *                     MIL_LogService, called from the main loop, sends
+ *                     the ring out of a UART as raw bytes(little endian).
+ *                     The format strings are kept together in the
+ *                     .mil_log section of the .out file, mil_log.py(next
+ *                     to this file) pulls them out at build time and
+ *                     turns the bytes back into text on the PC:
+ *
+ *                     python3 mil_log.py table Debug/KillBoard.out > fmt.json
+ *                     python3 mil_log.py decode fmt.json /dev/ttyUSB0 --baud 115200
+ *
+ * FORMAT NOTE: Arguments are 32 bit words, so %d %i %u %x %X %c %p
+ *              (with flags/width) work. %s and %f do not, log ints or
+ *              fixed point instead. At most 4 arguments
+ *
+ * LINKER NOTE: Add
+ *                  .mil_log : > FLASH
+ *              to the SECTIONS of your .cmd file, otherwise the linker
+ *              warns that it placed the section on its own
+ *
+ * Note: A full ring drops new records(counted in MIL_LogDropped),
+ *       the sequence numbers show the decoder where the gaps are.
+ *       Build with MIL_LOG_ENABLE 0 and every MIL_LOG call disappears
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_LOG_H_
+#define MIL_LOG_H_
+
+//0 compiles every MIL_LOG call out
+#ifndef MIL_LOG_ENABLE
+#define MIL_LOG_ENABLE 1
+#endif
+
+//ring size in 32 bit words, must be a power of 2
+#ifndef MIL_LOG_RING_WORDS
+#define MIL_LOG_RING_WORDS 256
+#endif
+
+//first byte(on the wire the fourth) of every record
+#define MIL_LOG_MAGIC 0xA5
+
+//section the format strings live in
+#define MIL_LOG_SECTION __attribute__((section(".mil_log")))
+
+#if MIL_LOG_ENABLE
+#define MIL_LOG_CALL(fmt, n, a, b, c, d) do{ \
+    static const char MIL_LOG_SECTION mil_log_fmt[] = fmt; \
+    MIL_LogWrite(mil_log_fmt, n, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d)); \
+}while(0)
+#else
+#define MIL_LOG_CALL(fmt, n, a, b, c, d) do{}while(0)
+#endif
+
+/*
+ * Desc: log calls, the number is how many arguments follow the format
+ *
+ * Notes: fmt must be a string literal
+ */
+#define MIL_LOG0(fmt)             MIL_LOG_CALL(fmt, 0, 0, 0, 0, 0)
+#define MIL_LOG1(fmt, a)          MIL_LOG_CALL(fmt, 1, a, 0, 0, 0)
+#define MIL_LOG2(fmt, a, b)       MIL_LOG_CALL(fmt, 2, a, b, 0, 0)
+#define MIL_LOG3(fmt, a, b, c)    MIL_LOG_CALL(fmt, 3, a, b, c, 0)
+#define MIL_LOG4(fmt, a, b, c, d) MIL_LOG_CALL(fmt, 4, a, b, c, d)
+
+/*
+ * Desc: Picks the UART the log goes out of
+ *
+ * Notes: Set up the UART first(MIL_InitUART, and MIL_UART_DMAInit
+ *        if use_dma is true)
+ *
+ * Parameters:
+ * base - UART TIVA base UARTx_BASE(where x is 0 to 7)
+ * use_dma - true sends straight out of the ring with MIL_UART_DMAWrite,
+ *           false fills the UART FIFO without waiting
+ * ptime_fn - time stamp source(0 for none)
+ */
+void MIL_LogInit(uint32_t base, bool use_dma, uint32_t (*ptime_fn)(void));
+
+/*
+ * Desc: Adds a record to the ring, use the MIL_LOG macros instead
+ *
+ * Notes: Safe from any ISR, interrupts are only off while the
+ *        words are copied
+ */
+void MIL_LogWrite(const char *fmt, uint8_t nargs, uint32_t a, uint32_t b, uint32_t c, uint32_t d);
+
+/*
+ * Desc: Sends whatever the UART can take right now,
+ *       call this from your main loop
+ *
+ * Returns: number of bytes handed to the UART
+ */
+uint32_t MIL_LogService(void);
+
+/*
+ * Desc: Number of records dropped because the ring was full
+ */
+uint32_t MIL_LogDropped(void);
+
+#endif /* MIL_LOG_H_ */
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""
+Name: mil_log.py
+Author: MIL
+Date Created: 10/15/2026
+Desc: PC side of MIL_LOG, turns the binary log back into text
+
+  table  - pulls the format strings out of the .mil_log section of a
+           .out/.elf file and prints them as JSON(address -> format)
+  decode - reads the log from a serial port or a capture file and
+           prints one line per record
+
+  python3 mil_log.py table Debug/KillBoard.out > fmt.json
+  python3 mil_log.py decode fmt.json /dev/ttyUSB0 --baud 115200
+  python3 mil_log.py decode Debug/KillBoard.out capture.bin --tick-hz 1000000
+
+decode takes either a table from "table" or the .out file itself.
+Serial ports need pyserial(pip install pyserial).
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+MAGIC = 0xA5
+HDR_WORDS = 3
+MAX_ARGS = 4
+SECTION = ".mil_log"
+
+# printf conversions MIL_LOG can handle, every argument is one 32 bit word
+CONV = re.compile(r"%([-+ 0#]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|z|j|t)?([diuxXcp%])")
+
+
+def elf_table(path):
+    """address -> format string for every string in the .mil_log section"""
+    with open(path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF":
+        raise ValueError(path + " is not an ELF file")
+
+    is64 = elf[4] == 2
+    end = "<" if elf[5] == 1 else ">"
+
+    if is64:
+        shoff, = struct.unpack_from(end + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", elf, 0x3A)
+        shdr = end + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(end + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", elf, 0x2E)
+        shdr = end + "IIIIIIIIII"
+
+    sections = [struct.unpack_from(shdr, elf, shoff + i * shentsize) for i in range(shnum)]
+    names = sections[shstrndx]
+
+    def name_of(sh):
+        start = names[4] + sh[0]
+        return elf[start:elf.index(b"\0", start)].decode()
+
+    table = {}
+    for sh in sections:
+        if name_of(sh) != SECTION:
+            continue
+        addr, off, size = sh[3], sh[4], sh[5]
+        data = elf[off:off + size]
+        pos = 0
+        # strings are NUL terminated, padding between them is NULs too
+        while pos < len(data):
+            if data[pos] == 0:
+                pos += 1
+                continue
+            stop = data.index(b"\0", pos)
+            table[(addr + pos) & 0xFFFFFFFF] = data[pos:stop].decode(errors="replace")
+            pos = stop + 1
+
+    return table
+
+
+def load_table(path):
+    with open(path, "rb") as f:
+        head = f.read(4)
+    if head == b"\x7fELF":
+        return elf_table(path)
+    with open(path) as f:
+        return {int(k, 0): v for k, v in json.load(f).items()}
+
+
+def format_record(fmt, args):
+    """printf with 32 bit words as arguments"""
+    args = list(args)
+
+    def one(m):
+        flags, width, prec, conv = m.groups()
+        if conv == "%":
+            return "%"
+        word = args.pop(0) if args else 0
+        if conv in "di":
+            value = word - (1 << 32) if word & 0x80000000 else word
+            conv = "d"
+        elif conv == "c":
+            value = chr(word & 0xFF)
+        elif conv == "p":
+            flags, conv, value = flags + "#", "x", word
+        else:
+            value = word
+        spec = "%" + flags + width + ("." + prec if prec else "") + conv
+        return spec % value
+
+    return CONV.sub(one, fmt)
+
+
+class Decoder:
+    """Finds records in a byte stream, resyncs on anything it cannot read"""
+
+    def __init__(self, table, tick_hz=0):
+        self.table = table
+        self.tick_hz = tick_hz
+        self.buf = bytearray()
+        self.seq = None
+
+    def feed(self, data):
+        self.buf += data
+        lines = []
+        while len(self.buf) >= HDR_WORDS * 4:
+            hdr, fmt_id, stamp = struct.unpack_from("<III", self.buf, 0)
+            nargs = (hdr >> 16) & 0xFF
+            if (hdr >> 24) != MAGIC or nargs > MAX_ARGS or fmt_id not in self.table:
+                del self.buf[0]
+                continue
+            size = (HDR_WORDS + nargs) * 4
+            if len(self.buf) < size:
+                break
+            args = struct.unpack_from("<%dI" % nargs, self.buf, HDR_WORDS * 4)
+            del self.buf[:size]
+
+            seq = hdr & 0xFFFF
+            if seq == 0 and self.seq not in (None, 0):
+                lines.append("--- restart ---")
+            elif self.seq is not None and seq != self.seq:
+                lines.append("... %d record(s) lost" % ((seq - self.seq) & 0xFFFF))
+            self.seq = (seq + 1) & 0xFFFF
+
+            when = "%.6f" % (stamp / self.tick_hz) if self.tick_hz else "%u" % stamp
+            lines.append("[%s] %s" % (when, format_record(self.table[fmt_id], args)))
+        return lines
+
+
+def open_source(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial
+        return serial.Serial(path, baudrate=baud, timeout=0.1)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="MIL_LOG format table and decoder")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    p = sub.add_parser("table", help="extract the format table from a .out file")
+    p.add_argument("elf")
+
+    p = sub.add_parser("decode", help="decode a log stream")
+    p.add_argument("table", help="JSON table or the .out file")
+    p.add_argument("source", help="serial port, capture file or - for stdin")
+    p.add_argument("--baud", type=int, default=115200)
+    p.add_argument("--tick-hz", type=float, default=0, help="time source ticks per second")
+
+    args = parser.parse_args()
+
+    if args.cmd == "table":
+        table = elf_table(args.elf)
+        json.dump({"0x%08X" % k: v for k, v in sorted(table.items())}, sys.stdout, indent=1)
+        print()
+        return
+
+    decoder = Decoder(load_table(args.table), args.tick_hz)
+    src = open_source(args.source, args.baud)
+    is_file = not hasattr(src, "in_waiting")
+    while True:
+        if is_file:
+            data = src.read1(4096) if hasattr(src, "read1") else src.read(4096)
+        else:
+            data = src.read(max(1, src.in_waiting))
+        if not data:
+            if is_file:
+                break
+            continue
+        for line in decoder.feed(data):
+            print(line, flush=True)
+
+
+if __name__ == "__main__":
+    main()
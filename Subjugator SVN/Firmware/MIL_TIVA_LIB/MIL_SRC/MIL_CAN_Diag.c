@@ -0,0 +1,209 @@
+/*
+ * Name: MIL_CAN_Diag.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: CAN bus load and error bookkeeping
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_CAN_Diag.h"
+
+/*
+ * Desc: clears one set of counters
+ */
+static void MIL_CAN_DiagClearId(MIL_CAN_DiagId_t *pid, uint32_t canid){
+
+    pid->canid = canid;
+    pid->rx = 0;
+    pid->tx = 0;
+    pid->lat_sum = 0;
+    pid->lat_max = 0;
+
+}
+
+/*
+ * Desc: ticks to ms, stops at 255 so it fits a byte
+ */
+static uint8_t MIL_CAN_DiagTicksToMs(MIL_CAN_Diag_t *pd, uint32_t ticks){
+
+    uint64_t ms;
+
+    if(!pd->tick_hz){
+        return 0;
+    }
+
+    ms = ((uint64_t)ticks * 1000) / pd->tick_hz;
+
+    return (ms > 255) ? 255 : (uint8_t)ms;
+
+}
+
+/*
+ * Desc: clears everything
+ */
+void MIL_CAN_DiagInit(MIL_CAN_Diag_t *pd, uint32_t tick_hz, uint32_t now){
+
+    pd->num_ids = 0;
+    MIL_CAN_DiagClearId(&pd->other, 0);
+
+    pd->tec = 0;
+    pd->rec = 0;
+    pd->state = 0;
+    pd->boff_count = 0;
+    pd->boff_start = 0;
+    pd->recover_last = 0;
+    pd->recover_max = 0;
+
+    pd->util_permille = 0;
+    pd->window_bits = 0;
+    pd->window_start = now;
+
+    pd->tick_hz = tick_hz;
+
+}
+
+/*
+ * Desc: bits a data frame takes on the wire
+ *
+ * Notes: SOF through CRC is 34 + 8*len bits(54 + 8*len extended)
+ *        and can get one stuff bit every 4 bits after the first 5.
+ *        CRC delimiter, ACK, EOF and the 3 bit gap add 13 fixed bits.
+ */
+uint32_t MIL_CAN_DiagFrameBits(uint8_t len, bool extended){
+
+    uint32_t stuffed;
+
+    if(len > 8){
+        len = 8;
+    }
+
+    stuffed = (extended ? 54 : 34) + (8 * (uint32_t)len);
+
+    return stuffed + ((stuffed - 1) / 4) + 13;
+
+}
+
+/*
+ * Desc: returns the counters for a CAN ID
+ */
+MIL_CAN_DiagId_t *MIL_CAN_DiagFind(MIL_CAN_Diag_t *pd, uint32_t canid){
+
+    for(uint8_t i = 0;i < pd->num_ids;i++){
+        if(pd->ids[i].canid == canid){
+            return &pd->ids[i];
+        }
+    }
+
+    if(pd->num_ids >= MIL_CAN_DIAG_IDS){
+        return &pd->other;
+    }
+
+    MIL_CAN_DiagClearId(&pd->ids[pd->num_ids], canid);
+
+    return &pd->ids[pd->num_ids++];
+
+}
+
+/*
+ * Desc: records a received frame
+ */
+void MIL_CAN_DiagRx(MIL_CAN_Diag_t *pd, uint32_t canid, uint8_t len){
+
+    MIL_CAN_DiagFind(pd, canid)->rx++;
+    pd->window_bits += MIL_CAN_DiagFrameBits(len, canid > 0x7FF);
+
+}
+
+/*
+ * Desc: records a sent frame and how long it waited
+ */
+void MIL_CAN_DiagTx(MIL_CAN_Diag_t *pd, uint32_t canid, uint8_t len, uint32_t latency){
+
+    MIL_CAN_DiagId_t *pid = MIL_CAN_DiagFind(pd, canid);
+
+    pid->tx++;
+    pid->lat_sum += latency;
+    if(latency > pid->lat_max){
+        pid->lat_max = latency;
+    }
+
+    pd->window_bits += MIL_CAN_DiagFrameBits(len, canid > 0x7FF);
+
+}
+
+/*
+ * Desc: records a change in controller state
+ */
+void MIL_CAN_DiagStatus(MIL_CAN_Diag_t *pd, uint8_t state, uint32_t now){
+
+    bool was_off = (pd->state & MIL_CAN_DIAG_BOFF_bm) != 0;
+    bool is_off = (state & MIL_CAN_DIAG_BOFF_bm) != 0;
+
+    if(!was_off && is_off){
+        pd->boff_count++;
+        pd->boff_start = now;
+    }
+    else if(was_off && !is_off){
+        pd->recover_last = now - pd->boff_start;
+        if(pd->recover_last > pd->recover_max){
+            pd->recover_max = pd->recover_last;
+        }
+    }
+
+    pd->state = state;
+
+}
+
+/*
+ * Desc: closes the utilisation window and stores the error counters
+ */
+void MIL_CAN_DiagSnapshot(MIL_CAN_Diag_t *pd, uint32_t now, uint32_t bit_rate,
+                          uint8_t tec, uint8_t rec){
+
+    uint32_t elapsed = now - pd->window_start;
+    uint64_t avail;
+    uint64_t util;
+
+    pd->tec = tec;
+    pd->rec = rec;
+
+    //bits the bus could have carried in this window
+    avail = pd->tick_hz ? (((uint64_t)bit_rate * elapsed) / pd->tick_hz) : 0;
+
+    if(avail){
+        util = ((uint64_t)pd->window_bits * 1000) / avail;
+        pd->util_permille = (util > 1000) ? 1000 : (uint16_t)util;
+    }
+
+    pd->window_bits = 0;
+    pd->window_start = now;
+
+}
+
+/*
+ * Desc: packs the last snapshot into a diagnostic frame
+ */
+void MIL_CAN_DiagEncode(MIL_CAN_Diag_t *pd, uint8_t *data){
+
+    uint32_t lat_max = pd->other.lat_max;
+
+    for(uint8_t i = 0;i < pd->num_ids;i++){
+        if(pd->ids[i].lat_max > lat_max){
+            lat_max = pd->ids[i].lat_max;
+        }
+    }
+
+    data[0] = MIL_CAN_DIAG_BYTE;
+    data[1] = pd->tec;
+    data[2] = pd->rec;
+    data[3] = pd->state;
+    data[4] = (pd->boff_count > 255) ? 255 : (uint8_t)pd->boff_count;
+    data[5] = (uint8_t)(pd->util_permille / 5);
+    data[6] = MIL_CAN_DiagTicksToMs(pd, pd->recover_max);
+    data[7] = MIL_CAN_DiagTicksToMs(pd, lat_max);
+
+}
@@ -0,0 +1,139 @@
+/*
+ * Name: MIL_CAN_Ring.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Fixed size single producer/single consumer
+ *       frame ring used by the MIL_CAN receive ISR
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_CAN_Ring.h"
+
+#define RING_MASK (MIL_CAN_RING_SIZE - 1)
+
+#if (MIL_CAN_RING_SIZE & RING_MASK) != 0
+#error "MIL_CAN_RING_SIZE must be a power of 2"
+#endif
+
+/*
+ * Desc: empties the ring and clears the drop counter
+ *
+ * Note: only call this while the producer is stopped
+ */
+void MIL_CAN_RingInit(MIL_CAN_Ring_t *pring){
+
+    pring->head = 0;
+    pring->tail = 0;
+    pring->dropped = 0;
+
+}
+
+/*
+ * Desc: PRODUCER SIDE. Returns the next free slot for the
+ *       producer to fill in place or 0 if the ring is full.
+ *       A full ring counts the frame as dropped.
+ */
+MIL_CAN_Frame_t *MIL_CAN_RingClaim(MIL_CAN_Ring_t *pring){
+
+    uint32_t head = pring->head;
+
+    //unsigned subtraction still works after the indexes wrap
+    if((head - pring->tail) >= MIL_CAN_RING_SIZE){
+        pring->dropped++;
+        return 0;
+    }
+
+    return &pring->frames[head & RING_MASK];
+
+}
+
+/*
+ * Desc: PRODUCER SIDE. Publishes the slot returned by
+ *       the last MIL_CAN_RingClaim
+ */
+void MIL_CAN_RingCommit(MIL_CAN_Ring_t *pring){
+
+    //frame contents must land before the consumer can see the new head
+    MIL_CAN_RING_BARRIER();
+    pring->head = pring->head + 1;
+
+}
+
+/*
+ * Desc: PRODUCER SIDE. Copies a whole frame into the ring
+ */
+bool MIL_CAN_RingPush(MIL_CAN_Ring_t *pring, const MIL_CAN_Frame_t *pframe){
+
+    MIL_CAN_Frame_t *pslot = MIL_CAN_RingClaim(pring);
+
+    if(!pslot){
+        return false;
+    }
+
+    *pslot = *pframe;
+    MIL_CAN_RingCommit(pring);
+
+    return true;
+
+}
+
+/*
+ * Desc: CONSUMER SIDE. Returns the oldest frame without
+ *       removing it or 0 if the ring is empty
+ */
+MIL_CAN_Frame_t *MIL_CAN_RingPeek(MIL_CAN_Ring_t *pring){
+
+    uint32_t tail = pring->tail;
+
+    if(tail == pring->head){
+        return 0;
+    }
+
+    //do not read the slot before head has been read
+    MIL_CAN_RING_BARRIER();
+
+    return &pring->frames[tail & RING_MASK];
+
+}
+
+/*
+ * Desc: CONSUMER SIDE. Removes the oldest frame
+ */
+void MIL_CAN_RingDrop(MIL_CAN_Ring_t *pring){
+
+    //slot must be fully read before the producer may reuse it
+    MIL_CAN_RING_BARRIER();
+    pring->tail = pring->tail + 1;
+
+}
+
+/*
+ * Desc: CONSUMER SIDE. Copies the oldest frame out and removes it
+ */
+bool MIL_CAN_RingPop(MIL_CAN_Ring_t *pring, MIL_CAN_Frame_t *pframe){
+
+    MIL_CAN_Frame_t *pslot = MIL_CAN_RingPeek(pring);
+
+    if(!pslot){
+        return false;
+    }
+
+    *pframe = *pslot;
+    MIL_CAN_RingDrop(pring);
+
+    return true;
+
+}
+
+/*
+ * Desc: number of frames waiting in the ring
+ */
+uint32_t MIL_CAN_RingCount(MIL_CAN_Ring_t *pring){
+
+    return pring->head - pring->tail;
+
+}
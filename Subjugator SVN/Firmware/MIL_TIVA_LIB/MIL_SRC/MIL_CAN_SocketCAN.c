@@ -0,0 +1,1112 @@
+/*
+ * Name: MIL_CAN_SocketCAN.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: MIL_CAN API on top of a Linux SocketCAN socket
+ *       (see MIL_CAN_SocketCAN.h for how to use it)
+ *
+ * Notes: Only built with MIL_CAN_SOCKETCAN defined, MIL_CAN.c
+ *        compiles to nothing in that case and this file does
+ *        the same in the TIVA build
+ */
+#ifdef MIL_CAN_SOCKETCAN
+
+//struct ifreq is hidden by -std=c99 otherwise
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+/* INCLUDES */
+//includes
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/error.h>
+#include <linux/can/raw.h>
+
+//MIL includes
+#include "MIL_CAN.h"
+
+/* MODULE STATE */
+/*
+ * Everything below is kept per controller,
+ * index 0 is CAN0 and index 1 is CAN1
+ */
+#define MIL_CAN_IDX(base) (((base) == CAN1_BASE) ? 1 : 0)
+
+/*
+ * Desc: one emulated message object
+ *
+ * rx - set up as part of a mailbox
+ * fifo - MSG_OBJ_FIFO, a full object passes frames on to the next one
+ * newdat/lost - same as the NEWDAT and MSGLST bits of the hardware
+ * pmail - mailbox the object belongs to
+ */
+typedef struct{
+
+  uint32_t id;
+  uint32_t mask;
+  bool     rx;
+  bool     fifo;
+  bool     newdat;
+  bool     lost;
+  uint32_t canid;
+  uint8_t  len;
+  uint8_t  data[8];
+  MIL_CAN_MailBox_t *pmail;
+
+}MIL_CAN_HostObj_t;
+
+static int Sock[2] = {-1, -1};          //-1 until MIL_InitCAN opens the interface
+static const char *IfName[2];           //0 uses the environment or MIL_CAN_SOCKETCAN_IF
+static MIL_CAN_HostObj_t Obj[2][32];    //message objects 1 to 32
+
+static MIL_CAN_Ring_t *pRxRing[2];      //0 while the controller is polled
+static uint32_t (*pTimeSource)(void);   //frame timestamp source
+static MIL_CAN_TxQ_t *pTxQ[2];          //0 while MIL_CANSimpleTX writes straight to the socket
+static bool TxServicing[2];             //a pdone callback queued more frames
+static MIL_CAN_Dispatch_t *pDispatch[2]; //0 when no handlers are used
+static bool DispatchInISR[2];           //handlers run from the "ISR" instead of MIL_CAN_DispatchPoll
+static MIL_CAN_TP_t *pTP[2];            //0 when the segmented transport is off
+static MIL_CAN_Gw_t *pGw;               //0 when the gateway is off
+
+//the "ISR" reads RX mailboxes itself when there is a ring or ISR dispatch
+#define MIL_CAN_RX_IN_ISR(idx) (pRxRing[idx] || (pDispatch[idx] && DispatchInISR[idx]))
+
+static uint32_t BitRate[2];             //rate passed in, 0 until initialized
+
+static MIL_CAN_Diag_t *pDiag[2];        //0 when telemetry is off
+static uint32_t DiagReportId[2];        //CAN ID of the 'D' frame
+static uint32_t DiagReportTicks[2];     //time source ticks between reports
+static uint32_t DiagLastReport[2];      //tick of the last report
+static uint8_t ErrState[2];             //MIL_CAN_DIAG bits from the error frames
+static uint8_t ErrTec[2];               //error counters from the error frames
+static uint8_t ErrRec[2];
+
+static void MIL_CAN_HostPump(uint8_t idx);
+static bool MIL_CAN_HostStore(uint8_t idx, struct can_frame *pcf);
+static void MIL_CAN_HostDrain(uint8_t idx);
+static void MIL_CAN_HostError(uint8_t idx, struct can_frame *pcf);
+static bool MIL_CAN_HostWrite(uint8_t idx, uint32_t canid, uint8_t *pdata, uint8_t len);
+static void MIL_CAN_HostTxService(uint8_t idx);
+static uint8_t MIL_CAN_MailDepth(MIL_CAN_MailBox_t *pmailbox);
+static uint32_t MIL_CAN_MailMask(MIL_CAN_MailBox_t *pmailbox);
+static uint32_t MIL_CAN_Now(void);
+static bool MIL_CAN_QueueIfClear(uint32_t base, uint32_t canid, uint8_t *data, uint8_t len,
+                                 void (*pdone)(uint32_t canid, void *pctx), void *pctx);
+static void MIL_CAN_TPSentDone(uint32_t canid, void *pctx){ MIL_CAN_TPSent((MIL_CAN_TP_t *)pctx, canid); }
+static bool MIL_CAN0_TPSend(uint32_t canid, uint8_t *data, uint8_t len){ return MIL_CAN_QueueIfClear(CAN0_BASE, canid, data, len, &MIL_CAN_TPSentDone, pTP[0]); }
+static bool MIL_CAN1_TPSend(uint32_t canid, uint8_t *data, uint8_t len){ return MIL_CAN_QueueIfClear(CAN1_BASE, canid, data, len, &MIL_CAN_TPSentDone, pTP[1]); }
+static void MIL_CAN_TPHandler(MIL_CAN_Frame_t *pframe, void *pctx);
+static void MIL_CAN0_GwHandler(MIL_CAN_Frame_t *pframe, void *pctx){ MIL_CAN_GwInput((MIL_CAN_Gw_t *)pctx, MIL_CAN_GW_0TO1, pframe); }
+static void MIL_CAN1_GwHandler(MIL_CAN_Frame_t *pframe, void *pctx){ MIL_CAN_GwInput((MIL_CAN_Gw_t *)pctx, MIL_CAN_GW_1TO0, pframe); }
+
+/*
+ * Desc: Picks the Linux interface a controller uses
+ */
+void MIL_CAN_SocketCANBind(uint32_t base, const char *ifname){
+
+    IfName[MIL_CAN_IDX(base)] = ifname;
+
+}
+
+/*
+ * Desc: Opens the controller's interface at MIL_CAN_DEFAULT_RATE
+ */
+void MIL_InitCAN(mil_can_port_t port,uint32_t base){
+
+    MIL_InitCANRate(port, base, MIL_CAN_DEFAULT_RATE);
+
+}
+
+/*
+ * Desc: Opens the controller's interface
+ *
+ * Notes: port is ignored, every message object starts out unused
+ *
+ * Returns:
+ * MIL_CAN_OK if the interface is open
+ * MIL_CAN_NOK if the interface does not exist or rate is 0
+ */
+mil_can_status_t MIL_InitCANRate(mil_can_port_t port, uint32_t base, uint32_t rate){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    const char *ifname = IfName[idx];
+    struct ifreq ifr;
+    struct sockaddr_can addr;
+    can_err_mask_t err_mask = CAN_ERR_CRTL | CAN_ERR_BUSOFF | CAN_ERR_RESTARTED;
+
+    (void)port;
+
+#ifdef CAN_ERR_CNT
+    err_mask |= CAN_ERR_CNT;
+#endif
+
+    if(!ifname){
+        ifname = getenv(idx ? "MIL_CAN1_IF" : "MIL_CAN0_IF");
+    }
+    if(!ifname){
+        ifname = MIL_CAN_SOCKETCAN_IF;
+    }
+
+    if(Sock[idx] >= 0){
+        close(Sock[idx]);
+    }
+
+    //non blocking so polling for mail never waits
+    Sock[idx] = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+    if(Sock[idx] < 0){
+        return MIL_CAN_NOK;
+    }
+
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, ifname, IFNAMSIZ - 1);
+
+    if(ioctl(Sock[idx], SIOCGIFINDEX, &ifr) < 0){
+        close(Sock[idx]);
+        Sock[idx] = -1;
+        return MIL_CAN_NOK;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    addr.can_ifindex = ifr.ifr_ifindex;
+
+    if((bind(Sock[idx], (struct sockaddr *)&addr, sizeof(addr)) < 0) ||
+       (MIL_CAN_SetBitRate(base, rate, MIL_CAN_SP_DEFAULT) != MIL_CAN_OK)){
+        close(Sock[idx]);
+        Sock[idx] = -1;
+        return MIL_CAN_NOK;
+    }
+
+    //bus-off and error passive changes arrive as error frames
+    setsockopt(Sock[idx], SOL_CAN_RAW, CAN_RAW_ERR_FILTER, &err_mask, sizeof(err_mask));
+
+    memset(Obj[idx], 0, sizeof(Obj[idx]));
+    ErrState[idx] = 0;
+    ErrTec[idx] = 0;
+    ErrRec[idx] = 0;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Remembers the bit rate(the interface's own rate is
+ *       set with ip link, see MIL_CAN_SocketCAN.h)
+ */
+mil_can_status_t MIL_CAN_SetBitRate(uint32_t base, uint32_t rate, uint16_t sample_point){
+
+    (void)sample_point;
+
+    if(!rate){
+        return MIL_CAN_NOK;
+    }
+
+    BitRate[MIL_CAN_IDX(base)] = rate;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Returns the bit rate passed to MIL_InitCANRate
+ */
+uint32_t MIL_CAN_GetBitRate(uint32_t base){
+
+    return BitRate[MIL_CAN_IDX(base)];
+
+}
+
+/*
+ * Desc: Does nothing, there are no CAN interrupts on a PC
+ */
+void MIL_CANIntEnable(void (*func_ptr)(void),uint32_t base){
+
+    (void)func_ptr;
+    (void)base;
+
+}
+
+/*
+ * Desc: Does nothing, there are no ports on a PC
+ */
+void MIL_CANPortClkEnable(mil_can_port_t port){
+
+    (void)port;
+
+}
+
+/*
+ * Desc: Writes a message to the interface, through the
+ *       TX queue if MIL_CAN_TxQueueInit was called
+ */
+void MIL_CANSimpleTX(uint32_t canid,uint8_t *pMsg,uint8_t MsgLen,uint32_t base){
+
+    if(pTxQ[MIL_CAN_IDX(base)]){
+        MIL_CANQueueTX(canid, pMsg, MsgLen, base, 0, 0);
+        return;
+    }
+
+    MIL_CAN_HostWrite(MIL_CAN_IDX(base), canid, pMsg, MsgLen);
+
+}
+
+/*
+ * Desc: Reserves a bank of message objects as a transmit queue
+ *
+ * Notes: Frames leave the queue as soon as the socket takes them,
+ *        they only wait while the socket's send buffer is full
+ */
+void MIL_CAN_TxQueueInit(uint32_t base, MIL_CAN_TxQ_t *pq, uint8_t first_obj, uint8_t num_obj){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+
+    MIL_CAN_TxQInit(pq, first_obj, num_obj);
+
+    for(uint8_t obj = pq->first_obj;obj < (pq->first_obj + pq->num_obj);obj++){
+        Obj[idx][obj - 1].rx = false;
+    }
+
+    pTxQ[idx] = pq;
+
+}
+
+/*
+ * Desc: Puts a message on the TX queue
+ *
+ * Notes: pdone runs before this returns if the socket took the frame
+ *
+ * Returns:
+ * MIL_CAN_OK if the message was queued
+ * MIL_CAN_NOK if the queue is full or was never set up
+ */
+mil_can_status_t MIL_CANQueueTX(uint32_t canid, uint8_t *pMsg, uint8_t MsgLen, uint32_t base,
+                                void (*pdone)(uint32_t canid, void *pctx), void *pctx){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    MIL_CAN_TxQ_t *pq = pTxQ[idx];
+    MIL_CAN_TxFrame_t frame;
+    uint8_t obj;
+
+    if(!pq){
+        return MIL_CAN_NOK;
+    }
+
+    if(MsgLen > 8){
+        MsgLen = 8;
+    }
+
+    frame.canid = canid;
+    frame.len = MsgLen;
+    for(uint8_t i = 0;i < MsgLen;i++){
+        frame.data[i] = pMsg[i];
+    }
+    frame.pdone = pdone;
+    frame.pctx = pctx;
+    frame.queued_at = MIL_CAN_Now();
+
+    if(MIL_CAN_TxQSubmit(pq, &frame, &obj) == MIL_CAN_TXQ_FULL){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_HostTxService(idx);
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Copies out the TX queue statistics
+ *
+ * Returns:
+ * MIL_CAN_OK if the stats were copied
+ * MIL_CAN_NOK if the queue was never set up
+ */
+mil_can_status_t MIL_CAN_TxStatsGet(uint32_t base, MIL_CAN_TxStats_t *pstats){
+
+    MIL_CAN_TxQ_t *pq = pTxQ[MIL_CAN_IDX(base)];
+
+    if(!pq){
+        return MIL_CAN_NOK;
+    }
+
+    *pstats = pq->stats;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Sets up the message objects of a mailbox
+ */
+void MIL_InitMailBox(MIL_CAN_MailBox_t *pmailbox){
+
+    uint8_t idx = MIL_CAN_IDX(pmailbox->base);
+    uint8_t depth = MIL_CAN_MailDepth(pmailbox);
+    MIL_CAN_HostObj_t *pobj;
+
+    pmailbox->msg_obj.ui32MsgID = pmailbox->canid;
+    pmailbox->msg_obj.ui32MsgIDMask = pmailbox->filt_mask;
+    pmailbox->msg_obj.ui32Flags = 0;
+    pmailbox->msg_obj.ui32MsgLen = pmailbox->msg_len;
+    pmailbox->msg_obj.pui8MsgData = pmailbox->buffer;
+
+    pmailbox->overruns = 0;
+
+    //same filter on every object, only the last one ends the FIFO
+    for(uint8_t i = 0;i < depth;i++){
+        pobj = &Obj[idx][pmailbox->obj_num - 1 + i];
+        pobj->id = pmailbox->canid;
+        pobj->mask = pmailbox->filt_mask;
+        pobj->rx = true;
+        pobj->fifo = (i < (depth - 1));
+        pobj->newdat = false;
+        pobj->lost = false;
+        pobj->pmail = pmailbox;
+    }
+
+}
+
+/*
+ * Desc: Copies the oldest frame of a mailbox to its buffer
+ *
+ * Returns:
+ * mil_can_status_t - MIL_CAN_OK if there was new data
+ *                    MIL_CAN_NOK if there is no data
+ */
+mil_can_status_t MIL_CAN_GetMail(MIL_CAN_MailBox_t *pmailbox){
+
+    uint8_t idx = MIL_CAN_IDX(pmailbox->base);
+    MIL_CAN_Ring_t *pring = pRxRing[idx];
+    MIL_CAN_HostObj_t *pobj = 0;
+    uint8_t len;
+
+    MIL_CAN_HostPump(idx);
+
+    //interrupt driven controller, mail comes off the ring in arrival order
+    if(pring){
+
+        MIL_CAN_Frame_t *pframe = MIL_CAN_RingPeek(pring);
+
+        if(!pframe || !(MIL_CAN_MailMask(pmailbox) & (0x01UL << (pframe->obj_num - 1)))){
+            return MIL_CAN_NOK;
+        }
+
+        if(pframe->flags & MIL_CAN_FRAME_LOST_bm){
+            pmailbox->overruns++;
+        }
+
+        len = (pframe->len < pmailbox->msg_len) ? pframe->len : pmailbox->msg_len;
+        for(uint8_t i = 0;i < len;i++){
+            pmailbox->buffer[i] = pframe->data[i];
+        }
+        pmailbox->msg_obj.ui32MsgID = pframe->canid;
+        pmailbox->msg_obj.ui32MsgLen = pframe->len;
+
+        MIL_CAN_RingDrop(pring);
+        return MIL_CAN_OK;
+    }
+
+    //lowest object holding data is the oldest frame of a FIFO
+    for(uint8_t i = 0;i < MIL_CAN_MailDepth(pmailbox);i++){
+        if(Obj[idx][pmailbox->obj_num - 1 + i].newdat){
+            pobj = &Obj[idx][pmailbox->obj_num - 1 + i];
+            break;
+        }
+    }
+
+    if(!pobj){
+        return MIL_CAN_NOK;
+    }
+
+    if(pobj->lost){
+        pmailbox->overruns++;
+    }
+
+    len = (pobj->len < pmailbox->msg_len) ? pobj->len : pmailbox->msg_len;
+    for(uint8_t i = 0;i < len;i++){
+        pmailbox->buffer[i] = pobj->data[i];
+    }
+    pmailbox->msg_obj.ui32MsgID = pobj->canid;
+    pmailbox->msg_obj.ui32MsgLen = pobj->len;
+
+    pobj->newdat = false;
+    pobj->lost = false;
+
+    if(pDiag[idx]){
+        MIL_CAN_DiagRx(pDiag[idx], pobj->canid, pobj->len);
+    }
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Will return MIL_CAN_OK for new data
+ *       or MIL_CAN_NOK if there is no data
+ */
+mil_can_status_t MIL_CAN_CheckMail(MIL_CAN_MailBox_t *pmailbox){
+
+    uint8_t idx = MIL_CAN_IDX(pmailbox->base);
+    MIL_CAN_Ring_t *pring = pRxRing[idx];
+
+    MIL_CAN_HostPump(idx);
+
+    if(pring){
+        MIL_CAN_Frame_t *pframe = MIL_CAN_RingPeek(pring);
+        if(pframe && (MIL_CAN_MailMask(pmailbox) & (0x01UL << (pframe->obj_num - 1)))){return MIL_CAN_OK;}
+        else{return MIL_CAN_NOK;}
+    }
+
+    for(uint8_t i = 0;i < MIL_CAN_MailDepth(pmailbox);i++){
+        if(Obj[idx][pmailbox->obj_num - 1 + i].newdat){
+            return MIL_CAN_OK;
+        }
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: Moves received frames to pring from now on
+ *
+ * Notes: CALL THIS BEFORE MIL_InitMailBox
+ */
+void MIL_CAN_RxRingEnable(uint32_t base, MIL_CAN_Ring_t *pring){
+
+    MIL_CAN_RingInit(pring);
+    pRxRing[MIL_CAN_IDX(base)] = pring;
+
+}
+
+/*
+ * Desc: Sets the function used to timestamp frames
+ */
+void MIL_CAN_SetTimeSource(uint32_t (*ptime_fn)(void)){
+
+    pTimeSource = ptime_fn;
+
+}
+
+/*
+ * Desc: Pulls the oldest received frame off the ring
+ *
+ * Returns:
+ * MIL_CAN_OK if a frame was copied
+ * MIL_CAN_NOK if the ring is empty or not enabled
+ */
+mil_can_status_t MIL_CAN_ReadFrame(uint32_t base, MIL_CAN_Frame_t *pframe){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    MIL_CAN_Ring_t *pring = pRxRing[idx];
+
+    MIL_CAN_HostPump(idx);
+
+    if(pring && MIL_CAN_RingPop(pring, pframe)){
+        return MIL_CAN_OK;
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: Turns on handler dispatch for a controller
+ *
+ * Notes: CALL THIS BEFORE MIL_InitMailBox
+ */
+void MIL_CAN_DispatchEnable(uint32_t base, MIL_CAN_Dispatch_t *pd, bool in_isr){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+
+    MIL_CAN_DispatchInit(pd);
+    DispatchInISR[idx] = in_isr;
+    pDispatch[idx] = pd;
+
+}
+
+/*
+ * Desc: Registers a handler for one message type on a mailbox
+ *
+ * Returns:
+ * MIL_CAN_OK if the handler was added
+ * MIL_CAN_NOK if dispatch is off or the table is full
+ */
+mil_can_status_t MIL_CAN_Register(MIL_CAN_MailBox_t *pmailbox, int16_t msg_type,
+                                  mil_can_handler_t phandler, void *pctx){
+
+    MIL_CAN_Dispatch_t *pd = pDispatch[MIL_CAN_IDX(pmailbox->base)];
+
+    if(pd && MIL_CAN_DispatchAdd(pd, pmailbox->obj_num, msg_type, phandler, pctx)){
+        MIL_CAN_DispatchLink(pd, pmailbox->obj_num, MIL_CAN_MailDepth(pmailbox));
+        return MIL_CAN_OK;
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: Runs the handler of every frame waiting in the ring
+ *
+ * Returns: number of frames taken off the ring
+ */
+uint32_t MIL_CAN_DispatchPoll(uint32_t base){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    MIL_CAN_Ring_t *pring = pRxRing[idx];
+    MIL_CAN_Dispatch_t *pd = pDispatch[idx];
+    MIL_CAN_HostObj_t *pobj;
+    MIL_CAN_Frame_t *pframe;
+    MIL_CAN_Frame_t frame;
+    uint32_t pending = 0;
+    uint32_t count = 0;
+    uint8_t obj;
+
+    MIL_CAN_HostPump(idx);
+
+    if(!pd){
+        return 0;
+    }
+
+    if(pring){
+        while((pframe = MIL_CAN_RingPeek(pring)) != 0){
+            MIL_CAN_DispatchFrame(pd, pframe);
+            MIL_CAN_RingDrop(pring);
+            count++;
+        }
+    }
+    else if(!DispatchInISR[idx]){
+        //same NEWDAT walk as the TIVA, lowest object first
+        for(obj = 0;obj < 32;obj++){
+            if(Obj[idx][obj].rx && Obj[idx][obj].newdat){
+                pending |= 0x01UL << obj;
+            }
+        }
+
+        while(pending){
+            obj = MIL_CAN_CTZ(pending) + 1;
+            pending &= pending - 1;
+
+            pobj = &Obj[idx][obj - 1];
+
+            frame.canid = pobj->canid;
+            frame.len = pobj->len;
+            frame.obj_num = obj;
+            frame.flags = pobj->lost ? MIL_CAN_FRAME_LOST_bm : 0;
+            frame.timestamp = MIL_CAN_Now();
+            memcpy(frame.data, pobj->data, pobj->len);
+
+            if(pobj->lost && pobj->pmail){
+                pobj->pmail->overruns++;
+            }
+            pobj->newdat = false;
+            pobj->lost = false;
+
+            if(pDiag[idx]){
+                MIL_CAN_DiagRx(pDiag[idx], frame.canid, frame.len);
+            }
+
+            MIL_CAN_DispatchFrame(pd, &frame);
+            count++;
+        }
+    }
+
+    if(pTP[idx]){
+        MIL_CAN_TPService(pTP[idx], MIL_CAN_Now());
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: Turns on the segmented transport on a mailbox
+ *
+ * Returns:
+ * MIL_CAN_OK if the transport is on
+ * MIL_CAN_NOK if the TX queue or main loop dispatch is missing
+ *             or the dispatch table is full
+ */
+mil_can_status_t MIL_CAN_TPEnable(MIL_CAN_MailBox_t *pmailbox, MIL_CAN_TP_t *ptp, uint32_t tick_hz){
+
+    uint8_t idx = MIL_CAN_IDX(pmailbox->base);
+    MIL_CAN_Dispatch_t *pd = pDispatch[idx];
+
+    //the transport does no locking so it cannot run from the ISR
+    if(!pd || DispatchInISR[idx] || !pTxQ[idx]){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_TPInit(ptp, tick_hz, idx ? &MIL_CAN1_TPSend : &MIL_CAN0_TPSend);
+
+    if(!MIL_CAN_DispatchAddRange(pd, pmailbox->obj_num, MIL_CAN_TP_FIRST_TYPE, MIL_CAN_TP_LAST_TYPE,
+                                 &MIL_CAN_TPHandler, ptp)){
+        return MIL_CAN_NOK;
+    }
+    MIL_CAN_DispatchLink(pd, pmailbox->obj_num, MIL_CAN_MailDepth(pmailbox));
+
+    pTP[idx] = ptp;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Starts sending a message to a transport peer
+ *
+ * Returns:
+ * MIL_CAN_OK if sending started
+ * MIL_CAN_NOK if the session is still busy, the transport is
+ *             off or the first frame did not fit in the queue
+ */
+mil_can_status_t MIL_CAN_TPWrite(uint32_t base, uint8_t session, uint8_t *data, uint16_t len){
+
+    MIL_CAN_TP_t *ptp = pTP[MIL_CAN_IDX(base)];
+
+    if(ptp && MIL_CAN_TPSend(ptp, session, data, len, MIL_CAN_Now())){
+        return MIL_CAN_OK;
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: Forwards frames between CAN0 and CAN1
+ *
+ * Returns:
+ * MIL_CAN_OK if the gateway is on
+ * MIL_CAN_NOK if a TX queue or dispatch is missing or a
+ *             dispatch table is full
+ */
+mil_can_status_t MIL_CAN_GwEnable(MIL_CAN_Gw_t *pgw, MIL_CAN_MailBox_t *pmailbox0,
+                                  MIL_CAN_MailBox_t *pmailbox1, uint32_t tick_hz){
+
+    if(!pTxQ[0] || !pTxQ[1]){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_GwInit(pgw, tick_hz, MIL_CAN_Now());
+
+    //frames are only queued in the handlers, sending waits for MIL_CAN_GwService
+    if(MIL_CAN_Register(pmailbox0, MIL_CAN_ANY_TYPE, &MIL_CAN0_GwHandler, pgw) != MIL_CAN_OK ||
+       MIL_CAN_Register(pmailbox1, MIL_CAN_ANY_TYPE, &MIL_CAN1_GwHandler, pgw) != MIL_CAN_OK){
+        return MIL_CAN_NOK;
+    }
+
+    pGw = pgw;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Sends the queued gateway frames the rate limits allow
+ *
+ * Returns: number of frames forwarded
+ */
+uint32_t MIL_CAN_GwService(void){
+
+    MIL_CAN_Frame_t *pframe;
+    uint32_t now = MIL_CAN_Now();
+    uint32_t count = 0;
+
+    if(!pGw){
+        return 0;
+    }
+
+    for(uint8_t dir = MIL_CAN_GW_0TO1;dir <= MIL_CAN_GW_1TO0;dir++){
+
+        uint32_t out_base = (dir == MIL_CAN_GW_0TO1) ? CAN1_BASE : CAN0_BASE;
+
+        while((pframe = MIL_CAN_GwPeek(pGw, dir, now)) != 0){
+            if(!MIL_CAN_QueueIfClear(out_base, pframe->canid, pframe->data, pframe->len, 0, 0)){
+                break;
+            }
+            MIL_CAN_GwDrop(pGw, dir);
+            count++;
+        }
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: Turns on bus load and error telemetry for a controller
+ */
+void MIL_CAN_DiagEnable(uint32_t base, MIL_CAN_Diag_t *pd, uint32_t tick_hz,
+                        uint32_t report_id, uint32_t report_ms){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    uint32_t now = MIL_CAN_Now();
+
+    MIL_CAN_DiagInit(pd, tick_hz, now);
+
+    DiagReportId[idx] = report_id;
+    DiagReportTicks[idx] = (uint32_t)(((uint64_t)tick_hz * report_ms) / 1000);
+    DiagLastReport[idx] = now;
+    pDiag[idx] = pd;
+
+}
+
+/*
+ * Desc: Sends the 'D' frame once every report period
+ *
+ * Notes: TEC/REC stay 0 unless the interface's driver
+ *        reports them in its error frames
+ */
+mil_can_status_t MIL_CAN_DiagService(uint32_t base){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    MIL_CAN_Diag_t *pd = pDiag[idx];
+    uint8_t report[8];
+    uint32_t now;
+
+    MIL_CAN_HostPump(idx);
+
+    if(!pd){
+        return MIL_CAN_NOK;
+    }
+
+    now = MIL_CAN_Now();
+    if((now - DiagLastReport[idx]) < DiagReportTicks[idx]){
+        return MIL_CAN_NOK;
+    }
+    DiagLastReport[idx] = now;
+
+    MIL_CAN_DiagSnapshot(pd, now, BitRate[idx], ErrTec[idx], ErrRec[idx]);
+    MIL_CAN_DiagEncode(pd, report);
+
+    MIL_CANSimpleTX(DiagReportId[idx], report, 8, base);
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Current time source tick(0 if none was set)
+ */
+static uint32_t MIL_CAN_Now(void){
+
+    return pTimeSource ? pTimeSource() : 0;
+
+}
+
+/*
+ * Desc: Transport and gateway frames go through the TX queue but
+ *       only while its overflow ring is empty, the rest of the ring
+ *       is left for the node's own frames
+ */
+static bool MIL_CAN_QueueIfClear(uint32_t base, uint32_t canid, uint8_t *data, uint8_t len,
+                                 void (*pdone)(uint32_t canid, void *pctx), void *pctx){
+
+    MIL_CAN_TxQ_t *pq = pTxQ[MIL_CAN_IDX(base)];
+
+    if(!pq || pq->ovf_count){
+        return false;
+    }
+
+    return MIL_CANQueueTX(canid, data, len, base, pdone, pctx) == MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Dispatch handler for transport frames
+ */
+static void MIL_CAN_TPHandler(MIL_CAN_Frame_t *pframe, void *pctx){
+
+    MIL_CAN_TPInput((MIL_CAN_TP_t *)pctx, pframe->canid, pframe->data, pframe->len, MIL_CAN_Now());
+
+}
+
+/*
+ * Desc: Number of message objects a mailbox uses
+ */
+static uint8_t MIL_CAN_MailDepth(MIL_CAN_MailBox_t *pmailbox){
+
+    uint8_t depth = pmailbox->fifo_depth ? pmailbox->fifo_depth : 1;
+
+    if(depth > (33 - pmailbox->obj_num)){
+        depth = 33 - pmailbox->obj_num;
+    }
+
+    return depth;
+
+}
+
+/*
+ * Desc: NEWDAT style mask of the message objects a mailbox uses
+ */
+static uint32_t MIL_CAN_MailMask(MIL_CAN_MailBox_t *pmailbox){
+
+    uint32_t mask = 0;
+
+    for(uint8_t i = 0;i < MIL_CAN_MailDepth(pmailbox);i++){
+        mask |= 0x01UL << (pmailbox->obj_num - 1 + i);
+    }
+
+    return mask;
+
+}
+
+/*
+ * Desc: Does what the hardware and the MIL CAN ISR would have
+ *       done since the last call: finishes queued frames, then
+ *       reads every frame waiting on the socket into the message
+ *       objects and, for interrupt driven controllers, on into
+ *       the ring or straight to the ISR handlers
+ */
+static void MIL_CAN_HostPump(uint8_t idx){
+
+    struct can_frame cf;
+
+    if(Sock[idx] < 0){
+        return;
+    }
+
+    MIL_CAN_HostTxService(idx);
+
+    while(read(Sock[idx], &cf, sizeof(cf)) == (ssize_t)sizeof(cf)){
+
+        if(cf.can_id & CAN_ERR_FLAG){
+            MIL_CAN_HostError(idx, &cf);
+        }
+        //drained one frame at a time like the ISR would
+        else if(MIL_CAN_HostStore(idx, &cf) && MIL_CAN_RX_IN_ISR(idx)){
+            MIL_CAN_HostDrain(idx);
+        }
+    }
+
+}
+
+/*
+ * Desc: Puts a frame into the first message object whose filter
+ *       matches, the same way the TIVA message handler does
+ *
+ *       A FIFO object that already holds a frame passes it on to
+ *       the next object, any other object is overwritten and
+ *       marks the loss
+ *
+ * Returns: false if no mailbox takes the frame
+ */
+static bool MIL_CAN_HostStore(uint8_t idx, struct can_frame *pcf){
+
+    MIL_CAN_HostObj_t *pobj;
+    uint32_t canid;
+    uint8_t len;
+
+    //remote frames never reach an RX mailbox
+    if(pcf->can_id & CAN_RTR_FLAG){
+        return false;
+    }
+
+    canid = (pcf->can_id & CAN_EFF_FLAG) ? (pcf->can_id & CAN_EFF_MASK) : (pcf->can_id & CAN_SFF_MASK);
+    len = (pcf->can_dlc > 8) ? 8 : pcf->can_dlc;
+
+    for(uint8_t obj = 0;obj < 32;obj++){
+
+        pobj = &Obj[idx][obj];
+
+        if(!pobj->rx || ((canid & pobj->mask) != (pobj->id & pobj->mask))){
+            continue;
+        }
+
+        if(pobj->fifo && pobj->newdat){
+            continue;
+        }
+
+        pobj->lost = pobj->newdat;
+        pobj->newdat = true;
+        pobj->canid = canid;
+        pobj->len = len;
+        memcpy(pobj->data, pcf->data, len);
+
+        return true;
+    }
+
+    return false;
+
+}
+
+/*
+ * Desc: MIL CAN ISR receive path, moves every object holding
+ *       a frame into the ring or hands it to its ISR handler
+ */
+static void MIL_CAN_HostDrain(uint8_t idx){
+
+    MIL_CAN_Ring_t *pring = pRxRing[idx];
+    MIL_CAN_Dispatch_t *pd = DispatchInISR[idx] ? pDispatch[idx] : 0;
+    MIL_CAN_HostObj_t *pobj;
+    MIL_CAN_Frame_t *pframe;
+    MIL_CAN_Frame_t scratch;
+    uint32_t timestamp = MIL_CAN_Now();
+
+    for(uint8_t obj = 1;obj <= 32;obj++){
+
+        pobj = &Obj[idx][obj - 1];
+
+        if(!pobj->rx || !pobj->newdat){
+            continue;
+        }
+
+        //frames for ISR handlers go to the stack, the rest straight into the ring
+        pframe = (pring && !pd) ? MIL_CAN_RingClaim(pring) : 0;
+        if(!pframe){
+            pframe = &scratch;
+        }
+
+        pframe->canid = pobj->canid;
+        pframe->len = pobj->len;
+        pframe->obj_num = obj;
+        pframe->flags = pobj->lost ? MIL_CAN_FRAME_LOST_bm : 0;
+        pframe->timestamp = timestamp;
+        memcpy(pframe->data, pobj->data, pobj->len);
+
+        pobj->newdat = false;
+        pobj->lost = false;
+
+        if(pDiag[idx]){
+            MIL_CAN_DiagRx(pDiag[idx], pframe->canid, pframe->len);
+        }
+
+        if(pframe != &scratch){
+            MIL_CAN_RingCommit(pring);
+        }
+        else if(pd && !MIL_CAN_DispatchFrame(pd, pframe) && pring){
+            MIL_CAN_RingPush(pring, pframe);
+        }
+        //otherwise the ring was full and the frame is dropped(counted in the ring)
+    }
+
+}
+
+/*
+ * Desc: Turns an error frame into controller state
+ *
+ * Notes: The TIVA restarts itself after a bus-off, on Linux that
+ *        takes ip link set can0 type can restart-ms 100
+ */
+static void MIL_CAN_HostError(uint8_t idx, struct can_frame *pcf){
+
+    uint8_t state = ErrState[idx];
+
+    if(pcf->can_id & CAN_ERR_BUSOFF){
+        state |= MIL_CAN_DIAG_BOFF_bm;
+    }
+
+    if(pcf->can_id & CAN_ERR_RESTARTED){
+        state = 0;
+    }
+
+    if((pcf->can_id & CAN_ERR_CRTL) && pcf->data[1]){
+        state &= MIL_CAN_DIAG_BOFF_bm;
+        if(pcf->data[1] & (CAN_ERR_CRTL_RX_PASSIVE | CAN_ERR_CRTL_TX_PASSIVE)){
+            state |= MIL_CAN_DIAG_PASSIVE_bm;
+        }
+        if(pcf->data[1] & (CAN_ERR_CRTL_RX_WARNING | CAN_ERR_CRTL_TX_WARNING)){
+            state |= MIL_CAN_DIAG_WARN_bm;
+        }
+    }
+
+#ifdef CAN_ERR_CNT
+    if(pcf->can_id & CAN_ERR_CNT){
+        ErrTec[idx] = pcf->data[6];
+        ErrRec[idx] = pcf->data[7];
+    }
+#endif
+
+    if(pDiag[idx] && (state != ErrState[idx])){
+        MIL_CAN_DiagStatus(pDiag[idx], state, MIL_CAN_Now());
+    }
+    ErrState[idx] = state;
+
+}
+
+/*
+ * Desc: Writes one frame to the socket
+ *
+ * Returns: false if the socket did not take it(send buffer full or not open)
+ */
+static bool MIL_CAN_HostWrite(uint8_t idx, uint32_t canid, uint8_t *pdata, uint8_t len){
+
+    struct can_frame cf;
+
+    if(Sock[idx] < 0){
+        return false;
+    }
+
+    memset(&cf, 0, sizeof(cf));
+    cf.can_id = (canid > CAN_SFF_MASK) ? ((canid & CAN_EFF_MASK) | CAN_EFF_FLAG) : canid;
+    cf.can_dlc = (len > 8) ? 8 : len;
+    memcpy(cf.data, pdata, cf.can_dlc);
+
+    return write(Sock[idx], &cf, sizeof(cf)) == (ssize_t)sizeof(cf);
+
+}
+
+/*
+ * Desc: MIL CAN ISR transmit path, writes every queued frame the
+ *       socket will take and finishes it like a TX interrupt would
+ *
+ * Notes: Stops at the first frame the socket refuses so frames
+ *        keep their queue order, the rest go on the next call
+ */
+static void MIL_CAN_HostTxService(uint8_t idx){
+
+    MIL_CAN_TxQ_t *pq = pTxQ[idx];
+    MIL_CAN_TxFrame_t *pframe;
+    MIL_CAN_TxFrame_t sent;
+    uint32_t busy;
+    bool progress;
+
+    //a pdone that queues more frames lands here, the loop below picks them up
+    if(!pq || TxServicing[idx]){
+        return;
+    }
+    TxServicing[idx] = true;
+
+    do{
+        progress = false;
+        busy = MIL_CAN_TxQBusyMask(pq);
+
+        for(uint8_t obj = 1; busy; obj++, busy >>= 1){
+
+            if(!(busy & 0x01)){
+                continue;
+            }
+
+            pframe = MIL_CAN_TxQInflight(pq, obj);
+            if(!MIL_CAN_HostWrite(idx, pframe->canid, pframe->data, pframe->len)){
+                TxServicing[idx] = false;
+                return;
+            }
+
+            MIL_CAN_TxQComplete(pq, obj, &sent);
+
+            if(pDiag[idx]){
+                MIL_CAN_DiagTx(pDiag[idx], sent.canid, sent.len, MIL_CAN_Now() - sent.queued_at);
+            }
+
+            if(sent.pdone){
+                sent.pdone(sent.canid, sent.pctx);
+            }
+
+            progress = true;
+        }
+    }while(progress);
+
+    TxServicing[idx] = false;
+
+}
+
+#endif /* MIL_CAN_SOCKETCAN */
@@ -0,0 +1,483 @@
+/*
+ * Name: MIL_DSP.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Fixed point filters for sampled sensor streams
+ *
+ * Note: MIL_DSP_SMLAD/MIL_DSP_QADD16 are the Cortex-M4 instructions
+ *       where the compiler has them and C that gives the same bits
+ *       everywhere else. Packed words hold the first sample in the
+ *       low half
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include"MIL_DSP.h"
+
+#if defined(__TI_COMPILER_VERSION__) && defined(__TI_ARM_V7M4__)
+
+#define MIL_DSP_SMLAD(x, y, acc) ((uint32_t)_smlad((int32_t)(x), (int32_t)(y), (int32_t)(acc)))
+#define MIL_DSP_QADD16(x, y)     ((uint32_t)_qadd16((int32_t)(x), (int32_t)(y)))
+
+#elif defined(__GNUC__) && defined(__ARM_FEATURE_SIMD32)
+
+#include <arm_acle.h>
+#define MIL_DSP_SMLAD(x, y, acc) ((uint32_t)__smlad((int32_t)(x), (int32_t)(y), (int32_t)(acc)))
+#define MIL_DSP_QADD16(x, y)     ((uint32_t)__qadd16((int32_t)(x), (int32_t)(y)))
+
+#else
+
+/*
+ * Desc: acc + x.lo * y.lo + x.hi * y.hi, wrapping like the instruction
+ */
+static uint32_t MIL_DSP_SMLAD(uint32_t x, uint32_t y, uint32_t acc){
+
+    acc += (uint32_t)((int32_t)(int16_t)x * (int16_t)y);
+    acc += (uint32_t)((int32_t)(int16_t)(x >> 16) * (int16_t)(y >> 16));
+
+    return acc;
+
+}
+
+static int16_t MIL_DSP_Sat16(int32_t v);
+
+/*
+ * Desc: both halves added and saturated on their own
+ */
+static uint32_t MIL_DSP_QADD16(uint32_t x, uint32_t y){
+
+    uint16_t lo = (uint16_t)MIL_DSP_Sat16((int32_t)(int16_t)x + (int16_t)y);
+    uint16_t hi = (uint16_t)MIL_DSP_Sat16((int32_t)(int16_t)(x >> 16) + (int16_t)(y >> 16));
+
+    return lo | ((uint32_t)hi << 16);
+
+}
+
+#endif
+
+//two Q15 values in one word, lo first
+#define MIL_DSP_PACK(lo, hi) ((uint32_t)(uint16_t)(lo) | ((uint32_t)(uint16_t)(hi) << 16))
+
+/*
+ * Desc: Clamps to the Q15 range
+ */
+static int16_t MIL_DSP_Sat16(int32_t v){
+
+    if(v > INT16_MAX){
+        return INT16_MAX;
+    }
+    if(v < INT16_MIN){
+        return INT16_MIN;
+    }
+
+    return (int16_t)v;
+
+}
+
+/*
+ * Desc: Clamps to the Q31 range
+ */
+static int32_t MIL_DSP_Sat32(int64_t v){
+
+    if(v > INT32_MAX){
+        return INT32_MAX;
+    }
+    if(v < INT32_MIN){
+        return INT32_MIN;
+    }
+
+    return (int32_t)v;
+
+}
+
+/*
+ * Desc: log2 of a power of 2, -1 for anything else
+ */
+static int8_t MIL_DSP_Log2(uint32_t v){
+
+    int8_t n = 0;
+
+    if(!v || (v & (v - 1))){
+        return -1;
+    }
+    while(v >>= 1){
+        n++;
+    }
+
+    return n;
+
+}
+
+/*
+ * Desc: Takes one channel out of a MIL_ADC_DMA block as Q15
+ */
+void MIL_DSP_FromADC(const uint16_t *raw, uint8_t stride, int16_t *out, uint16_t count){
+
+    uint16_t i;
+
+    //12 bits up to the top of the Q15 range
+    for(i = 0;i < count;i++){
+        out[i] = (int16_t)((raw[(uint32_t)i * stride] & 0xFFF) << 3);
+    }
+
+}
+
+/*
+ * Desc: Mean of a block
+ */
+int16_t MIL_DSP_MeanQ15(const int16_t *in, uint16_t count){
+
+    uint32_t acc = 0;
+    uint16_t i;
+
+    if(!count){
+        return 0;
+    }
+
+    //two samples per SMLAD, times 1 each
+    for(i = 0;(i + 1) < count;i += 2){
+        acc = MIL_DSP_SMLAD(MIL_DSP_PACK(in[i], in[i + 1]), 0x00010001, acc);
+    }
+    if(i < count){
+        acc += (uint32_t)(int32_t)in[i];
+    }
+
+    return (int16_t)((int32_t)acc / (int32_t)count);
+
+}
+
+/*
+ * Desc: out = a + b, saturated to Q15
+ */
+void MIL_DSP_AddQ15(const int16_t *a, const int16_t *b, int16_t *out, uint16_t count){
+
+    uint32_t sum;
+    uint16_t i;
+
+    for(i = 0;(i + 1) < count;i += 2){
+        sum = MIL_DSP_QADD16(MIL_DSP_PACK(a[i], a[i + 1]), MIL_DSP_PACK(b[i], b[i + 1]));
+        out[i] = (int16_t)sum;
+        out[i + 1] = (int16_t)(sum >> 16);
+    }
+    if(i < count){
+        out[i] = MIL_DSP_Sat16((int32_t)a[i] + b[i]);
+    }
+
+}
+
+/*
+ * Desc: Sets up a moving average
+ *
+ * Returns: false if len is not valid
+ */
+bool MIL_DSP_MAvgQ15Init(MIL_DSP_MAvgQ15_t *pf, int16_t *hist, uint16_t len, int16_t start){
+
+    int8_t shift = MIL_DSP_Log2(len);
+    uint16_t i;
+
+    if(shift < 0){
+        return false;
+    }
+
+    for(i = 0;i < len;i++){
+        hist[i] = start;
+    }
+
+    pf->hist = hist;
+    pf->mask = len - 1;
+    pf->pos = 0;
+    pf->shift = (uint8_t)shift;
+    pf->sum = (int32_t)start << shift;
+
+    return true;
+
+}
+
+bool MIL_DSP_MAvgQ31Init(MIL_DSP_MAvgQ31_t *pf, int32_t *hist, uint16_t len, int32_t start){
+
+    int8_t shift = MIL_DSP_Log2(len);
+    uint16_t i;
+
+    if(shift < 0){
+        return false;
+    }
+
+    for(i = 0;i < len;i++){
+        hist[i] = start;
+    }
+
+    pf->hist = hist;
+    pf->mask = len - 1;
+    pf->pos = 0;
+    pf->shift = (uint8_t)shift;
+    pf->sum = (int64_t)start * len;
+
+    return true;
+
+}
+
+/*
+ * Desc: Filters a block
+ *
+ * Notes: The running sum swaps the oldest sample for the newest,
+ *        two operations per sample whatever len is
+ */
+void MIL_DSP_MAvgQ15(MIL_DSP_MAvgQ15_t *pf, const int16_t *in, int16_t *out, uint16_t count){
+
+    int32_t sum = pf->sum;
+    uint16_t pos = pf->pos;
+    int16_t x;
+    uint16_t i;
+
+    for(i = 0;i < count;i++){
+        x = in[i];
+        sum += x - pf->hist[pos];
+        pf->hist[pos] = x;
+        pos = (pos + 1) & pf->mask;
+        out[i] = (int16_t)(sum >> pf->shift);
+    }
+
+    pf->sum = sum;
+    pf->pos = pos;
+
+}
+
+void MIL_DSP_MAvgQ31(MIL_DSP_MAvgQ31_t *pf, const int32_t *in, int32_t *out, uint16_t count){
+
+    int64_t sum = pf->sum;
+    uint16_t pos = pf->pos;
+    int32_t x;
+    uint16_t i;
+
+    for(i = 0;i < count;i++){
+        x = in[i];
+        sum += (int64_t)x - pf->hist[pos];
+        pf->hist[pos] = x;
+        pos = (pos + 1) & pf->mask;
+        out[i] = (int32_t)(sum >> pf->shift);
+    }
+
+    pf->sum = sum;
+    pf->pos = pos;
+
+}
+
+/*
+ * Desc: Sets up an exponential average
+ */
+void MIL_DSP_EmaQ15Init(MIL_DSP_EmaQ15_t *pf, uint8_t k, int16_t start){
+
+    pf->k = (k < 1) ? 1 : ((k > 15) ? 15 : k);
+    pf->y = (int32_t)start * 65536;
+
+}
+
+void MIL_DSP_EmaQ31Init(MIL_DSP_EmaQ31_t *pf, uint8_t k, int32_t start){
+
+    pf->k = (k < 1) ? 1 : ((k > 31) ? 31 : k);
+    pf->y = start;
+
+}
+
+/*
+ * Desc: Filters a block
+ */
+void MIL_DSP_EmaQ15(MIL_DSP_EmaQ15_t *pf, const int16_t *in, int16_t *out, uint16_t count){
+
+    int32_t y = pf->y;
+    uint16_t i;
+
+    //y is Q31, (x - y) cannot overflow 32 bits once divided by 2^k
+    for(i = 0;i < count;i++){
+        y += (int32_t)((((int64_t)in[i] * 65536) - y) >> pf->k);
+        out[i] = (int16_t)((y + 0x8000) >> 16);
+    }
+
+    pf->y = y;
+
+}
+
+void MIL_DSP_EmaQ31(MIL_DSP_EmaQ31_t *pf, const int32_t *in, int32_t *out, uint16_t count){
+
+    int32_t y = pf->y;
+    uint16_t i;
+
+    for(i = 0;i < count;i++){
+        y += (int32_t)(((int64_t)in[i] - y) >> pf->k);
+        out[i] = y;
+    }
+
+    pf->y = y;
+
+}
+
+/*
+ * Desc: Sets up a biquad stage with cleared history
+ */
+void MIL_DSP_BiquadQ15Init(MIL_DSP_BiquadQ15_t *pf, int16_t b0, int16_t b1, int16_t b2,
+                           int16_t a1, int16_t a2){
+
+    pf->b0b1 = MIL_DSP_PACK(b0, b1);
+    pf->b2a1 = MIL_DSP_PACK(b2, a1);
+    pf->a2 = a2;
+    pf->x1 = 0;
+    pf->x2 = 0;
+    pf->y1 = 0;
+    pf->y2 = 0;
+
+}
+
+void MIL_DSP_BiquadQ31Init(MIL_DSP_BiquadQ31_t *pf, int32_t b0, int32_t b1, int32_t b2,
+                           int32_t a1, int32_t a2){
+
+    pf->b0 = b0;
+    pf->b1 = b1;
+    pf->b2 = b2;
+    pf->a1 = a1;
+    pf->a2 = a2;
+    pf->x1 = 0;
+    pf->x2 = 0;
+    pf->y1 = 0;
+    pf->y2 = 0;
+
+}
+
+/*
+ * Desc: Filters a block
+ *
+ * Notes: Direct form 1, 5 products in 2 SMLADs and a multiply,
+ *        rounded back from Q29 to Q15
+ */
+void MIL_DSP_BiquadQ15(MIL_DSP_BiquadQ15_t *pf, const int16_t *in, int16_t *out, uint16_t count){
+
+    int16_t x1 = pf->x1, x2 = pf->x2, y1 = pf->y1, y2 = pf->y2;
+    int16_t x0;
+    uint32_t acc;
+    uint16_t i;
+
+    for(i = 0;i < count;i++){
+        x0 = in[i];
+
+        acc = MIL_DSP_SMLAD(MIL_DSP_PACK(x0, x1), pf->b0b1, 0x2000);
+        acc = MIL_DSP_SMLAD(MIL_DSP_PACK(x2, y1), pf->b2a1, acc);
+        acc += (uint32_t)((int32_t)pf->a2 * y2);
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = MIL_DSP_Sat16((int32_t)acc >> 14);
+        out[i] = y1;
+    }
+
+    pf->x1 = x1;
+    pf->x2 = x2;
+    pf->y1 = y1;
+    pf->y2 = y2;
+
+}
+
+/*
+ * Desc: Filters a block
+ *
+ * Notes: 64 bit sum(SMLAL on the M4), rounded back from Q61 to Q31
+ */
+void MIL_DSP_BiquadQ31(MIL_DSP_BiquadQ31_t *pf, const int32_t *in, int32_t *out, uint16_t count){
+
+    int32_t x1 = pf->x1, x2 = pf->x2, y1 = pf->y1, y2 = pf->y2;
+    int32_t x0;
+    int64_t acc;
+    uint16_t i;
+
+    for(i = 0;i < count;i++){
+        x0 = in[i];
+
+        acc = (int64_t)1 << 29;
+        acc += (int64_t)pf->b0 * x0;
+        acc += (int64_t)pf->b1 * x1;
+        acc += (int64_t)pf->b2 * x2;
+        acc += (int64_t)pf->a1 * y1;
+        acc += (int64_t)pf->a2 * y2;
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = MIL_DSP_Sat32(acc >> 30);
+        out[i] = y1;
+    }
+
+    pf->x1 = x1;
+    pf->x2 = x2;
+    pf->y1 = y1;
+    pf->y2 = y2;
+
+}
+
+/*
+ * Desc: Sets up a CIC decimator
+ *
+ * Returns: false if order or rate is not valid
+ */
+bool MIL_DSP_CicQ15Init(MIL_DSP_CicQ15_t *pf, uint8_t order, uint16_t rate){
+
+    int8_t bits = MIL_DSP_Log2(rate);
+    uint8_t i;
+
+    //the gain rate^order has to fit above the 16 input bits
+    if(!order || order > MIL_DSP_CIC_MAX_ORDER || bits < 1 || (order * bits) > 16){
+        return false;
+    }
+
+    for(i = 0;i < MIL_DSP_CIC_MAX_ORDER;i++){
+        pf->integ[i] = 0;
+        pf->comb[i] = 0;
+    }
+
+    pf->order = order;
+    pf->shift = order * bits;
+    pf->rate = rate;
+    pf->phase = 0;
+
+    return true;
+
+}
+
+/*
+ * Desc: Decimates a block
+ *
+ * Returns: number of outputs written
+ */
+uint16_t MIL_DSP_CicQ15(MIL_DSP_CicQ15_t *pf, const int16_t *in, int16_t *out, uint16_t count){
+
+    uint32_t v;
+    uint32_t prev;
+    uint16_t produced = 0;
+    uint16_t i;
+    uint8_t s;
+
+    for(i = 0;i < count;i++){
+        //integrators at the input rate
+        v = (uint32_t)(int32_t)in[i];
+        for(s = 0;s < pf->order;s++){
+            pf->integ[s] += v;
+            v = pf->integ[s];
+        }
+
+        if(++pf->phase < pf->rate){
+            continue;
+        }
+        pf->phase = 0;
+
+        //combs at the output rate
+        for(s = 0;s < pf->order;s++){
+            prev = pf->comb[s];
+            pf->comb[s] = v;
+            v -= prev;
+        }
+
+        //exact division by the gain, the result is back in Q15
+        out[produced++] = MIL_DSP_Sat16((int32_t)v >> pf->shift);
+    }
+
+    return produced;
+
+}
@@ -0,0 +1,178 @@
+/*
+ * Name: MIL_LOG.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Tokenised logging that is cheap enough for ISRs
+ *
+ * Note: head/tail count bytes and only go up, the ring index
+ *       is the count masked with the ring size
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/uart.h"
+
+#include"MIL_UART_DMA.h"
+#include"MIL_LOG.h"
+
+#define MIL_LOG_RING_BYTES (MIL_LOG_RING_WORDS * 4)
+#define MIL_LOG_HDR_WORDS  3
+
+static uint32_t LogRing[MIL_LOG_RING_WORDS];
+static volatile uint32_t LogHead;       //written with interrupts off only
+static volatile uint32_t LogTail;       //written by the drain only
+static uint32_t LogSeq;
+static uint32_t LogDrops;
+static uint32_t LogBase;                //0 until MIL_LogInit
+static bool LogDMA;
+static volatile bool LogDMABusy;        //a MIL_UART_DMAWrite out of the ring is running
+static uint32_t LogDMALen;
+static uint32_t (*pLogTime)(void);
+
+static void MIL_LogDMADone(const uint8_t *data, void *pctx);
+
+/*
+ * Desc: Picks the UART the log goes out of
+ */
+void MIL_LogInit(uint32_t base, bool use_dma, uint32_t (*ptime_fn)(void)){
+
+    bool int_off = IntMasterDisable();
+
+    LogHead = 0;
+    LogTail = 0;
+    LogSeq = 0;
+    LogDrops = 0;
+    LogDMA = use_dma;
+    LogDMABusy = false;
+    pLogTime = ptime_fn;
+    LogBase = base;
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+}
+
+/*
+ * Desc: Adds a record to the ring
+ */
+void MIL_LogWrite(const char *fmt, uint8_t nargs, uint32_t a, uint32_t b, uint32_t c, uint32_t d){
+
+    uint32_t words = MIL_LOG_HDR_WORDS + nargs;
+    uint32_t w;
+    bool int_off;
+
+    int_off = IntMasterDisable();
+
+    //room is checked in whole records so the drain never sees half of one
+    if((MIL_LOG_RING_BYTES - (LogHead - LogTail)) < (words * 4)){
+        LogDrops++;
+        LogSeq++;
+        if(!int_off){
+            IntMasterEnable();
+        }
+        return;
+    }
+
+    w = LogHead >> 2;
+    LogRing[w++ % MIL_LOG_RING_WORDS] = ((uint32_t)MIL_LOG_MAGIC << 24) | ((uint32_t)nargs << 16) | (LogSeq++ & 0xFFFF);
+    LogRing[w++ % MIL_LOG_RING_WORDS] = (uint32_t)fmt;
+    LogRing[w++ % MIL_LOG_RING_WORDS] = pLogTime ? pLogTime() : 0;
+
+    //fall through copies exactly nargs words
+    switch(nargs){
+        case 4: LogRing[(w + 3) % MIL_LOG_RING_WORDS] = d;
+        /* fall through */
+        case 3: LogRing[(w + 2) % MIL_LOG_RING_WORDS] = c;
+        /* fall through */
+        case 2: LogRing[(w + 1) % MIL_LOG_RING_WORDS] = b;
+        /* fall through */
+        case 1: LogRing[w % MIL_LOG_RING_WORDS] = a;
+        default: break;
+    }
+
+    LogHead += words * 4;
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+}
+
+/*
+ * Desc: Sends whatever the UART can take right now
+ *
+ * Returns: number of bytes handed to the UART
+ */
+uint32_t MIL_LogService(void){
+
+    uint8_t *pbytes = (uint8_t *)LogRing;
+    uint32_t head = LogHead;
+    uint32_t tail = LogTail;
+    uint32_t off;
+    uint32_t len;
+
+    if(!LogBase || head == tail){
+        return 0;
+    }
+
+    if(LogDMA){
+        if(LogDMABusy){
+            return 0;
+        }
+
+        //the uDMA reads straight out of the ring, up to its end
+        off = tail % MIL_LOG_RING_BYTES;
+        len = head - tail;
+        if(len > (MIL_LOG_RING_BYTES - off)){
+            len = MIL_LOG_RING_BYTES - off;
+        }
+        if(len > MIL_UART_DMA_MAX_WRITE){
+            len = MIL_UART_DMA_MAX_WRITE;
+        }
+
+        LogDMALen = len;
+        LogDMABusy = true;
+        if(MIL_UART_DMAWrite(LogBase, pbytes + off, len, &MIL_LogDMADone, 0) != MIL_UART_OK){
+            LogDMABusy = false;
+            return 0;
+        }
+
+        return len;
+    }
+
+    //no uDMA, top up the FIFO and come back later
+    while(tail != head && UARTCharPutNonBlocking(LogBase, pbytes[tail % MIL_LOG_RING_BYTES])){
+        tail++;
+    }
+
+    len = tail - LogTail;
+    LogTail = tail;
+
+    return len;
+
+}
+
+/*
+ * Desc: Number of records dropped because the ring was full
+ */
+uint32_t MIL_LogDropped(void){
+
+    return LogDrops;
+
+}
+
+/*
+ * Desc: The ring part the uDMA was sending is free again
+ */
+static void MIL_LogDMADone(const uint8_t *data, void *pctx){
+
+    (void)data;
+    (void)pctx;
+
+    LogTail += LogDMALen;
+    LogDMABusy = false;
+
+}
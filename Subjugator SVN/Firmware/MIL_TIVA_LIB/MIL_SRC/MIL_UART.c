@@ -80,6 +80,18 @@
 #include "utils/uartstdio.h"
 
 #include"MIL_UART.h"
+#include"MIL_CLK.h"
+
+//UART0_BASE to UART7_BASE are 0x1000 apart
+#define MIL_UART_IDX(base) (((base) - UART0_BASE) >> 12)
+
+//RS485 driver enable of every UART
+static uint32_t DEPort[8];      //0 when a UART has no DE pin
+static uint8_t  DEPin[8];
+static uint32_t DESetup[8];     //SysCtlDelay counts
+static uint32_t DEHold[8];      //SysCtlDelay counts
+
+static uint32_t MIL_UART_UsToDelay(uint32_t us);
 
 /*
  * Desc: Enables a specified UART base
@@ -195,7 +207,7 @@ void MIL_InitUART(uint32_t base,uint32_t baud_rate){
     };
 
     UARTConfigSetExpClk(base ,
-                        SysCtlClockGet(),
+                        MIL_ClkGetHz(),
                         baud_rate,
                        (UART_CONFIG_WLEN_8 |
                         UART_CONFIG_STOP_ONE |
@@ -295,3 +307,116 @@ void MIL_UART_FIFOEn(uint32_t base, uint8_t int_depth){
     UARTFIFOEnable(base);
 }
 
+/*
+ * Desc: Puts a UART in 9 bit multi-drop mode, the hardware
+ *       only lets data addressed to us through
+ *
+ * Parameters:
+ *       base: UART TIVA base UARTx_BASE(where x is 0 to 7)
+ *       addr: this board's address
+ *       mask: address bits that have to match
+ */
+void MIL_UART_9BitInit(uint32_t base, uint8_t addr, uint8_t mask){
+
+    UART9BitAddrSet(base, addr, mask);
+    UART9BitEnable(base);
+
+    //the 9th bit is sent as a stuck parity bit, 0 marks data
+    UARTParityModeSet(base, UART_CONFIG_PAR_ZERO);
+
+}
+
+/*
+ * Desc: Gives a UART an RS485 driver enable pin
+ *
+ * Parameters:
+ *       base: UART TIVA base UARTx_BASE(where x is 0 to 7)
+ *       gpio_base: GPIO_PORTx_BASE of the DE pin
+ *       pin: GPIO_PIN_x of the DE pin
+ *       setup_us/hold_us: wait after raising/before dropping DE
+ */
+void MIL_UART_RS485Init(uint32_t base, uint32_t gpio_base, uint8_t pin,
+                        uint32_t setup_us, uint32_t hold_us){
+
+    uint32_t idx = MIL_UART_IDX(base);
+
+    if(base < UART0_BASE || idx > 7){
+        return;
+    }
+
+    switch(gpio_base){
+
+        case GPIO_PORTA_BASE: SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOA); break;
+        case GPIO_PORTB_BASE: SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOB); break;
+        case GPIO_PORTC_BASE: SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOC); break;
+        case GPIO_PORTD_BASE: SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD); break;
+        case GPIO_PORTE_BASE: SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOE); break;
+        case GPIO_PORTF_BASE: SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF); break;
+        default: return;
+
+    };
+
+    //receive until we have something to say
+    GPIOPinTypeGPIOOutput(gpio_base, pin);
+    GPIOPinWrite(gpio_base, pin, 0);
+
+    DEPin[idx] = pin;
+    DESetup[idx] = MIL_UART_UsToDelay(setup_us);
+    DEHold[idx] = MIL_UART_UsToDelay(hold_us);
+    DEPort[idx] = gpio_base;
+
+}
+
+/*
+ * Desc: Sends a message to one board on a 9 bit bus
+ *
+ * NOTE: THIS WAITS UNTIL THE LAST BYTE HAS LEFT THE UART
+ *
+ * Parameters:
+ *       base: UART TIVA base UARTx_BASE(where x is 0 to 7)
+ *       addr: address of the board to talk to
+ *       data/len: message
+ */
+void MIL_UART_9BitSend(uint32_t base, uint8_t addr, const uint8_t *data, uint16_t len){
+
+    uint32_t idx = MIL_UART_IDX(base);
+    uint32_t de_port = (base >= UART0_BASE && idx <= 7) ? DEPort[idx] : 0;
+
+    if(de_port){
+        GPIOPinWrite(de_port, DEPin[idx], DEPin[idx]);
+        if(DESetup[idx]){
+            SysCtlDelay(DESetup[idx]);
+        }
+    }
+
+    //waits for the address to leave, then data goes out with the 9th bit clear
+    UART9BitAddrSend(base, addr);
+
+    while(len--){
+        UARTCharPut(base, *data++);
+    }
+
+    //BUSY only clears once the last stop bit is on the wire
+    while(UARTBusy(base));
+
+    if(de_port){
+        if(DEHold[idx]){
+            SysCtlDelay(DEHold[idx]);
+        }
+        GPIOPinWrite(de_port, DEPin[idx], 0);
+    }
+
+}
+
+/*
+ * Desc: Microseconds to SysCtlDelay counts(3 cycles each), rounded up
+ */
+static uint32_t MIL_UART_UsToDelay(uint32_t us){
+
+    if(!us){
+        return 0;
+    }
+
+    return (uint32_t)(((uint64_t)MIL_ClkGetHz() * us + 2999999) / 3000000);
+
+}
@@ -0,0 +1,185 @@
+/*
+ * Name: MIL_TIME.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Microsecond timebase, cycle counter and timed events
+ *
+ * What to understand: SysCtlDelay spins the CPU for a number of loops,
+ *                     so nothing else runs while it waits and the wait
+ *                     changes length whenever the clock does.
+ *
+ *                     This module takes one wide timer(WTIMER5 unless
+ *                     you set MIL_TIME_BASE) and splits it in two:
+ *
+ *                     TIMER A - counts microseconds forever, the ISR adds
+ *                               the top 32 bits every 71 minutes, so
+ *                               MIL_TimeNowUs never wraps
+ *                     TIMER B - one shot, wakes up for the next timed
+ *                               event and nothing else
+ *
+ *                     Instead of waiting you either:
+ *                     -set a MIL_Deadline_t and check it from your loop
+ *                     -start a MIL_TimeEvent_t and a callback runs when
+ *                      it is due(once, or every period)
+ *
+ *                     The DWT cycle counter(MIL_CYC_NOW) counts single
+ *                     CPU cycles for timing short pieces of code.
+ *
+ * CLOCK NOTE: Call MIL_TimeInit after the clock is set(MIL_CLK), the
+ *             timer ticks once every MIL_ClkGetHz() / 1000000 cycles so
+ *             clocks that are not a whole number of MHz run slightly off
+ *
+ * CALLBACK NOTE: Event callbacks run in the timer ISR, keep them short.
+ *                They may start or stop any event, themselves included
+ *
+ * HOW TO USE:
+ *   static MIL_TimeEvent_t led_ev;
+ *   static MIL_Deadline_t  rx_timeout;
+ *
+ *   MIL_TimeInit();
+ *   MIL_TimeEventStart(&led_ev, 0, 500000, &LedToggle, 0);  //every 0.5s
+ *   MIL_DeadlineSet(&rx_timeout, 20000);                    //20ms from now
+ *
+ *   while(1){
+ *     if(MIL_DeadlineExpired(&rx_timeout)){ ... }
+ *   }
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/sysctl.h"
+
+#ifndef MIL_TIME_H_
+#define MIL_TIME_H_
+
+//wide timer used by the timebase(set all four to move it)
+#ifndef MIL_TIME_BASE
+#define MIL_TIME_BASE   WTIMER5_BASE
+#define MIL_TIME_PERIPH SYSCTL_PERIPH_WTIMER5
+#define MIL_TIME_INT_A  INT_WTIMER5A
+#define MIL_TIME_INT_B  INT_WTIMER5B
+#endif
+
+//Cortex-M4 debug registers for the cycle counter
+#define MIL_DEMCR       0xE000EDFC
+#define MIL_DEMCR_TRCENA 0x01000000
+#define MIL_DWT_CTRL    0xE0001000
+#define MIL_DWT_CYCCNTENA 0x00000001
+#define MIL_DWT_CYCCNT  0xE0001004
+
+//CPU cycles since MIL_CycInit, wraps every 2^32 cycles
+#define MIL_CYC_NOW()   HWREG(MIL_DWT_CYCCNT)
+
+/*
+ * Desc: called from the timer ISR when an event is due
+ */
+typedef void (*mil_time_cb_t)(void *pctx);
+
+/*
+ * Desc: a point in time to poll against(do not touch fields directly)
+ */
+typedef struct{
+
+  uint64_t at;
+
+}MIL_Deadline_t;
+
+/*
+ * Desc: a timed callback(do not touch fields directly)
+ */
+typedef struct MIL_TimeEvent_s{
+
+  uint64_t at;
+  uint32_t period;
+  mil_time_cb_t pcb;
+  void *pctx;
+  bool armed;
+  struct MIL_TimeEvent_s *pnext;
+
+}MIL_TimeEvent_t;
+
+/*
+ * Desc: Starts the microsecond timebase and the cycle counter,
+ *       safe to call more than once
+ */
+void MIL_TimeInit(void);
+
+/*
+ * Desc: Microseconds since MIL_TimeInit
+ */
+uint64_t MIL_TimeNowUs(void);
+
+/*
+ * Desc: Low 32 bits of MIL_TimeNowUs(wraps every 71 minutes)
+ *
+ * Notes: Cheaper than MIL_TimeNowUs and fits the time source of
+ *        MIL_LogInit and MIL_CAN_SetTimeSource(1000000 ticks/s)
+ */
+uint32_t MIL_TimeNowUs32(void);
+
+/*
+ * Desc: Spins for us microseconds
+ *
+ * Notes: This still blocks, only use it for waits too short to be
+ *        worth an event(a few microseconds on a bus line)
+ */
+void MIL_TimeWaitUs(uint32_t us);
+
+/*
+ * Desc: Sets a deadline us microseconds from now
+ */
+void MIL_DeadlineSet(MIL_Deadline_t *pdl, uint32_t us);
+
+/*
+ * Desc: Moves a deadline us microseconds past where it was
+ *
+ * Notes: Use this for steady periods, the time your loop took to
+ *        notice does not add up
+ */
+void MIL_DeadlineAdvance(MIL_Deadline_t *pdl, uint32_t us);
+
+/*
+ * Desc: true once the deadline has passed
+ */
+bool MIL_DeadlineExpired(const MIL_Deadline_t *pdl);
+
+/*
+ * Desc: Starts(or restarts) a timed event
+ *
+ * Parameters:
+ * pev - your event, must start zeroed(static) and stay in scope while it is running
+ * delay_us - first call this many microseconds from now(0 for as soon as possible)
+ * period_us - then every period_us(0 for once)
+ * pcb - callback
+ * pctx - handed to the callback
+ *
+ * Notes: A periodic event that falls a whole period behind skips the
+ *        calls it missed instead of running them back to back
+ */
+void MIL_TimeEventStart(MIL_TimeEvent_t *pev, uint32_t delay_us, uint32_t period_us,
+                        mil_time_cb_t pcb, void *pctx);
+
+/*
+ * Desc: Stops an event, nothing happens if it is not running
+ */
+void MIL_TimeEventStop(MIL_TimeEvent_t *pev);
+
+/*
+ * Desc: true while the event is waiting to be called
+ */
+bool MIL_TimeEventRunning(const MIL_TimeEvent_t *pev);
+
+/*
+ * Desc: Turns on the DWT cycle counter(MIL_TimeInit does this too)
+ */
+void MIL_CycInit(void);
+
+/*
+ * Desc: CPU cycles to microseconds at the current clock
+ */
+uint32_t MIL_CycToUs(uint32_t cycles);
+
+#endif /* MIL_TIME_H_ */
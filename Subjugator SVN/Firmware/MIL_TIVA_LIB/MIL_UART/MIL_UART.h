@@ -103,6 +103,7 @@
 //completely arbitrary
 #define MIL_RX_INT_EN UART_INT_RX
 #define MIL_TX_INT_EN UART_INT_TX
+#define MIL_9BIT_INT_EN UART_INT_9BIT
 
 /*
  * Desc: Enables a specified UART base
@@ -176,5 +177,62 @@ void MIL_UART_InitISR(uint32_t base,uint32_t int_flags,void (*pISR)(void));
  */
 void MIL_UART_FIFOEn(uint32_t base, uint8_t int_depth);
 
+/*
+ * Desc: Puts a UART in 9 bit multi-drop mode(for RS485 buses
+ *       shared by several boards)
+ *
+ *       Every byte carries a 9th bit. Bytes with it set are
+ *       addresses, the rest are data. The hardware compares every
+ *       address with ours and only lets data through after a match,
+ *       everything meant for other boards is dropped without an
+ *       interrupt
+ *
+ * 9 BIT NOTE: The address byte that matched is the first byte you
+ *             read and raises MIL_9BIT_INT_EN, so you can tell where
+ *             a message starts. Use MIL_UART_9BitSend to send, plain
+ *             UARTCharPut would send everything as data
+ *
+ * Parameters:
+ *       base: UART TIVA base UARTx_BASE(where x is 0 to 7)
+ *       addr: this board's address
+ *       mask: address bits that have to match(0xFF for an exact
+ *             match, clear low bits to answer a group of addresses)
+ */
+void MIL_UART_9BitInit(uint32_t base, uint8_t addr, uint8_t mask);
+
+/*
+ * Desc: Gives a UART an RS485 driver enable(DE) pin. The pin is
+ *       high while we send and low(receive) the rest of the time
+ *
+ * Timing Note: setup_us is waited after DE goes high before the first
+ *              bit and hold_us after the last stop bit has left before
+ *              DE goes low. Most transceivers need 0-1us, long or
+ *              terminated lines a bit more. Releasing late lets the
+ *              other board's reply collide with our driver
+ *
+ * Parameters:
+ *       base: UART TIVA base UARTx_BASE(where x is 0 to 7)
+ *       gpio_base: GPIO_PORTx_BASE of the DE pin
+ *       pin: GPIO_PIN_x of the DE pin
+ *       setup_us/hold_us: see Timing Note
+ */
+void MIL_UART_RS485Init(uint32_t base, uint32_t gpio_base, uint8_t pin,
+                        uint32_t setup_us, uint32_t hold_us);
+
+/*
+ * Desc: Sends a message to one board on a 9 bit bus, the address
+ *       byte first then the data, with DE around it if
+ *       MIL_UART_RS485Init was called
+ *
+ * NOTE: THIS WAITS UNTIL THE LAST BYTE HAS LEFT THE UART
+ *       (about 87us per byte at 115.2k) SO DE IS RELEASED ON TIME
+ *
+ * Parameters:
+ *       base: UART TIVA base UARTx_BASE(where x is 0 to 7)
+ *       addr: address of the board to talk to
+ *       data/len: message
+ */
+void MIL_UART_9BitSend(uint32_t base, uint8_t addr, const uint8_t *data, uint16_t len);
+
 
 #endif /* MIL_UART_H_ */
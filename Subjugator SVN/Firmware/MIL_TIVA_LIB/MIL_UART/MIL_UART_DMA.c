@@ -0,0 +1,551 @@
+/*
+ * Name: MIL_UART_DMA.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: UART transport that moves bytes with the uDMA instead
+ *       of one interrupt per byte
+ *
+ * Note: On the TM4C123 a finished uDMA transfer raises the UART's
+ *       own interrupt(it cannot be masked in the UART), so one ISR
+ *       handles RX halves, the receive timeout, errors and TX batches
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_uart.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/uart.h"
+#include "driverlib/udma.h"
+
+#include"MIL_DMA.h"
+#include"MIL_UART.h"
+#include"MIL_UART_DMA.h"
+
+//UART0_BASE to UART7_BASE are 0x1000 apart
+#define MIL_UART_IDX(base) (((base) - UART0_BASE) >> 12)
+
+#define MIL_UART_ERR_INTS (UART_INT_OE | UART_INT_BE | UART_INT_PE | UART_INT_FE)
+
+//RX and TX uDMA channel of every UART
+static const uint32_t DMAMap[8][2] = {
+    {UDMA_CH8_UART0RX,  UDMA_CH9_UART0TX},
+    {UDMA_CH22_UART1RX, UDMA_CH23_UART1TX},
+    {UDMA_CH12_UART2RX, UDMA_CH13_UART2TX},
+    {UDMA_CH16_UART3RX, UDMA_CH17_UART3TX},
+    {UDMA_CH18_UART4RX, UDMA_CH19_UART4TX},
+    {UDMA_CH6_UART5RX,  UDMA_CH7_UART5TX},
+    {UDMA_CH10_UART6RX, UDMA_CH11_UART6TX},
+    {UDMA_CH20_UART7RX, UDMA_CH21_UART7TX}
+};
+
+static MIL_UART_DMA_t *pUART[8];        //0 while a UART is not on the uDMA
+
+static void MIL_UART_DMAISR(uint8_t idx);
+static void MIL_UART0_DMAISR(void){ MIL_UART_DMAISR(0); }
+static void MIL_UART1_DMAISR(void){ MIL_UART_DMAISR(1); }
+static void MIL_UART2_DMAISR(void){ MIL_UART_DMAISR(2); }
+static void MIL_UART3_DMAISR(void){ MIL_UART_DMAISR(3); }
+static void MIL_UART4_DMAISR(void){ MIL_UART_DMAISR(4); }
+static void MIL_UART5_DMAISR(void){ MIL_UART_DMAISR(5); }
+static void MIL_UART6_DMAISR(void){ MIL_UART_DMAISR(6); }
+static void MIL_UART7_DMAISR(void){ MIL_UART_DMAISR(7); }
+static void (*const DMAISR[8])(void) = {
+    MIL_UART0_DMAISR, MIL_UART1_DMAISR, MIL_UART2_DMAISR, MIL_UART3_DMAISR,
+    MIL_UART4_DMAISR, MIL_UART5_DMAISR, MIL_UART6_DMAISR, MIL_UART7_DMAISR
+};
+static MIL_UART_DMA_t *MIL_UART_DMAOf(uint32_t base);
+static void MIL_UART_DMARxArm(MIL_UART_DMA_t *pdma, uint32_t select);
+static void MIL_UART_DMARxDrain(MIL_UART_DMA_t *pdma);
+static uint32_t MIL_UART_DMAHead(MIL_UART_DMA_t *pdma);
+static uint32_t MIL_UART_DMAWaiting(MIL_UART_DMA_t *pdma);
+static void MIL_UART_DMATxStart(MIL_UART_DMA_t *pdma);
+
+/*
+ * Desc: Moves a UART over to the uDMA
+ *
+ * Returns:
+ * MIL_UART_OK if the UART runs on the uDMA
+ * MIL_UART_NOK if base or rx_size is not valid
+ */
+mil_uart_status_t MIL_UART_DMAInit(uint32_t base, MIL_UART_DMA_t *pdma, uint8_t *rx_buf,
+                                   uint16_t rx_size, mil_uart_rx_t prx){
+
+    uint8_t idx;
+
+    if(base < UART0_BASE || base > UART7_BASE || (base & 0xFFF)){
+        return MIL_UART_NOK;
+    }
+    if(rx_size < 2 || rx_size > (2 * MIL_UART_DMA_MAX_WRITE) || (rx_size & 1)){
+        return MIL_UART_NOK;
+    }
+    idx = MIL_UART_IDX(base);
+
+    pdma->base = base;
+    pdma->rx_buf = rx_buf;
+    pdma->rx_size = rx_size;
+    pdma->rx_half = rx_size / 2;
+    pdma->rx_alt = false;
+    pdma->rx_done = 0;
+    pdma->rx_tail = 0;
+    pdma->prx = prx;
+    pdma->tx_head = 0;
+    pdma->tx_tail = 0;
+    pdma->tx_queued = 0;
+    pdma->tx_count = 0;
+    pdma->stats.rx_bytes = 0;
+    pdma->stats.rx_lost = 0;
+    pdma->stats.rx_errors = 0;
+    pdma->stats.tx_bytes = 0;
+
+    MIL_DMAInit();
+    pdma->rx_ch = MIL_DMAChannelAssign(DMAMap[idx][0]);
+    pdma->tx_ch = MIL_DMAChannelAssign(DMAMap[idx][1]);
+
+    //RX: both halves armed, burst requests only so the bytes of a burst that
+    //never reach the FIFO level stay behind and raise the receive timeout
+    uDMAChannelAttributeDisable(pdma->rx_ch, UDMA_ATTR_ALL);
+    uDMAChannelAttributeEnable(pdma->rx_ch, UDMA_ATTR_USEBURST | UDMA_ATTR_HIGH_PRIORITY);
+    MIL_UART_DMARxArm(pdma, UDMA_PRI_SELECT);
+    MIL_UART_DMARxArm(pdma, UDMA_ALT_SELECT);
+
+    //TX: tasks are set up per batch
+    uDMAChannelAttributeDisable(pdma->tx_ch, UDMA_ATTR_ALL);
+
+    //the uDMA is only asked for data once the FIFO is half full/empty
+    MIL_UART_FIFOEn(base, 4);
+
+    pUART[idx] = pdma;
+
+    UARTIntRegister(base, DMAISR[idx]);
+    UARTIntEnable(base, UART_INT_RT | MIL_UART_ERR_INTS);
+    UARTDMAEnable(base, UART_DMA_RX | UART_DMA_TX);
+
+    uDMAChannelEnable(pdma->rx_ch);
+
+    return MIL_UART_OK;
+
+}
+
+/*
+ * Desc: Number of received bytes waiting to be read
+ */
+uint16_t MIL_UART_DMAAvailable(uint32_t base){
+
+    MIL_UART_DMA_t *pdma = MIL_UART_DMAOf(base);
+    uint32_t avail;
+    bool int_off;
+
+    if(!pdma){
+        return 0;
+    }
+
+    int_off = IntMasterDisable();
+    avail = MIL_UART_DMAHead(pdma) - pdma->rx_tail;
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    return (avail > pdma->rx_size) ? pdma->rx_size : avail;
+
+}
+
+/*
+ * Desc: Copies out received bytes
+ *
+ * Returns: number of bytes copied
+ */
+uint16_t MIL_UART_DMARead(uint32_t base, uint8_t *data, uint16_t max){
+
+    MIL_UART_DMA_t *pdma = MIL_UART_DMAOf(base);
+    uint32_t avail;
+    uint16_t pos;
+    uint16_t count;
+
+    if(!pdma){
+        return 0;
+    }
+
+    avail = MIL_UART_DMAWaiting(pdma);
+    if(avail > max){
+        avail = max;
+    }
+
+    pos = pdma->rx_tail % pdma->rx_size;
+    for(count = 0;count < avail;count++){
+        data[count] = pdma->rx_buf[pos];
+        if(++pos == pdma->rx_size){
+            pos = 0;
+        }
+    }
+
+    pdma->rx_tail += count;
+    pdma->stats.rx_bytes += count;
+
+    return count;
+
+}
+
+/*
+ * Desc: Hands every received byte to a packet parser
+ *       straight from the uDMA buffer
+ *
+ * Returns: number of bytes handed to the parser
+ */
+uint16_t MIL_UART_PktPoll(uint32_t base, MIL_UART_Pkt_t *pp){
+
+    MIL_UART_DMA_t *pdma = MIL_UART_DMAOf(base);
+    uint32_t avail;
+    uint32_t first;
+    uint16_t pos;
+
+    if(!pdma){
+        return 0;
+    }
+
+    avail = MIL_UART_DMAWaiting(pdma);
+    pos = pdma->rx_tail % pdma->rx_size;
+
+    //at most two pieces, up to the end of the buffer and from its start
+    first = pdma->rx_size - pos;
+    if(first > avail){
+        first = avail;
+    }
+    MIL_UART_PktFeed(pp, pdma->rx_buf + pos, first);
+    MIL_UART_PktFeed(pp, pdma->rx_buf, avail - first);
+
+    pdma->rx_tail += avail;
+    pdma->stats.rx_bytes += avail;
+
+    return avail;
+
+}
+
+/*
+ * Desc: Queues a buffer to send
+ *
+ * Returns:
+ * MIL_UART_OK if the buffer was queued
+ * MIL_UART_NOK if the queue is full, len is out of range or
+ *              the UART was never set up
+ */
+mil_uart_status_t MIL_UART_DMAWrite(uint32_t base, const uint8_t *data, uint16_t len,
+                                    mil_uart_done_t pdone, void *pctx){
+
+    MIL_UART_DMA_t *pdma = MIL_UART_DMAOf(base);
+    MIL_UART_DMATx_t *ptx;
+    bool int_off;
+
+    if(!pdma || len == 0 || len > MIL_UART_DMA_MAX_WRITE){
+        return MIL_UART_NOK;
+    }
+
+    //the ISR takes entries off and starts the next batch
+    int_off = IntMasterDisable();
+
+    if(pdma->tx_queued >= MIL_UART_DMA_TXQ_LEN){
+        if(!int_off){
+            IntMasterEnable();
+        }
+        return MIL_UART_NOK;
+    }
+
+    ptx = &pdma->txq[pdma->tx_head];
+    ptx->data = data;
+    ptx->len = len;
+    ptx->pdone = pdone;
+    ptx->pctx = pctx;
+    pdma->tx_head = (pdma->tx_head + 1) % MIL_UART_DMA_TXQ_LEN;
+    pdma->tx_queued++;
+
+    //idle uDMA starts now, a busy one picks this up with the next batch
+    MIL_UART_DMATxStart(pdma);
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    return MIL_UART_OK;
+
+}
+
+/*
+ * Desc: true while anything is queued or being sent
+ */
+bool MIL_UART_DMATxBusy(uint32_t base){
+
+    MIL_UART_DMA_t *pdma = MIL_UART_DMAOf(base);
+
+    return pdma && pdma->tx_queued;
+
+}
+
+/*
+ * Desc: Copies out the counters
+ *
+ * Returns:
+ * MIL_UART_OK if the counters were copied
+ * MIL_UART_NOK if the UART was never set up
+ */
+mil_uart_status_t MIL_UART_DMAStatsGet(uint32_t base, MIL_UART_DMAStats_t *pstats){
+
+    MIL_UART_DMA_t *pdma = MIL_UART_DMAOf(base);
+    bool int_off;
+
+    if(!pdma){
+        return MIL_UART_NOK;
+    }
+
+    int_off = IntMasterDisable();
+    *pstats = pdma->stats;
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    return MIL_UART_OK;
+
+}
+
+/*
+ * Desc: State of a UART, 0 if it is not on the uDMA
+ */
+static MIL_UART_DMA_t *MIL_UART_DMAOf(uint32_t base){
+
+    if(base < UART0_BASE || base > UART7_BASE){
+        return 0;
+    }
+
+    return pUART[MIL_UART_IDX(base)];
+
+}
+
+/*
+ * Desc: Points the primary(first half) or alternate(second half)
+ *       structure back at its half of the buffer
+ */
+static void MIL_UART_DMARxArm(MIL_UART_DMA_t *pdma, uint32_t select){
+
+    uint8_t *pdst = pdma->rx_buf + ((select == UDMA_ALT_SELECT) ? pdma->rx_half : 0);
+
+    //one burst empties the FIFO down from its half full request level
+    uDMAChannelControlSet(pdma->rx_ch | select,
+                          UDMA_SIZE_8 | UDMA_SRC_INC_NONE | UDMA_DST_INC_8 | UDMA_ARB_8);
+    uDMAChannelTransferSet(pdma->rx_ch | select, UDMA_MODE_PINGPONG,
+                           (void *)(pdma->base + UART_O_DR), pdst, pdma->rx_half);
+
+}
+
+/*
+ * Desc: Reads the bytes left in the RX FIFO into the half the uDMA
+ *       is filling and moves the uDMA on past them, so they count
+ *       the same as bytes the uDMA moved itself
+ *
+ * Notes: Call from the ISR only
+ */
+static void MIL_UART_DMARxDrain(MIL_UART_DMA_t *pdma){
+
+    uint32_t select;
+    uint32_t left;
+    uint8_t *pdst;
+
+    //no burst may write the buffer while the CPU does
+    uDMAChannelDisable(pdma->rx_ch);
+
+    while(UARTCharsAvail(pdma->base)){
+
+        select = pdma->rx_alt ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+        left = uDMAChannelSizeGet(pdma->rx_ch | select);
+
+        if(left){
+            pdst = pdma->rx_buf + (pdma->rx_alt ? pdma->rx_half : 0) + (pdma->rx_half - left);
+            *pdst = (uint8_t)UARTCharGetNonBlocking(pdma->base);
+            left--;
+        }
+
+        if(left){
+            //the uDMA carries on with the next byte of the half
+            uDMAChannelTransferSet(pdma->rx_ch | select, UDMA_MODE_PINGPONG,
+                                   (void *)(pdma->base + UART_O_DR), pdst + 1, left);
+        }
+        else{
+            //the half is full, switch halves the way the uDMA would have
+            pdma->rx_done += pdma->rx_half;
+            MIL_UART_DMARxArm(pdma, select);
+            pdma->rx_alt = !pdma->rx_alt;
+            if(pdma->rx_alt){
+                uDMAChannelAttributeEnable(pdma->rx_ch, UDMA_ATTR_ALTSELECT);
+            }
+            else{
+                uDMAChannelAttributeDisable(pdma->rx_ch, UDMA_ATTR_ALTSELECT);
+            }
+        }
+    }
+
+    uDMAChannelEnable(pdma->rx_ch);
+
+}
+
+/*
+ * Desc: Bytes received so far, only goes up
+ *
+ * Notes: Call with interrupts off or from the ISR
+ */
+static uint32_t MIL_UART_DMAHead(MIL_UART_DMA_t *pdma){
+
+    uint32_t left = uDMAChannelSizeGet(pdma->rx_ch | (pdma->rx_alt ? UDMA_ALT_SELECT : UDMA_PRI_SELECT));
+
+    return pdma->rx_done + (pdma->rx_half - left);
+
+}
+
+/*
+ * Desc: Bytes waiting to be read, anything older than one buffer
+ *       has been written over and is skipped(and counted)
+ */
+static uint32_t MIL_UART_DMAWaiting(MIL_UART_DMA_t *pdma){
+
+    uint32_t head;
+    uint32_t avail;
+    bool int_off;
+
+    //rx_done and the active half only change in the ISR
+    int_off = IntMasterDisable();
+    head = MIL_UART_DMAHead(pdma);
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    avail = head - pdma->rx_tail;
+    if(avail > pdma->rx_size){
+        pdma->stats.rx_lost += avail - pdma->rx_size;
+        pdma->rx_tail = head - pdma->rx_size;
+        avail = pdma->rx_size;
+    }
+
+    return avail;
+
+}
+
+/*
+ * Desc: Sends every queued buffer as one scatter-gather transfer
+ *       if the uDMA is idle
+ *
+ * Notes: Call with interrupts off or from the ISR
+ */
+static void MIL_UART_DMATxStart(MIL_UART_DMA_t *pdma){
+
+    uint8_t n = pdma->tx_queued;
+    uint8_t slot = pdma->tx_tail;
+
+    if(pdma->tx_count || !n){
+        return;
+    }
+
+    //every task ends in scatter-gather mode except the last, which stops the channel
+    for(uint8_t i = 0;i < n;i++){
+
+        MIL_UART_DMATx_t *ptx = &pdma->txq[slot];
+        tDMAControlTable task = uDMATaskStructEntry(ptx->len, UDMA_SIZE_8,
+                                                    UDMA_SRC_INC_8, (void *)ptx->data,
+                                                    UDMA_DST_INC_NONE, (void *)(pdma->base + UART_O_DR),
+                                                    UDMA_ARB_4,
+                                                    (i == n - 1) ? UDMA_MODE_BASIC : UDMA_MODE_PER_SCATTER_GATHER);
+
+        pdma->tx_task[i] = task;
+        slot = (slot + 1) % MIL_UART_DMA_TXQ_LEN;
+    }
+
+    uDMAChannelScatterGatherSet(pdma->tx_ch, n, pdma->tx_task, 1);
+    pdma->tx_count = n;
+    uDMAChannelEnable(pdma->tx_ch);
+
+}
+
+/*
+ * Desc: UART ISR while on the uDMA
+ */
+static void MIL_UART_DMAISR(uint8_t idx){
+
+    MIL_UART_DMA_t *pdma = pUART[idx];
+    uint32_t status;
+    bool pri_done;
+    bool alt_done;
+    bool notify;
+
+    status = UARTIntStatus(pdma->base, true);
+    UARTIntClear(pdma->base, status);
+
+    if(status & MIL_UART_ERR_INTS){
+        pdma->stats.rx_errors++;
+    }
+
+    //end of a burst that did not fill a half
+    notify = (status & UART_INT_RT) != 0;
+
+    //RX halves, the finished one is re-armed while the other fills
+    pri_done = uDMAChannelModeGet(pdma->rx_ch | UDMA_PRI_SELECT) == UDMA_MODE_STOP;
+    alt_done = uDMAChannelModeGet(pdma->rx_ch | UDMA_ALT_SELECT) == UDMA_MODE_STOP;
+
+    if(pri_done && alt_done){
+        //both filled before we got here, the channel stopped and
+        //starts again with the half that was filling last time
+        pdma->rx_done += 2 * pdma->rx_half;
+        MIL_UART_DMARxArm(pdma, UDMA_PRI_SELECT);
+        MIL_UART_DMARxArm(pdma, UDMA_ALT_SELECT);
+        if(pdma->rx_alt){
+            uDMAChannelAttributeEnable(pdma->rx_ch, UDMA_ATTR_ALTSELECT);
+        }
+        else{
+            uDMAChannelAttributeDisable(pdma->rx_ch, UDMA_ATTR_ALTSELECT);
+        }
+        uDMAChannelEnable(pdma->rx_ch);
+        notify = true;
+    }
+    else if(pri_done){
+        pdma->rx_done += pdma->rx_half;
+        MIL_UART_DMARxArm(pdma, UDMA_PRI_SELECT);
+        pdma->rx_alt = true;
+        notify = true;
+    }
+    else if(alt_done){
+        pdma->rx_done += pdma->rx_half;
+        MIL_UART_DMARxArm(pdma, UDMA_ALT_SELECT);
+        pdma->rx_alt = false;
+        notify = true;
+    }
+
+    //the end of a burst sits in the FIFO below the uDMA request level
+    if(status & UART_INT_RT){
+        MIL_UART_DMARxDrain(pdma);
+    }
+
+    //TX batch finished, hand the buffers back and start the next batch
+    if(pdma->tx_count && !uDMAChannelIsEnabled(pdma->tx_ch)){
+
+        uint8_t n = pdma->tx_count;
+
+        //tx_count stays set so a pdone that writes again only queues
+        while(n--){
+            MIL_UART_DMATx_t tx = pdma->txq[pdma->tx_tail];
+
+            pdma->tx_tail = (pdma->tx_tail + 1) % MIL_UART_DMA_TXQ_LEN;
+            pdma->tx_queued--;
+            pdma->stats.tx_bytes += tx.len;
+
+            if(tx.pdone){
+                tx.pdone(tx.data, tx.pctx);
+            }
+        }
+
+        pdma->tx_count = 0;
+        MIL_UART_DMATxStart(pdma);
+    }
+
+    if(notify && pdma->prx){
+        uint32_t avail = MIL_UART_DMAHead(pdma) - pdma->rx_tail;
+
+        pdma->prx(pdma->base, (avail > pdma->rx_size) ? pdma->rx_size : avail);
+    }
+
+}
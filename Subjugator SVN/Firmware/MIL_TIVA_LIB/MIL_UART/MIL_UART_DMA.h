@@ -0,0 +1,227 @@
+/*
+ * Name: MIL_UART_DMA.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: UART transport that moves bytes with the uDMA instead
+ *       of one interrupt per byte
+ *
+ * What to understand: With MIL_InitUART alone every byte costs either a
+ *                     polling loop or an interrupt. Here the uDMA does
+ *                     the copying and the CPU only hears about it now
+ *                     and then.
+ *
+ *                     RX: the uDMA fills a circular buffer you give it,
+ *                     one half at a time(ping-pong mode). While one half
+ *                     fills, the finished half is re-armed, so reception
+ *                     never stops. MIL_UART_DMARead copies out whatever
+ *                     has arrived, even part of a half.
+ *
+ *                     The uDMA only moves bytes in bursts of 8 once the
+ *                     FIFO is half full. The last few bytes of a message
+ *                     stay in the FIFO until the UART receive timeout(no
+ *                     new byte for 32 bit times), then the ISR reads them
+ *                     into the buffer itself. So the optional prx callback
+ *                     runs at the end of every message as well as every
+ *                     half buffer.
+ *
+ *                     TX: MIL_UART_DMAWrite queues your buffer(NOT
+ *                     copied). Everything queued while the uDMA is busy
+ *                     goes out back to back as one scatter-gather
+ *                     transfer, one interrupt for the whole batch.
+ *
+ * Interrupt Note: This installs its own ISR on the UART, do not use
+ *                 MIL_UART_InitISR on the same base
+ *
+ * BUFFER NOTE: rx_size is split into two halves of at most 1024 bytes.
+ *              At 115.2k a 256 byte buffer gives you about 11ms to read
+ *              a half before it is written over
+ *
+ * HOW TO USE:
+ *   static uint8_t rx_buf[256];
+ *   static MIL_UART_DMA_t uart_dma;
+ *
+ *   MIL_InitUART(UART1_BASE, MIL_DEFAULT_BAUD_115K);
+ *   MIL_UART_DMAInit(UART1_BASE, &uart_dma, rx_buf, sizeof(rx_buf), 0);
+ *
+ *   n = MIL_UART_DMARead(UART1_BASE, msg, sizeof(msg));
+ *   MIL_UART_DMAWrite(UART1_BASE, reply, reply_len, 0, 0);
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "driverlib/udma.h"
+#include "MIL_UART_Pkt.h"
+
+#ifndef MIL_UART_DMA_H_
+#define MIL_UART_DMA_H_
+
+//buffers that can wait to be sent, also the most tasks in one scatter-gather transfer
+#ifndef MIL_UART_DMA_TXQ_LEN
+#define MIL_UART_DMA_TXQ_LEN 8
+#endif
+
+//largest buffer one MIL_UART_DMAWrite can take(one uDMA transfer)
+#define MIL_UART_DMA_MAX_WRITE 1024
+
+/*
+ * Desc: result of operations that can fail
+ */
+typedef enum{
+
+   MIL_UART_NOK, //operation failed
+   MIL_UART_OK   //operation succeeded
+
+}mil_uart_status_t;
+
+/*
+ * Desc: callbacks, both run in the UART ISR
+ *
+ * mil_uart_rx_t - bytes are waiting(a half filled or a burst ended)
+ * mil_uart_done_t - a buffer from MIL_UART_DMAWrite was sent and
+ *                   is yours again
+ */
+typedef void (*mil_uart_rx_t)(uint32_t base, uint16_t avail);
+typedef void (*mil_uart_done_t)(const uint8_t *data, void *pctx);
+
+/*
+ * Desc: counters, all counters only go up
+ *
+ * rx_bytes - bytes read out with MIL_UART_DMARead
+ * rx_lost - bytes written over before they were read
+ * rx_errors - overrun, break, parity and framing errors
+ * tx_bytes - bytes sent
+ */
+typedef struct{
+
+  uint32_t rx_bytes;
+  uint32_t rx_lost;
+  uint32_t rx_errors;
+  uint32_t tx_bytes;
+
+}MIL_UART_DMAStats_t;
+
+/*
+ * Desc: one queued buffer(do not touch fields directly)
+ */
+typedef struct{
+
+  const uint8_t *data;
+  uint16_t len;
+  mil_uart_done_t pdone;
+  void *pctx;
+
+}MIL_UART_DMATx_t;
+
+/*
+ * Desc: state of one UART(do not touch fields directly)
+ */
+typedef struct{
+
+  uint32_t base;
+  uint32_t rx_ch;
+  uint32_t tx_ch;
+
+  //receiving
+  uint8_t *rx_buf;
+  uint16_t rx_size;
+  uint16_t rx_half;
+  volatile bool     rx_alt;     //the alternate half is filling
+  volatile uint32_t rx_done;    //bytes in finished halves, only goes up
+  uint32_t rx_tail;             //bytes read out, only goes up
+  mil_uart_rx_t prx;
+
+  //sending
+  MIL_UART_DMATx_t txq[MIL_UART_DMA_TXQ_LEN];
+  uint8_t tx_head;              //next free entry
+  uint8_t tx_tail;              //oldest entry not sent yet
+  volatile uint8_t tx_queued;   //entries not sent yet, running ones included
+  uint8_t tx_count;             //entries in the running transfer
+  tDMAControlTable tx_task[MIL_UART_DMA_TXQ_LEN];
+
+  MIL_UART_DMAStats_t stats;
+
+}MIL_UART_DMA_t;
+
+/*
+ * Desc: Moves a UART over to the uDMA
+ *
+ * Notes: CALL MIL_InitUART FIRST. This turns the FIFOs on
+ *        (the uDMA needs them) and installs the UART ISR
+ *
+ * Parameters:
+ * base - UART TIVA base UARTx_BASE(where x is 0 to 7)
+ * pdma - storage you declare(one per UART)
+ * rx_buf - receive buffer
+ * rx_size - size of rx_buf, even and at most 2048
+ * prx - called when bytes are waiting(can be 0 to just poll)
+ *
+ * Returns:
+ * MIL_UART_OK if the UART runs on the uDMA
+ * MIL_UART_NOK if base or rx_size is not valid
+ */
+mil_uart_status_t MIL_UART_DMAInit(uint32_t base, MIL_UART_DMA_t *pdma, uint8_t *rx_buf,
+                                   uint16_t rx_size, mil_uart_rx_t prx);
+
+/*
+ * Desc: Number of received bytes waiting to be read
+ */
+uint16_t MIL_UART_DMAAvailable(uint32_t base);
+
+/*
+ * Desc: Copies out received bytes
+ *
+ * Parameters:
+ * data - where to put them
+ * max - most bytes to copy
+ *
+ * Returns: number of bytes copied
+ */
+uint16_t MIL_UART_DMARead(uint32_t base, uint8_t *data, uint16_t max);
+
+/*
+ * Desc: Hands every received byte to a packet parser(see
+ *       MIL_UART_Pkt.h) straight from the uDMA buffer,
+ *       call this from your main loop
+ *
+ * Notes: Do not mix this with MIL_UART_DMARead on the same base.
+ *        To send, build the packet with MIL_UART_PktEncode in a
+ *        buffer of yours and queue it with MIL_UART_DMAWrite
+ *
+ * Returns: number of bytes handed to the parser
+ */
+uint16_t MIL_UART_PktPoll(uint32_t base, MIL_UART_Pkt_t *pp);
+
+/*
+ * Desc: Queues a buffer to send
+ *
+ * Notes: data is NOT copied, leave it alone until pdone runs
+ *        (or MIL_UART_DMATxBusy returns false)
+ *
+ * Parameters:
+ * data/len - bytes to send(1 to MIL_UART_DMA_MAX_WRITE)
+ * pdone - called from the ISR when the buffer was sent(can be 0)
+ * pctx - handed back to pdone
+ *
+ * Returns:
+ * MIL_UART_OK if the buffer was queued
+ * MIL_UART_NOK if the queue is full, len is out of range or
+ *              the UART was never set up
+ */
+mil_uart_status_t MIL_UART_DMAWrite(uint32_t base, const uint8_t *data, uint16_t len,
+                                    mil_uart_done_t pdone, void *pctx);
+
+/*
+ * Desc: true while anything is queued or being sent
+ */
+bool MIL_UART_DMATxBusy(uint32_t base);
+
+/*
+ * Desc: Copies out the counters
+ *
+ * Returns:
+ * MIL_UART_OK if the counters were copied
+ * MIL_UART_NOK if the UART was never set up
+ */
+mil_uart_status_t MIL_UART_DMAStatsGet(uint32_t base, MIL_UART_DMAStats_t *pstats);
+
+#endif /* MIL_UART_DMA_H_ */
@@ -0,0 +1,226 @@
+/*
+ * Name: MIL_UART_Pkt.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: COBS framed, CRC-16 checked packets for UART links
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_UART_Pkt.h"
+
+//CRC-16/CCITT-FALSE one byte at a time
+static const uint16_t CRC16Table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+
+#define MIL_UART_PKT_CRC(crc, b) ((uint16_t)(((crc) << 8) ^ CRC16Table[(((crc) >> 8) ^ (b)) & 0xFF]))
+
+static void MIL_UART_PktReset(MIL_UART_Pkt_t *pp);
+static void MIL_UART_PktEnd(MIL_UART_Pkt_t *pp);
+
+/*
+ * Desc: CRC-16/CCITT-FALSE of a buffer
+ */
+uint16_t MIL_UART_PktCRC16(uint16_t crc, const uint8_t *data, uint16_t len){
+
+    while(len--){
+        crc = MIL_UART_PKT_CRC(crc, *data++);
+    }
+
+    return crc;
+
+}
+
+/*
+ * Desc: Builds a packet
+ *
+ * Returns: packet length including the final 0x00, 0 if it did not fit
+ */
+uint16_t MIL_UART_PktEncode(const uint8_t *data, uint16_t len, uint8_t *out, uint16_t out_size){
+
+    uint16_t crc = MIL_UART_PktCRC16(0xFFFF, data, len);
+    uint16_t code_pos = 0;      //where the current block's code byte goes
+    uint16_t o = 1;
+    uint8_t code = 1;
+    uint8_t b;
+
+    if(out_size < MIL_UART_PKT_ENCODED_SIZE((uint32_t)len)){
+        return 0;
+    }
+
+    //payload then the CRC, high byte first
+    for(uint32_t i = 0;i < (uint32_t)len + 2;i++){
+
+        if(i < len){
+            b = data[i];
+        }
+        else{
+            b = (i == len) ? (crc >> 8) : (crc & 0xFF);
+        }
+
+        if(b == 0){
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+        }
+        else{
+            out[o++] = b;
+            //a full block has no zero after it
+            if(++code == 0xFF){
+                out[code_pos] = code;
+                code_pos = o++;
+                code = 1;
+            }
+        }
+    }
+
+    out[code_pos] = code;
+    out[o++] = 0;
+
+    return o;
+
+}
+
+/*
+ * Desc: Sets up a parser
+ */
+void MIL_UART_PktInit(MIL_UART_Pkt_t *pp, mil_uart_pkt_rx_t prx, void *pctx){
+
+    pp->prx = prx;
+    pp->pctx = pctx;
+    pp->stats.packets = 0;
+    pp->stats.crc_errors = 0;
+    pp->stats.frame_errors = 0;
+
+    MIL_UART_PktReset(pp);
+
+}
+
+/*
+ * Desc: Hands the parser received bytes
+ */
+void MIL_UART_PktFeed(MIL_UART_Pkt_t *pp, const uint8_t *data, uint16_t len){
+
+    uint8_t b;
+
+    while(len--){
+
+        b = *data++;
+
+        if(b == 0){
+            MIL_UART_PktEnd(pp);
+            continue;
+        }
+
+        if(pp->bad){
+            continue;
+        }
+
+        if(pp->left == 0){
+            //code byte, the block before it ended in a 0x00 unless it was full
+            bool zero = pp->code && pp->code != 0xFF;
+
+            pp->code = b;
+            pp->left = b - 1;
+            if(!zero){
+                continue;
+            }
+            b = 0;
+        }
+        else{
+            pp->left--;
+        }
+
+        if(pp->pos >= sizeof(pp->buf)){
+            pp->bad = true;
+            continue;
+        }
+        pp->buf[pp->pos++] = b;
+        pp->crc = MIL_UART_PKT_CRC(pp->crc, b);
+    }
+
+}
+
+/*
+ * Desc: Copies out the parser's counters
+ */
+void MIL_UART_PktStatsGet(MIL_UART_Pkt_t *pp, MIL_UART_PktStats_t *pstats){
+
+    *pstats = pp->stats;
+
+}
+
+/*
+ * Desc: Gets ready for the next packet
+ */
+static void MIL_UART_PktReset(MIL_UART_Pkt_t *pp){
+
+    pp->pos = 0;
+    pp->crc = 0xFFFF;
+    pp->left = 0;
+    pp->code = 0;
+    pp->bad = false;
+
+}
+
+/*
+ * Desc: 0x00 arrived, checks the packet and hands it over
+ */
+static void MIL_UART_PktEnd(MIL_UART_Pkt_t *pp){
+
+    //0x00 right after 0x00 is only padding, senders may use it to resync
+    if(pp->code == 0 && !pp->bad){
+        return;
+    }
+
+    if(pp->bad || pp->left != 0 || pp->pos < 2){
+        pp->stats.frame_errors++;
+    }
+    else if(pp->crc != 0){
+        pp->stats.crc_errors++;
+    }
+    else{
+        pp->stats.packets++;
+        if(pp->prx){
+            pp->prx(pp->buf, pp->pos - 2, pp->pctx);
+        }
+    }
+
+    MIL_UART_PktReset(pp);
+
+}
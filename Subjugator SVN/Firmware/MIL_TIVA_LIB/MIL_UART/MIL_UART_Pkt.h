@@ -0,0 +1,134 @@
+/*
+ * Name: MIL_UART_Pkt.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: COBS framed, CRC-16 checked packets for UART links
+ *
+ * What to understand: Every board used to make up its own byte protocol
+ *                     and most of them cannot find the start of the next
+ *                     message after a byte is lost. Here every packet is
+ *
+ *                     COBS( payload | CRC-16 high | CRC-16 low ) | 0x00
+ *
+ *                     COBS(Consistent Overhead Byte Stuffing) rewrites the
+ *                     data so it never contains 0x00, at a cost of one byte
+ *                     per 254. 0x00 can therefore only mean "end of packet"
+ *                     and after any noise the receiver is back in step at
+ *                     the next 0x00.
+ *
+ *                     The CRC is CRC-16/CCITT-FALSE(poly 0x1021, start
+ *                     0xFFFF), sent high byte first. Run over payload and
+ *                     CRC together it comes out 0, so the receiver checks
+ *                     it as the bytes arrive without knowing where the
+ *                     payload ends.
+ *
+ *                     MIL_UART_PktFeed decodes as bytes come in, O(1) work
+ *                     per byte, and calls your handler with each good
+ *                     payload straight out of the parser's buffer.
+ *
+ * NOISE NOTE: Garbage picked up while the line is idle sticks to the
+ *             front of the next packet and costs you that packet. If
+ *             your line can do that, send a 0x00 before every packet
+ *             too, back to back 0x00s are ignored
+ *
+ * Note: This file only depends on stdint/stdbool so it can be
+ *       built on a PC as well as the TIVA(fuzzing, benchmarks,
+ *       PC side tools). MIL_UART_PktPoll in MIL_UART_DMA feeds
+ *       a parser from a uDMA UART
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_UART_PKT_H_
+#define MIL_UART_PKT_H_
+
+//largest payload a parser accepts
+#ifndef MIL_UART_PKT_MAX_PAYLOAD
+#define MIL_UART_PKT_MAX_PAYLOAD 128
+#endif
+
+//size a packet with len payload bytes can grow to(COBS, CRC and the 0x00)
+#define MIL_UART_PKT_ENCODED_SIZE(len) ((len) + 2 + (((len) + 2) / 254) + 2)
+
+/*
+ * Desc: called with every good payload
+ *
+ * Notes: data points into the parser and is only valid during the call
+ */
+typedef void (*mil_uart_pkt_rx_t)(const uint8_t *data, uint16_t len, void *pctx);
+
+/*
+ * Desc: parser counters, all counters only go up
+ *
+ * packets - good packets handed to the handler
+ * crc_errors - packets with a bad CRC
+ * frame_errors - packets too long, too short or cut off
+ */
+typedef struct{
+
+  uint32_t packets;
+  uint32_t crc_errors;
+  uint32_t frame_errors;
+
+}MIL_UART_PktStats_t;
+
+/*
+ * Desc: a parser(do not touch fields directly)
+ */
+typedef struct{
+
+  uint8_t  buf[MIL_UART_PKT_MAX_PAYLOAD + 2];
+  uint16_t pos;             //decoded bytes so far
+  uint16_t crc;             //CRC of the decoded bytes
+  uint8_t  left;            //bytes left in the current COBS block
+  uint8_t  code;            //code byte of the current block, 0 before the first
+  bool     bad;             //too long, ignore everything up to the next 0x00
+  mil_uart_pkt_rx_t prx;
+  void    *pctx;
+
+  MIL_UART_PktStats_t stats;
+
+}MIL_UART_Pkt_t;
+
+/*
+ * Desc: CRC-16/CCITT-FALSE of a buffer
+ *
+ * Parameters:
+ * crc - 0xFFFF to start, or the result of the previous call to continue
+ */
+uint16_t MIL_UART_PktCRC16(uint16_t crc, const uint8_t *data, uint16_t len);
+
+/*
+ * Desc: Builds a packet
+ *
+ * Parameters:
+ * data/len - payload
+ * out/out_size - where the packet goes, MIL_UART_PKT_ENCODED_SIZE(len)
+ *                is always enough
+ *
+ * Returns: packet length including the final 0x00, 0 if it did not fit
+ */
+uint16_t MIL_UART_PktEncode(const uint8_t *data, uint16_t len, uint8_t *out, uint16_t out_size);
+
+/*
+ * Desc: Sets up a parser
+ *
+ * Parameters:
+ * pp - your parser
+ * prx - called with every good payload
+ * pctx - handed back to prx
+ */
+void MIL_UART_PktInit(MIL_UART_Pkt_t *pp, mil_uart_pkt_rx_t prx, void *pctx);
+
+/*
+ * Desc: Hands the parser received bytes, any number at a time
+ */
+void MIL_UART_PktFeed(MIL_UART_Pkt_t *pp, const uint8_t *data, uint16_t len);
+
+/*
+ * Desc: Copies out the parser's counters
+ */
+void MIL_UART_PktStatsGet(MIL_UART_Pkt_t *pp, MIL_UART_PktStats_t *pstats);
+
+#endif /* MIL_UART_PKT_H_ */
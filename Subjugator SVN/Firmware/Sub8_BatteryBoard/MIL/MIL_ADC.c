@@ -50,11 +50,50 @@
 #include "driverlib/gpio.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
 #include "driverlib/uart.h"
 #include "utils/uartstdio.h"
 
 //MIL includes
 #include "MIL_ADC.h"
+#include "MIL_CLK.h"
+
+//steps each sequencer can hold, SS0 to SS3
+static const uint8_t SeqSteps[4] = {8, 4, 4, 1};
+
+//step flag that sends the result to digital comparator 0 to 7
+static const uint32_t CompCtl[8] = {
+    ADC_CTL_CMP0, ADC_CTL_CMP1, ADC_CTL_CMP2, ADC_CTL_CMP3,
+    ADC_CTL_CMP4, ADC_CTL_CMP5, ADC_CTL_CMP6, ADC_CTL_CMP7
+};
+
+//digital comparator alarms of ADC0 and ADC1
+static mil_adc_alarm_t pAlarm[2];
+static uint8_t AlarmSeq[2];
+static uint8_t AlarmIdx[2][8];          //palarms entry of every comparator
+static uint8_t AlarmOver[2];            //comparators that watch a high threshold
+
+static void MIL_ADCAlarmISR(uint8_t adc);
+static void MIL_ADC0_AlarmISR(void){ MIL_ADCAlarmISR(0); }
+static void MIL_ADC1_AlarmISR(void){ MIL_ADCAlarmISR(1); }
+
+/*
+ * Desc: TivaWare trigger source for a mil_trig_t
+ */
+static uint32_t MIL_ADCTrigSource(mil_trig_t trig){
+
+    //determine trigger source
+    switch(trig){
+        case MIL_ADC_TimTrig:
+            return ADC_TRIGGER_TIMER;
+        case MIL_ADC_AlwaysTrig:
+            return ADC_TRIGGER_ALWAYS;
+        case MIL_ADC_SoftTrig:
+        default:
+            return ADC_TRIGGER_PROCESSOR;
+    }
+
+}
 
 /*
  * Desc: This function will configure the selected ADC channel
@@ -230,49 +269,14 @@ mil_adc_stat_t MIL_ADCSeqInit(uint32_t base,uint8_t seq_num,uint16_t pin_bitfiel
 
     pin_bitfield = pin_bitfield & 0x0FFF; //get rid of extraneous bits
 
-    uint32_t local_trig;
-
-    //determine trigger source
-    switch(trig){
-        case MIL_ADC_SoftTrig:
-            local_trig = ADC_TRIGGER_PROCESSOR;
-            break;
-        case MIL_ADC_TimTrig:
-            local_trig = ADC_TRIGGER_TIMER;
-            break;
-        case MIL_ADC_AlwaysTrig:
-            local_trig = ADC_TRIGGER_ALWAYS;
-            break;
-        default:
-            local_trig = ADC_TRIGGER_PROCESSOR;
-            break;
-    }
+    uint32_t local_trig = MIL_ADCTrigSource(trig);
 
     ADCSequenceConfigure(base,seq_num,local_trig,seq_num);
 
     uint8_t step_max;
 
     //generate max number of steps
-    switch(seq_num){
-        case MIL_ADC_SEQ0:
-            step_max = 8;
-            break;
-
-        case MIL_ADC_SEQ1:
-            step_max = 4;
-            break;
-
-        case MIL_ADC_SEQ2:
-            step_max = 4;
-            break;
-
-        case MIL_ADC_SEQ3:
-            step_max = 4;
-            break;
-        default:
-            step_max = 1;
-            break;
-    }
+    step_max = (seq_num <= MIL_ADC_SEQ3) ? SeqSteps[seq_num] : 1;
 
     uint8_t step_need = 0;
     uint16_t temp_field = pin_bitfield;
@@ -378,6 +382,395 @@ void MIL_ADCIntEnable(void (*isr_ptr)(void),uint32_t base,uint8_t seq_num){
 
 }
 
+/*
+ * Desc: Sets up a timer to trigger every sequence you
+ *       initialized with MIL_ADC_TimTrig
+ *
+ * Parameters:
+ *  timer_base - TIMER0_BASE to TIMER5_BASE
+ *  rate_hz - sequences per second
+ *
+ * Returns:
+ *  MIL_ADC_OK if the timer is running
+ *  MIL_ADC_NOK if timer_base is not valid or rate_hz is 0 or
+ *              faster than the system clock
+ */
+mil_adc_stat_t MIL_ADCTimerTrigInit(uint32_t timer_base,uint32_t rate_hz){
+
+    //TIMER0_BASE to TIMER5_BASE are 0x1000 apart
+    static const uint32_t timer_periph[6] = {
+        SYSCTL_PERIPH_TIMER0, SYSCTL_PERIPH_TIMER1, SYSCTL_PERIPH_TIMER2,
+        SYSCTL_PERIPH_TIMER3, SYSCTL_PERIPH_TIMER4, SYSCTL_PERIPH_TIMER5
+    };
+    uint32_t clk = MIL_ClkGetHz();
+
+    if(timer_base < TIMER0_BASE || timer_base > TIMER5_BASE || (timer_base & 0xFFF)){
+
+        return MIL_ADC_NOK;
+
+    }
+    if(!rate_hz || rate_hz > clk){
+
+        return MIL_ADC_NOK;
+
+    }
+
+    SysCtlPeripheralEnable(timer_periph[(timer_base - TIMER0_BASE) >> 12]);
+    while(!SysCtlPeripheralReady(timer_periph[(timer_base - TIMER0_BASE) >> 12]));
+
+    TimerDisable(timer_base, TIMER_A);
+    TimerConfigure(timer_base, TIMER_CFG_PERIODIC);
+    TimerLoadSet(timer_base, TIMER_A, (clk / rate_hz) - 1);
+
+    //the timeout goes to the ADC instead of an interrupt
+    TimerControlTrigger(timer_base, TIMER_A, true);
+    TimerEnable(timer_base, TIMER_A);
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: Turns on hardware averaging for a whole ADC module
+ *
+ * Parameters:
+ *  base - ADC0_BASE or ADC1_BASE
+ *  factor - 0(off), 2, 4, 8, 16, 32 or 64
+ *
+ * Returns:
+ *  MIL_ADC_OK if averaging is set
+ *  MIL_ADC_NOK if base or factor is not valid
+ */
+mil_adc_stat_t MIL_ADCOversample(uint32_t base,uint8_t factor){
+
+    if(base != ADC0_BASE && base != ADC1_BASE){
+
+        return MIL_ADC_NOK;
+
+    }
+
+    //a power of 2 from 2 to 64, or 0
+    if(factor == 1 || factor > 64 || (factor & (factor - 1))){
+
+        return MIL_ADC_NOK;
+
+    }
+
+    ADCHardwareOversampleConfigure(base, factor);
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: Spreads a set of channels over the sequencers of one ADC
+ *       so one trigger samples all of them
+ *
+ * Returns:
+ *  MIL_ADC_OK if the scan is set up
+ *  MIL_ADC_NOK if base is not valid or pin_bitfield is empty
+ */
+mil_adc_stat_t MIL_ADCScanInit(MIL_ADC_Scan_t *pscan,uint32_t base,uint16_t pin_bitfield,mil_trig_t trig){
+
+    uint32_t periph;
+    uint32_t config_field;
+    uint8_t seq = 0;
+    uint8_t step = 0;
+    uint8_t channel;
+
+    if(base == ADC0_BASE){
+
+        periph = SYSCTL_PERIPH_ADC0;
+
+    }
+    else if(base == ADC1_BASE){
+
+        periph = SYSCTL_PERIPH_ADC1;
+
+    }
+    else{
+
+        return MIL_ADC_NOK;
+
+    }
+
+    pin_bitfield = pin_bitfield & 0x0FFF; //get rid of extraneous bits
+
+    if(!pin_bitfield){
+
+        return MIL_ADC_NOK;
+
+    }
+
+    SysCtlPeripheralEnable(periph);
+    SysCtlPeripheralReset(periph);
+    while(!SysCtlPeripheralReady(periph));
+
+    pscan->base = base;
+    pscan->count = 0;
+    pscan->seq_bm = 0;
+
+    for(seq = 0;seq < 4;seq++){
+
+        pscan->seq_steps[seq] = 0;
+
+    }
+
+    //fill SS0 first, then SS1, SS2 and SS3
+    seq = 0;
+    for(channel = 0;channel < 12;channel++){
+
+        if(!(pin_bitfield & (0x01 << channel))){
+
+            continue;
+
+        }
+
+        if(step == SeqSteps[seq]){
+
+            seq++;
+            step = 0;
+
+        }
+
+        pscan->channel[pscan->count++] = channel;
+        pscan->seq_steps[seq]++;
+        step++;
+
+    }
+
+    //priority is the sequence number so a trigger runs SS0, SS1, SS2 then SS3
+    channel = 0;
+    for(seq = 0;seq < 4 && pscan->seq_steps[seq];seq++){
+
+        ADCSequenceDisable(base, seq);
+        ADCSequenceConfigure(base, seq, MIL_ADCTrigSource(trig), seq);
+
+        for(step = 0;step < pscan->seq_steps[seq];step++){
+
+            config_field = pscan->channel[channel++];
+
+            if((step + 1) == pscan->seq_steps[seq]){
+
+                config_field |= ADC_CTL_END | ADC_CTL_IE;
+
+            }
+
+            ADCSequenceStepConfigure(base, seq, step, config_field);
+
+        }
+
+        ADCSequenceEnable(base, seq);
+        ADCIntClear(base, seq);
+
+        pscan->seq_bm |= 0x01 << seq;
+        pscan->last_seq = seq;
+
+    }
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: Starts a scan set up with MIL_ADC_SoftTrig
+ */
+void MIL_ADCScanStart(MIL_ADC_Scan_t *pscan){
+
+    uint8_t seq;
+
+    //arm every sequencer, then start them all with one signal
+    for(seq = 0;seq < 4;seq++){
+
+        if(pscan->seq_bm & (0x01 << seq)){
+
+            ADCProcessorTrigger(pscan->base, seq | ADC_TRIGGER_WAIT);
+
+        }
+
+    }
+
+    ADCProcessorTrigger(pscan->base, ADC_TRIGGER_SIGNAL);
+
+}
+
+/*
+ * Desc: Interrupt at the end of every scan
+ */
+void MIL_ADCScanIntEnable(MIL_ADC_Scan_t *pscan,void (*isr_ptr)(void)){
+
+    MIL_ADCIntEnable(isr_ptr, pscan->base, pscan->last_seq);
+
+}
+
+/*
+ * Desc: Reads a finished scan without waiting
+ *
+ * Returns:
+ *  MIL_ADC_OK if psamples holds a new scan
+ *  MIL_ADC_NOK if the scan has not finished(psamples is left alone)
+ */
+mil_adc_stat_t MIL_ADCScanRead(MIL_ADC_Scan_t *pscan,uint16_t *psamples){
+
+    uint32_t fifo[8];
+    uint8_t seq;
+    uint8_t step;
+    uint8_t entry = 0;
+
+    //every sequencer has to be done, not just the last one
+    for(seq = 0;seq < 4;seq++){
+
+        if((pscan->seq_bm & (0x01 << seq)) && !ADCIntStatus(pscan->base, seq, false)){
+
+            return MIL_ADC_NOK;
+
+        }
+
+    }
+
+    for(seq = 0;seq < 4;seq++){
+
+        if(!(pscan->seq_bm & (0x01 << seq))){
+
+            continue;
+
+        }
+
+        ADCSequenceDataGet(pscan->base, seq, fifo);
+        ADCIntClear(pscan->base, seq);
+
+        for(step = 0;step < pscan->seq_steps[seq];step++){
+
+            psamples[pscan->channel[entry++]] = (uint16_t)fifo[step];
+
+        }
+
+    }
+
+    return MIL_ADC_OK;
+
+}
+
+/*
+ * Desc: Watches channels against low/high thresholds in hardware
+ *
+ * Returns:
+ *  MIL_ADC_OK if the alarms are armed
+ *  MIL_ADC_NOK if a parameter is not valid or the thresholds need
+ *              more steps or comparators than there are
+ */
+mil_adc_stat_t MIL_ADCAlarmInit(uint32_t base,uint8_t seq_num,const MIL_ADC_Alarm_t *palarms,
+                                uint8_t count,mil_trig_t trig,mil_adc_alarm_t palarm){
+
+    uint8_t adc;
+    uint8_t comp = 0;
+    uint8_t idx;
+    uint16_t low;
+    uint16_t high;
+
+    if(base == ADC0_BASE){
+
+        adc = 0;
+
+    }
+    else if(base == ADC1_BASE){
+
+        adc = 1;
+
+    }
+    else{
+
+        return MIL_ADC_NOK;
+
+    }
+
+    if(seq_num > MIL_ADC_SEQ3 || !count || !palarm){
+
+        return MIL_ADC_NOK;
+
+    }
+
+    //count the thresholds first so nothing is touched on failure
+    for(idx = 0;idx < count;idx++){
+
+        if(palarms[idx].channel > 11){
+
+            return MIL_ADC_NOK;
+
+        }
+
+        comp += (palarms[idx].low != 0) + (palarms[idx].high != 0 && palarms[idx].high <= 0xFFF);
+
+    }
+
+    if(!comp || comp > 8 || comp > SeqSteps[seq_num]){
+
+        return MIL_ADC_NOK;
+
+    }
+
+    ADCSequenceDisable(base, seq_num);
+    ADCSequenceConfigure(base, seq_num, MIL_ADCTrigSource(trig), seq_num);
+
+    pAlarm[adc] = palarm;
+    AlarmSeq[adc] = seq_num;
+    AlarmOver[adc] = 0;
+
+    comp = 0;
+    for(idx = 0;idx < count;idx++){
+
+        low = palarms[idx].low;
+        high = palarms[idx].high;
+
+        //below low is the low region, it rearms at low + hyst
+        if(low){
+
+            ADCComparatorConfigure(base, comp, ADC_COMP_TRIG_NONE | ADC_COMP_INT_LOW_HONCE);
+            ADCComparatorRegionSet(base, comp, low,
+                                   ((low + palarms[idx].hyst) > 0xFFF) ? 0xFFF : (low + palarms[idx].hyst));
+            AlarmIdx[adc][comp++] = idx;
+
+        }
+
+        //high and above is the high region, it rearms below high - hyst
+        if(high && high <= 0xFFF){
+
+            ADCComparatorConfigure(base, comp, ADC_COMP_TRIG_NONE | ADC_COMP_INT_HIGH_HONCE);
+            ADCComparatorRegionSet(base, comp,
+                                   (palarms[idx].hyst > high) ? 0 : (high - palarms[idx].hyst), high);
+            AlarmOver[adc] |= 0x01 << comp;
+            AlarmIdx[adc][comp++] = idx;
+
+        }
+
+    }
+
+    //one step per comparator, the results go to the comparators only
+    for(idx = 0;idx < comp;idx++){
+
+        ADCComparatorReset(base, idx, true, true);
+        ADCSequenceStepConfigure(base, seq_num, idx,
+                                 palarms[AlarmIdx[adc][idx]].channel | CompCtl[idx] |
+                                 (((idx + 1) == comp) ? ADC_CTL_END : 0));
+
+    }
+
+    ADCComparatorIntClear(base, 0xFF);
+    ADCIntRegister(base, seq_num, adc ? MIL_ADC1_AlarmISR : MIL_ADC0_AlarmISR);
+    ADCIntEnableEx(base, ADC_INT_DCON_SS0 << seq_num);
+
+    for(idx = 0;idx < comp;idx++){
+
+        ADCComparatorIntEnable(base, idx);
+
+    }
+
+    ADCSequenceEnable(base, seq_num);
+
+    return MIL_ADC_OK;
+
+}
+
 /*
  * Desc: Runs get data sequence specified in the ADCSeqInit function
  *       This function can also be called in interrupts if need be
@@ -452,7 +845,7 @@ mil_adc_stat_t MIL_ADCGetData(uint32_t base,uint8_t seq_num,uint32_t timeout,uin
 float MIL_ADC_HextoFloat(uint16_t adc_value){
 
     float voltage;
-    float slope = 3/0xFFF;
+    float slope = 3.0f/0xFFF;
 
     voltage = adc_value * slope;
     return voltage;
@@ -528,3 +921,30 @@ void MIL_ADC_FloattoASCII(uint16_t adc_value,char *pstring){
 
 }
 
+/*
+ * Desc: Hands every comparator that fired to the alarm callback
+ *
+ * Parameters:
+ *  adc - 0 for ADC0, 1 for ADC1
+ */
+static void MIL_ADCAlarmISR(uint8_t adc){
+
+    uint32_t base = adc ? ADC1_BASE : ADC0_BASE;
+    uint32_t status;
+    uint8_t comp;
+
+    status = ADCComparatorIntStatus(base) & 0xFF;
+    ADCComparatorIntClear(base, status);
+    ADCIntClearEx(base, ADC_INT_DCON_SS0 << AlarmSeq[adc]);
+
+    for(comp = 0;status;comp++, status >>= 1){
+
+        if(status & 0x01){
+
+            pAlarm[adc](base, AlarmIdx[adc][comp], (AlarmOver[adc] >> comp) & 0x01);
+
+        }
+
+    }
+
+}
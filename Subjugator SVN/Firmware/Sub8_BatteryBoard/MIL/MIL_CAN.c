@@ -12,6 +12,11 @@
  *        board termination resistors
  */
 
+/*
+ * Host builds(MIL_CAN_SOCKETCAN) use MIL_CAN_SocketCAN.c instead
+ */
+#ifndef MIL_CAN_SOCKETCAN
+
 /* INCLUDES */
 //includes
 #include <stdbool.h>
@@ -28,6 +33,57 @@
 
 //MIL includes
 #include"MIL_CAN.h"
+#include"MIL_CLK.h"
+
+/* MODULE STATE */
+/*
+ * Everything below is kept per controller,
+ * index 0 is CAN0 and index 1 is CAN1
+ */
+#define MIL_CAN_IDX(base) (((base) == CAN1_BASE) ? 1 : 0)
+
+static MIL_CAN_Ring_t *pRxRing[2];      //0 while the controller is polled
+static uint32_t RxObjMask[2];           //bit (obj_num - 1) is set for every RX mailbox
+static uint32_t (*pTimeSource)(void);   //frame timestamp source
+static MIL_CAN_TxQ_t *pTxQ[2];          //0 while MIL_CANSimpleTX uses the legacy path
+static uint32_t TxBankMask[2];          //bit (obj_num - 1) is set for every TX queue object
+static MIL_CAN_Dispatch_t *pDispatch[2]; //0 when no handlers are used
+static bool DispatchInISR[2];           //handlers run from the ISR instead of MIL_CAN_DispatchPoll
+static MIL_CAN_TP_t *pTP[2];            //0 when the segmented transport is off
+static MIL_CAN_Gw_t *pGw;               //0 when the gateway is off
+
+//the ISR reads RX mailboxes itself when there is a ring or ISR dispatch
+#define MIL_CAN_RX_IN_ISR(idx) (pRxRing[idx] || (pDispatch[idx] && DispatchInISR[idx]))
+
+static MIL_CAN_MailBox_t *pMailOf[2][32]; //mailbox each RX object belongs to
+
+static uint32_t BitRate[2];             //actual bit rate, 0 until initialized
+
+static MIL_CAN_Diag_t *pDiag[2];        //0 when telemetry is off
+static uint32_t DiagReportId[2];        //CAN ID of the 'D' frame
+static uint32_t DiagReportTicks[2];     //time source ticks between reports
+static uint32_t DiagLastReport[2];      //tick of the last report
+
+static void MIL_CAN_ISR(uint32_t base);
+static void MIL_CAN0_ISR(void){ MIL_CAN_ISR(CAN0_BASE); }
+static void MIL_CAN1_ISR(void){ MIL_CAN_ISR(CAN1_BASE); }
+static void MIL_CAN_InstallISR(uint32_t base);
+static void MIL_CAN_TxLoad(uint32_t base, uint8_t obj, MIL_CAN_TxFrame_t *pframe);
+static void MIL_CAN_RxRead(uint32_t base, uint8_t obj, MIL_CAN_Frame_t *pframe, uint32_t timestamp);
+static void MIL_CAN_DiagCountRx(uint8_t idx, uint32_t canid, uint8_t len);
+static uint8_t MIL_CAN_MailDepth(MIL_CAN_MailBox_t *pmailbox);
+static uint32_t MIL_CAN_MailMask(MIL_CAN_MailBox_t *pmailbox);
+static void MIL_CAN_MailSeen(MIL_CAN_MailBox_t *pmailbox);
+static uint8_t MIL_CAN_RingMailCount(MIL_CAN_Ring_t *pring, MIL_CAN_MailBox_t *pmailbox);
+static uint32_t MIL_CAN_Now(void);
+static bool MIL_CAN_QueueIfClear(uint32_t base, uint32_t canid, uint8_t *data, uint8_t len,
+                                 void (*pdone)(uint32_t canid, void *pctx), void *pctx);
+static void MIL_CAN_TPSentDone(uint32_t canid, void *pctx){ MIL_CAN_TPSent((MIL_CAN_TP_t *)pctx, canid); }
+static bool MIL_CAN0_TPSend(uint32_t canid, uint8_t *data, uint8_t len){ return MIL_CAN_QueueIfClear(CAN0_BASE, canid, data, len, &MIL_CAN_TPSentDone, pTP[0]); }
+static bool MIL_CAN1_TPSend(uint32_t canid, uint8_t *data, uint8_t len){ return MIL_CAN_QueueIfClear(CAN1_BASE, canid, data, len, &MIL_CAN_TPSentDone, pTP[1]); }
+static void MIL_CAN_TPHandler(MIL_CAN_Frame_t *pframe, void *pctx);
+static void MIL_CAN0_GwHandler(MIL_CAN_Frame_t *pframe, void *pctx){ MIL_CAN_GwInput((MIL_CAN_Gw_t *)pctx, MIL_CAN_GW_0TO1, pframe); }
+static void MIL_CAN1_GwHandler(MIL_CAN_Frame_t *pframe, void *pctx){ MIL_CAN_GwInput((MIL_CAN_Gw_t *)pctx, MIL_CAN_GW_1TO0, pframe); }
 
 /*
  * Desc: enables CAN which can be enabled on
@@ -37,7 +93,7 @@
  * Notes: Does not enable interrupts
  *        or port clocks
  *        PORT and Interrupts
- *        must be enabled outside funciton
+ *        must be enabled outside function
  *	
  *		  IF YOU SET CAN1_BASE AS YOUR BASE
  *   	  FUNCTION WILL DEFAULT TO CONFIGURING PORT A
@@ -54,9 +110,29 @@
  * port - from mil_port enum
  * base - CAN base(CAN0_BASE or CAN1_BASE) from tivaware
  * Assumes: Port clocks are enabled
+ *
+ * Notes: Runs at MIL_CAN_DEFAULT_RATE, use MIL_InitCANRate
+ *        for anything else
  */
 void MIL_InitCAN(mil_can_port_t port,uint32_t base){
 
+    MIL_InitCANRate(port, base, MIL_CAN_DEFAULT_RATE);
+
+}
+
+/*
+ * Desc: Same as MIL_InitCAN but at a bit rate you pick
+ *
+ * Notes: The bit timing is worked out from the current system
+ *        clock, so set the clock(MIL_CLK) BEFORE calling this
+ *
+ * Returns:
+ * MIL_CAN_OK if the rate could be set
+ * MIL_CAN_NOK if the system clock cannot make that rate,
+ *             the controller is left disabled
+ */
+mil_can_status_t MIL_InitCANRate(mil_can_port_t port, uint32_t base, uint32_t rate){
+
 
     //pin configuration
     /*
@@ -97,6 +173,7 @@ void MIL_InitCAN(mil_can_port_t port,uint32_t base){
 			GPIOPinConfigure(GPIO_PA0_CAN1RX);
 			GPIOPinConfigure(GPIO_PA1_CAN1TX);
 			GPIOPinTypeCAN(GPIO_PORTA_BASE, GPIO_PIN_0 | GPIO_PIN_1);
+		
 	}
 
 		
@@ -108,11 +185,56 @@ void MIL_InitCAN(mil_can_port_t port,uint32_t base){
     CANRetrySet(base,1);
 
     //Set bit rates
-    CANBitRateSet(base, SysCtlClockGet(), 200000);
+    if(MIL_CAN_SetBitRate(base, rate, MIL_CAN_SP_DEFAULT) != MIL_CAN_OK){
+        return MIL_CAN_NOK;
+    }
 
     //enable CAN
     CANEnable(base);
 
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Changes the bit rate of a running controller
+ *
+ * Notes: CANBitTimingSet puts the controller in init mode
+ *        while it writes the timing and puts it back after
+ *
+ * Returns:
+ * MIL_CAN_OK if the rate was set
+ * MIL_CAN_NOK if the system clock cannot make that rate(nothing changed)
+ */
+mil_can_status_t MIL_CAN_SetBitRate(uint32_t base, uint32_t rate, uint16_t sample_point){
+
+    MIL_CAN_BitTiming_t timing;
+    tCANBitClkParms clk_parms;
+
+    if(!MIL_CAN_SolveBitTiming(MIL_ClkGetHz(), rate, sample_point, &timing)){
+        return MIL_CAN_NOK;
+    }
+
+    clk_parms.ui32SyncPropPhase1Seg = timing.sync_prop_phase1;
+    clk_parms.ui32Phase2Seg = timing.phase2;
+    clk_parms.ui32SJW = timing.sjw;
+    clk_parms.ui32QuantumPrescaler = timing.prescaler;
+
+    CANBitTimingSet(base, &clk_parms);
+
+    BitRate[MIL_CAN_IDX(base)] = timing.actual_rate;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Returns the bit rate the controller actually runs at
+ */
+uint32_t MIL_CAN_GetBitRate(uint32_t base){
+
+    return BitRate[MIL_CAN_IDX(base)];
+
 }
 
 /*
@@ -188,6 +310,10 @@ void MIL_CANPortClkEnable(mil_can_port_t port){
  * Desc: Easy to use function to transmit a message to the CAN bus
  * 	     This function declares a temporary Can message object and uses
  *	     object 0 to transmit the message
+ *
+ *       If MIL_CAN_TxQueueInit was called for this base the message
+ *       goes through the TX queue instead(see MIL_CANQueueTX) so
+ *       back to back calls no longer overwrite each other
  * 
  * Inputs: 
  * canid - ID of your CAN node
@@ -196,6 +322,11 @@ void MIL_CANPortClkEnable(mil_can_port_t port){
  * base - which CAN module you want to use(CAN1_BASE or CAN0_BASE from tivaWare)
  */
 void MIL_CANSimpleTX(uint32_t canid,uint8_t *pMsg,uint8_t MsgLen,uint32_t base){
+
+	if(pTxQ[MIL_CAN_IDX(base)]){
+		MIL_CANQueueTX(canid, pMsg, MsgLen, base, 0, 0);
+		return;
+	}
 	
 	tCANMsgObject SimpleTXObj;
 	SimpleTXObj.ui32MsgID = canid;
@@ -207,16 +338,146 @@ void MIL_CANSimpleTX(uint32_t canid,uint8_t *pMsg,uint8_t MsgLen,uint32_t base){
 }
 
 /*
- * Desc: after configureing your mailbox struct
+ * Desc: Reserves a bank of message objects as a transmit queue
+ *
+ * Notes: Objects first_obj to first_obj + num_obj - 1 belong to the
+ *        queue from now on, DO NOT USE THEM FOR MAILBOXES
+ *
+ *        Call this once before anything is sent, frames already
+ *        queued are forgotten
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pq - queue storage you declare(one per controller)
+ * first_obj - first message object of the bank(1 to 32)
+ * num_obj - objects in the bank(up to MIL_CAN_TXQ_MAX_BANK)
+ */
+void MIL_CAN_TxQueueInit(uint32_t base, MIL_CAN_TxQ_t *pq, uint8_t first_obj, uint8_t num_obj){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+
+    MIL_CAN_TxQInit(pq, first_obj, num_obj);
+
+    //make sure nothing left over in the bank goes out
+    for(uint8_t obj = pq->first_obj;obj < (pq->first_obj + pq->num_obj);obj++){
+        CANMessageClear(base, obj);
+    }
+
+    TxBankMask[idx] = 0;
+    for(uint8_t i = 0;i < pq->num_obj;i++){
+        TxBankMask[idx] |= 0x01UL << (pq->first_obj - 1 + i);
+    }
+    pTxQ[idx] = pq;
+
+    MIL_CAN_InstallISR(base);
+
+}
+
+/*
+ * Desc: Puts a message on the TX queue
+ *
+ * Notes: Safe to call from the main loop and from ISRs
+ *
+ * Parameters:
+ * canid - ID to transmit with
+ * pMsg - pointer to your message(copied, reuse it right away)
+ * MsgLen - the number of bytes in your message(up to 8 bytes)
+ * base - CAN0_BASE or CAN1_BASE
+ * pdone - called from the CAN ISR once the frame has been sent(can be 0)
+ * pctx - handed back to pdone
+ *
+ * Returns:
+ * MIL_CAN_OK if the message was queued
+ * MIL_CAN_NOK if the queue is full or was never set up
+ */
+mil_can_status_t MIL_CANQueueTX(uint32_t canid, uint8_t *pMsg, uint8_t MsgLen, uint32_t base,
+                                void (*pdone)(uint32_t canid, void *pctx), void *pctx){
+
+    MIL_CAN_TxQ_t *pq = pTxQ[MIL_CAN_IDX(base)];
+    MIL_CAN_TxFrame_t frame;
+    mil_can_txq_res_t res;
+    uint8_t obj;
+    bool int_off;
+
+    if(!pq){
+        return MIL_CAN_NOK;
+    }
+
+    if(MsgLen > 8){
+        MsgLen = 8;
+    }
+
+    frame.canid = canid;
+    frame.len = MsgLen;
+    for(uint8_t i = 0;i < MsgLen;i++){
+        frame.data[i] = pMsg[i];
+    }
+    frame.pdone = pdone;
+    frame.pctx = pctx;
+    frame.queued_at = MIL_CAN_Now();
+
+    /*
+     * The object has to be loaded before the ISR can look at it,
+     * a busy object without TXRQST set reads as already sent
+     */
+    int_off = IntMasterDisable();
+
+    res = MIL_CAN_TxQSubmit(pq, &frame, &obj);
+    if(res == MIL_CAN_TXQ_LOAD){
+        MIL_CAN_TxLoad(base, obj, MIL_CAN_TxQInflight(pq, obj));
+    }
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    return (res == MIL_CAN_TXQ_FULL) ? MIL_CAN_NOK : MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Copies out the TX queue statistics
+ *
+ * Returns:
+ * MIL_CAN_OK if the stats were copied
+ * MIL_CAN_NOK if the queue was never set up
+ */
+mil_can_status_t MIL_CAN_TxStatsGet(uint32_t base, MIL_CAN_TxStats_t *pstats){
+
+    MIL_CAN_TxQ_t *pq = pTxQ[MIL_CAN_IDX(base)];
+    bool int_off;
+
+    if(!pq){
+        return MIL_CAN_NOK;
+    }
+
+    int_off = IntMasterDisable();
+    *pstats = pq->stats;
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: after configuring your mailbox struct
  *       pass it into this function in order to
  *       intialize reception
  *
  * Parameters:
  * pmailbox - a pointer to your mailbox
  * outBuffer- a pointer to your CAN output array
+ *
+ * Notes: with fifo_depth > 1 every object but the last
+ *        gets MSG_OBJ_FIFO so the hardware chains them
  */
 void MIL_InitMailBox(MIL_CAN_MailBox_t *pmailbox){
 
+    uint8_t depth = MIL_CAN_MailDepth(pmailbox);
+    uint32_t flags;
+
     //basically copy mailbox parameters to TI CAN object
     pmailbox->msg_obj.ui32MsgID = pmailbox->canid;
     pmailbox->msg_obj.ui32MsgIDMask = pmailbox->filt_mask;
@@ -231,7 +492,25 @@ void MIL_InitMailBox(MIL_CAN_MailBox_t *pmailbox){
     }
     pmailbox->msg_obj.ui32MsgLen = pmailbox->msg_len;
 
-    CANMessageSet(pmailbox->base, pmailbox->obj_num, &pmailbox->msg_obj, MSG_OBJ_TYPE_RX);
+    //the ring ISR only runs if the object raises an interrupt
+    if(MIL_CAN_RX_IN_ISR(MIL_CAN_IDX(pmailbox->base))){
+        pmailbox->msg_obj.ui32Flags |= MSG_OBJ_RX_INT_ENABLE;
+    }
+
+    pmailbox->overruns = 0;
+    pmailbox->fifo_used = 0;
+    pmailbox->fifo_seen = 0;
+    pmailbox->fifo_head = 0;
+    RxObjMask[MIL_CAN_IDX(pmailbox->base)] |= MIL_CAN_MailMask(pmailbox);
+
+    //same filter on every object, only the last one ends the FIFO
+    flags = pmailbox->msg_obj.ui32Flags;
+    for(uint8_t i = 0;i < depth;i++){
+        pmailbox->msg_obj.ui32Flags = (i < (depth - 1)) ? (flags | MSG_OBJ_FIFO) : flags;
+        CANMessageSet(pmailbox->base, pmailbox->obj_num + i, &pmailbox->msg_obj, MSG_OBJ_TYPE_RX);
+        pMailOf[MIL_CAN_IDX(pmailbox->base)][pmailbox->obj_num - 1 + i] = pmailbox;
+    }
+    pmailbox->msg_obj.ui32Flags = flags;
 }
 
 /*
@@ -257,26 +536,72 @@ void MIL_InitMailBox(MIL_CAN_MailBox_t *pmailbox){
  */
 mil_can_status_t MIL_CAN_GetMail(MIL_CAN_MailBox_t *pmailbox){
 
+        MIL_CAN_Ring_t *pring = pRxRing[MIL_CAN_IDX(pmailbox->base)];
 
-        if(CANStatusGet(pmailbox->base,CAN_STS_NEWDAT) & (0x01<<(pmailbox->obj_num-1))){
+        //interrupt driven controller, mail comes off the ring in arrival order
+        if(pring){
 
-            //receive message and clear flag
-            CANMessageGet(pmailbox->base,pmailbox->obj_num,&pmailbox->msg_obj,1);
+            MIL_CAN_Frame_t *pframe = MIL_CAN_RingPeek(pring);
 
-//            for(uint8_t i = 0;i < pmailbox->msg_len;i++){
-//
-//                pdata[i] = pmailbox->msg_obj.pui8MsgData[i];
-//
-//            }
+            if(!pframe || !(MIL_CAN_MailMask(pmailbox) & (0x01UL << (pframe->obj_num - 1)))){
+                return MIL_CAN_NOK;
+            }
 
+            if(pframe->flags & MIL_CAN_FRAME_LOST_bm){
+                pmailbox->overruns++;
+            }
+
+            uint8_t len = (pframe->len < pmailbox->msg_len) ? pframe->len : pmailbox->msg_len;
+            for(uint8_t i = 0;i < len;i++){
+                pmailbox->buffer[i] = pframe->data[i];
+            }
+            pmailbox->msg_obj.ui32MsgID = pframe->canid;
+            pmailbox->msg_obj.ui32MsgLen = pframe->len;
+
+            MIL_CAN_RingDrop(pring);
+            pmailbox->fifo_used = MIL_CAN_RingMailCount(pring, pmailbox);
             return MIL_CAN_OK;
         }
 
-    else{
+        /*
+         * Nothing but this read frees an object, so frames that show up
+         * between two looks went into the free objects lowest first.
+         * Looking right before and right after the read keeps the only
+         * look-to-look span with a free in it far shorter than a frame
+         */
+        bool int_off = IntMasterDisable();
+        uint8_t obj;
 
-        return MIL_CAN_NOK;
+        MIL_CAN_MailSeen(pmailbox);
 
-    }
+        if(!pmailbox->fifo_used){
+            if(!int_off){
+                IntMasterEnable();
+            }
+            return MIL_CAN_NOK;
+        }
+
+        obj = pmailbox->fifo_order[pmailbox->fifo_head];
+        pmailbox->fifo_head = (pmailbox->fifo_head + 1) & 0x1F;
+        pmailbox->fifo_used--;
+        pmailbox->fifo_seen &= ~(0x01UL << (obj - 1));
+
+        //receive message and clear flag
+        CANMessageGet(pmailbox->base,obj,&pmailbox->msg_obj,1);
+        MIL_CAN_MailSeen(pmailbox);
+
+        if(!int_off){
+            IntMasterEnable();
+        }
+
+        if(pmailbox->msg_obj.ui32Flags & MSG_OBJ_DATA_LOST){
+            pmailbox->overruns++;
+        }
+
+        MIL_CAN_DiagCountRx(MIL_CAN_IDX(pmailbox->base), pmailbox->msg_obj.ui32MsgID,
+                            pmailbox->msg_obj.ui32MsgLen);
+
+        return MIL_CAN_OK;
 
 }
 /*
@@ -292,14 +617,682 @@ mil_can_status_t MIL_CAN_GetMail(MIL_CAN_MailBox_t *pmailbox){
  */
 mil_can_status_t MIL_CAN_CheckMail(MIL_CAN_MailBox_t *pmailbox){
 
-    if(CANStatusGet(pmailbox->base,CAN_STS_NEWDAT) & (0x01 << (pmailbox->obj_num-1))){return MIL_CAN_OK;}
+    MIL_CAN_Ring_t *pring = pRxRing[MIL_CAN_IDX(pmailbox->base)];
+
+    if(pring){
+        MIL_CAN_Frame_t *pframe = MIL_CAN_RingPeek(pring);
+        pmailbox->fifo_used = MIL_CAN_RingMailCount(pring, pmailbox);
+        if(pframe && (MIL_CAN_MailMask(pmailbox) & (0x01UL << (pframe->obj_num - 1)))){return MIL_CAN_OK;}
+        else{return MIL_CAN_NOK;}
+    }
+
+    //only adds to the read order, safe without masking interrupts
+    MIL_CAN_MailSeen(pmailbox);
+    if(pmailbox->fifo_used){return MIL_CAN_OK;}
     else{return MIL_CAN_NOK;}
 
 }
 
+/*
+ * Desc: Switches a CAN controller from polled reception
+ *       to interrupt driven reception
+ *
+ * Notes: CALL THIS BEFORE MIL_InitMailBox
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pring - ring storage you declare(one per controller)
+ */
+void MIL_CAN_RxRingEnable(uint32_t base, MIL_CAN_Ring_t *pring){
+
+    MIL_CAN_RingInit(pring);
+    pRxRing[MIL_CAN_IDX(base)] = pring;
+
+    MIL_CAN_InstallISR(base);
+
+}
+
+/*
+ * Desc: Sets the function the ISR calls to timestamp frames
+ *
+ * Parameters:
+ * ptime_fn - returns the current time in whatever unit you like
+ */
+void MIL_CAN_SetTimeSource(uint32_t (*ptime_fn)(void)){
 
+    pTimeSource = ptime_fn;
 
+}
+
+/*
+ * Desc: Pulls the oldest received frame off the ring
+ *
+ * Returns:
+ * MIL_CAN_OK if a frame was copied
+ * MIL_CAN_NOK if the ring is empty or not enabled
+ */
+mil_can_status_t MIL_CAN_ReadFrame(uint32_t base, MIL_CAN_Frame_t *pframe){
+
+    MIL_CAN_Ring_t *pring = pRxRing[MIL_CAN_IDX(base)];
+
+    if(pring && MIL_CAN_RingPop(pring, pframe)){
+        return MIL_CAN_OK;
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: Turns on handler dispatch for a controller
+ *
+ * Notes: CALL THIS BEFORE MIL_InitMailBox
+ *
+ * Parameters:
+ * base - CAN0_BASE or CAN1_BASE
+ * pd - table storage you declare(one per controller)
+ * in_isr - true runs handlers inside the CAN ISR,
+ *          false runs them from MIL_CAN_DispatchPoll
+ */
+void MIL_CAN_DispatchEnable(uint32_t base, MIL_CAN_Dispatch_t *pd, bool in_isr){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+
+    MIL_CAN_DispatchInit(pd);
+    DispatchInISR[idx] = in_isr;
+    pDispatch[idx] = pd;
+
+    if(in_isr){
+        MIL_CAN_InstallISR(base);
+    }
+
+}
+
+/*
+ * Desc: Registers a handler for one message type on a mailbox
+ *
+ * Returns:
+ * MIL_CAN_OK if the handler was added
+ * MIL_CAN_NOK if dispatch is off or the table is full
+ */
+mil_can_status_t MIL_CAN_Register(MIL_CAN_MailBox_t *pmailbox, int16_t msg_type,
+                                  mil_can_handler_t phandler, void *pctx){
+
+    MIL_CAN_Dispatch_t *pd = pDispatch[MIL_CAN_IDX(pmailbox->base)];
+
+    //every object of a FIFO mailbox shares the mailbox's handlers
+    if(pd && MIL_CAN_DispatchAdd(pd, pmailbox->obj_num, msg_type, phandler, pctx)){
+        MIL_CAN_DispatchLink(pd, pmailbox->obj_num, MIL_CAN_MailDepth(pmailbox));
+        return MIL_CAN_OK;
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: Runs the handler of every frame waiting in the ring,
+ *       or waiting in the mailboxes of a polled controller
+ *
+ * Returns: number of frames handled
+ */
+uint32_t MIL_CAN_DispatchPoll(uint32_t base){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    MIL_CAN_Ring_t *pring = pRxRing[idx];
+    MIL_CAN_Dispatch_t *pd = pDispatch[idx];
+    MIL_CAN_Frame_t *pframe;
+    MIL_CAN_Frame_t frame;
+    uint32_t pending;
+    uint32_t count = 0;
+    uint8_t obj;
+
+    if(!pd){
+        return 0;
+    }
+
+    if(pring){
+        //handlers run straight out of the ring slot, no copy
+        while((pframe = MIL_CAN_RingPeek(pring)) != 0){
+            MIL_CAN_DispatchFrame(pd, pframe);
+            MIL_CAN_RingDrop(pring);
+            count++;
+        }
+    }
+    else if(!DispatchInISR[idx]){
+        /*
+         * One NEWDAT read covers every mailbox, after that only
+         * objects holding a frame are touched. Lowest object first
+         * is the order the hardware prioritises them in and keeps
+         * FIFO mailboxes in arrival order
+         */
+        pending = CANStatusGet(base, CAN_STS_NEWDAT) & RxObjMask[idx];
+
+        while(pending){
+            obj = MIL_CAN_CTZ(pending) + 1;
+            pending &= pending - 1;
+
+            MIL_CAN_RxRead(base, obj, &frame, MIL_CAN_Now());
+
+            if((frame.flags & MIL_CAN_FRAME_LOST_bm) && pMailOf[idx][obj - 1]){
+                pMailOf[idx][obj - 1]->overruns++;
+            }
+            MIL_CAN_DiagCountRx(idx, frame.canid, frame.len);
+
+            MIL_CAN_DispatchFrame(pd, &frame);
+            count++;
+        }
+    }
+
+    if(pTP[idx]){
+        MIL_CAN_TPService(pTP[idx], MIL_CAN_Now());
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: Turns on the segmented transport on a mailbox
+ *
+ * Returns:
+ * MIL_CAN_OK if the transport is on
+ * MIL_CAN_NOK if the TX queue or main loop dispatch is missing
+ *             or the dispatch table is full
+ */
+mil_can_status_t MIL_CAN_TPEnable(MIL_CAN_MailBox_t *pmailbox, MIL_CAN_TP_t *ptp, uint32_t tick_hz){
+
+    uint8_t idx = MIL_CAN_IDX(pmailbox->base);
+    MIL_CAN_Dispatch_t *pd = pDispatch[idx];
+
+    //the transport does no locking so it cannot run from the ISR
+    if(!pd || DispatchInISR[idx] || !pTxQ[idx]){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_TPInit(ptp, tick_hz, idx ? &MIL_CAN1_TPSend : &MIL_CAN0_TPSend);
+
+    if(!MIL_CAN_DispatchAddRange(pd, pmailbox->obj_num, MIL_CAN_TP_FIRST_TYPE, MIL_CAN_TP_LAST_TYPE,
+                                 &MIL_CAN_TPHandler, ptp)){
+        return MIL_CAN_NOK;
+    }
+    MIL_CAN_DispatchLink(pd, pmailbox->obj_num, MIL_CAN_MailDepth(pmailbox));
 
+    pTP[idx] = ptp;
 
+    return MIL_CAN_OK;
 
+}
+
+/*
+ * Desc: Starts sending a message to a transport peer
+ *
+ * Returns:
+ * MIL_CAN_OK if sending started
+ * MIL_CAN_NOK if the session is still busy, the transport is
+ *             off or the first frame did not fit in the queue
+ */
+mil_can_status_t MIL_CAN_TPWrite(uint32_t base, uint8_t session, uint8_t *data, uint16_t len){
+
+    MIL_CAN_TP_t *ptp = pTP[MIL_CAN_IDX(base)];
+
+    if(ptp && MIL_CAN_TPSend(ptp, session, data, len, MIL_CAN_Now())){
+        return MIL_CAN_OK;
+    }
+
+    return MIL_CAN_NOK;
+
+}
+
+/*
+ * Desc: Forwards frames between CAN0 and CAN1
+ *
+ * Returns:
+ * MIL_CAN_OK if the gateway is on
+ * MIL_CAN_NOK if a TX queue or dispatch is missing or a
+ *             dispatch table is full
+ */
+mil_can_status_t MIL_CAN_GwEnable(MIL_CAN_Gw_t *pgw, MIL_CAN_MailBox_t *pmailbox0,
+                                  MIL_CAN_MailBox_t *pmailbox1, uint32_t tick_hz){
+
+    if(!pTxQ[0] || !pTxQ[1]){
+        return MIL_CAN_NOK;
+    }
+
+    MIL_CAN_GwInit(pgw, tick_hz, MIL_CAN_Now());
+
+    //frames are only queued in the handlers, sending waits for MIL_CAN_GwService
+    if(MIL_CAN_Register(pmailbox0, MIL_CAN_ANY_TYPE, &MIL_CAN0_GwHandler, pgw) != MIL_CAN_OK ||
+       MIL_CAN_Register(pmailbox1, MIL_CAN_ANY_TYPE, &MIL_CAN1_GwHandler, pgw) != MIL_CAN_OK){
+        return MIL_CAN_NOK;
+    }
+
+    pGw = pgw;
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Sends the queued gateway frames the rate limits allow
+ *
+ * Returns: number of frames forwarded
+ */
+uint32_t MIL_CAN_GwService(void){
+
+    MIL_CAN_Frame_t *pframe;
+    uint32_t now = MIL_CAN_Now();
+    uint32_t count = 0;
+
+    if(!pGw){
+        return 0;
+    }
+
+    for(uint8_t dir = MIL_CAN_GW_0TO1;dir <= MIL_CAN_GW_1TO0;dir++){
+
+        uint32_t out_base = (dir == MIL_CAN_GW_0TO1) ? CAN1_BASE : CAN0_BASE;
+
+        while((pframe = MIL_CAN_GwPeek(pGw, dir, now)) != 0){
+            if(!MIL_CAN_QueueIfClear(out_base, pframe->canid, pframe->data, pframe->len, 0, 0)){
+                break;
+            }
+            MIL_CAN_GwDrop(pGw, dir);
+            count++;
+        }
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: Turns on bus load and error telemetry for a controller
+ */
+void MIL_CAN_DiagEnable(uint32_t base, MIL_CAN_Diag_t *pd, uint32_t tick_hz,
+                        uint32_t report_id, uint32_t report_ms){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    uint32_t now = MIL_CAN_Now();
+
+    MIL_CAN_DiagInit(pd, tick_hz, now);
+
+    DiagReportId[idx] = report_id;
+    DiagReportTicks[idx] = (uint32_t)(((uint64_t)tick_hz * report_ms) / 1000);
+    DiagLastReport[idx] = now;
+    pDiag[idx] = pd;
+
+    //bus-off and error passive changes come in through the error interrupt
+    MIL_CAN_InstallISR(base);
+
+}
+
+/*
+ * Desc: Sends the 'D' frame once every report period
+ */
+mil_can_status_t MIL_CAN_DiagService(uint32_t base){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    MIL_CAN_Diag_t *pd = pDiag[idx];
+    uint8_t report[8];
+    uint32_t now;
+    uint32_t tec;
+    uint32_t rec;
+    bool int_off;
+
+    if(!pd){
+        return MIL_CAN_NOK;
+    }
+
+    now = MIL_CAN_Now();
+    if((now - DiagLastReport[idx]) < DiagReportTicks[idx]){
+        return MIL_CAN_NOK;
+    }
+    DiagLastReport[idx] = now;
+
+    CANErrCntrGet(base, &rec, &tec);
+
+    //the ISR adds to the same counters
+    int_off = IntMasterDisable();
+    MIL_CAN_DiagSnapshot(pd, now, BitRate[idx], (tec > 255) ? 255 : tec, rec);
+    MIL_CAN_DiagEncode(pd, report);
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    MIL_CANSimpleTX(DiagReportId[idx], report, 8, base);
+
+    return MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Current time source tick(0 if none was set)
+ */
+static uint32_t MIL_CAN_Now(void){
+
+    return pTimeSource ? pTimeSource() : 0;
+
+}
+
+/*
+ * Desc: Transport and gateway frames go through the TX queue but
+ *       only while its overflow ring is empty, the rest of the ring
+ *       is left for the node's own frames
+ */
+static bool MIL_CAN_QueueIfClear(uint32_t base, uint32_t canid, uint8_t *data, uint8_t len,
+                                 void (*pdone)(uint32_t canid, void *pctx), void *pctx){
+
+    MIL_CAN_TxQ_t *pq = pTxQ[MIL_CAN_IDX(base)];
+
+    if(!pq || pq->ovf_count){
+        return false;
+    }
+
+    return MIL_CANQueueTX(canid, data, len, base, pdone, pctx) == MIL_CAN_OK;
+
+}
+
+/*
+ * Desc: Dispatch handler for transport frames
+ */
+static void MIL_CAN_TPHandler(MIL_CAN_Frame_t *pframe, void *pctx){
+
+    MIL_CAN_TPInput((MIL_CAN_TP_t *)pctx, pframe->canid, pframe->data, pframe->len, MIL_CAN_Now());
+
+}
+
+/*
+ * Desc: Number of message objects a mailbox uses
+ */
+static uint8_t MIL_CAN_MailDepth(MIL_CAN_MailBox_t *pmailbox){
+
+    uint8_t depth = pmailbox->fifo_depth ? pmailbox->fifo_depth : 1;
+
+    if(depth > (33 - pmailbox->obj_num)){
+        depth = 33 - pmailbox->obj_num;
+    }
+
+    return depth;
+
+}
+
+/*
+ * Desc: Adds objects that took a frame since the last look to the
+ *       end of the mailbox's read order, lowest first
+ */
+static void MIL_CAN_MailSeen(MIL_CAN_MailBox_t *pmailbox){
+
+    uint32_t fresh = CANStatusGet(pmailbox->base,CAN_STS_NEWDAT) & MIL_CAN_MailMask(pmailbox)
+                     & ~pmailbox->fifo_seen;
+
+    pmailbox->fifo_seen |= fresh;
+    while(fresh){
+        pmailbox->fifo_order[(pmailbox->fifo_head + pmailbox->fifo_used) & 0x1F] = MIL_CAN_CTZ(fresh) + 1;
+        pmailbox->fifo_used++;
+        fresh &= fresh - 1;
+    }
+
+}
+
+/*
+ * Desc: Frames in the ring that belong to a mailbox
+ */
+static uint8_t MIL_CAN_RingMailCount(MIL_CAN_Ring_t *pring, MIL_CAN_MailBox_t *pmailbox){
+
+    uint32_t mask = MIL_CAN_MailMask(pmailbox);
+    uint32_t head = pring->head;
+    uint8_t count = 0;
+
+    //only the ISR moves head, slots before it are settled
+    MIL_CAN_RING_BARRIER();
+    for(uint32_t i = pring->tail;i != head;i++){
+        if(mask & (0x01UL << (pring->frames[i & (MIL_CAN_RING_SIZE - 1)].obj_num - 1))){
+            count++;
+        }
+    }
+
+    return count;
+
+}
+
+/*
+ * Desc: NEWDAT style mask of the message objects a mailbox uses
+ */
+static uint32_t MIL_CAN_MailMask(MIL_CAN_MailBox_t *pmailbox){
+
+    uint32_t mask = 0;
+
+    for(uint8_t i = 0;i < MIL_CAN_MailDepth(pmailbox);i++){
+        mask |= 0x01UL << (pmailbox->obj_num - 1 + i);
+    }
+
+    return mask;
+
+}
+
+/*
+ * Desc: Counts a received frame for the telemetry
+ */
+static void MIL_CAN_DiagCountRx(uint8_t idx, uint32_t canid, uint8_t len){
+
+    bool int_off;
+
+    if(!pDiag[idx]){
+        return;
+    }
+
+    int_off = IntMasterDisable();
+    MIL_CAN_DiagRx(pDiag[idx], canid, len);
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+}
+
+/*
+ * Desc: Hooks the MIL CAN ISR up to a controller
+ */
+static void MIL_CAN_InstallISR(uint32_t base){
+
+    /*
+     * Only the error interrupt is turned on at the controller level,
+     * CAN_INT_STATUS would fire for every frame on the bus
+     * (including ones we filter out)
+     */
+    CANIntRegister(base, (base == CAN1_BASE) ? &MIL_CAN1_ISR : &MIL_CAN0_ISR);
+    CANIntEnable(base, CAN_INT_MASTER | CAN_INT_ERROR);
+
+    switch(base){
+        case CAN0_BASE:
+            IntEnable(INT_CAN0);
+            break;
+
+        case CAN1_BASE:
+            IntEnable(INT_CAN1);
+            break;
+    }
+
+}
+
+/*
+ * Desc: Reads an RX message object into a frame, which
+ *       clears its NEWDAT and interrupt pending bits
+ */
+static void MIL_CAN_RxRead(uint32_t base, uint8_t obj, MIL_CAN_Frame_t *pframe, uint32_t timestamp){
+
+    tCANMsgObject msg;
+
+    msg.pui8MsgData = pframe->data;
+
+    CANMessageGet(base, obj, &msg, true);
+
+    pframe->canid = msg.ui32MsgID;
+    pframe->len = (msg.ui32MsgLen > 8) ? 8 : msg.ui32MsgLen;
+    pframe->obj_num = obj;
+    pframe->flags = (msg.ui32Flags & MSG_OBJ_DATA_LOST) ? MIL_CAN_FRAME_LOST_bm : 0;
+    pframe->timestamp = timestamp;
+
+}
+
+/*
+ * Desc: Writes a queued frame into a TX message object
+ */
+static void MIL_CAN_TxLoad(uint32_t base, uint8_t obj, MIL_CAN_TxFrame_t *pframe){
+
+    tCANMsgObject msg;
+
+    msg.ui32MsgID = pframe->canid;
+    msg.ui32MsgIDMask = 0;
+    msg.ui32Flags = MSG_OBJ_TX_INT_ENABLE;
+    msg.ui32MsgLen = pframe->len;
+    msg.pui8MsgData = pframe->data;
+
+    CANMessageSet(base, obj, &msg, MSG_OBJ_TYPE_TX);
+
+}
+
+/*
+ * Desc: MIL CAN ISR body shared by both controllers
+ *
+ *       Reads NEWDAT and moves every RX object holding a frame
+ *       into the ring. Reading an object with CANMessageGet
+ *       clears both its NEWDAT and interrupt pending bits.
+ *
+ *       If the ring is full the object is still read so the
+ *       interrupt is released, the frame is counted in
+ *       pring->dropped
+ *
+ *       With ISR dispatch on, each frame goes to its handler
+ *       right here and only frames without a handler reach
+ *       the ring
+ *
+ *       TX queue objects that are busy but no longer requesting
+ *       to transmit have been sent, each one is refilled from the
+ *       overflow ring and its callback is run
+ *
+ *       A bus-off restarts the controller so it can recover
+ *       (it stays in init mode otherwise and never comes back)
+ */
+static void MIL_CAN_ISR(uint32_t base){
+
+    uint8_t idx = MIL_CAN_IDX(base);
+    MIL_CAN_Ring_t *pring = pRxRing[idx];
+    MIL_CAN_TxQ_t *pq = pTxQ[idx];
+    MIL_CAN_Dispatch_t *pd = DispatchInISR[idx] ? pDispatch[idx] : 0;
+    MIL_CAN_Diag_t *pdiag = pDiag[idx];
+    MIL_CAN_Frame_t *pframe;
+    MIL_CAN_Frame_t scratch;
+    MIL_CAN_TxFrame_t sent;
+    uint32_t timestamp;
+    uint32_t pending;
+    uint32_t cause;
+    uint32_t keep;
+    uint32_t status;
+    uint8_t obj;
+    bool int_off;
+
+    //one timestamp per pass, everything drained here arrived within a frame time of it
+    timestamp = MIL_CAN_Now();
+
+    //reading the control status register releases a status interrupt
+    if(CANIntStatus(base, CAN_INT_STS_CAUSE) == CAN_INT_INTID_STATUS){
+
+        status = CANStatusGet(base, CAN_STS_CONTROL);
+
+        //clearing init starts the 128 x 11 recessive bit recovery
+        if(status & CAN_STATUS_BUS_OFF){
+            CANEnable(base);
+        }
+
+        if(pdiag){
+            MIL_CAN_DiagStatus(pdiag,
+                               ((status & CAN_STATUS_BUS_OFF) ? MIL_CAN_DIAG_BOFF_bm : 0) |
+                               ((status & CAN_STATUS_EPASS) ? MIL_CAN_DIAG_PASSIVE_bm : 0) |
+                               ((status & CAN_STATUS_EWARN) ? MIL_CAN_DIAG_WARN_bm : 0),
+                               timestamp);
+        }
+    }
+
+    /*
+     * Other ISRs may queue frames, the queue is only
+     * touched with interrupts off
+     */
+    if(pq){
+
+        int_off = IntMasterDisable();
+        pending = MIL_CAN_TxQBusyMask(pq) & ~CANStatusGet(base, CAN_STS_TXREQUEST);
+        if(!int_off){
+            IntMasterEnable();
+        }
+
+        while(pending){
+
+            obj = MIL_CAN_CTZ(pending) + 1;
+            pending &= pending - 1;
+
+            CANIntClear(base, obj);
+
+            int_off = IntMasterDisable();
+            if(MIL_CAN_TxQComplete(pq, obj, &sent)){
+                MIL_CAN_TxLoad(base, obj, MIL_CAN_TxQInflight(pq, obj));
+            }
+            if(pdiag){
+                //fresh time, a higher priority ISR may have queued it after timestamp
+                MIL_CAN_DiagTx(pdiag, sent.canid, sent.len, MIL_CAN_Now() - sent.queued_at);
+            }
+            if(!int_off){
+                IntMasterEnable();
+            }
+
+            if(sent.pdone){
+                sent.pdone(sent.canid, sent.pctx);
+            }
+        }
+    }
+
+    //polled mailboxes are left alone when there is no ring
+    pending = MIL_CAN_RX_IN_ISR(idx) ? (CANStatusGet(base, CAN_STS_NEWDAT) & RxObjMask[idx]) : 0;
+
+    while(pending){
+
+        obj = MIL_CAN_CTZ(pending) + 1;
+        pending &= pending - 1;
+
+        //frames for ISR handlers are read to the stack, the rest straight into the ring
+        pframe = (pring && !pd) ? MIL_CAN_RingClaim(pring) : 0;
+        if(!pframe){
+            pframe = &scratch;
+        }
+
+        MIL_CAN_RxRead(base, obj, pframe, timestamp);
+
+        if(pdiag){
+            MIL_CAN_DiagRx(pdiag, pframe->canid, pframe->len);
+        }
+
+        if(pframe != &scratch){
+            MIL_CAN_RingCommit(pring);
+        }
+        else if(pd && !MIL_CAN_DispatchFrame(pd, pframe) && pring){
+            MIL_CAN_RingPush(pring, pframe);
+        }
+        //otherwise the ring was full and the frame is dropped(counted in the ring)
+    }
+
+    /*
+     * Anything still pending that is not an RX mailbox or
+     * TX queue object(a TX object someone set up with its
+     * interrupt on) is cleared here so the ISR does not fire
+     * forever. An RX or TX queue object that finished during
+     * this pass is left pending so the ISR runs again for it.
+     */
+    keep = (MIL_CAN_RX_IN_ISR(idx) ? RxObjMask[idx] : 0) | TxBankMask[idx];
+    cause = CANIntStatus(base, CAN_INT_STS_CAUSE);
+    while((cause >= 1) && (cause <= 32) && !(keep & (0x01UL << (cause - 1)))){
+        CANIntClear(base, cause);
+        cause = CANIntStatus(base, CAN_INT_STS_CAUSE);
+    }
+
+}
 
+#endif /* MIL_CAN_SOCKETCAN */
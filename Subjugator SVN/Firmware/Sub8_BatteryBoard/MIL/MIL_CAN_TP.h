@@ -0,0 +1,261 @@
+/*
+ * Name: MIL_CAN_TP.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Segmented transport for messages longer than one CAN frame
+ *
+ * What to understand: A message of up to MIL_CAN_TP_BUF_SIZE bytes is
+ *                     cut into frames the same way ISO 15765-2(ISO-TP)
+ *                     does it. The first data byte says what kind of
+ *                     frame it is(the PCI byte):
+ *
+ *                     BYTE 0 | FRAME        | REST
+ *                     0x0L   | single       | L(1 to 7) data bytes
+ *                     0x1H   | first        | length low byte, 6 data bytes
+ *                     0x2N   | consecutive  | 7 data bytes, N is a 4 bit sequence
+ *                     0x3S   | flow control | block size, separation time
+ *
+ *                     The receiver answers a first frame with a flow
+ *                     control frame telling the sender how many
+ *                     consecutive frames it may send before waiting for
+ *                     the next flow control(block size, 0 = all of them)
+ *                     and how long to wait between them(separation time).
+ *                     That keeps a slow receiver from being flooded while
+ *                     a fast one can take a message at full bus speed.
+ *
+ * MSG TYPE NOTE: PCI bytes are 0x00 to 0x3F, MIL message types are ASCII
+ *                letters('K','T','H'...), so transport frames can share a
+ *                mailbox with ordinary messages
+ *
+ * SESSION NOTE: A session is one peer. Frames from the peer arrive with
+ *               rx_id and everything we send it goes out with tx_id.
+ *               Every session sends and receives on its own so several
+ *               transfers can run at the same time.
+ *
+ * ORDER NOTE: A session keeps one consecutive frame on the bus at a
+ *             time and waits for MIL_CAN_TPSent before loading the
+ *             next one, so frames can never pass each other in the
+ *             TX hardware and reach the peer out of sequence
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA. It does no locking,
+ *       call everything from the same context(the main loop).
+ *       MIL_CAN_TPSent is the one exception, it may run from an ISR.
+ *       Times are in ticks of whatever clock you pass in as now.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_CAN_TP_H_
+#define MIL_CAN_TP_H_
+
+//peers that can be talked to at once
+#ifndef MIL_CAN_TP_SESSIONS
+#define MIL_CAN_TP_SESSIONS 4
+#endif
+
+//largest message a session can receive(up to 4095)
+#ifndef MIL_CAN_TP_BUF_SIZE
+#define MIL_CAN_TP_BUF_SIZE 256
+#endif
+
+//consecutive frames we accept before sending another flow control(0 = no limit)
+#ifndef MIL_CAN_TP_BLOCK_SIZE
+#define MIL_CAN_TP_BLOCK_SIZE 8
+#endif
+
+//separation time we ask senders for, 0x00 to 0x7F ms or 0xF1 to 0xF9 for 100 to 900 us
+#ifndef MIL_CAN_TP_STMIN
+#define MIL_CAN_TP_STMIN 0
+#endif
+
+//a transfer is given up after this long without a frame from the peer
+#ifndef MIL_CAN_TP_TIMEOUT_MS
+#define MIL_CAN_TP_TIMEOUT_MS 1000
+#endif
+
+//flow control WAITs in a row a send puts up with before giving up(ISO-TP N_WFTmax)
+#ifndef MIL_CAN_TP_WFT_MAX
+#define MIL_CAN_TP_WFT_MAX 8
+#endif
+
+//largest message the 12 bit length can describe
+#define MIL_CAN_TP_MAX_LEN 4095
+
+//first data bytes(message types) transport frames use
+#define MIL_CAN_TP_FIRST_TYPE 0x00
+#define MIL_CAN_TP_LAST_TYPE  0x3F
+
+/*
+ * Desc: callbacks
+ *
+ * mil_can_tp_send_t - puts one frame on the bus, false if there
+ *                     is no room right now(it is tried again later).
+ *                     Every frame it takes must be reported with
+ *                     MIL_CAN_TPSent once it has left
+ * mil_can_tp_rx_t - a whole message arrived(data is only valid
+ *                   during the call)
+ * mil_can_tp_done_t - a message we sent finished, ok is false if
+ *                     the peer refused it, stopped answering or
+ *                     sent more than MIL_CAN_TP_WFT_MAX WAITs in a row,
+ *                     or no frame could be sent for MIL_CAN_TP_TIMEOUT_MS
+ */
+typedef bool (*mil_can_tp_send_t)(uint32_t canid, uint8_t *data, uint8_t len);
+typedef void (*mil_can_tp_rx_t)(uint8_t session, uint8_t *data, uint16_t len, void *pctx);
+typedef void (*mil_can_tp_done_t)(uint8_t session, bool ok, void *pctx);
+
+/*
+ * Desc: per session counters, all counters only go up
+ *
+ * rx_msgs/tx_msgs - messages completed
+ * rx_errors - receptions dropped(sequence error, timeout, too long)
+ * tx_errors - sends that failed(refused, timeout, too many WAITs)
+ */
+typedef struct{
+
+  uint32_t rx_msgs;
+  uint32_t tx_msgs;
+  uint32_t rx_errors;
+  uint32_t tx_errors;
+
+}MIL_CAN_TPStats_t;
+
+/*
+ * Desc: one peer(do not touch fields directly)
+ */
+typedef struct{
+
+  uint32_t rx_id;
+  uint32_t tx_id;
+  mil_can_tp_rx_t   prx;
+  mil_can_tp_done_t pdone;
+  void    *pctx;
+
+  //receiving
+  uint8_t  rx_state;
+  uint16_t rx_len;
+  uint16_t rx_pos;
+  uint8_t  rx_sn;           //sequence number expected next
+  uint8_t  rx_bs_left;      //frames until we send the next flow control
+  bool     rx_fc_pending;   //flow control the bus had no room for
+  uint32_t rx_last;         //tick of the last frame from the peer
+  uint8_t  rx_buf[MIL_CAN_TP_BUF_SIZE];
+
+  //sending
+  uint8_t  tx_state;
+  uint8_t *tx_data;         //caller's buffer, kept until pdone
+  uint16_t tx_len;
+  uint16_t tx_pos;
+  uint8_t  tx_sn;
+  uint8_t  tx_bs;           //block size the peer asked for
+  uint8_t  tx_bs_left;
+  uint8_t  tx_waits;        //flow control WAITs since the last CTS
+  uint32_t tx_gap;          //separation time the peer asked for in ticks
+  uint32_t tx_last;         //tick of the last frame sent/flow control received
+  uint32_t tx_queued;       //frames psend took, written by the main loop only
+  volatile uint32_t tx_sent; //frames that left, written by MIL_CAN_TPSent only
+
+  MIL_CAN_TPStats_t stats;
+
+}MIL_CAN_TPSession_t;
+
+/*
+ * Desc: the transport(do not touch fields directly)
+ */
+typedef struct{
+
+  MIL_CAN_TPSession_t session[MIL_CAN_TP_SESSIONS];
+  uint8_t  num_sessions;
+  uint32_t tick_hz;
+  uint32_t timeout;         //MIL_CAN_TP_TIMEOUT_MS in ticks
+  mil_can_tp_send_t psend;
+
+}MIL_CAN_TP_t;
+
+/*
+ * Desc: sets up a transport with no sessions
+ *
+ * Parameters:
+ * ptp - your transport
+ * tick_hz - ticks per second of the now values you pass in
+ *           (0 turns off timeouts and separation times)
+ * psend - puts a frame on the bus
+ */
+void MIL_CAN_TPInit(MIL_CAN_TP_t *ptp, uint32_t tick_hz, mil_can_tp_send_t psend);
+
+/*
+ * Desc: adds a peer
+ *
+ * Parameters:
+ * rx_id - CAN ID the peer sends with
+ * tx_id - CAN ID we send to the peer with
+ * prx - called with every whole message from the peer(can be 0)
+ * pdone - called when a send finishes(can be 0)
+ * pctx - handed back to prx/pdone
+ *
+ * Returns: the session number, -1 if there is no room
+ */
+int8_t MIL_CAN_TPOpen(MIL_CAN_TP_t *ptp, uint32_t rx_id, uint32_t tx_id,
+                      mil_can_tp_rx_t prx, mil_can_tp_done_t pdone, void *pctx);
+
+/*
+ * Desc: starts sending a message to a peer
+ *
+ * Notes: data is NOT copied, leave it alone until pdone runs.
+ *        Up to 7 bytes go out right away as a single frame
+ *        and pdone runs before this returns
+ *
+ * Parameters:
+ * session - from MIL_CAN_TPOpen
+ * data/len - message(1 to MIL_CAN_TP_MAX_LEN bytes)
+ * now - current tick
+ *
+ * Returns: false if the session is still sending or len is out of range
+ */
+bool MIL_CAN_TPSend(MIL_CAN_TP_t *ptp, uint8_t session, uint8_t *data, uint16_t len, uint32_t now);
+
+/*
+ * Desc: hands the transport a received frame
+ *
+ * Parameters:
+ * canid - ID the frame arrived with
+ * data/len - the frame
+ * now - current tick
+ *
+ * Returns: false if the frame is not for any session
+ */
+bool MIL_CAN_TPInput(MIL_CAN_TP_t *ptp, uint32_t canid, uint8_t *data, uint8_t len, uint32_t now);
+
+/*
+ * Desc: sends consecutive frames that are due and gives up on
+ *       peers that stopped answering, call this from your main loop
+ *
+ * Parameters:
+ * now - current tick
+ */
+void MIL_CAN_TPService(MIL_CAN_TP_t *ptp, uint32_t now);
+
+/*
+ * Desc: tells the transport a frame psend took has left
+ *
+ * Notes: Safe to call from an ISR, this only adds to one counter
+ *
+ * Parameters:
+ * canid - ID the frame was sent with(the session's tx_id)
+ */
+void MIL_CAN_TPSent(MIL_CAN_TP_t *ptp, uint32_t canid);
+
+/*
+ * Desc: true while a session is still sending
+ */
+bool MIL_CAN_TPBusy(MIL_CAN_TP_t *ptp, uint8_t session);
+
+/*
+ * Desc: copies out a session's counters
+ *
+ * Returns: false if there is no such session
+ */
+bool MIL_CAN_TPStatsGet(MIL_CAN_TP_t *ptp, uint8_t session, MIL_CAN_TPStats_t *pstats);
+
+#endif /* MIL_CAN_TP_H_ */
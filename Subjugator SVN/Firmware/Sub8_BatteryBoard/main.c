@@ -49,7 +49,8 @@ uint8_t msgData[BMB_CAN_MSG_LEN] = {0}; //CAN Buffer
 uint8_t cellMsg[CELL_MSG_LEN] = "x37"; //byte 0 is batt and cell num (top nibble battery, bottom nibble cell)
                                        //and  byte 1-2 is 16 bit voltage
 
-uint32_t tempData[12]; //temp data from ADC
+uint16_t tempData[12]; //latest ADC scan, indexed by channel
+MIL_ADC_Scan_t adcScan; //all 12 channels on one trigger
 uint16_t bufferIndex = 0;
 
 uint16_t Bat0Cell0[BUFF_SIZE]; //Battery 0 Cell 0 Buffer
@@ -69,7 +70,6 @@ uint16_t Bat1Cell5[BUFF_SIZE]; //Battery 1 Cell 5 Buffer
 uint32_t Bat1Cell[6] = {0}; //battery1 cell voltages
 
 uint16_t test = 0x00;
-uint32_t testData[3] = {0, 0, 0};
 double testVoltage[3] = {0.0, 0.0, 0.0};
 
 //------------------ End Variables ------------------
@@ -82,10 +82,12 @@ void initTimer0(void (*pISR)(void), float period_ms){
     while(!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER0));
     TimerConfigure(TIMER0_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_B_PERIODIC);
     TimerPrescaleSet(TIMER0_BASE, TIMER_B, 0xFF);
-    TimerLoadSet(TIMER0_BASE, TIMER_B, period_ms/1000 * SysCtlClockGet()/0xFF);
-    TimerIntEnable(TIMER0_BASE, TIMER_TIMB_TIMEOUT);
-    TimerIntRegister(TIMER0_BASE, TIMER_B, pISR);
-    IntEnable(INT_TIMER0B);
+    TimerLoadSet(TIMER0_BASE, TIMER_B, period_ms/1000 * MIL_ClkGetHz()/0xFF);
+    if(pISR){ //0 when the timer only triggers the ADC
+        TimerIntEnable(TIMER0_BASE, TIMER_TIMB_TIMEOUT);
+        TimerIntRegister(TIMER0_BASE, TIMER_B, pISR);
+        IntEnable(INT_TIMER0B);
+    }
     TimerEnable(TIMER0_BASE, TIMER_B);
 }
 
@@ -106,8 +108,7 @@ void initGPIO(){
     GPIOPinTypeGPIOInput(GPIO_PORTB_BASE, GPIO_PIN_4 | GPIO_PIN_5);
     GPIOPinTypeGPIOInput(GPIO_PORTD_BASE, GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3);
     GPIOPinTypeGPIOInput(GPIO_PORTE_BASE, GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5);
-    //MIL_ADCPinConfig(0x0FFF); //CH0-11 (B4-5, D0-3, E0-5)
-    MIL_ADCPinConfig(MIL_ADC_CH4_PD3_bm | MIL_ADC_CH5_PD2_bm | MIL_ADC_CH6_PD1_bm);
+    MIL_ADCPinConfig(0x0FFF); //CH0-11 (B4-5, D0-3, E0-5)
 
     //I2C
     //GPIOPinTypeI2CSCL(GPIO_PORTB_BASE, GPIO_PIN_2); //PORTB 2
@@ -184,17 +185,16 @@ void updateMessage(uint8_t batteryNum, uint8_t cellNum){
     }
 }
 
-//Timer0 ISR, used for timing between ADC samples
-void TIMER0_ISR(void){
-    TimerIntClear(TIMER0_BASE, TIMER_TIMB_TIMEOUT);
-
-    MIL_ADCGetData(ADC0_BASE, MIL_ADC_SEQ0, 10, &testData); //get data from ADC
+//ADC0 end of scan ISR, Timer0B starts a scan every period in hardware
+void ADC0_SCAN_ISR(void){
+    //clears the done flag of every sequencer in the scan
+    if(MIL_ADCScanRead(&adcScan, tempData) != MIL_ADC_OK){ //get data from ADC
+        return;
+    }
     for(int i = 0; i < 3; i++){
-        testVoltage[i] = 3.3*(testData[i]/4095.0); //convert to voltage
+        testVoltage[i] = 3.3*(tempData[4 + i]/4095.0); //convert to voltage (CH4-6)
     }
-    /*MIL_ADCGetData(ADC0_BASE, MIL_ADC_SEQ0, 10, tempData); //get data from ADC
-
-    Bat0Cell0[(bufferIndex & BUFF_SIZE)] = tempData[5]; //load from channel into respective cell
+    /*Bat0Cell0[(bufferIndex & BUFF_SIZE)] = tempData[5]; //load from channel into respective cell
     Bat0Cell1[(bufferIndex & BUFF_SIZE)] = tempData[4];
     Bat0Cell2[(bufferIndex & BUFF_SIZE)] = tempData[0];
     Bat0Cell3[(bufferIndex & BUFF_SIZE)] = tempData[1];
@@ -228,14 +228,15 @@ int main(void){
     //fillBuffers(); //fill cell voltage buffers
 
     MIL_CANPortClkEnable(MIL_CAN_PORT_A); //enable PORTA
-    MIL_InitCAN(MIL_CAN_PORT_A, CAN1_BASE); //configure CAN1 on PORTA
+    MIL_InitCANRate(MIL_CAN_PORT_A, CAN1_BASE, 200000); //configure CAN1 on PORTA at 200k
     //MIL_CAN_MailBox_t CAN_MsgBox = {.canid = BMB_CANID, .filt_mask = BMB_FILTID_bm,.base = BMB_CAN_BASE,.msg_len = BMB_CAN_MSG_LEN,.obj_num = 1,.rx_flag_int = 0,.buffer = msgData};
     //MIL_InitMailBox(&CAN_MsgBox); //initialize mailbox
 
-    //MIL_ADCSeqInit(ADC0_BASE, MIL_ADC_SEQ0, 0xFFF, MIL_ADC_TimTrig);
-    MIL_ADCSeqInit(ADC0_BASE, MIL_ADC_SEQ0, MIL_ADC_CH4_PD3_bm | MIL_ADC_CH5_PD2_bm | MIL_ADC_CH6_PD1_bm, MIL_ADC_TimTrig);
+    MIL_ADCScanInit(&adcScan, ADC0_BASE, 0x0FFF, MIL_ADC_TimTrig); //CH0-11 split over SS0 and SS1
+
+    MIL_ADCScanIntEnable(&adcScan, &ADC0_SCAN_ISR); //read each scan as it finishes
 
-    initTimer0(&TIMER0_ISR, 100); //initialize timer0 for 100ms period
+    initTimer0(0, 100); //initialize timer0 for 100ms period, triggers the scan
     TimerControlTrigger(TIMER0_BASE, TIMER_B, true);
 
     IntMasterEnable(); //master interrupt enable
@@ -246,9 +247,9 @@ int main(void){
                 /*GPIOPinWrite(GPIO_PORTB_BASE, GPIO_PIN_6, 0x00);
                 //updateMessage(i, j); //update messages as necessary
                 MIL_CANSimpleTX(BMB_CANID, cellMsg, CELL_MSG_LEN, BMB_CAN_BASE); //send battery message
-                SysCtlDelay(16000000); //delay
+                SysCtlDelay(MIL_ClkGetHz()); //3s delay(3 clocks per loop) at any clock
                 GPIOPinWrite(GPIO_PORTB_BASE, GPIO_PIN_6, 0xFF);*/
-                SysCtlDelay(16000000); //delay
+                SysCtlDelay(MIL_ClkGetHz()); //3s delay(3 clocks per loop) at any clock
             }
         }
     }
@@ -17,10 +17,15 @@
 #include <stdbool.h>
 #include "inc/hw_memmap.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/pin_map.h"
 #include "driverlib/pwm.h"
 #include "driverlib/sysctl.h"
 
+//thrust curve in use, a straight line until MIL_BR_curve_set
+static int32_t Curve[BR_CURVE_LEN];
+static bool CurveLoaded = false;
+
 /*
  * Desc: This function maps a float value 1 to -1
  *       to the corresponding duty cycle needed
@@ -48,7 +53,7 @@ float MIL_BR_linear_duty(float Thrust){
     if(Thrust){
 
         //-1 corresponds to 1100us/2000us duty, 1 corresponds to 1900us/2000us duty cycle
-        return (Thrust * 0.4 + 1.5)/BR_ESC_PERIOD_MS;
+        return (Thrust * 0.4f + 1.5f)/BR_ESC_PERIOD_MS;
 
     }
     /*
@@ -88,3 +93,127 @@ uint32_t MIL_BR_linear_per(float Thrust, uint32_t ui32Base, uint32_t ui32Gen){
     return MIL_BR_linear_duty(Thrust) * PWMGenPeriodGet(ui32Base, ui32Gen);
 
 }
+
+/*
+ * Desc: Reads a generator's period into its cache
+ */
+void MIL_BR_gen_init(mil_br_gen_t *pgen, uint32_t ui32Base, uint32_t ui32Gen){
+
+    pgen->period = PWMGenPeriodGet(ui32Base, ui32Gen);
+    pgen->stop = (pgen->period * BR_STOP_US + BR_ESC_PERIOD_US / 2) / BR_ESC_PERIOD_US;
+    pgen->span = (pgen->period * BR_SPAN_US + BR_ESC_PERIOD_US / 2) / BR_ESC_PERIOD_US;
+
+    if(!CurveLoaded){
+        MIL_BR_curve_set(0);
+    }
+
+}
+
+/*
+ * Desc: Q15 thrust to the period passed into PWMPulseWidthSet
+ *
+ * Notes: The top BR_CURVE_BITS of the offset thrust pick the table
+ *        step, the rest interpolate inside it. Every product fits
+ *        in 32 bits for periods up to 2 * 0xFFFF clocks
+ */
+uint32_t MIL_BR_q15_per(const mil_br_gen_t *pgen, int16_t Thrust){
+
+    uint32_t u = (uint32_t)((int32_t)Thrust + 32768);
+    uint32_t idx = u >> (16 - BR_CURVE_BITS);
+    int32_t frac = u & ((1 << (16 - BR_CURVE_BITS)) - 1);
+    int32_t out = Curve[idx] + (((Curve[idx + 1] - Curve[idx]) * frac) >> (16 - BR_CURVE_BITS));
+
+    //round to the nearest PWM clock
+    return pgen->stop + ((out * (int32_t)pgen->span + 0x4000) >> 15);
+
+}
+
+/*
+ * Desc: float thrust(1 to -1) to Q15, clamped
+ */
+int16_t MIL_BR_float_to_q15(float Thrust){
+
+    if(Thrust >= 1.0f){
+        return 32767;
+    }
+    if(Thrust <= -1.0f){
+        return -32768;
+    }
+
+    return (int16_t)(Thrust * 32768.0f);
+
+}
+
+/*
+ * Desc: Loads a thrust curve
+ */
+void MIL_BR_curve_set(const int32_t *pcurve){
+
+    for(uint16_t i = 0;i < BR_CURVE_LEN;i++){
+        Curve[i] = pcurve ? pcurve[i] : ((int32_t)i << (16 - BR_CURVE_BITS)) - 32768;
+    }
+    CurveLoaded = true;
+
+}
+
+/*
+ * Desc: Empties a stage
+ */
+void MIL_BR_stage_init(mil_br_stage_t *pstage, uint32_t ui32Base){
+
+    pstage->base = ui32Base;
+    pstage->gen_bits = 0;
+    pstage->count = 0;
+
+}
+
+/*
+ * Desc: Stages one pulse width
+ */
+bool MIL_BR_stage(mil_br_stage_t *pstage, uint32_t ui32Out, uint32_t width){
+
+    uint8_t i;
+
+    for(i = 0;i < pstage->count;i++){
+        if(pstage->out[i] == ui32Out){
+            break;
+        }
+    }
+
+    if(i == BR_STAGE_MAX){
+        return false;
+    }
+    if(i == pstage->count){
+        pstage->count++;
+    }
+
+    pstage->out[i] = ui32Out;
+    pstage->width[i] = width;
+    pstage->gen_bits |= BR_OUT_GEN_BIT(ui32Out);
+
+    return true;
+
+}
+
+/*
+ * Desc: Writes every staged width and commits them at the next
+ *       period boundary, then empties the stage
+ */
+void MIL_BR_commit(mil_br_stage_t *pstage){
+
+    bool int_off = IntMasterDisable();
+
+    //generators hold these until the sync update
+    for(uint8_t i = 0;i < pstage->count;i++){
+        PWMPulseWidthSet(pstage->base, pstage->out[i], pstage->width[i]);
+    }
+    PWMSyncUpdate(pstage->base, pstage->gen_bits);
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    pstage->gen_bits = 0;
+    pstage->count = 0;
+
+}
@@ -26,6 +26,8 @@
 #define BR_ESC_PERIOD_MS 2
 //In seconds
 #define BR_ESC_PERIOD_SEC 0.002
+//In microseconds
+#define BR_ESC_PERIOD_US 2000
 
 //useful duty cycles
 /*
@@ -38,6 +40,28 @@
 #define BR_MAX_REV_TRHUST_DUTY 1.1/BR_ESC_PERIOD_MS //max reverse
 #define BR_STOP_THRUST_DUTY 1.5/BR_ESC_PERIOD_MS //full stop
 
+//same pulses in microseconds for the integer(Q15) path
+#define BR_STOP_US 1500        //full stop
+#define BR_SPAN_US 400         //full forward/reverse is stop +- span
+
+//thrust curve table, 2^BR_CURVE_BITS steps plus the end point
+#define BR_CURVE_BITS 8
+#define BR_CURVE_LEN ((1 << BR_CURVE_BITS) + 1)
+
+//most pulse widths one commit can carry(every output of a PWM module)
+#define BR_STAGE_MAX 8
+
+/*
+ * Generator mode for synchronised updates, pass it to PWMGenConfigure
+ * with the count mode. Pulse widths(and periods) written to a
+ * generator in this mode wait until PWMSyncUpdate, then every
+ * generator named takes them at its next counter zero
+ */
+#define BR_GEN_MODE_SYNC (PWM_GEN_MODE_SYNC | PWM_GEN_MODE_GEN_SYNC_GLOBAL)
+
+//PWMSyncUpdate bit of the generator behind a PWM_OUT_x
+#define BR_OUT_GEN_BIT(out) (1 << ((((out) & ~0x3F) >> 6) - 1))
+
 /*Useful macros */
 /*
  * Desc:
@@ -110,6 +134,133 @@ float  MIL_BR_linear_duty(float Thrust);
  */
 uint32_t MIL_BR_linear_per(float Thrust, uint32_t ui32Base, uint32_t ui32Gen);
 
+/*
+ * INTEGER PATH:
+ * MIL_BR_linear_per does its maths in double(software on the M4F)
+ * and reads the generator period back every call. The functions
+ * below read the period once into a mil_br_gen_t and then turn
+ * a Q15 thrust into a pulse width with one table look up, one
+ * multiply and one shift:
+ *
+ * thrust(Q15) -> thrust curve(interpolated table) -> stop + curve * span
+ *
+ * The table starts out as a straight line(same result as the float
+ * functions, to within one PWM clock). Load a measured thrust curve
+ * with MIL_BR_curve_set to make the thrust linear instead of the pulse
+ *
+ * The cycles saved on the M4F have not been measured yet. A
+ * TKB_BENCH build of the kill board(Bench_Thrust in its main.c)
+ * reports them, HOST_TEST/test_br_esc only gives a PC ratio
+ */
+
+/*
+ * Desc: cached timing of one PWM generator(do not touch fields directly)
+ */
+typedef struct{
+
+    uint32_t period;    //PWM clocks in one ESC period
+    uint32_t stop;      //pulse width of BR_STOP_US
+    uint32_t span;      //PWM clocks in BR_SPAN_US
+
+}mil_br_gen_t;
+
+/*
+ * Desc: Reads a generator's period into its cache
+ *
+ * Notes: Call it again if the period or the PWM clock changes
+ *
+ * Input:
+ *      pgen - cache to fill
+ *      ui32Base - PWM base from TivaWare
+ *      ui32Gen - which PWM generator you're using
+ */
+void MIL_BR_gen_init(mil_br_gen_t *pgen, uint32_t ui32Base, uint32_t ui32Gen);
+
+/*
+ * Desc: Q15 thrust to the period passed into PWMPulseWidthSet
+ *
+ * Input:
+ *      pgen - cache of the thruster's generator
+ *      Thrust - -32768(max reverse) to 32767(max forward)
+ * Output: The corresponding period
+ */
+uint32_t MIL_BR_q15_per(const mil_br_gen_t *pgen, int16_t Thrust);
+
+/*
+ * Desc: float thrust(1 to -1) to Q15, clamped
+ */
+int16_t MIL_BR_float_to_q15(float Thrust);
+
+/*
+ * Desc: Loads a thrust curve
+ *
+ * Input:
+ *      pcurve - BR_CURVE_LEN points, point i is the output for thrust
+ *               -32768 + i * 65536 / (BR_CURVE_LEN - 1), in Q15 of the
+ *               span(-32768 full reverse pulse, 32768 full forward)
+ *               0 restores the straight line
+ */
+void MIL_BR_curve_set(const int32_t *pcurve);
+
+/*
+ * STAGED UPDATES:
+ * With every generator in BR_GEN_MODE_SYNC, collect the pulse widths
+ * of one control cycle in a mil_br_stage_t and commit them together,
+ * every output changes at the same period boundary and none changes
+ * part way through a pulse:
+ *
+ *   mil_br_stage_t stage;
+ *   MIL_BR_stage_init(&stage, PWM0_BASE);
+ *   MIL_BR_stage(&stage, PWM_OUT_0, width0);
+ *   MIL_BR_stage(&stage, PWM_OUT_5, width5);
+ *   MIL_BR_commit(&stage);
+ *
+ * Use one stage per caller(a local is fine), the commit is the
+ * only part that touches the hardware
+ */
+
+/*
+ * Desc: pulse widths waiting to be committed(do not touch fields directly)
+ */
+typedef struct{
+
+    uint32_t base;
+    uint32_t gen_bits;
+    uint8_t count;
+    uint32_t out[BR_STAGE_MAX];
+    uint32_t width[BR_STAGE_MAX];
+
+}mil_br_stage_t;
+
+/*
+ * Desc: Empties a stage
+ *
+ * Input:
+ *      pstage - your stage
+ *      ui32Base - PWM base from TivaWare
+ */
+void MIL_BR_stage_init(mil_br_stage_t *pstage, uint32_t ui32Base);
+
+/*
+ * Desc: Stages one pulse width, replaces a width already staged
+ *       for the same output
+ *
+ * Input:
+ *      ui32Out - PWM_OUT_x
+ *      width - period from MIL_BR_q15_per or MIL_BR_linear_per
+ * Output: false if the stage is full
+ */
+bool MIL_BR_stage(mil_br_stage_t *pstage, uint32_t ui32Out, uint32_t width);
+
+/*
+ * Desc: Writes every staged width and commits them at the next
+ *       period boundary, then empties the stage
+ *
+ * Notes: Interrupts are held off while the widths are written so a
+ *        commit from an ISR cannot carry half of this one with it
+ */
+void MIL_BR_commit(mil_br_stage_t *pstage);
+
 #endif /* MIL_BR_ESC_H_ */
 
 
@@ -0,0 +1,473 @@
+/*
+ * Name: MIL_CAN_TP.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Segmented transport for messages longer than one CAN frame
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_CAN_TP.h"
+
+//PCI byte, high nibble
+#define TP_SINGLE      0x0
+#define TP_FIRST       0x1
+#define TP_CONSECUTIVE 0x2
+#define TP_FLOW        0x3
+
+//flow control status, low nibble
+#define TP_FC_CTS      0x0 //go ahead
+#define TP_FC_WAIT     0x1 //not yet, wait for another flow control
+#define TP_FC_OVERFLOW 0x2 //message is too long, give up
+
+//session states
+#define TP_RX_IDLE     0
+#define TP_RX_BUSY     1
+#define TP_TX_IDLE     0
+#define TP_TX_WAIT_FC  1
+#define TP_TX_SEND     2
+
+/*
+ * Desc: separation time byte to ticks, rounded up so
+ *       we are never faster than the peer asked for
+ */
+static uint32_t MIL_CAN_TPGap(MIL_CAN_TP_t *ptp, uint8_t stmin){
+
+    uint32_t us;
+
+    if(stmin <= 0x7F){
+        us = (uint32_t)stmin * 1000;
+    }
+    else if((stmin >= 0xF1) && (stmin <= 0xF9)){
+        us = (uint32_t)(stmin - 0xF0) * 100;
+    }
+    else{
+        //reserved values mean the longest time
+        us = 127000;
+    }
+
+    return (uint32_t)((((uint64_t)ptp->tick_hz * us) + 999999) / 1000000);
+
+}
+
+/*
+ * Desc: hands one frame to psend and counts it until MIL_CAN_TPSent
+ */
+static bool MIL_CAN_TPPut(MIL_CAN_TP_t *ptp, MIL_CAN_TPSession_t *ps, uint8_t *frame, uint8_t len){
+
+    if(!ptp->psend(ps->tx_id, frame, len)){
+        return false;
+    }
+
+    ps->tx_queued++;
+
+    return true;
+
+}
+
+/*
+ * Desc: true while a frame psend took has not left yet
+ */
+static bool MIL_CAN_TPOnBus(MIL_CAN_TPSession_t *ps){
+
+    return ps->tx_queued != ps->tx_sent;
+
+}
+
+/*
+ * Desc: sends a flow control frame to the peer
+ */
+static bool MIL_CAN_TPFlow(MIL_CAN_TP_t *ptp, MIL_CAN_TPSession_t *ps, uint8_t status){
+
+    uint8_t fc[3];
+
+    fc[0] = (TP_FLOW << 4) | status;
+    fc[1] = MIL_CAN_TP_BLOCK_SIZE;
+    fc[2] = MIL_CAN_TP_STMIN;
+
+    return MIL_CAN_TPPut(ptp, ps, fc, 3);
+
+}
+
+/*
+ * Desc: ends a send and tells the owner
+ */
+static void MIL_CAN_TPFinish(MIL_CAN_TP_t *ptp, uint8_t session, bool ok){
+
+    MIL_CAN_TPSession_t *ps = &ptp->session[session];
+
+    ps->tx_state = TP_TX_IDLE;
+
+    if(ok){
+        ps->stats.tx_msgs++;
+    }
+    else{
+        ps->stats.tx_errors++;
+    }
+
+    if(ps->pdone){
+        ps->pdone(session, ok, ps->pctx);
+    }
+
+}
+
+/*
+ * Desc: a whole message arrived
+ */
+static void MIL_CAN_TPDeliver(MIL_CAN_TPSession_t *ps, uint8_t session, uint8_t *data, uint16_t len){
+
+    ps->rx_state = TP_RX_IDLE;
+    ps->stats.rx_msgs++;
+
+    if(ps->prx){
+        ps->prx(session, data, len, ps->pctx);
+    }
+
+}
+
+/*
+ * Desc: gives up on the message being received
+ */
+static void MIL_CAN_TPRxAbort(MIL_CAN_TPSession_t *ps){
+
+    ps->rx_state = TP_RX_IDLE;
+    ps->rx_fc_pending = false;
+    ps->stats.rx_errors++;
+
+}
+
+/*
+ * Desc: sets up a transport with no sessions
+ */
+void MIL_CAN_TPInit(MIL_CAN_TP_t *ptp, uint32_t tick_hz, mil_can_tp_send_t psend){
+
+    ptp->num_sessions = 0;
+    ptp->tick_hz = tick_hz;
+    ptp->timeout = (uint32_t)(((uint64_t)tick_hz * MIL_CAN_TP_TIMEOUT_MS) / 1000);
+    ptp->psend = psend;
+
+}
+
+/*
+ * Desc: adds a peer
+ */
+int8_t MIL_CAN_TPOpen(MIL_CAN_TP_t *ptp, uint32_t rx_id, uint32_t tx_id,
+                      mil_can_tp_rx_t prx, mil_can_tp_done_t pdone, void *pctx){
+
+    MIL_CAN_TPSession_t *ps;
+
+    if(ptp->num_sessions >= MIL_CAN_TP_SESSIONS){
+        return -1;
+    }
+
+    ps = &ptp->session[ptp->num_sessions];
+
+    ps->rx_id = rx_id;
+    ps->tx_id = tx_id;
+    ps->prx = prx;
+    ps->pdone = pdone;
+    ps->pctx = pctx;
+
+    ps->rx_state = TP_RX_IDLE;
+    ps->rx_fc_pending = false;
+    ps->tx_state = TP_TX_IDLE;
+    ps->tx_queued = 0;
+    ps->tx_sent = 0;
+
+    ps->stats.rx_msgs = 0;
+    ps->stats.tx_msgs = 0;
+    ps->stats.rx_errors = 0;
+    ps->stats.tx_errors = 0;
+
+    return (int8_t)ptp->num_sessions++;
+
+}
+
+/*
+ * Desc: starts sending a message to a peer
+ */
+bool MIL_CAN_TPSend(MIL_CAN_TP_t *ptp, uint8_t session, uint8_t *data, uint16_t len, uint32_t now){
+
+    MIL_CAN_TPSession_t *ps;
+    uint8_t frame[8];
+
+    if((session >= ptp->num_sessions) || (len == 0) || (len > MIL_CAN_TP_MAX_LEN)){
+        return false;
+    }
+
+    ps = &ptp->session[session];
+
+    if(ps->tx_state != TP_TX_IDLE){
+        return false;
+    }
+
+    //fits one frame, no flow control needed
+    if(len <= 7){
+        frame[0] = (TP_SINGLE << 4) | len;
+        for(uint8_t i = 0;i < len;i++){
+            frame[1 + i] = data[i];
+        }
+
+        if(!MIL_CAN_TPPut(ptp, ps, frame, len + 1)){
+            return false;
+        }
+
+        MIL_CAN_TPFinish(ptp, session, true);
+        return true;
+    }
+
+    frame[0] = (TP_FIRST << 4) | (len >> 8);
+    frame[1] = len & 0xFF;
+    for(uint8_t i = 0;i < 6;i++){
+        frame[2 + i] = data[i];
+    }
+
+    if(!MIL_CAN_TPPut(ptp, ps, frame, 8)){
+        return false;
+    }
+
+    ps->tx_data = data;
+    ps->tx_len = len;
+    ps->tx_pos = 6;
+    ps->tx_sn = 1;
+    ps->tx_waits = 0;
+    ps->tx_state = TP_TX_WAIT_FC;
+    ps->tx_last = now;
+
+    return true;
+
+}
+
+/*
+ * Desc: hands the transport a received frame
+ */
+bool MIL_CAN_TPInput(MIL_CAN_TP_t *ptp, uint32_t canid, uint8_t *data, uint8_t len, uint32_t now){
+
+    MIL_CAN_TPSession_t *ps = 0;
+    uint8_t session;
+    uint16_t n;
+
+    for(session = 0;session < ptp->num_sessions;session++){
+        if(ptp->session[session].rx_id == canid){
+            ps = &ptp->session[session];
+            break;
+        }
+    }
+
+    if(!ps || !len || ((data[0] >> 4) > TP_FLOW)){
+        return false;
+    }
+
+    switch(data[0] >> 4){
+
+        case TP_SINGLE:
+            n = data[0] & 0x0F;
+            if(ps->rx_state != TP_RX_IDLE){
+                //a new message replaces one that was cut off
+                MIL_CAN_TPRxAbort(ps);
+            }
+            if((n == 0) || (n > (len - 1))){
+                ps->stats.rx_errors++;
+                break;
+            }
+            MIL_CAN_TPDeliver(ps, session, &data[1], n);
+            break;
+
+        case TP_FIRST:
+            n = ((uint16_t)(data[0] & 0x0F) << 8) | ((len > 1) ? data[1] : 0);
+            if(ps->rx_state != TP_RX_IDLE){
+                MIL_CAN_TPRxAbort(ps);
+            }
+            if((len < 8) || (n < 8)){
+                ps->stats.rx_errors++;
+                break;
+            }
+            if(n > MIL_CAN_TP_BUF_SIZE){
+                ps->stats.rx_errors++;
+                MIL_CAN_TPFlow(ptp, ps, TP_FC_OVERFLOW);
+                break;
+            }
+
+            for(uint8_t i = 0;i < 6;i++){
+                ps->rx_buf[i] = data[2 + i];
+            }
+            ps->rx_len = n;
+            ps->rx_pos = 6;
+            ps->rx_sn = 1;
+            ps->rx_bs_left = MIL_CAN_TP_BLOCK_SIZE;
+            ps->rx_last = now;
+            ps->rx_state = TP_RX_BUSY;
+
+            //if the bus has no room MIL_CAN_TPService tries again
+            ps->rx_fc_pending = !MIL_CAN_TPFlow(ptp, ps, TP_FC_CTS);
+            break;
+
+        case TP_CONSECUTIVE:
+            if(ps->rx_state != TP_RX_BUSY){
+                break;
+            }
+
+            n = ps->rx_len - ps->rx_pos;
+            if(n > 7){
+                n = 7;
+            }
+
+            if(((data[0] & 0x0F) != ps->rx_sn) || ((len - 1) < n)){
+                MIL_CAN_TPRxAbort(ps);
+                break;
+            }
+
+            for(uint8_t i = 0;i < n;i++){
+                ps->rx_buf[ps->rx_pos + i] = data[1 + i];
+            }
+            ps->rx_pos += n;
+            ps->rx_sn = (ps->rx_sn + 1) & 0x0F;
+            ps->rx_last = now;
+
+            if(ps->rx_pos >= ps->rx_len){
+                MIL_CAN_TPDeliver(ps, session, ps->rx_buf, ps->rx_len);
+            }
+            else if(MIL_CAN_TP_BLOCK_SIZE && (--ps->rx_bs_left == 0)){
+                ps->rx_bs_left = MIL_CAN_TP_BLOCK_SIZE;
+                ps->rx_fc_pending = !MIL_CAN_TPFlow(ptp, ps, TP_FC_CTS);
+            }
+            break;
+
+        case TP_FLOW:
+            if((ps->tx_state != TP_TX_WAIT_FC) || (len < 3)){
+                break;
+            }
+
+            switch(data[0] & 0x0F){
+                case TP_FC_CTS:
+                    ps->tx_bs = data[1];
+                    ps->tx_bs_left = data[1];
+                    ps->tx_waits = 0;
+                    ps->tx_gap = MIL_CAN_TPGap(ptp, data[2]);
+                    //the first consecutive frame goes out on the next service
+                    ps->tx_last = now - ps->tx_gap;
+                    ps->tx_state = TP_TX_SEND;
+                    break;
+                case TP_FC_WAIT:
+                    //a peer that only ever says wait would hold the session forever
+                    if(++ps->tx_waits > MIL_CAN_TP_WFT_MAX){
+                        MIL_CAN_TPFinish(ptp, session, false);
+                        break;
+                    }
+                    ps->tx_last = now;
+                    break;
+                default:
+                    MIL_CAN_TPFinish(ptp, session, false);
+                    break;
+            }
+            break;
+    }
+
+    return true;
+
+}
+
+/*
+ * Desc: sends the consecutive frame that is due and gives up on
+ *       peers that stopped answering
+ */
+void MIL_CAN_TPService(MIL_CAN_TP_t *ptp, uint32_t now){
+
+    MIL_CAN_TPSession_t *ps;
+    uint8_t frame[8];
+    uint16_t n;
+
+    for(uint8_t session = 0;session < ptp->num_sessions;session++){
+
+        ps = &ptp->session[session];
+
+        if(ps->rx_fc_pending){
+            ps->rx_fc_pending = !MIL_CAN_TPFlow(ptp, ps, TP_FC_CTS);
+        }
+
+        if(ptp->timeout && (ps->rx_state == TP_RX_BUSY) && ((now - ps->rx_last) > ptp->timeout)){
+            MIL_CAN_TPRxAbort(ps);
+        }
+
+        if(ptp->timeout && (ps->tx_state == TP_TX_WAIT_FC) && ((now - ps->tx_last) > ptp->timeout)){
+            MIL_CAN_TPFinish(ptp, session, false);
+        }
+
+        //a consecutive frame that never leaves(bus off) or that psend keeps refusing ends the send
+        if(ptp->timeout && (ps->tx_state == TP_TX_SEND) && ((now - ps->tx_last) > ptp->timeout)){
+            MIL_CAN_TPFinish(ptp, session, false);
+        }
+
+        //one consecutive frame at a time, the next waits until this one has left
+        if((ps->tx_state != TP_TX_SEND) || MIL_CAN_TPOnBus(ps) || ((now - ps->tx_last) < ps->tx_gap)){
+            continue;
+        }
+
+        n = ps->tx_len - ps->tx_pos;
+        if(n > 7){
+            n = 7;
+        }
+
+        frame[0] = (TP_CONSECUTIVE << 4) | ps->tx_sn;
+        for(uint8_t i = 0;i < n;i++){
+            frame[1 + i] = ps->tx_data[ps->tx_pos + i];
+        }
+
+        if(!MIL_CAN_TPPut(ptp, ps, frame, n + 1)){
+            continue;
+        }
+
+        ps->tx_pos += n;
+        ps->tx_sn = (ps->tx_sn + 1) & 0x0F;
+        ps->tx_last = now;
+
+        if(ps->tx_pos >= ps->tx_len){
+            MIL_CAN_TPFinish(ptp, session, true);
+        }
+        else if(ps->tx_bs && (--ps->tx_bs_left == 0)){
+            ps->tx_state = TP_TX_WAIT_FC;
+        }
+    }
+
+}
+
+/*
+ * Desc: tells the transport a frame psend took has left
+ */
+void MIL_CAN_TPSent(MIL_CAN_TP_t *ptp, uint32_t canid){
+
+    for(uint8_t session = 0;session < ptp->num_sessions;session++){
+        if(ptp->session[session].tx_id == canid){
+            ptp->session[session].tx_sent++;
+            return;
+        }
+    }
+
+}
+
+/*
+ * Desc: true while a session is still sending
+ */
+bool MIL_CAN_TPBusy(MIL_CAN_TP_t *ptp, uint8_t session){
+
+    return (session < ptp->num_sessions) && (ptp->session[session].tx_state != TP_TX_IDLE);
+
+}
+
+/*
+ * Desc: copies out a session's counters
+ */
+bool MIL_CAN_TPStatsGet(MIL_CAN_TP_t *ptp, uint8_t session, MIL_CAN_TPStats_t *pstats){
+
+    if(session >= ptp->num_sessions){
+        return false;
+    }
+
+    *pstats = ptp->session[session].stats;
+
+    return true;
+
+}
@@ -0,0 +1,95 @@
+/*
+ * Name: MIL_CAN_Timing.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Works out CAN bit timing registers for any
+ *       system clock and bit rate
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "MIL_CAN_Timing.h"
+
+//TIVA CANBIT register limits(see tCANBitClkParms)
+#define TQ_MIN 4
+#define TQ_MAX 24
+#define SPP1_MIN 2
+#define SPP1_MAX 16
+#define PHASE2_MIN 1
+#define PHASE2_MAX 8
+#define SJW_MAX 4
+#define PRESCALER_MAX 1024
+
+/*
+ * Desc: finds the best bit timing for a bit rate
+ */
+bool MIL_CAN_SolveBitTiming(uint32_t clk_hz, uint32_t rate, uint16_t sample_point,
+                            MIL_CAN_BitTiming_t *ptiming){
+
+    bool found = false;
+    uint32_t best_err = 0;
+    uint32_t best_sp_err = 0;
+
+    if((rate == 0) || (clk_hz == 0)){
+        return false;
+    }
+
+    //most TQ first so a tie on both errors keeps the longer bit
+    for(uint8_t tq = TQ_MAX;tq >= TQ_MIN;tq--){
+
+        uint32_t clks_per_bit = rate * tq;
+        uint32_t prescaler = (clk_hz + (clks_per_bit / 2)) / clks_per_bit;
+
+        if((prescaler < 1) || (prescaler > PRESCALER_MAX)){
+            continue;
+        }
+
+        uint32_t actual = clk_hz / (prescaler * tq);
+        uint32_t diff = (actual > rate) ? (actual - rate) : (rate - actual);
+        uint32_t err = (uint32_t)(((uint64_t)diff * 1000000) / rate);
+
+        if(err > MIL_CAN_RATE_TOL_PPM){
+            continue;
+        }
+
+        //phase2 has to fit 1 to 8 TQ, sync+prop+phase1 2 to 16 TQ
+        uint8_t spp1_lo = (tq - PHASE2_MAX > SPP1_MIN) ? (tq - PHASE2_MAX) : SPP1_MIN;
+        uint8_t spp1_hi = (tq - PHASE2_MIN < SPP1_MAX) ? (tq - PHASE2_MIN) : SPP1_MAX;
+
+        if(spp1_lo > spp1_hi){
+            continue;
+        }
+
+        uint32_t spp1 = (((uint32_t)tq * sample_point) + 500) / 1000;
+        if(spp1 < spp1_lo){
+            spp1 = spp1_lo;
+        }
+        if(spp1 > spp1_hi){
+            spp1 = spp1_hi;
+        }
+
+        uint16_t sp = (uint16_t)(((spp1 * 1000) + (tq / 2)) / tq);
+        uint32_t sp_err = (sp > sample_point) ? (sp - sample_point) : (sample_point - sp);
+
+        if(found && ((err > best_err) || ((err == best_err) && (sp_err >= best_sp_err)))){
+            continue;
+        }
+
+        found = true;
+        best_err = err;
+        best_sp_err = sp_err;
+
+        ptiming->sync_prop_phase1 = (uint8_t)spp1;
+        ptiming->phase2 = tq - (uint8_t)spp1;
+        ptiming->sjw = (ptiming->phase2 < SJW_MAX) ? ptiming->phase2 : SJW_MAX;
+        ptiming->prescaler = (uint16_t)prescaler;
+        ptiming->actual_rate = actual;
+        ptiming->sample_point = sp;
+    }
+
+    return found;
+
+}
@@ -0,0 +1,178 @@
+/*
+ * Name: MIL_CAN_TxQ.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Bookkeeping for the MIL_CAN transmit queue
+ *
+ * What to understand: The TIVA has 32 message objects. The TX queue
+ *                     reserves a bank of consecutive objects for
+ *                     transmitting so several frames can be waiting
+ *                     in hardware at once instead of every frame
+ *                     fighting over one object.
+ *
+ *                     When every object in the bank is still waiting
+ *                     to go out, frames are parked in a small software
+ *                     overflow ring. Each time hardware finishes a frame
+ *                     the freed object is refilled from that ring.
+ *
+ * ORDER NOTE: The TIVA sends pending objects lowest object number
+ *             first, not in the order they were loaded, so two frames
+ *             with the same ID in the bank could leave swapped. The
+ *             bank therefore holds at most one frame per CAN ID, the
+ *             next frame with that ID waits in the overflow ring until
+ *             the one in hardware has gone out. Frames with the same
+ *             ID always leave in the order they were queued.
+ *
+ * PRIORITY NOTE: Priority follows CAN arbitration, a lower CAN ID is
+ *                more important. When an object frees up the overflow
+ *                ring hands it the lowest ID frame allowed into
+ *                hardware(oldest first between equal IDs). Frames
+ *                already in the bank go out lowest object number
+ *                first whatever their ID, loaded objects are never
+ *                rewritten to reorder them.
+ *
+ * Note: This file only depends on stdint/stdbool so it can
+ *       be built on a PC as well as the TIVA. It does no locking,
+ *       MIL_CAN.c calls it with interrupts disabled.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef MIL_CAN_TXQ_H_
+#define MIL_CAN_TXQ_H_
+
+//largest hardware bank a queue can manage(1 to 32)
+#ifndef MIL_CAN_TXQ_MAX_BANK
+#define MIL_CAN_TXQ_MAX_BANK 8
+#endif
+
+//frames the software overflow ring can hold
+#ifndef MIL_CAN_TXQ_OVF_SIZE
+#define MIL_CAN_TXQ_OVF_SIZE 16
+#endif
+
+/*
+ * Desc: one frame waiting to be sent
+ *
+ * PARAMETERS:
+ * canid - ID to transmit with
+ * len - bytes in data(0 to 8)
+ * data - payload(copied, your buffer can be reused right away)
+ * pdone - called once the frame has left the controller(can be 0)
+ *         THIS RUNS IN THE CAN ISR, KEEP IT SHORT
+ * pctx - handed back to pdone untouched
+ * queued_at - time source tick the frame was queued(for latency)
+ */
+typedef struct{
+
+  uint32_t canid;
+  uint8_t  len;
+  uint8_t  data[8];
+  void (*pdone)(uint32_t canid, void *pctx);
+  void    *pctx;
+  uint32_t queued_at;
+
+}MIL_CAN_TxFrame_t;
+
+/*
+ * Desc: queue statistics, all counters only go up
+ *
+ * sent - frames the controller finished
+ * parked - frames that had to wait in the overflow ring
+ * dropped - frames thrown away because everything was full
+ * hw_high_water - most bank objects ever busy at once
+ * ovf_high_water - most frames ever waiting in the overflow ring
+ */
+typedef struct{
+
+  uint32_t sent;
+  uint32_t parked;
+  uint32_t dropped;
+  uint8_t  hw_high_water;
+  uint8_t  ovf_high_water;
+
+}MIL_CAN_TxStats_t;
+
+/*
+ * Desc: the queue itself(do not touch fields directly)
+ */
+typedef struct{
+
+  uint8_t  first_obj;       //first message object of the bank(1 to 32)
+  uint8_t  num_obj;         //objects in the bank
+  uint32_t busy;            //bit n set while bank object n holds a frame
+  MIL_CAN_TxFrame_t inflight[MIL_CAN_TXQ_MAX_BANK];
+
+  uint8_t  ovf_head;        //oldest parked frame
+  uint8_t  ovf_count;       //frames parked
+  MIL_CAN_TxFrame_t ovf[MIL_CAN_TXQ_OVF_SIZE];
+
+  MIL_CAN_TxStats_t stats;
+
+}MIL_CAN_TxQ_t;
+
+/*
+ *Desc: result of handing a frame to the queue
+ */
+typedef enum{
+    MIL_CAN_TXQ_LOAD,   //frame took a free object, load it into hardware now
+    MIL_CAN_TXQ_PARKED, //frame is waiting in the overflow ring
+    MIL_CAN_TXQ_FULL    //frame was dropped
+}mil_can_txq_res_t;
+
+/*
+ * Desc: sets up an empty queue
+ *
+ * Parameters:
+ * pq - your queue
+ * first_obj - first message object of the bank(1 to 32)
+ * num_obj - objects in the bank(clamped to MIL_CAN_TXQ_MAX_BANK
+ *           and to the end of the 32 objects)
+ */
+void MIL_CAN_TxQInit(MIL_CAN_TxQ_t *pq, uint8_t first_obj, uint8_t num_obj);
+
+/*
+ * Desc: hands a frame to the queue
+ *
+ * Parameters:
+ * pq - your queue
+ * pframe - frame to send(copied)
+ * pobj - set to the message object to load when
+ *        MIL_CAN_TXQ_LOAD is returned
+ *
+ * Returns: see mil_can_txq_res_t
+ */
+mil_can_txq_res_t MIL_CAN_TxQSubmit(MIL_CAN_TxQ_t *pq,
+                                    const MIL_CAN_TxFrame_t *pframe,
+                                    uint8_t *pobj);
+
+/*
+ * Desc: returns the frame currently held by a bank object
+ *       or 0 if that object is not busy/not in the bank
+ */
+MIL_CAN_TxFrame_t *MIL_CAN_TxQInflight(MIL_CAN_TxQ_t *pq, uint8_t obj);
+
+/*
+ * Desc: marks a bank object as sent and refills it from
+ *       the overflow ring(with a frame whose ID is not still
+ *       in hardware)
+ *
+ * Parameters:
+ * pq - your queue
+ * obj - message object the controller finished
+ * pdone - the finished frame is copied here(so the caller
+ *         can run its callback)
+ *
+ * Returns: true if obj was refilled and must be loaded
+ *          into hardware again(see MIL_CAN_TxQInflight)
+ */
+bool MIL_CAN_TxQComplete(MIL_CAN_TxQ_t *pq, uint8_t obj, MIL_CAN_TxFrame_t *pdone);
+
+/*
+ * Desc: busy objects as a NEWDAT/TXRQST style mask,
+ *       bit (obj_num - 1) is set for each busy object
+ */
+uint32_t MIL_CAN_TxQBusyMask(MIL_CAN_TxQ_t *pq);
+
+#endif /* MIL_CAN_TXQ_H_ */
@@ -0,0 +1,335 @@
+/*
+ * Name: MIL_TIME.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Microsecond timebase, cycle counter and timed events
+ *
+ * Note: Both halves of the wide timer count down with a prescale of
+ *       one microsecond, timer A from 0xFFFFFFFF so the time passed
+ *       is 0xFFFFFFFF - value
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+
+#include"MIL_CLK.h"
+#include"MIL_TIME.h"
+
+static bool Init = false;
+static uint32_t CycPerUs = 0;
+static volatile uint32_t Epoch = 0;     //times timer A wrapped
+static MIL_TimeEvent_t *pHead = 0;      //running events, soonest first
+
+static void MIL_TimeWrapISR(void);
+static void MIL_TimeEventISR(void);
+static void MIL_TimeEventInsert(MIL_TimeEvent_t *pev);
+static void MIL_TimeEventUnlink(MIL_TimeEvent_t *pev);
+static void MIL_TimeEventArm(void);
+
+/*
+ * Desc: Starts the microsecond timebase and the cycle counter,
+ *       safe to call more than once
+ */
+void MIL_TimeInit(void){
+
+    if(Init){
+        return;
+    }
+    Init = true;
+
+    MIL_CycInit();
+
+    SysCtlPeripheralEnable(MIL_TIME_PERIPH);
+    while(!SysCtlPeripheralReady(MIL_TIME_PERIPH));
+
+    //A runs forever, B only when an event is due
+    TimerConfigure(MIL_TIME_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_PERIODIC | TIMER_CFG_B_ONE_SHOT);
+    TimerPrescaleSet(MIL_TIME_BASE, TIMER_A, CycPerUs - 1);
+    TimerPrescaleSet(MIL_TIME_BASE, TIMER_B, CycPerUs - 1);
+    TimerLoadSet(MIL_TIME_BASE, TIMER_A, 0xFFFFFFFF);
+
+    TimerIntRegister(MIL_TIME_BASE, TIMER_A, &MIL_TimeWrapISR);
+    TimerIntRegister(MIL_TIME_BASE, TIMER_B, &MIL_TimeEventISR);
+    TimerIntClear(MIL_TIME_BASE, TIMER_TIMA_TIMEOUT | TIMER_TIMB_TIMEOUT);
+    TimerIntEnable(MIL_TIME_BASE, TIMER_TIMA_TIMEOUT | TIMER_TIMB_TIMEOUT);
+    IntEnable(MIL_TIME_INT_A);
+    IntEnable(MIL_TIME_INT_B);
+
+    TimerEnable(MIL_TIME_BASE, TIMER_A);
+
+}
+
+/*
+ * Desc: Microseconds since MIL_TimeInit
+ *
+ * Notes: If A wrapped but its ISR has not run yet(interrupts off,
+ *        or called from a higher priority ISR) the pending flag
+ *        is counted in here
+ */
+uint64_t MIL_TimeNowUs(void){
+
+    bool int_off = IntMasterDisable();
+    uint32_t epoch = Epoch;
+    uint32_t left = TimerValueGet(MIL_TIME_BASE, TIMER_A);
+
+    if((TimerIntStatus(MIL_TIME_BASE, false) & TIMER_TIMA_TIMEOUT) && left > 0x80000000){
+        epoch++;
+    }
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+    return ((uint64_t)epoch << 32) | (0xFFFFFFFF - left);
+
+}
+
+/*
+ * Desc: Low 32 bits of MIL_TimeNowUs(wraps every 71 minutes)
+ */
+uint32_t MIL_TimeNowUs32(void){
+
+    return 0xFFFFFFFF - TimerValueGet(MIL_TIME_BASE, TIMER_A);
+
+}
+
+/*
+ * Desc: Spins for us microseconds
+ */
+void MIL_TimeWaitUs(uint32_t us){
+
+    uint32_t start = MIL_TimeNowUs32();
+
+    //unsigned difference stays right across the wrap
+    while((MIL_TimeNowUs32() - start) < us);
+
+}
+
+/*
+ * Desc: Sets a deadline us microseconds from now
+ */
+void MIL_DeadlineSet(MIL_Deadline_t *pdl, uint32_t us){
+
+    pdl->at = MIL_TimeNowUs() + us;
+
+}
+
+/*
+ * Desc: Moves a deadline us microseconds past where it was
+ */
+void MIL_DeadlineAdvance(MIL_Deadline_t *pdl, uint32_t us){
+
+    pdl->at += us;
+
+}
+
+/*
+ * Desc: true once the deadline has passed
+ */
+bool MIL_DeadlineExpired(const MIL_Deadline_t *pdl){
+
+    return MIL_TimeNowUs() >= pdl->at;
+
+}
+
+/*
+ * Desc: Starts(or restarts) a timed event
+ */
+void MIL_TimeEventStart(MIL_TimeEvent_t *pev, uint32_t delay_us, uint32_t period_us,
+                        mil_time_cb_t pcb, void *pctx){
+
+    bool int_off = IntMasterDisable();
+
+    if(pev->armed){
+        MIL_TimeEventUnlink(pev);
+    }
+
+    pev->at = MIL_TimeNowUs() + delay_us;
+    pev->period = period_us;
+    pev->pcb = pcb;
+    pev->pctx = pctx;
+    MIL_TimeEventInsert(pev);
+    MIL_TimeEventArm();
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+}
+
+/*
+ * Desc: Stops an event, nothing happens if it is not running
+ */
+void MIL_TimeEventStop(MIL_TimeEvent_t *pev){
+
+    bool int_off = IntMasterDisable();
+
+    if(pev->armed){
+        MIL_TimeEventUnlink(pev);
+        MIL_TimeEventArm();
+    }
+
+    if(!int_off){
+        IntMasterEnable();
+    }
+
+}
+
+/*
+ * Desc: true while the event is waiting to be called
+ */
+bool MIL_TimeEventRunning(const MIL_TimeEvent_t *pev){
+
+    return pev->armed;
+
+}
+
+/*
+ * Desc: Turns on the DWT cycle counter
+ */
+void MIL_CycInit(void){
+
+    CycPerUs = (MIL_ClkGetHz() + 500000) / 1000000;
+
+    HWREG(MIL_DEMCR) |= MIL_DEMCR_TRCENA;
+    HWREG(MIL_DWT_CYCCNT) = 0;
+    HWREG(MIL_DWT_CTRL) |= MIL_DWT_CYCCNTENA;
+
+}
+
+/*
+ * Desc: CPU cycles to microseconds at the current clock
+ */
+uint32_t MIL_CycToUs(uint32_t cycles){
+
+    if(!CycPerUs){
+        CycPerUs = (MIL_ClkGetHz() + 500000) / 1000000;
+    }
+
+    return cycles / CycPerUs;
+
+}
+
+/*
+ * Desc: Adds a running event in time order(interrupts must be off)
+ */
+static void MIL_TimeEventInsert(MIL_TimeEvent_t *pev){
+
+    MIL_TimeEvent_t **pp = &pHead;
+
+    //equal times go after the ones already waiting
+    while(*pp && (*pp)->at <= pev->at){
+        pp = &(*pp)->pnext;
+    }
+
+    pev->pnext = *pp;
+    *pp = pev;
+    pev->armed = true;
+
+}
+
+/*
+ * Desc: Takes a running event out of the list(interrupts must be off)
+ */
+static void MIL_TimeEventUnlink(MIL_TimeEvent_t *pev){
+
+    MIL_TimeEvent_t **pp = &pHead;
+
+    while(*pp && *pp != pev){
+        pp = &(*pp)->pnext;
+    }
+
+    if(*pp){
+        *pp = pev->pnext;
+    }
+    pev->pnext = 0;
+    pev->armed = false;
+
+}
+
+/*
+ * Desc: Loads timer B for the soonest event(interrupts must be off)
+ *
+ * Notes: Events further off than B can count wake it up early,
+ *        the ISR finds nothing due and loads it again
+ */
+static void MIL_TimeEventArm(void){
+
+    uint64_t now;
+    uint64_t wait = 1;
+
+    TimerDisable(MIL_TIME_BASE, TIMER_B);
+
+    if(!pHead){
+        return;
+    }
+
+    now = MIL_TimeNowUs();
+    if(pHead->at > now){
+        wait = pHead->at - now;
+        if(wait > 0xFFFFFFFF){
+            wait = 0xFFFFFFFF;
+        }
+    }
+
+    TimerLoadSet(MIL_TIME_BASE, TIMER_B, (uint32_t)wait);
+    TimerEnable(MIL_TIME_BASE, TIMER_B);
+
+}
+
+/*
+ * Desc: Counts the top 32 bits of the timebase
+ */
+static void MIL_TimeWrapISR(void){
+
+    TimerIntClear(MIL_TIME_BASE, TIMER_TIMA_TIMEOUT);
+    Epoch++;
+
+}
+
+/*
+ * Desc: Calls every event that is due, then loads B for the next one
+ */
+static void MIL_TimeEventISR(void){
+
+    MIL_TimeEvent_t *pev;
+    uint64_t now;
+
+    TimerIntClear(MIL_TIME_BASE, TIMER_TIMB_TIMEOUT);
+
+    //the list is shared with higher priority ISRs, only the callback runs with interrupts on
+    IntMasterDisable();
+
+    now = MIL_TimeNowUs();
+    while(pHead && pHead->at <= now){
+        pev = pHead;
+        pHead = pev->pnext;
+        pev->pnext = 0;
+        pev->armed = false;
+
+        //periodic events go back in before the call so it can stop them
+        if(pev->period){
+            pev->at += pev->period;
+            if(pev->at <= now){
+                pev->at = now + pev->period;
+            }
+            MIL_TimeEventInsert(pev);
+        }
+
+        IntMasterEnable();
+        pev->pcb(pev->pctx);
+        IntMasterDisable();
+
+        now = MIL_TimeNowUs();
+    }
+
+    MIL_TimeEventArm();
+
+    IntMasterEnable();
+
+}
@@ -0,0 +1,179 @@
+/*
+ * Name: TKB_Kill.c
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Kill/unkill state machine for the thruster kill board
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+#include"TKB_Kill.h"
+
+static void TKB_KillEnter(tkb_kill_t *pk, tkb_kill_state_t state, uint32_t now_ms);
+static void TKB_KillUpdate(tkb_kill_t *pk, uint32_t now_ms);
+
+/*
+ * Desc: Starts the machine in ESC_POWER(main and thrusters powered)
+ */
+void TKB_KillInit(tkb_kill_t *pk, const tkb_kill_ops_t *pops, uint32_t now_ms){
+
+    pk->pops = pops;
+    pk->sources = 0;
+
+    pk->pops->pmain_power(true);
+    TKB_KillEnter(pk, TKB_KILL_ESC_POWER, now_ms);
+
+}
+
+/*
+ * Desc: Raises or clears a kill source and acts on it right away
+ */
+void TKB_KillSet(tkb_kill_t *pk, uint8_t src, bool kill, uint32_t now_ms){
+
+    uint8_t last_sources = pk->sources;
+    tkb_kill_state_t last_state = pk->state;
+
+    if(kill){
+        pk->sources |= src;
+    }
+    else{
+        pk->sources &= ~src;
+    }
+
+    TKB_KillUpdate(pk, now_ms);
+
+    //a new source on an already killed board is still worth a report
+    if(pk->state == last_state && pk->sources != last_sources && pk->pops->preport){
+        pk->pops->preport(pk->state, pk->sources);
+    }
+
+}
+
+/*
+ * Desc: Moves on from any state whose time is up
+ */
+void TKB_KillStep(tkb_kill_t *pk, uint32_t now_ms){
+
+    TKB_KillUpdate(pk, now_ms);
+
+}
+
+/*
+ * Desc: Current state
+ */
+tkb_kill_state_t TKB_KillState(const tkb_kill_t *pk){
+
+    return pk->state;
+
+}
+
+/*
+ * Desc: Sources holding a kill right now
+ */
+uint8_t TKB_KillSources(const tkb_kill_t *pk){
+
+    return pk->sources;
+
+}
+
+/*
+ * Desc: true if thrust commands may reach the thrusters(state RUN)
+ */
+bool TKB_KillCanThrust(const tkb_kill_t *pk){
+
+    return pk->state == TKB_KILL_RUN;
+
+}
+
+/*
+ * Desc: Sets the outputs of a state and reports it
+ */
+static void TKB_KillEnter(tkb_kill_t *pk, tkb_kill_state_t state, uint32_t now_ms){
+
+    const tkb_kill_ops_t *pops = pk->pops;
+
+    pk->state = state;
+    pk->since_ms = now_ms;
+
+    switch(state){
+        case TKB_KILL_ESC_POWER:
+            pops->pmain_power(true);
+            pops->pthrust_power(true);
+            break;
+        case TKB_KILL_ESC_ARM:
+            pops->pstop_thrust();
+            break;
+        case TKB_KILL_RUN:
+            break;
+        case TKB_KILL_SOFT:
+        case TKB_KILL_HARD_PENDING:
+            pops->pstop_thrust();
+            pops->pthrust_power(false);
+            break;
+        case TKB_KILL_HARD:
+            pops->pthrust_power(false);
+            pops->pmain_power(false);
+            //the command has been carried out
+            pk->sources &= ~TKB_KILL_SRC_HARD_MOBO;
+            break;
+    }
+
+    if(pops->preport){
+        pops->preport(state, pk->sources);
+    }
+
+}
+
+/*
+ * Desc: Takes every transition that is due, more than one if the
+ *       next state's condition already holds
+ */
+static void TKB_KillUpdate(tkb_kill_t *pk, uint32_t now_ms){
+
+    tkb_kill_state_t last;
+
+    do{
+        uint32_t in_state = now_ms - pk->since_ms;
+        bool hard = (pk->sources & TKB_KILL_SRC_HARD_bm) != 0;
+        bool soft = (pk->sources & TKB_KILL_SRC_SOFT_bm) != 0;
+
+        last = pk->state;
+
+        switch(pk->state){
+            case TKB_KILL_ESC_POWER:
+            case TKB_KILL_ESC_ARM:
+            case TKB_KILL_RUN:
+            case TKB_KILL_SOFT:
+                if(hard){
+                    TKB_KillEnter(pk, TKB_KILL_HARD_PENDING, now_ms);
+                }
+                else if(soft){
+                    if(pk->state != TKB_KILL_SOFT){
+                        TKB_KillEnter(pk, TKB_KILL_SOFT, now_ms);
+                    }
+                }
+                else if(pk->state == TKB_KILL_SOFT){
+                    TKB_KillEnter(pk, TKB_KILL_ESC_POWER, now_ms);
+                }
+                else if(pk->state == TKB_KILL_ESC_POWER && in_state >= TKB_KILL_ESC_BOOT_MS){
+                    TKB_KillEnter(pk, TKB_KILL_ESC_ARM, now_ms);
+                }
+                else if(pk->state == TKB_KILL_ESC_ARM && in_state >= TKB_KILL_ESC_ARM_MS){
+                    TKB_KillEnter(pk, TKB_KILL_RUN, now_ms);
+                }
+                break;
+            //once started a hard kill always cuts main
+            case TKB_KILL_HARD_PENDING:
+                if(in_state >= TKB_KILL_HARD_GRACE_MS){
+                    TKB_KillEnter(pk, TKB_KILL_HARD, now_ms);
+                }
+                break;
+            case TKB_KILL_HARD:
+                if(!hard && in_state >= TKB_KILL_HARD_OFF_MS){
+                    TKB_KillEnter(pk, TKB_KILL_ESC_POWER, now_ms);
+                }
+                break;
+        }
+    }while(pk->state != last);
+
+}
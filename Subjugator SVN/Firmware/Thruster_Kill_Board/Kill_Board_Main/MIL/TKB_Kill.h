@@ -0,0 +1,159 @@
+/*
+ * Name: TKB_Kill.h
+ * Author: MIL
+ * Date Created: 10/15/2026
+ * Desc: Kill/unkill state machine for the thruster kill board
+ *
+ * What to understand: The kill sequences used to wait out their 10
+ *                     second steps inside the timer ISR, so while the
+ *                     board was killing or unkilling nothing else ran,
+ *                     no CAN, no heart beats, no hall checks.
+ *
+ *                     Here every sequence is a state and every wait is
+ *                     a time the state has to last. TKB_KillStep is
+ *                     called from a timer tick with the time in ms and
+ *                     moves on when the wait is over, it never waits
+ *                     itself. Anything that can kill the board is a
+ *                     source, the board stays killed while any source
+ *                     holds:
+ *
+ *                     STATE        | OUTPUTS                 | LEAVES WHEN
+ *                     ESC_POWER    | thrusters powered       | ESC boot time is up
+ *                     ESC_ARM      | stop pulses out         | ESC arm time is up
+ *                     RUN          | thrust commands allowed | any source kills
+ *                     SOFT         | thrusters off           | soft sources clear
+ *                     HARD_PENDING | thrusters off, main on  | grace time is up
+ *                     HARD         | thrusters and main off  | off time is up and
+ *                                  |                         | hard sources clear
+ *
+ *                     A hard source beats a soft one from any state.
+ *                     Leaving SOFT or HARD goes through ESC_POWER and
+ *                     ESC_ARM again, the ESCs lost power.
+ *
+ * SOURCE NOTE: Hall sources are levels, set them every tick. The
+ *              motherboard hard kill is a command, it is cleared as
+ *              soon as main power is cut(there is no hard unkill)
+ *
+ * Note: This file only depends on stdint/stdbool, all pin and CAN
+ *       work goes through tkb_kill_ops_t, so the same machine runs on
+ *       a PC against a simulated clock
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifndef TKB_KILL_H_
+#define TKB_KILL_H_
+
+//time main stays powered after a hard kill(lets motherboard shut down)
+#ifndef TKB_KILL_HARD_GRACE_MS
+#define TKB_KILL_HARD_GRACE_MS 10000
+#endif
+
+//least time main and thrusters stay off after a hard kill
+#ifndef TKB_KILL_HARD_OFF_MS
+#define TKB_KILL_HARD_OFF_MS 10000
+#endif
+
+//time the ESCs need after power up before they take pulses
+#ifndef TKB_KILL_ESC_BOOT_MS
+#define TKB_KILL_ESC_BOOT_MS 2000
+#endif
+
+//time the ESCs need stop pulses before they arm
+#ifndef TKB_KILL_ESC_ARM_MS
+#define TKB_KILL_ESC_ARM_MS 2000
+#endif
+
+//kill sources
+#define TKB_KILL_SRC_SOFT_HALL 0x01
+#define TKB_KILL_SRC_SOFT_MOBO 0x02
+#define TKB_KILL_SRC_HARD_HALL 0x04
+#define TKB_KILL_SRC_HARD_MOBO 0x08
+#define TKB_KILL_SRC_SOFT_bm (TKB_KILL_SRC_SOFT_HALL | TKB_KILL_SRC_SOFT_MOBO)
+#define TKB_KILL_SRC_HARD_bm (TKB_KILL_SRC_HARD_HALL | TKB_KILL_SRC_HARD_MOBO)
+
+typedef enum{
+
+  TKB_KILL_ESC_POWER = 0,
+  TKB_KILL_ESC_ARM,
+  TKB_KILL_RUN,
+  TKB_KILL_SOFT,
+  TKB_KILL_HARD_PENDING,
+  TKB_KILL_HARD
+
+}tkb_kill_state_t;
+
+/*
+ * Desc: what the machine does to the outside world
+ *
+ * pmain_power - main(motherboard) power on/off
+ * pthrust_power - thruster power on/off
+ * pstop_thrust - stop pulses on every thruster and PWM outputs on
+ * preport - called after every change of state or sources(0 for none)
+ */
+typedef struct{
+
+  void (*pmain_power)(bool on);
+  void (*pthrust_power)(bool on);
+  void (*pstop_thrust)(void);
+  void (*preport)(tkb_kill_state_t state, uint8_t sources);
+
+}tkb_kill_ops_t;
+
+/*
+ * Desc: one kill state machine(do not touch fields directly)
+ */
+typedef struct{
+
+  const tkb_kill_ops_t *pops;
+  tkb_kill_state_t state;
+  uint8_t sources;
+  uint32_t since_ms;        //time the state was entered
+
+}tkb_kill_t;
+
+/*
+ * Desc: Starts the machine in ESC_POWER(main and thrusters powered)
+ *
+ * Parameters:
+ * pk - your machine
+ * pops - your outputs, must stay in scope
+ * now_ms - current time
+ */
+void TKB_KillInit(tkb_kill_t *pk, const tkb_kill_ops_t *pops, uint32_t now_ms);
+
+/*
+ * Desc: Raises or clears a kill source and acts on it right away
+ *
+ * Parameters:
+ * src - one or more TKB_KILL_SRC_ defines
+ * kill - true raises, false clears
+ * now_ms - current time
+ */
+void TKB_KillSet(tkb_kill_t *pk, uint8_t src, bool kill, uint32_t now_ms);
+
+/*
+ * Desc: Moves on from any state whose time is up, call it from a
+ *       periodic tick
+ *
+ * Notes: now_ms may wrap, waits are worked out as differences
+ */
+void TKB_KillStep(tkb_kill_t *pk, uint32_t now_ms);
+
+/*
+ * Desc: Current state
+ */
+tkb_kill_state_t TKB_KillState(const tkb_kill_t *pk);
+
+/*
+ * Desc: Sources holding a kill right now
+ */
+uint8_t TKB_KillSources(const tkb_kill_t *pk);
+
+/*
+ * Desc: true if thrust commands may reach the thrusters(state RUN)
+ */
+bool TKB_KillCanThrust(const tkb_kill_t *pk);
+
+#endif /* TKB_KILL_H_ */
@@ -60,6 +60,10 @@
 #include "MIL_CAN.h"
 #include "Thruster_Kill_Board.h"
 
+//PWM generator timing read once by TKB_PWM0_Init, PWM_GEN_0 to PWM_GEN_3
+#define TKB_GEN_IDX(gen) (((gen) - PWM_GEN_0) / (PWM_GEN_1 - PWM_GEN_0))
+static mil_br_gen_t GenCache[4];
+
 /*** CAN MESSAGES ***/
 /* TX MESSAGES */
 //C strings are terminated by Null character
@@ -92,6 +96,13 @@ static const char GO_Msg[C_GO_LEN] = "GO";      // 0x47 0x00
  */
 void TKB_PWM0_Init(void){
 
+    //PWM clock dividers, PWMDiv[n] divides the system clock by 2^n
+    static const uint32_t PWMDiv[] = {
+        SYSCTL_PWMDIV_1, SYSCTL_PWMDIV_2, SYSCTL_PWMDIV_4, SYSCTL_PWMDIV_8,
+        SYSCTL_PWMDIV_16, SYSCTL_PWMDIV_32, SYSCTL_PWMDIV_64
+    };
+    uint8_t div = 0;
+
     //PWM clock enable
     SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0);
 
@@ -116,34 +127,55 @@ void TKB_PWM0_Init(void){
      * PWM Mod 0
      * ALL GENERATORS
      * Up down mode
-     * No sync(you can sync generators together)
+     * Global sync, new pulse widths wait for a commit(MIL_BR_commit)
+     * so all eight outputs change at the same period boundary
      */
     PWMGenConfigure(TKB_PWM_BASE,
                     TKB_FH_PWM_GEN,
                     PWM_GEN_MODE_UP_DOWN |
-                    PWM_GEN_MODE_NO_SYNC);
+                    BR_GEN_MODE_SYNC);
     PWMGenConfigure(TKB_PWM_BASE,
                     TKB_FV_PWM_GEN,
                     PWM_GEN_MODE_UP_DOWN |
-                    PWM_GEN_MODE_NO_SYNC);
+                    BR_GEN_MODE_SYNC);
     PWMGenConfigure(TKB_PWM_BASE,
                     TKB_BH_PWM_GEN,
                     PWM_GEN_MODE_UP_DOWN |
-                    PWM_GEN_MODE_NO_SYNC);
+                    BR_GEN_MODE_SYNC);
     PWMGenConfigure(TKB_PWM_BASE,
                     TKB_BV_PWM_GEN,
                     PWM_GEN_MODE_UP_DOWN |
-                    PWM_GEN_MODE_NO_SYNC);
+                    BR_GEN_MODE_SYNC);
 
-    /* (desired period in seconds) * (clock frequency) = PWM Period */
+    /*
+     * Pick the smallest PWM clock divider that still fits the ESC
+     * period in the 16 bit counter(up down mode counts to half the
+     * period), 16MHz needs none but 80MHz does
+     */
+    while(div < (sizeof(PWMDiv) / sizeof(PWMDiv[0])) - 1 &&
+          BR_ESC_PERIOD_SEC * (MIL_ClkGetHz() >> div) > 2 * 0xFFFF){
+        div++;
+    }
+    SysCtlPWMClockSet(PWMDiv[div]);
+
+    /* (desired period in seconds) * (PWM clock frequency) = PWM Period */
     /*
      * This block sets each generator(all of them) to the Blue Robotics
      * designated period which is 2000us
      */
-    PWMGenPeriodSet(TKB_PWM_BASE, TKB_FH_PWM_GEN, BR_ESC_PERIOD_SEC * (SysCtlClockGet()));
-    PWMGenPeriodSet(TKB_PWM_BASE, TKB_FV_PWM_GEN, BR_ESC_PERIOD_SEC * (SysCtlClockGet()));
-    PWMGenPeriodSet(TKB_PWM_BASE, TKB_BH_PWM_GEN, BR_ESC_PERIOD_SEC * (SysCtlClockGet()));
-    PWMGenPeriodSet(TKB_PWM_BASE, TKB_BV_PWM_GEN, BR_ESC_PERIOD_SEC * (SysCtlClockGet()));
+    PWMGenPeriodSet(TKB_PWM_BASE, TKB_FH_PWM_GEN, BR_ESC_PERIOD_SEC * (MIL_ClkGetHz() >> div));
+    PWMGenPeriodSet(TKB_PWM_BASE, TKB_FV_PWM_GEN, BR_ESC_PERIOD_SEC * (MIL_ClkGetHz() >> div));
+    PWMGenPeriodSet(TKB_PWM_BASE, TKB_BH_PWM_GEN, BR_ESC_PERIOD_SEC * (MIL_ClkGetHz() >> div));
+    PWMGenPeriodSet(TKB_PWM_BASE, TKB_BV_PWM_GEN, BR_ESC_PERIOD_SEC * (MIL_ClkGetHz() >> div));
+
+    //periods are double buffered too in sync mode
+    PWMSyncUpdate(TKB_PWM_BASE, TKB_PWM_ALL_GEN_BITS);
+
+    //cache the periods so thrust updates never read them back
+    MIL_BR_gen_init(&GenCache[TKB_GEN_IDX(TKB_FH_PWM_GEN)], TKB_PWM_BASE, TKB_FH_PWM_GEN);
+    MIL_BR_gen_init(&GenCache[TKB_GEN_IDX(TKB_FV_PWM_GEN)], TKB_PWM_BASE, TKB_FV_PWM_GEN);
+    MIL_BR_gen_init(&GenCache[TKB_GEN_IDX(TKB_BH_PWM_GEN)], TKB_PWM_BASE, TKB_BH_PWM_GEN);
+    MIL_BR_gen_init(&GenCache[TKB_GEN_IDX(TKB_BV_PWM_GEN)], TKB_PWM_BASE, TKB_BV_PWM_GEN);
 
     //enable all generators on the pwm moduel
     PWMGenEnable(TKB_PWM_BASE, TKB_FH_PWM_GEN);
@@ -151,93 +183,43 @@ void TKB_PWM0_Init(void){
     PWMGenEnable(TKB_PWM_BASE, TKB_BH_PWM_GEN);
     PWMGenEnable(TKB_PWM_BASE, TKB_BV_PWM_GEN);
 
+    //line the counters up so every generator hits zero together
+    PWMSyncTimeBase(TKB_PWM_BASE, TKB_PWM_ALL_GEN_BITS);
+
 }
 
 
 /*
- * Desc: Initializes communication with ESC by sending
- *       the stop pulse
- *
- *       ALSO SETS PWM OUTPUT TO TRUE
+ * Desc: Main(motherboard) power on or off
  */
-void TKB_Init_ESC(void){
-
-    //power the thrusters
-    POWER_THRUSTERS();
-
-    //delay 5 seconds to wait for thruster to power up
-    for(uint8_t i = 0; i < 2;i++){ SEC_1_DELAY();}
-
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_FHL_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_FH_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_FHR_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_FH_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_FVL_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_FV_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_FVR_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_FV_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_BHL_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_BH_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_BHR_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_BH_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_BVL_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_BV_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_BVR_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_BV_PWM_GEN));
-
-    TKB_PWM_OUT_EN();
-
-    for(uint8_t i = 0; i < 2;i++){ SEC_1_DELAY();}
+void TKB_MainPower(bool on){
+    if(on){
+        POWER_MAIN();
+    }
+    else{
+        KILL_MAIN();
+    }
 }
 
 /*
- * Desc: Executes thruster kill sequence
- *
- *       SEQUENCE:
- *       SEND STOP TO THRUSTERS
- *       KILL POWER TO THRUSTERS
- *       TRANSMIT HARD KILL TO MOBO
- *       KILL POWER TO MAIN
+ * Desc: Thruster power on or off
  */
-void TKB_HardKill(void){
-    for(uint8_t i = 0;i < 10;i++){SEC_1_DELAY();} //wait 10s
-    KILL_MAIN();
-    KILL_THRUSTERS();
-    for(uint8_t i = 0;i < 10;i++){SEC_1_DELAY();} //wait 10s
-    TKB_HardUnKill();
-}
-
-void TKB_HardUnKill(void){
-    POWER_MAIN(); //give mobo power
-    POWER_THRUSTERS(); //give thrusters power
-    TKB_Init_ESC(); //init ESCs
+void TKB_ThrustPower(bool on){
+    if(on){
+        POWER_THRUSTERS();
+    }
+    else{
+        KILL_THRUSTERS();
+    }
 }
 
 /*
- * Desc: Executes thruster kill sequence
- *
- *       SEQUENCE:
- *       SEND STOP TO THRUSTERS //from SoftKill
- *       DISABLE PWM OUTPUT     //from SoftKill
- *       KILL POWER TO THRUSTERS
- *
+ * Desc: Sends the stop pulse to every ESC and turns the
+ *       PWM outputs on
  */
-void TKB_SoftKill(void){
-    KILL_THRUSTERS();
-    TKB_IdleThrusters();
-}
-
-void TKB_SoftUnKill(void){
-    POWER_THRUSTERS();
-    TKB_Init_ESC();
+void TKB_StopAndEnable(void){
+    TKB_StopAllThrust();
+    TKB_PWM_OUT_EN();
 }
 
 /*
@@ -260,30 +242,36 @@ void TKB_IdleThrusters(void){
  */
 void TKB_StopAllThrust(void){
 
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_FHL_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_FH_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_FHR_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_FH_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_FVL_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_FV_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_FVR_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_FV_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_BHL_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_BH_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_BHR_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_BH_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_BVL_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_BV_PWM_GEN));
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     TKB_PWM_BVR_PIN,
-                     PWM_STOP_PER(TKB_PWM_BASE,TKB_BV_PWM_GEN));
+    mil_br_stage_t stage;
+
+    MIL_BR_stage_init(&stage, TKB_PWM_BASE);
+
+    MIL_BR_stage(&stage,
+                 TKB_PWM_FHL_PIN,
+                 GenCache[TKB_GEN_IDX(TKB_FH_PWM_GEN)].stop);
+    MIL_BR_stage(&stage,
+                 TKB_PWM_FHR_PIN,
+                 GenCache[TKB_GEN_IDX(TKB_FH_PWM_GEN)].stop);
+    MIL_BR_stage(&stage,
+                 TKB_PWM_FVL_PIN,
+                 GenCache[TKB_GEN_IDX(TKB_FV_PWM_GEN)].stop);
+    MIL_BR_stage(&stage,
+                 TKB_PWM_FVR_PIN,
+                 GenCache[TKB_GEN_IDX(TKB_FV_PWM_GEN)].stop);
+    MIL_BR_stage(&stage,
+                 TKB_PWM_BHL_PIN,
+                 GenCache[TKB_GEN_IDX(TKB_BH_PWM_GEN)].stop);
+    MIL_BR_stage(&stage,
+                 TKB_PWM_BHR_PIN,
+                 GenCache[TKB_GEN_IDX(TKB_BH_PWM_GEN)].stop);
+    MIL_BR_stage(&stage,
+                 TKB_PWM_BVL_PIN,
+                 GenCache[TKB_GEN_IDX(TKB_BV_PWM_GEN)].stop);
+    MIL_BR_stage(&stage,
+                 TKB_PWM_BVR_PIN,
+                 GenCache[TKB_GEN_IDX(TKB_BV_PWM_GEN)].stop);
+
+    MIL_BR_commit(&stage);
 
 }
 /*
@@ -296,9 +284,42 @@ void TKB_StopAllThrust(void){
  * Assumes: Assumes PWM and ESCs are intialized
  */
 void TKB_PWM_SetSpeed(tkb_thrust_data_t thruster){
-    PWMPulseWidthSet(TKB_PWM_BASE,
-                     thruster.pwm_out,
-                     MIL_BR_linear_per(thruster.speed.speed_float,TKB_PWM_BASE,thruster.pwm_gen));
+
+    mil_br_stage_t stage;
+
+    MIL_BR_stage_init(&stage, TKB_PWM_BASE);
+    MIL_BR_stage(&stage,
+                 thruster.pwm_out,
+                 MIL_BR_q15_per(&GenCache[TKB_GEN_IDX(thruster.pwm_gen)],thruster.speed_q15));
+    MIL_BR_commit(&stage);
+
+}
+
+/*
+ * Desc: cached timing of a PWM generator
+ */
+const mil_br_gen_t *TKB_PWM_Gen(uint32_t pwm_gen){
+    return &GenCache[TKB_GEN_IDX(pwm_gen)];
+}
+
+/*
+ * Desc: sets all NUM_THRUSTERS thrusters to their speed_q15 variables
+ *       in one go
+ */
+void TKB_PWM_SetAll(tkb_thrust_data_t *pthrusters){
+
+    mil_br_stage_t stage;
+
+    //the maths happens here, the commit only writes
+    MIL_BR_stage_init(&stage, TKB_PWM_BASE);
+    for(uint8_t i = 0;i < NUM_THRUSTERS;i++){
+        MIL_BR_stage(&stage,
+                     pthrusters[i].pwm_out,
+                     MIL_BR_q15_per(&GenCache[TKB_GEN_IDX(pthrusters[i].pwm_gen)],pthrusters[i].speed_q15));
+    }
+
+    MIL_BR_commit(&stage);
+
 }
 
 
@@ -310,9 +331,6 @@ void TKB_PWM_SetSpeed(tkb_thrust_data_t thruster){
  */
 void Timer0_OVF_Init(void (*pISR)(void), float period_ms){
 
-    //We will be dividing the system clock by 255
-    uint8_t prescale = 0xFF;
-
     //enable peripheral clock
     /*
      * A feature of ARM processors in general is that in order to use any
@@ -323,21 +341,22 @@ void Timer0_OVF_Init(void (*pISR)(void), float period_ms){
     //wait for peripheral clock to stabilize
     while(!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER0));
 
-    //configure timer for periodic count
-    TimerConfigure(TIMER0_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_B_PERIODIC);
-
-    //Set the prescale to divide system clock
-    TimerPrescaleSet(TIMER0_BASE, TIMER_B, prescale);
+    //configure timer for full width(32 bit) periodic count
+    /*
+     * 32 bits hold over 50 seconds of ticks even at 80MHz, so no
+     * prescale is needed whatever clock the board runs at
+     */
+    TimerConfigure(TIMER0_BASE, TIMER_CFG_PERIODIC);
 
-    //set timer to interrupt every 1 second
+    //set timer to interrupt every period
     /*
      * The equation to determine timer period is
-     * (Time in seconds) * (System Clock)/(Clock prescale)
+     * (Time in seconds) * (System Clock)
      */
-    TimerLoadSet(TIMER0_BASE, TIMER_B, period_ms/1000 * SysCtlClockGet()/prescale);
+    TimerLoadSet(TIMER0_BASE, TIMER_A, (uint32_t)(period_ms * (MIL_ClkGetHz()/1000)) - 1);
 
     //enable interrupt triggered on timeout
-    TimerIntEnable(TIMER0_BASE, TIMER_TIMB_TIMEOUT);
+    TimerIntEnable(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
 
     //set ISR function
     /*
@@ -348,21 +367,18 @@ void Timer0_OVF_Init(void (*pISR)(void), float period_ms){
      * In this case I passed Timer0IntBlink into this function to
      * set it as my interrupt service routine
      */
-    TimerIntRegister(TIMER0_BASE, TIMER_B, pISR);
+    TimerIntRegister(TIMER0_BASE, TIMER_A, pISR);
 
     //enable timer interrupts from CPU perspective
-    IntEnable(INT_TIMER0B);
+    IntEnable(INT_TIMER0A);
 
     //enable timer
-    TimerEnable(TIMER0_BASE, TIMER_B);
+    TimerEnable(TIMER0_BASE, TIMER_A);
 }
 
 
 void Timer1_OVF_Init(void (*pISR)(void), float period_ms){
 
-    //We will be dividing the system clock by 255
-    uint8_t prescale = 0xFF;
-
     //enable peripheral clock
     /*
      * A feature of ARM processors in general is that in order to use any
@@ -373,21 +389,22 @@ void Timer1_OVF_Init(void (*pISR)(void), float period_ms){
     //wait for peripheral clock to stabilize
     while(!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER1));
 
-    //configure timer for periodic count
-    TimerConfigure(TIMER1_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_B_PERIODIC);
-
-    //Set the prescale to divide system clock
-    TimerPrescaleSet(TIMER1_BASE, TIMER_B, prescale);
+    //configure timer for full width(32 bit) periodic count
+    /*
+     * 32 bits hold over 50 seconds of ticks even at 80MHz, so no
+     * prescale is needed whatever clock the board runs at
+     */
+    TimerConfigure(TIMER1_BASE, TIMER_CFG_PERIODIC);
 
-    //set timer to interrupt every 1 second
+    //set timer to interrupt every period
     /*
      * The equation to determine timer period is
-     * (Time in seconds) * (System Clock)/(Clock Prescale)
+     * (Time in seconds) * (System Clock)
      */
-    TimerLoadSet(TIMER1_BASE, TIMER_B, period_ms/1000 * SysCtlClockGet()/prescale);
+    TimerLoadSet(TIMER1_BASE, TIMER_A, (uint32_t)(period_ms * (MIL_ClkGetHz()/1000)) - 1);
 
     //enable interrupt triggered on timeout
-    TimerIntEnable(TIMER1_BASE, TIMER_TIMB_TIMEOUT);
+    TimerIntEnable(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
 
     //set ISR function
     /*
@@ -398,13 +415,13 @@ void Timer1_OVF_Init(void (*pISR)(void), float period_ms){
      * In this case I passed Timer0IntBlink into this function to
      * set it as my interrupt service routine
      */
-    TimerIntRegister(TIMER1_BASE, TIMER_B, pISR);
+    TimerIntRegister(TIMER1_BASE, TIMER_A, pISR);
 
     //enable timer interrupts from CPU perspective
-    IntEnable(INT_TIMER1B);
+    IntEnable(INT_TIMER1A);
 
     //enable timer
-    TimerEnable(TIMER1_BASE, TIMER_B);
+    TimerEnable(TIMER1_BASE, TIMER_A);
 }
 
 
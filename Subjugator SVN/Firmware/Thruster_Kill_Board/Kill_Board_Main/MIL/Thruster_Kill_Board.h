@@ -73,7 +73,7 @@
 #define THRUSTER_KILL_BOARD_H_
 
 //Delay macros
-#define SEC1 16000000
+#define SEC1 MIL_ClkGetHz()
 #define MS_100_DELAY() SysCtlDelay((SEC1/30))
 #define SEC_1_DELAY()  SysCtlDelay((SEC1/3))
 #define SEC_15_DELAY() SysCtlDelay(15*(SEC1/3))
@@ -130,6 +130,12 @@
 #define TKB_MOBO_FILTID_bm 0xFF
 #define TKB_CAN_MOBO_LEN 8 // r/w , address ,float
 #define TKB_CAN_MOBO_OBJ 2
+//objects 2 to 9, one per thruster so a full thrust burst fits
+#define TKB_CAN_MOBO_DEPTH 8
+
+//TX queue, objects 10 to 13 hold outgoing status/kill frames
+#define TKB_CAN_TXQ_OBJ 10
+#define TKB_CAN_TXQ_LEN 4
 
 /***********CAN END********************/
 
@@ -153,6 +159,10 @@
 #define TKB_BH_PWM_GEN PWM_GEN_0
 #define TKB_BV_PWM_GEN PWM_GEN_3
 
+//every generator above, for PWMSyncUpdate and PWMSyncTimeBase
+#define TKB_PWM_ALL_GEN_BITS (PWM_GEN_0_BIT | PWM_GEN_1_BIT | \
+                              PWM_GEN_2_BIT | PWM_GEN_3_BIT)
+
 //from schematic cross referenced with signals by signal name table
 //in TM4C123GH6PM manual
 #define TKB_PWM_FHL_PIN PWM_OUT_3
@@ -197,6 +207,7 @@ typedef struct{
     uint32_t pwm_gen;
     uint32_t pwm_out;
     tkb_speed_data_t speed;
+    int16_t speed_q15;          //speed the PWM is set from(see MIL_BR_q15_per)
 
 }tkb_thrust_data_t;
 
@@ -217,40 +228,16 @@ void TKB_PWM0_Init(void);
 
 
 /*
- * Desc: Initializes communication with ESC by sending
- *       the stop pulse
- *
- *       ALSO SETS PWM OUTPUT TO TRUE
- */
-void TKB_Init_ESC(void);
-
-/*
- * Desc: Executes thruster kill sequence
+ * Desc: Outputs used by the kill state machine(TKB_Kill.h), the
+ *       kill and unkill sequences themselves live there
  *
- *       SEQUENCE:
- *       SEND STOP TO THRUSTERS
- *       KILL POWER TO THRUSTERS
- *       TRANSMIT HARD KILL TO MOBO
- *       KILL POWER TO MAIN
+ * TKB_MainPower - main(motherboard) power on or off
+ * TKB_ThrustPower - thruster power on or off
+ * TKB_StopAndEnable - stop pulse to every ESC, PWM outputs on
  */
-void TKB_HardKill(void);
-
-/*
- * Desc: unkill sequence from hard kill
- *       POWER MAIN
- *       POWER THRUSTERS
- *       INIT ESC
- */
-void TKB_UnKill(void);
-
-/*
- * Desc: Executes thruster kill sequence
- *
- *       SEQUENCE:
- *       SEND STOP TO THRUSTERS
- *       KILL POWER TO THRUSTERS
- */
-void TKB_SoftKill(void);
+void TKB_MainPower(bool on);
+void TKB_ThrustPower(bool on);
+void TKB_StopAndEnable(void);
 
 /*
  * Desc: Executes idle
@@ -267,9 +254,17 @@ void TKB_IdleThrusters(void);
  */
 void TKB_StopAllThrust(void);
 
+/*
+ * Desc: cached timing of a PWM generator(filled in by TKB_PWM0_Init)
+ *
+ * Parameters:
+ * pwm_gen - TKB_xx_PWM_GEN
+ */
+const mil_br_gen_t *TKB_PWM_Gen(uint32_t pwm_gen);
+
 /*
  * Desc: will read in struct data and set thruster to the speed
- *       specified in speed variable
+ *       specified in speed_q15 variable
  *
  * Parameters:
  * thruster - your struct containg thruster data
@@ -278,6 +273,21 @@ void TKB_StopAllThrust(void);
  */
 void TKB_PWM_SetSpeed(tkb_thrust_data_t thruster);
 
+/*
+ * Desc: sets all NUM_THRUSTERS thrusters to their speed_q15 variables
+ *       in one go
+ *
+ * Parameters:
+ * pthrusters - the indexable array of thrusters
+ *
+ * Notes: every pulse width is worked out before the first one is
+ *        written, so all thrusters change within a few cycles
+ *        of each other
+ *
+ * Assumes: Assumes PWM and ESCs are intialized
+ */
+void TKB_PWM_SetAll(tkb_thrust_data_t *pthrusters);
+
 /**************THRUSTER END***************************/
 
 /**************PROTOCOL END***************************/
@@ -294,10 +304,35 @@ void TKB_PWM_SetSpeed(tkb_thrust_data_t thruster);
 #define THRUST_FLOAT_START 2
 #define THRUST_FLOAT_END 5
 
+/*
+ * All thruster(packed) message, one update is two frames:
+ *
+ * BYTE | 0   | 1                  | 2 - 7
+ *      | 'P' | seq << 1 | half    | 4 setpoints, 12 bits each
+ *
+ * half 0 carries thrusters 0-3 and half 1 thrusters 4-7, both
+ * halves of an update share seq(0 to 127) and nothing moves until
+ * the second half arrives. Setpoints are signed, +-THRUST_ALL_FULL_SCALE
+ * is full forward/reverse, packed little endian two to every 3 bytes:
+ *
+ * byte 0: A[7:0]  byte 1: B[3:0] A[11:8]  byte 2: B[11:4]
+ *
+ * Updates thrown away because a half went missing are counted, the
+ * board sends the count on TKB_CANID with the status once it changes:
+ *
+ * BYTE | 0   | 1   | 2 - 5
+ *      | 'P' | 'R' | updates dropped since power up, little endian
+ */
+#define THRUST_ALL_SEQ_IDX 1
+#define THRUST_ALL_DATA_START 2
+#define THRUST_ALL_PER_FRAME 4
+#define THRUST_ALL_FULL_SCALE 2047
+
 //BYTE DEFINES
 /*CMD/Response(CR) Byte*/
 #define CMD_BYTE  0x43
 #define RESP_BYTE 0x52
+#define STATE_BYTE 0x58 //ASCII: 'X' kill state change(see TKB_Kill.h)
 /*Hard/Soft(HS) Kill Byte*/
 #define SOFT_BYTE 0x53 //ASCII: 'S' SOFT
 #define HARD_BYTE 0x48 //ASCII: 'H' HARD
@@ -310,6 +345,7 @@ void TKB_PWM_SetSpeed(tkb_thrust_data_t thruster);
 #define KILL_START_BYTE 0x4B //ASCII: 'K'
 #define HEARTBEAT_START_BYTE 0x48 //ASCII: 'H'
 #define THRUST_START_BYTE 0x54 //ASCII: 'T'
+#define THRUST_ALL_START_BYTE 0x50 //ASCII: 'P' all thrusters, packed
 
 /*
  * Desc: checks if the message is a kill message
@@ -58,17 +58,18 @@
  *       HALL_GO       -  HALL_KILL_ENABLE     :PB2
  *       HALL_ON_OFF   -  HALL_HARDKILL        :PB0
  *
- *  POSSIBLE BOARD LOCK FUNCTIONS:
- *  BOARD LOCKS WILL OCCUR UNDER KILL CONDITIONS(EITHER SOFT OR HARD)
- *  IN THIS, THE PROGRAM WILL BE LOCKED IN AN STATE WAITING TO BE UNKILLED
- *  THESE CAN ORIGINATE FROM HALL INPUTS OR VIA A KILL MESSAGE OVER CAN
+ *  KILL HANDLING:
+ *  KILLS AND UNKILLS RUN IN THE KILL STATE MACHINE(SEE TKB_Kill.h)
+ *  NOTHING WAITS OR LOCKS THE BOARD, CAN, HEART BEATS AND THE HALL
+ *  CHECKS KEEP RUNNING THROUGH EVERY KILL SEQUENCE
+ *  KILLS CAN ORIGINATE FROM HALL INPUTS OR VIA A KILL MESSAGE OVER CAN
  *
- *  CAN_Mobo_Unkill - will lock if motherboard transmits soft kill message
- *      must be unkilled by motherboard
+ *  Every change of kill state is sent as 'K' 'X' <state> <sources>
+ *  <status 0> <status 1> on TKB_CANID
  *
- *  TIM0_ISR - checks hall effect sensors and kills as necessary
+ *  TIM0_ISR - checks hall effect sensors and steps the kill state machine
  *
- *  TIM1_ISR - transmits the board status
+ *  TIM1_ISR - transmits the board status and any new 'P' drops
  *
  *
  * NOTE CAN MESSAGES:
@@ -80,6 +81,10 @@
  * thruster commands on thruster channel
  * heart beats on thruster channel
  *
+ * Thruster commands come as 'T'(one thruster per frame, float) or
+ * 'P'(all eight thrusters in two frames, see THRUST_ALL_ in
+ * Thruster_Kill_Board.h). A 'P' update moves every thruster at once
+ *
  *
  *
  */
@@ -100,6 +105,10 @@
 #include "MIL_CLK.h"
 #include "MIL_CAN.h"
 #include "Thruster_Kill_Board.h"
+#include "TKB_Kill.h"
+#ifdef TKB_BENCH
+#include "MIL_TIME.h"
+#endif
 
 static const uint8_t C_KILL_LEN = 3;
 static const uint8_t C_GO_LEN = 2;
@@ -125,6 +134,9 @@ static const char GO_Msg[C_GO_LEN] = "GO";      // 0x47 0x00
  * to thrusters
  */
 #define HEART_LIMIT 100
+
+//TIM0 period, also the step of the kill state machine clock
+#define TIM0_PERIOD_MS 10
 #define IDLE_LIMIT 50
 
 /*********************************************ISR PROTO*************************************************/
@@ -158,6 +170,19 @@ void TIM1_ISR(void);
  */
 void Thrust_Pack_Handler(uint8_t *pMsg,tkb_thrust_data_t *thrusters);
 
+/*
+ * Desc: This will parse one half of a packed all thruster('P') command
+ *
+ *       if first half
+ *          keep thrusters 0-3 until the second half
+ *       if second half of the same update
+ *          extract thrusters 4-7
+ *          command all thrusters at once
+ *       else
+ *          drop the update
+ */
+void Thrust_All_Pack_Handler(uint8_t *pMsg,tkb_thrust_data_t *pthrusters);
+
 /*
  * Desc: This will parse data that results from a kill commands from motherboard
  *        and the rest of the CAN network
@@ -171,7 +196,28 @@ void Thrust_Pack_Handler(uint8_t *pMsg,tkb_thrust_data_t *thrusters);
  *
  * NOTE: MOTHERBOARD CANNONT TRANSMIT HARD KILL MESSAGES IN THIS VERSION OF THE FIRMWARE
  */
-void Kill_Pack_Handler(uint8_t *pMsg,MIL_CAN_MailBox_t MailBox);
+void Kill_Pack_Handler(uint8_t *pMsg);
+
+/*
+ * Desc: CAN dispatch handlers, one per message type
+ *       (see MIL_CAN_Register calls in main)
+ *
+ * Kill channel:
+ * Kill_Msg_Handler - 'K' kill commands
+ * Heartbeat_Msg_Handler - 'H' heart beats
+ * Kill_Other_Handler - anything else
+ *
+ * Thruster channel:
+ * Thrust_Msg_Handler - 'T' thruster commands(pctx is the thruster array)
+ * Thrust_All_Msg_Handler - 'P' packed thruster commands(pctx is the thruster array)
+ * Mobo_Other_Handler - anything else
+ */
+void Kill_Msg_Handler(MIL_CAN_Frame_t *pframe, void *pctx);
+void Heartbeat_Msg_Handler(MIL_CAN_Frame_t *pframe, void *pctx);
+void Kill_Other_Handler(MIL_CAN_Frame_t *pframe, void *pctx);
+void Thrust_Msg_Handler(MIL_CAN_Frame_t *pframe, void *pctx);
+void Thrust_All_Msg_Handler(MIL_CAN_Frame_t *pframe, void *pctx);
+void Mobo_Other_Handler(MIL_CAN_Frame_t *pframe, void *pctx);
 
 
 /*
@@ -201,6 +247,19 @@ uint8_t CAN_Mobo_Unkill(MIL_CAN_MailBox_t MailbBox);
  */
 uint8_t Check_MSGisKCSU(uint8_t *pMsg);
 
+#ifdef TKB_BENCH
+/*
+ * Desc: Times thrust to pulse width conversion, float path against
+ *       Q15 path, with the DWT cycle counter
+ *
+ *       Sends 'B' <float cycles(2 bytes)> <Q15 cycles(2 bytes)>
+ *       on TKB_CANID, cycles per conversion, high byte first
+ *
+ * NOTE: build with TKB_BENCH defined to include it
+ */
+void Bench_Thrust(void);
+#endif
+
 
 //FLAGS
 //timer ISR designated to soft kill if no new data received
@@ -223,11 +282,23 @@ volatile uint8_t overall_softkill_last = 0;
 volatile uint8_t HALL_softkill_flag = 0;
 volatile uint8_t mobo_softkill_flag = 0;
 
-//initialize ESCs flags and timer for unkill subprocess
-volatile uint8_t init_ESCS_start = 0;
-volatile uint16_t init_ESCS_timer = 0;
-volatile uint8_t init_ESCS_CMDsent = 0;
-volatile uint8_t init_ESCS_done = 0;
+//kill state machine and its clock(ms, counted by TIM0)
+static tkb_kill_t Kill;
+volatile uint32_t kill_ms = 0;
+
+/*
+ * Desc: kill state machine outputs
+ *       Kill_Report keeps boardStatus in step with the
+ *       machine and sends every change over CAN
+ */
+static void Kill_Report(tkb_kill_state_t state, uint8_t sources);
+static void Kill_StopThrust(void);
+static const tkb_kill_ops_t Kill_Ops = {
+    .pmain_power = &TKB_MainPower,
+    .pthrust_power = &TKB_ThrustPower,
+    .pstop_thrust = &Kill_StopThrust,
+    .preport = &Kill_Report
+};
 
 //counts how many times the board tried to idle
 volatile uint8_t idle_counter = 0;
@@ -235,6 +306,13 @@ volatile uint8_t idle_counter = 0;
 //counts TIM_ISR0 loops to determine when to send messages to mobo, preventing spam
 volatile uint8_t moboTxWait_counter = 0;
 
+//first half of a packed 'P' update waits here for the second half
+static int16_t thrust_all_staged[THRUST_ALL_PER_FRAME];
+static uint8_t thrust_all_seq = 0;
+static bool thrust_all_have_first = false;
+//'P' updates thrown away because a half went missing, TIM1_ISR reports it
+static volatile uint32_t thrust_all_dropped = 0;
+
 /*** CAN MESSAGES ***/
 /* TX MESSAGES */
 //C strings are terminated by Null character
@@ -247,6 +325,14 @@ static const uint8_t C_STATUS_LEN = 2;
 volatile uint8_t boardStatus[C_STATUS_LEN] = {0};
 volatile bool lastGo = 0;
 
+//status and kill messages are sent from both timer ISRs and main,
+//the queue keeps them from overwriting each other
+static MIL_CAN_TxQ_t CAN_TxQueue;
+
+//received frames wait in the ring until the main loop hands them to their handler
+static MIL_CAN_Ring_t CAN_RxRing;
+static MIL_CAN_Dispatch_t CAN_Dispatch;
+
 /* RX MESSAGES */
 //static const char Hard_Killed_CMD[C_KILL_LEN]   = "KCHA";    // 0x4B 0x43 0x48 0x41 0x00 hard assert
 //static const char Soft_Killed_CMD[C_KILL_LEN]   = "KCSA";    // 0x4B 0x43 0x53 0x41 0x00 soft assert
@@ -294,14 +380,14 @@ int main(void){
 
     /*********TRHUSTERS*************/
      //thruster attributes
-    tkb_thrust_data_t thrust0_fhl = {.thrust_addr = 0,.pwm_gen = TKB_FH_PWM_GEN,.pwm_out = TKB_PWM_FHL_PIN,.speed.speed_float = 0},
-                      thrust1_fhr = {.thrust_addr = 1,.pwm_gen = TKB_FH_PWM_GEN,.pwm_out = TKB_PWM_FHR_PIN,.speed.speed_float = 0},
-                      thrust2_fvl = {.thrust_addr = 2,.pwm_gen = TKB_FV_PWM_GEN,.pwm_out = TKB_PWM_FVL_PIN,.speed.speed_float = 0},
-                      thrust3_fvr = {.thrust_addr = 3,.pwm_gen = TKB_FV_PWM_GEN,.pwm_out = TKB_PWM_FVR_PIN,.speed.speed_float = 0},
-                      thrust4_bhl = {.thrust_addr = 4,.pwm_gen = TKB_BH_PWM_GEN,.pwm_out = TKB_PWM_BHL_PIN,.speed.speed_float = 0},
-                      thrust5_bhr = {.thrust_addr = 5,.pwm_gen = TKB_BH_PWM_GEN,.pwm_out = TKB_PWM_BHR_PIN,.speed.speed_float = 0},
-                      thrust6_bvl = {.thrust_addr = 6,.pwm_gen = TKB_BV_PWM_GEN,.pwm_out = TKB_PWM_BVL_PIN,.speed.speed_float = 0},
-                      thrust7_bvr = {.thrust_addr = 7,.pwm_gen = TKB_BV_PWM_GEN,.pwm_out = TKB_PWM_BVR_PIN,.speed.speed_float = 0};
+    tkb_thrust_data_t thrust0_fhl = {.thrust_addr = 0,.pwm_gen = TKB_FH_PWM_GEN,.pwm_out = TKB_PWM_FHL_PIN,.speed.speed_float = 0,.speed_q15 = 0},
+                      thrust1_fhr = {.thrust_addr = 1,.pwm_gen = TKB_FH_PWM_GEN,.pwm_out = TKB_PWM_FHR_PIN,.speed.speed_float = 0,.speed_q15 = 0},
+                      thrust2_fvl = {.thrust_addr = 2,.pwm_gen = TKB_FV_PWM_GEN,.pwm_out = TKB_PWM_FVL_PIN,.speed.speed_float = 0,.speed_q15 = 0},
+                      thrust3_fvr = {.thrust_addr = 3,.pwm_gen = TKB_FV_PWM_GEN,.pwm_out = TKB_PWM_FVR_PIN,.speed.speed_float = 0,.speed_q15 = 0},
+                      thrust4_bhl = {.thrust_addr = 4,.pwm_gen = TKB_BH_PWM_GEN,.pwm_out = TKB_PWM_BHL_PIN,.speed.speed_float = 0,.speed_q15 = 0},
+                      thrust5_bhr = {.thrust_addr = 5,.pwm_gen = TKB_BH_PWM_GEN,.pwm_out = TKB_PWM_BHR_PIN,.speed.speed_float = 0,.speed_q15 = 0},
+                      thrust6_bvl = {.thrust_addr = 6,.pwm_gen = TKB_BV_PWM_GEN,.pwm_out = TKB_PWM_BVL_PIN,.speed.speed_float = 0,.speed_q15 = 0},
+                      thrust7_bvr = {.thrust_addr = 7,.pwm_gen = TKB_BV_PWM_GEN,.pwm_out = TKB_PWM_BVR_PIN,.speed.speed_float = 0,.speed_q15 = 0};
 
     //a pointer array so I can address thruster by index if need be
     tkb_thrust_data_t pthrusters[8];
@@ -328,7 +414,7 @@ int main(void){
     uint8_t Kill_Data[TKB_CAN_KILL_LEN];
      //all struct data initialized here
      MIL_CAN_MailBox_t CAN_KillBox = {.canid = TKB_KILLID, .filt_mask = TKB_KILL_FILTID_bm,.base = TKB_CAN_BASE,.msg_len = TKB_CAN_KILL_LEN,.obj_num = 1,.rx_flag_int = 0,.buffer = Kill_Data},
-                       CAN_MoboBox = {.canid = TKB_MOBOID, .filt_mask = TKB_MOBO_FILTID_bm,.base = TKB_CAN_BASE,.msg_len = TKB_CAN_MOBO_LEN,.obj_num = 2,.rx_flag_int = 0,.buffer = Mobo_Data};
+                       CAN_MoboBox = {.canid = TKB_MOBOID, .filt_mask = TKB_MOBO_FILTID_bm,.base = TKB_CAN_BASE,.msg_len = TKB_CAN_MOBO_LEN,.obj_num = TKB_CAN_MOBO_OBJ,.rx_flag_int = 0,.buffer = Mobo_Data,.fifo_depth = TKB_CAN_MOBO_DEPTH};
 
 
 
@@ -345,11 +431,8 @@ int main(void){
     //will intialize the module
     TKB_PWM0_Init();
 
-    //will send stop signal to ESCs
-    //to begin communication
-    TKB_Init_ESC();
-    init_ESCS_done = 1;
-    boardStatus[1] |= 0x40; //set thruster initialized flag
+    //the ESCs are powered and sent the stop signal by the
+    //kill state machine once CAN is up(see below)
 
     /**************************************THRUSTER INIT END**********************/
 
@@ -367,10 +450,31 @@ int main(void){
 
     TKB_CANInit();
 
+    //every MIL_CANSimpleTX below goes through the TX queue
+    MIL_CAN_TxQueueInit(TKB_CAN_BASE, &CAN_TxQueue, TKB_CAN_TXQ_OBJ, TKB_CAN_TXQ_LEN);
+
+    //frames are queued by the CAN ISR and decoded in the main loop
+    MIL_CAN_RxRingEnable(TKB_CAN_BASE, &CAN_RxRing);
+    MIL_CAN_DispatchEnable(TKB_CAN_BASE, &CAN_Dispatch, false);
+
     //initialize KILL mailbox
     MIL_InitMailBox(&CAN_KillBox);
     MIL_InitMailBox(&CAN_MoboBox);
 
+    //message type(first byte) to handler
+    MIL_CAN_Register(&CAN_KillBox, KILL_START_BYTE, &Kill_Msg_Handler, 0);
+    MIL_CAN_Register(&CAN_KillBox, HEARTBEAT_START_BYTE, &Heartbeat_Msg_Handler, 0);
+    MIL_CAN_Register(&CAN_KillBox, MIL_CAN_ANY_TYPE, &Kill_Other_Handler, 0);
+    MIL_CAN_Register(&CAN_MoboBox, THRUST_START_BYTE, &Thrust_Msg_Handler, pthrusters);
+    MIL_CAN_Register(&CAN_MoboBox, THRUST_ALL_START_BYTE, &Thrust_All_Msg_Handler, pthrusters);
+    MIL_CAN_Register(&CAN_MoboBox, MIL_CAN_ANY_TYPE, &Mobo_Other_Handler, 0);
+
+    //powers thrusters, TIM0 steps it through the ESC start up
+    TKB_KillInit(&Kill, &Kill_Ops, kill_ms);
+
+#ifdef TKB_BENCH
+    Bench_Thrust();
+#endif
 
     /**************************************CAN INIT END********************/
 
@@ -385,7 +489,7 @@ int main(void){
      * be considered the normal rate at which
      * motherboard will transmit messages
      */
-    Timer0_OVF_Init(&TIM0_ISR,10);
+    Timer0_OVF_Init(&TIM0_ISR,TIM0_PERIOD_MS);
 
     //configured for 1s period
     Timer1_OVF_Init(&TIM1_ISR, 1000);
@@ -426,50 +530,13 @@ int main(void){
 
         /****************CAN HANDLING START**************************/
         /*
-         * Software implemented priority encoder
+         * Every frame received since the last pass goes to its
+         * handler in arrival order(see the MIL_CAN_Register calls)
+         *
+         * systems will periodically ensure the thrusters are idle if there hasn't been
+         * a message sent from motherboard
          */
-
-        //Check for non motherboard sources of kill
-        if(MIL_CAN_CheckMail(&CAN_KillBox) == MIL_CAN_OK){
-            MIL_CAN_GetMail(&CAN_KillBox);
-
-            //if it's a kill message, run the kill handler
-            if(TKB_Check_KillMsg(Kill_Data)){
-                Kill_Pack_Handler(Kill_Data,CAN_KillBox);
-            }
-
-            //if it's a heart beat, reset missed counter
-            else if(TKB_Check_HeartbeatMsg(Kill_Data)){
-                heartbeat_missed_counter = 0;
-            }
-
-            else
-            {
-                init_ESCS_start = 0;
-                boardStatus[1] &= 0xBF;
-            }
-
-            //expand here to accept more messages from kill channel
-
-        }
-
-        //interpret motherboard data
-        else if(MIL_CAN_CheckMail(&CAN_MoboBox)== MIL_CAN_OK){
-            MIL_CAN_GetMail(&CAN_MoboBox);
-            idle_counter = 0x00; //set idle command to 0 since we received something
-
-            if((boardStatus[0] & 0x1C) == 0x00){ //if not softkilled
-                //if it's a thruster message do this
-                if((TKB_Check_ThrustMsg(Mobo_Data)) && (init_ESCS_done == 1)){
-                    Thrust_Pack_Handler(Mobo_Data,pthrusters);
-                }
-            }
-            //expand here to accept more messages from thruster channel
-
-        }
-        //systems will periodically ensure the thrusters are idle if there hasn't been
-        //a message sent from motherboard
-        else{
+        if(MIL_CAN_DispatchPoll(TKB_CAN_BASE) == 0){
             if(idle_counter >= IDLE_LIMIT){
                 TKB_IdleThrusters();
             }
@@ -483,66 +550,6 @@ int main(void){
 
         /**************HEART BEAT CHECK END***************************************/
 
-
-        /**************INITIALIZE ESCS SUBPROCESS START***************************/
-
-        if(init_ESCS_start == 1)
-        {
-            boardStatus[1] &= 0xBF; //clear thruster initialized flag
-            // Wait 300 * 10 ms for the thrusters to power up,
-            // then send the stop command to the thrusters to initialize them.
-            // This runs only once, and then sets the init_ESCS_CMDsent flag
-            if((init_ESCS_CMDsent == 0) && (init_ESCS_timer >= 300))
-            {
-                PWMPulseWidthSet(TKB_PWM_BASE,
-                                 TKB_PWM_FHL_PIN,
-                                 PWM_STOP_PER(TKB_PWM_BASE,TKB_FH_PWM_GEN));
-                PWMPulseWidthSet(TKB_PWM_BASE,
-                                 TKB_PWM_FHR_PIN,
-                                 PWM_STOP_PER(TKB_PWM_BASE,TKB_FH_PWM_GEN));
-                PWMPulseWidthSet(TKB_PWM_BASE,
-                                 TKB_PWM_FVL_PIN,
-                                 PWM_STOP_PER(TKB_PWM_BASE,TKB_FV_PWM_GEN));
-                PWMPulseWidthSet(TKB_PWM_BASE,
-                                 TKB_PWM_FVR_PIN,
-                                 PWM_STOP_PER(TKB_PWM_BASE,TKB_FV_PWM_GEN));
-                PWMPulseWidthSet(TKB_PWM_BASE,
-                                 TKB_PWM_BHL_PIN,
-                                 PWM_STOP_PER(TKB_PWM_BASE,TKB_BH_PWM_GEN));
-                PWMPulseWidthSet(TKB_PWM_BASE,
-                                 TKB_PWM_BHR_PIN,
-                                 PWM_STOP_PER(TKB_PWM_BASE,TKB_BH_PWM_GEN));
-                PWMPulseWidthSet(TKB_PWM_BASE,
-                                 TKB_PWM_BVL_PIN,
-                                 PWM_STOP_PER(TKB_PWM_BASE,TKB_BV_PWM_GEN));
-                PWMPulseWidthSet(TKB_PWM_BASE,
-                                 TKB_PWM_BVR_PIN,
-                                 PWM_STOP_PER(TKB_PWM_BASE,TKB_BV_PWM_GEN));
-
-                TKB_PWM_OUT_EN();
-                init_ESCS_CMDsent = 1;
-                init_ESCS_timer = 0;
-            }
-
-            if((init_ESCS_CMDsent == 1) && (init_ESCS_timer >= 200))
-            {
-                // After sending the stop command and waiting 300 * 10 ms,
-                // set the init_ESCS_done flag to allow sending thrust commands.
-                // End the subprocess by resetting the previous flags
-                init_ESCS_start = 0;
-                init_ESCS_CMDsent = 0;
-                init_ESCS_timer = 0;
-                init_ESCS_done = 1;
-                boardStatus[1] |= 0x40; //set thruster initialized flag
-
-                // Notify the mobo that the unkill process is complete
-                moboTxWait_counter = 0;
-                MIL_CANSimpleTX(TKB_CANID,boardStatus,C_STATUS_LEN,TKB_CAN_BASE);
-            }
-        }
-
-        /**************INITIALIZE ESCS SUBPROCESS END*****************************/
-
     }
 
 }
@@ -564,16 +571,99 @@ void Thrust_Pack_Handler(uint8_t *pMsg,tkb_thrust_data_t *pthrusters){
 
     uint8_t thrust_id = pMsg[THRUST_ID_IDX];
 
+    //a bad ID would write past the thruster array
+    if(thrust_id >= NUM_THRUSTERS) return;
+
      //extract float data
      for(uint8_t i = 0;i < 4 ;i++){
 
          pthrusters[thrust_id].speed.array[i] = pMsg[THRUST_FLOAT_START + i];
 
       }
+      pthrusters[thrust_id].speed_q15 = MIL_BR_float_to_q15(pthrusters[thrust_id].speed.speed_float);
       TKB_PWM_SetSpeed(pthrusters[thrust_id]);
 
 }
 
+/*
+ * Desc: Pulls setpoint n(0 to 3) out of the data bytes of a 'P' frame
+ *
+ * Returns: the signed 12 bit setpoint
+ */
+static int16_t Thrust_All_Unpack(uint8_t *pData, uint8_t n){
+
+    uint8_t *p = pData + (n >> 1) * 3;
+    uint16_t raw;
+
+    if(n & 0x01){
+        raw = (p[1] >> 4) | ((uint16_t)p[2] << 4);
+    }
+    else{
+        raw = p[0] | ((uint16_t)(p[1] & 0x0F) << 8);
+    }
+
+    //sign extend 12 bits to 16
+    return (int16_t)(raw << 4) >> 4;
+
+}
+
+/*
+ * Desc: Setpoint to the Q15 thrust the ESC functions take
+ */
+static int16_t Thrust_All_ToQ15(int16_t setpoint){
+
+    if(setpoint < -THRUST_ALL_FULL_SCALE){
+        setpoint = -THRUST_ALL_FULL_SCALE;
+    }
+
+    return (int16_t)(((int32_t)setpoint * 32767) / THRUST_ALL_FULL_SCALE);
+
+}
+
+/*
+ * Desc: This will parse one half of a packed all thruster('P') command
+ *
+ * Parameters:
+ * pthrusters - our set indexable array of thrusters object
+ * pMsg- pointer to received message
+ *
+ * Notes: A first half replaces any first half still waiting, a second
+ *        half only counts if its seq matches the waiting first half
+ */
+void Thrust_All_Pack_Handler(uint8_t *pMsg,tkb_thrust_data_t *pthrusters){
+
+    uint8_t *pData = &pMsg[THRUST_ALL_DATA_START];
+    uint8_t seq = pMsg[THRUST_ALL_SEQ_IDX] >> 1;
+
+    //first half, thrusters 0-3
+    if((pMsg[THRUST_ALL_SEQ_IDX] & 0x01) == 0){
+        if(thrust_all_have_first){
+            thrust_all_dropped++;
+        }
+        for(uint8_t i = 0;i < THRUST_ALL_PER_FRAME;i++){
+            thrust_all_staged[i] = Thrust_All_Unpack(pData, i);
+        }
+        thrust_all_seq = seq;
+        thrust_all_have_first = true;
+        return;
+    }
+
+    //second half, thrusters 4-7
+    if(!thrust_all_have_first || (seq != thrust_all_seq)){
+        thrust_all_have_first = false;
+        thrust_all_dropped++;
+        return;
+    }
+    thrust_all_have_first = false;
+
+    for(uint8_t i = 0;i < THRUST_ALL_PER_FRAME;i++){
+        pthrusters[i].speed_q15 = Thrust_All_ToQ15(thrust_all_staged[i]);
+        pthrusters[i + THRUST_ALL_PER_FRAME].speed_q15 = Thrust_All_ToQ15(Thrust_All_Unpack(pData, i));
+    }
+    TKB_PWM_SetAll(pthrusters);
+
+}
+
 /*
  * Desc: This will parse data that results from a kill commands from motherboard
  *        and the rest of the CAN network
@@ -586,31 +676,123 @@ void Thrust_Pack_Handler(uint8_t *pMsg,tkb_thrust_data_t *pthrusters){
  *       else
  *          ignore
  *
- * LOCK: THIS FUNCTION WILL LOCK THE BOARD UNTIL MOBO UNKILLS IT
- *       IF LOCK CONDITION MET
+ * Notes: Only raises/clears the motherboard kill sources, the
+ *        kill state machine does the rest
  *
  */
-void Kill_Pack_Handler(uint8_t *pMsg,MIL_CAN_MailBox_t MailBox){
-    if(pMsg[MSG_CR_IDX] == CMD_BYTE){ //if it's a command byte
-        if(pMsg[MSG_UA_IDX] == A_BYTE){ //if asserting
-            if(pMsg[KILL_TYPE_IDX] == SOFT_BYTE){ //if soft kill
-                boardStatus[0] |= 0x10; //set flag
-                TKB_SoftKill(); //soft kill
-            }
-            else if(pMsg[KILL_TYPE_IDX] == HARD_BYTE){ //if hard kill
-                boardStatus[0] |= 0x80; //set flag
-                TKB_HardKill(); //hard kill
-            }
+void Kill_Pack_Handler(uint8_t *pMsg){
+
+    bool int_off;
+
+    if(pMsg[MSG_CR_IDX] != CMD_BYTE){ //if it's not a command byte
+        return;
+    }
+
+    //TIM0 steps the same machine
+    int_off = IntMasterDisable();
+
+    if(pMsg[MSG_UA_IDX] == A_BYTE){ //if asserting
+        if(pMsg[KILL_TYPE_IDX] == SOFT_BYTE){ //if soft kill
+            TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_MOBO, true, kill_ms);
         }
-        else if(pMsg[MSG_UA_IDX] == U_BYTE){ //if unassert
-            if(pMsg[KILL_TYPE_IDX] == SOFT_BYTE){ //if soft unkill
-                TKB_SoftUnKill(); //soft kill
-            }
-            //can't hard unkill
+        else if(pMsg[KILL_TYPE_IDX] == HARD_BYTE){ //if hard kill
+            TKB_KillSet(&Kill, TKB_KILL_SRC_HARD_MOBO, true, kill_ms);
+        }
+    }
+    else if(pMsg[MSG_UA_IDX] == U_BYTE){ //if unassert
+        if(pMsg[KILL_TYPE_IDX] == SOFT_BYTE){ //if soft unkill
+            TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_MOBO, false, kill_ms);
         }
+        //can't hard unkill
+    }
+
+    if(!int_off){
+        IntMasterEnable();
     }
 }
 
+/*
+ * Desc: kill channel, 'K' message
+ */
+void Kill_Msg_Handler(MIL_CAN_Frame_t *pframe, void *pctx){
+
+    Kill_Pack_Handler(pframe->data);
+
+}
+
+/*
+ * Desc: kill channel, 'H' message
+ *       reset missed counter
+ */
+void Heartbeat_Msg_Handler(MIL_CAN_Frame_t *pframe, void *pctx){
+
+    heartbeat_missed_counter = 0;
+
+}
+
+/*
+ * Desc: kill channel, any other message
+ */
+void Kill_Other_Handler(MIL_CAN_Frame_t *pframe, void *pctx){
+
+    //expand here to accept more messages from kill channel
+    //(register a handler for the new type in main)
+
+}
+
+/*
+ * Desc: thruster channel, 'T' message
+ *
+ * Parameters:
+ * pctx - the thruster array
+ */
+void Thrust_Msg_Handler(MIL_CAN_Frame_t *pframe, void *pctx){
+
+    //too short to hold the thruster ID and float
+    if(pframe->len <= THRUST_FLOAT_END) return;
+
+    idle_counter = 0x00; //set idle command to 0 since we received something
+
+    if(TKB_KillCanThrust(&Kill)){ //if not killed and the ESCs are armed
+        Thrust_Pack_Handler(pframe->data, (tkb_thrust_data_t *)pctx);
+    }
+
+}
+
+/*
+ * Desc: thruster channel, 'P' message
+ *
+ * Parameters:
+ * pctx - the thruster array
+ */
+void Thrust_All_Msg_Handler(MIL_CAN_Frame_t *pframe, void *pctx){
+
+    //both halves carry all 8 bytes
+    if(pframe->len < 8) return;
+
+    idle_counter = 0x00; //set idle command to 0 since we received something
+
+    if(TKB_KillCanThrust(&Kill)){ //if not killed and the ESCs are armed
+        Thrust_All_Pack_Handler(pframe->data, (tkb_thrust_data_t *)pctx);
+    }
+    else{
+        //a first half from before the kill must not pair with one after it
+        thrust_all_have_first = false;
+    }
+
+}
+
+/*
+ * Desc: thruster channel, any other message
+ */
+void Mobo_Other_Handler(MIL_CAN_Frame_t *pframe, void *pctx){
+
+    idle_counter = 0x00; //set idle command to 0 since we received something
+
+    //expand here to accept more messages from thruster channel
+    //(register a handler for the new type in main)
+
+}
 
 /*
  * Desc: Handles heart beat logic
@@ -705,6 +887,100 @@ uint8_t Check_MSGisKCSU(uint8_t *pMsg){
 
 
 /*********************************************FUNC DEFINITIONS**********************************/
+
+#ifdef TKB_BENCH
+/*
+ * Desc: Times thrust to pulse width conversion, float path against
+ *       Q15 path, with the DWT cycle counter
+ */
+void Bench_Thrust(void){
+
+    static float thrust_float[256];
+    static int16_t thrust_q15[256];
+    const mil_br_gen_t *pgen = TKB_PWM_Gen(TKB_FH_PWM_GEN);
+    volatile uint32_t sink = 0;
+    uint32_t start;
+    uint32_t cyc_float;
+    uint32_t cyc_q15;
+    uint8_t msg[5];
+
+    //the same 256 thrusts both ways, worked out before timing
+    for(uint16_t i = 0;i < 256;i++){
+        thrust_q15[i] = (int16_t)((i << 8) - 32768);
+        thrust_float[i] = thrust_q15[i] / 32768.0f;
+    }
+
+    MIL_CycInit();
+
+    start = MIL_CYC_NOW();
+    for(uint16_t i = 0;i < 256;i++){
+        sink += MIL_BR_linear_per(thrust_float[i],TKB_PWM_BASE,TKB_FH_PWM_GEN);
+    }
+    cyc_float = (MIL_CYC_NOW() - start) / 256;
+
+    start = MIL_CYC_NOW();
+    for(uint16_t i = 0;i < 256;i++){
+        sink += MIL_BR_q15_per(pgen,thrust_q15[i]);
+    }
+    cyc_q15 = (MIL_CYC_NOW() - start) / 256;
+
+    msg[0] = 'B';
+    msg[1] = cyc_float >> 8;
+    msg[2] = cyc_float;
+    msg[3] = cyc_q15 >> 8;
+    msg[4] = cyc_q15;
+    MIL_CANSimpleTX(TKB_CANID,msg,sizeof(msg),TKB_CAN_BASE);
+
+}
+#endif
+
+/*
+ * Desc: Kill state machine stop, every thruster to its stop pulse
+ *       and any waiting first half of a 'P' update thrown away
+ */
+static void Kill_StopThrust(void){
+
+    thrust_all_have_first = false;
+    TKB_StopAndEnable();
+
+}
+
+/*
+ * Desc: Kill state machine report, runs after every change of
+ *       kill state or kill sources
+ *
+ *       boardStatus[0]: 0x08 soft(hardware) 0x10 soft(software)
+ *                       0x40 hard(hardware) 0x80 hard(software)
+ *       boardStatus[1]: 0x40 thrusters initialized
+ */
+static void Kill_Report(tkb_kill_state_t state, uint8_t sources){
+
+    uint8_t msg[6];
+    uint8_t kill_bits = 0;
+
+    if(sources & TKB_KILL_SRC_SOFT_HALL){ kill_bits |= 0x08; }
+    if(sources & TKB_KILL_SRC_SOFT_MOBO){ kill_bits |= 0x10; }
+    if(sources & TKB_KILL_SRC_HARD_HALL){ kill_bits |= 0x40; }
+    if(sources & TKB_KILL_SRC_HARD_MOBO){ kill_bits |= 0x80; }
+
+    boardStatus[0] = (boardStatus[0] & 0x27) | kill_bits;
+    if(state == TKB_KILL_RUN){
+        boardStatus[1] |= 0x40; //set thruster initialized flag
+    }
+    else{
+        boardStatus[1] &= 0xBF; //clear thruster initialized flag
+    }
+
+    msg[MSG_TYPE_IDX] = KILL_START_BYTE;
+    msg[MSG_CR_IDX] = STATE_BYTE;
+    msg[2] = (uint8_t)state;
+    msg[3] = sources;
+    msg[4] = boardStatus[0];
+    msg[5] = boardStatus[1];
+    MIL_CANSimpleTX(TKB_CANID,msg,sizeof(msg),TKB_CAN_BASE);
+
+}
+
 void updateHallFlags(){
     if(HALL_Check_Soft() == HALL_TRUE){
         boardStatus[0] |= 0x04; //set flag
@@ -730,28 +1006,19 @@ void updateHallFlags(){
 
 //TIMER0 = hall effects and kill handling (10ms)
 void TIM0_ISR(void){
-    TimerIntClear(TIMER0_BASE, TIMER_TIMB_TIMEOUT);
+    TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
     updateHallFlags();
 
-    //if hard hall effect is false (POWER OFF)
-    if((boardStatus[0] & 0x20) != 0x20){
-        boardStatus[0] |= 0x40; //set hard kill (hardware)
-        TKB_HardKill(); //hard kill
-        boardStatus[0] &= 0xBF; //clear hard kill (hardware)
-    }
+    kill_ms += TIM0_PERIOD_MS;
 
-    //if soft hall effect flag is true
-    if((boardStatus[0] & 0x04) == 0x04){
-        boardStatus[0] |= 0x08; //set soft kill (hardware)
-        boardStatus[1] &= 0xBF; //clear thruster initialized flag
-        TKB_SoftKill(); //soft kill
-    }
-    //else if soft hall effect is false
-    else if((boardStatus[0] & 0x04) != 0x04){
-        boardStatus[0] &= 0xF7; //clear soft kill (hardware)
-        TKB_SoftUnKill(); //soft unkill
-        boardStatus[1] |= 0x40; //set thruster initialized flag
-    }
+    //hard kill while hard hall effect is false (POWER OFF)
+    TKB_KillSet(&Kill, TKB_KILL_SRC_HARD_HALL, (boardStatus[0] & 0x20) != 0x20, kill_ms);
+
+    //soft kill while soft hall effect flag is true
+    TKB_KillSet(&Kill, TKB_KILL_SRC_SOFT_HALL, (boardStatus[0] & 0x04) == 0x04, kill_ms);
+
+    //move on from any kill state whose time is up
+    TKB_KillStep(&Kill, kill_ms);
 
     //send a soft kill asserted message every 1 second
     if(moboTxWait_counter > 100){
@@ -773,21 +1040,30 @@ void TIM0_ISR(void){
         heartbeat_missed_counter += 1;
     }
 
-    //increment the init_ESCS_timer if the init_ESCS_start flag is set
-    if(init_ESCS_start == 1)
-    {
-        init_ESCS_timer += 1;
-    }
-
     //increment idle counter
     idle_counter++;
 }
 
 //TIMER1 = board status (1s)
 void TIM1_ISR(void){
-    TimerIntClear(TIMER1_BASE, TIMER_TIMB_TIMEOUT);
+    TimerIntClear(TIMER1_BASE, TIMER_TIMA_TIMEOUT);
+
+    static uint32_t dropped_sent = 0;
+    uint32_t dropped = thrust_all_dropped;
+    uint8_t msg[6];
 
     if((boardStatus[0] & 0xFC) == 0x00){ //if no kill flags raised
         MIL_CANSimpleTX(TKB_CANID,boardStatus,C_STATUS_LEN,TKB_CAN_BASE); //send board status
     }
+
+    //'P' 'R' drop count, only when it moved
+    if(dropped != dropped_sent){
+        msg[MSG_TYPE_IDX] = THRUST_ALL_START_BYTE;
+        msg[MSG_CR_IDX] = RESP_BYTE;
+        for(uint8_t i = 0;i < 4;i++){
+            msg[2 + i] = (uint8_t)(dropped >> (8 * i));
+        }
+        MIL_CANSimpleTX(TKB_CANID,msg,sizeof(msg),TKB_CAN_BASE);
+        dropped_sent = dropped;
+    }
 }